@@ -0,0 +1,159 @@
+#include "transactiondb/src/Reader.hpp"
+#include "transactiondb/src/PipelineDataCallback.hpp"
+#include "sparta/pipeViewer/Outputter.hpp"
+#include "sparta/utils/SpartaAssert.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/**
+ * \file ReaderBenchmark.cpp
+ * \brief Writes a synthetic pipeViewer database and times reading it back
+ * with pipeViewer::Reader the way Argos does (one window per chunk).
+ *
+ * Usage: ArgosReaderBenchmark [num_records] [database prefix]
+ *
+ * The database is a mix of annotation, instruction and pair records,
+ * roughly 100 bytes per record on average. 20 million records give a
+ * database of about 2 GB.
+ */
+namespace
+{
+    using namespace sparta::pipeViewer;
+
+    constexpr uint64_t HEARTBEAT = 1000;
+    constexpr uint64_t RECORDS_PER_CYCLE = 8;
+    constexpr uint32_t NUM_LOCATIONS = 64;
+
+    //! Counts records and touches their contents like a real consumer
+    class CountingCallback : public PipelineDataCallback
+    {
+    public:
+        uint64_t records = 0;
+        uint64_t checksum = 0;
+
+        void foundTransactionRecord(const transaction_t* t) override {
+            ++records;
+            checksum += t->time_End ^ t->location_ID;
+        }
+        void foundInstRecord(const instruction_t* t) override {
+            foundTransactionRecord(t);
+            checksum += t->virtual_ADR;
+        }
+        void foundMemRecord(const memoryoperation_t* t) override {
+            foundTransactionRecord(t);
+        }
+        void foundAnnotationRecord(const annotation_t* t) override {
+            foundTransactionRecord(t);
+            checksum += t->annt.size();
+        }
+        void foundPairRecord(const pair_t* t) override {
+            foundTransactionRecord(t);
+            for(const auto& str : t->stringVector) {
+                checksum += str.size();
+            }
+        }
+    };
+
+    void writeDatabase(const std::string& prefix, const uint64_t num_records)
+    {
+        Outputter out(prefix, HEARTBEAT);
+
+        pair_t pair;
+        pair.flags = is_Pair;
+        pair.pairId = 1;
+        pair.length = 4;
+        pair.nameVector = {"uid", "pc", "opcode", "disasm"};
+        pair.sizeOfVector = {sizeof(uint64_t), sizeof(uint64_t), sizeof(uint32_t), 0};
+        pair.delimVector = {sparta::PairFormatter::DECIMAL, sparta::PairFormatter::HEX,
+                            sparta::PairFormatter::DECIMAL, sparta::PairFormatter::DECIMAL};
+        // opcode is an integer with a string representation; disasm is string-only
+        pair.valueVector = {{0, true}, {0, true}, {0, true}, {0, false}};
+        pair.stringVector = {"", "", "", ""};
+        const std::string opcodes[] = {"add", "sub", "ld", "st"};
+
+        annotation_t annt;
+        annt.flags = is_Annotation;
+
+        instruction_t inst;
+        inst.flags = is_Instruction;
+
+        uint64_t written = 0;
+        for(uint64_t cycle = 0; written < num_records; ++cycle) {
+            if(cycle % HEARTBEAT == 0) {
+                out.writeIndex();
+            }
+            for(uint64_t i = 0; i < RECORDS_PER_CYCLE && written < num_records; ++i, ++written) {
+                transaction_t t(cycle, cycle + 1, 0, written, written & 0xfff,
+                                (written % NUM_LOCATIONS), 0, 0);
+                switch(written % 3) {
+                case 0:
+                    static_cast<transaction_t&>(annt) = t;
+                    annt.flags = is_Annotation;
+                    annt.annt = "uid " + std::to_string(written) + " add x1, x2, x3";
+                    annt.length = annt.annt.size();
+                    out.writeTransaction(annt);
+                    break;
+                case 1:
+                    static_cast<transaction_t&>(inst) = t;
+                    inst.flags = is_Instruction;
+                    inst.virtual_ADR = 0x1000 + written * 4;
+                    inst.real_ADR = inst.virtual_ADR;
+                    out.writeTransaction(inst);
+                    break;
+                default:
+                    static_cast<transaction_t&>(pair) = t;
+                    pair.flags = is_Pair;
+                    // Pair locations are kept apart from the others
+                    pair.location_ID = NUM_LOCATIONS + (written % NUM_LOCATIONS);
+                    pair.valueVector[0].first = written;
+                    pair.valueVector[1].first = 0x1000 + written * 4;
+                    pair.valueVector[2].first = written % 4;
+                    pair.stringVector[2] = opcodes[written % 4];
+                    pair.stringVector[3] = opcodes[written % 4] + " x1, x2, x3";
+                    out.writeTransaction(pair);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const uint64_t num_records = (argc > 1) ? std::strtoull(argv[1], nullptr, 0) : 5000000;
+    const std::string prefix = (argc > 2) ? argv[2] : "reader_bench_";
+
+    using clock = std::chrono::steady_clock;
+    auto seconds = [](clock::duration d) { return std::chrono::duration<double>(d).count(); };
+
+    auto t0 = clock::now();
+    writeDatabase(prefix, num_records);
+    auto t1 = clock::now();
+
+    auto reader = Reader::construct<CountingCallback>(prefix);
+    auto t2 = clock::now();
+
+    // Read the whole database one chunk at a time, like Argos scrolling
+    const uint64_t chunk = reader.getChunkSize() * 10;
+    for(uint64_t start = reader.getCycleFirst(); start <= reader.getCycleLast(); start += chunk) {
+        reader.getWindow(start, start + chunk);
+    }
+    auto t3 = clock::now();
+
+    const auto& cb = reader.getCallbackAs<CountingCallback>();
+    sparta_assert(cb.records == num_records,
+                  "Read " << cb.records << " records but wrote " << num_records);
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "records:      " << num_records << '\n'
+              << "write:        " << seconds(t1 - t0) << " s\n"
+              << "open:         " << seconds(t2 - t1) << " s\n"
+              << "read:         " << seconds(t3 - t2) << " s ("
+              << std::setprecision(0) << (num_records / seconds(t3 - t2)) << " records/s)\n"
+              << "checksum:     " << cb.checksum << std::endl;
+    return 0;
+}
@@ -1,10 +1,17 @@
 #include <cassert>
 #include <cstdlib>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <limits>
 #include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 /*!
  * \brief Helper for quickly scanning through a SPARTA log file based on
@@ -24,76 +31,249 @@
  * // reject BAD_LOCATION return value, read from file, repeat above...
  * \endcode
  *
+ * The log is memory-mapped and scanned line by line with memchr. A sparse
+ * tick index (one entry per INDEX_INTERVAL bytes of log) lets a lookup
+ * binary-search to the right part of the file and then scan only a short
+ * distance. The index is built on first use and cached next to the log in
+ * "<log>.tickidx". The cache is rebuilt if the log's size or modification
+ * time no longer match it.
+ *
  * \todo This should support reading lines directly from the file as well
  */
 class LogSearch
 {
-    std::ifstream in_;
+    //! Sidecar index file header
+    struct IndexHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t log_bytes;     //!< Size of the log when indexed
+        int64_t log_mtime_sec;  //!< Modification time of the log when indexed
+        int64_t log_mtime_nsec;
+        uint64_t interval;      //!< INDEX_INTERVAL used to build the index
+        uint64_t num_entries;
+    };
+
+    /*!
+     * \brief Index entry. No "{tick" line before \a offset has a tick
+     * greater than \a max_tick_before. \a offset is always the start of a line
+     */
+    struct IndexEntry {
+        uint64_t offset;
+        uint64_t max_tick_before;
+    };
+
+    static constexpr char INDEX_MAGIC[8] = {'S','P','L','O','G','I','D','X'};
+    static constexpr uint32_t INDEX_VERSION = 1;
+
+    //! Approximate number of log bytes between index entries
+    static constexpr uint64_t INDEX_INTERVAL = 64 * 1024;
+
+    //! Ticks are not expected to have more digits than this
+    static constexpr uint32_t MAX_TICK_DIGITS = 20;
+
+    const std::string filename_;
+    const char* data_ = nullptr;
     uint64_t file_bytes_ = 0;
+    struct stat stat_ = {};
+    std::vector<IndexEntry> index_;
+    bool index_built_ = false;
+
+    /*!
+     * \brief Parse the tick of the line starting at \a pos
+     * \return false if the line does not start with "{tick"
+     */
+    bool parseTick_(uint64_t pos, uint64_t& tick) const
+    {
+        if(data_[pos] != '{'){
+            return false;
+        }
+        ++pos;
+        const uint64_t end = std::min(file_bytes_, pos + MAX_TICK_DIGITS);
+        tick = 0;
+        while(pos < end && data_[pos] >= '0' && data_[pos] <= '9'){
+            tick = tick * 10 + (data_[pos] - '0');
+            ++pos;
+        }
+        return true;
+    }
+
+    //! Offset of the start of the line after the one containing \a pos
+    uint64_t nextLine_(const uint64_t pos) const
+    {
+        const void* nl = std::memchr(data_ + pos, '\n', file_bytes_ - pos);
+        if(nl == nullptr){
+            return file_bytes_;
+        }
+        return static_cast<const char*>(nl) - data_ + 1;
+    }
+
+    //! Modification time of the log. macOS names the stat field differently
+    const struct timespec& logMtime_() const
+    {
+#ifdef __APPLE__
+        return stat_.st_mtimespec;
+#else
+        return stat_.st_mtim;
+#endif
+    }
+
+    std::string indexFilename_() const
+    {
+        return filename_ + ".tickidx";
+    }
+
+    //! Load the cached index if it describes the current log
+    bool loadIndex_()
+    {
+        std::ifstream in(indexFilename_(), std::ios::binary);
+        IndexHeader hdr;
+        if(!in.read(reinterpret_cast<char*>(&hdr), sizeof(hdr))){
+            return false;
+        }
+        if(std::memcmp(hdr.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+           hdr.version != INDEX_VERSION ||
+           hdr.log_bytes != file_bytes_ ||
+           hdr.log_mtime_sec != static_cast<int64_t>(logMtime_().tv_sec) ||
+           hdr.log_mtime_nsec != static_cast<int64_t>(logMtime_().tv_nsec) ||
+           hdr.interval != INDEX_INTERVAL){
+            return false;
+        }
+        index_.resize(hdr.num_entries);
+        if(!in.read(reinterpret_cast<char*>(index_.data()), index_.size() * sizeof(IndexEntry))){
+            index_.clear();
+            return false;
+        }
+        return true;
+    }
+
+    //! Write the index next to the log. Failure (e.g. read-only directory) is not an error
+    void saveIndex_() const
+    {
+        const std::string tmp_name = indexFilename_() + ".tmp";
+        {
+            std::ofstream out(tmp_name, std::ios::binary);
+            if(!out){
+                return;
+            }
+            IndexHeader hdr = {};
+            std::memcpy(hdr.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+            hdr.version = INDEX_VERSION;
+            hdr.log_bytes = file_bytes_;
+            hdr.log_mtime_sec = logMtime_().tv_sec;
+            hdr.log_mtime_nsec = logMtime_().tv_nsec;
+            hdr.interval = INDEX_INTERVAL;
+            hdr.num_entries = index_.size();
+            out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+            out.write(reinterpret_cast<const char*>(index_.data()), index_.size() * sizeof(IndexEntry));
+            if(!out){
+                out.close();
+                std::remove(tmp_name.c_str());
+                return;
+            }
+        }
+        // Rename so that a concurrent reader never sees a partial index
+        if(std::rename(tmp_name.c_str(), indexFilename_().c_str()) != 0){
+            std::remove(tmp_name.c_str());
+        }
+    }
+
+    //! Scan the whole log once, recording an entry every INDEX_INTERVAL bytes
+    void buildIndex_()
+    {
+        index_.clear();
+        uint64_t max_tick = 0;
+        uint64_t next_entry = 0;
+        for(uint64_t pos = 0; pos < file_bytes_; pos = nextLine_(pos)){
+            if(pos >= next_entry){
+                index_.push_back({pos, max_tick});
+                next_entry = pos + INDEX_INTERVAL;
+            }
+            uint64_t tick;
+            if(parseTick_(pos, tick) && tick > max_tick){
+                max_tick = tick;
+            }
+        }
+    }
+
+    void ensureIndex_()
+    {
+        if(index_built_){
+            return;
+        }
+        index_built_ = true;
+        if(!loadIndex_()){
+            buildIndex_();
+            saveIndex_();
+        }
+    }
 
 public:
 
     static const uint64_t BAD_LOCATION = std::numeric_limits<uint64_t>::max();
 
     explicit LogSearch(const std::string& filename)
-        : in_(filename)
+        : filename_(filename)
     {
-        file_bytes_ = 0;
-        if(in_.is_open()){
-            in_.seekg(0, in_.end);
-            const auto len = in_.tellg();
-            if(len >= 0){
-                file_bytes_ = static_cast<uint64_t>(len);
+        const int fd = open(filename_.c_str(), O_RDONLY);
+        if(fd == -1){
+            return;
+        }
+        if(fstat(fd, &stat_) == 0 && stat_.st_size > 0){
+            void* addr = mmap(nullptr, stat_.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(addr != MAP_FAILED){
+                data_ = static_cast<const char*>(addr);
+                file_bytes_ = static_cast<uint64_t>(stat_.st_size);
             }
         }
+        close(fd);
+    }
+
+    LogSearch(const LogSearch&) = delete;
+    LogSearch& operator=(const LogSearch&) = delete;
+
+    ~LogSearch()
+    {
+        if(data_ != nullptr){
+            munmap(const_cast<char*>(data_), file_bytes_);
+        }
     }
 
     uint64_t getLocationByTick(uint64_t tick, uint64_t earlier_location=0)
     {
         // Early out for no file or empty file
-        if(in_.is_open() == false || file_bytes_ == 0){
+        if(data_ == nullptr || file_bytes_ == 0){
             return BAD_LOCATION;
         }
 
-        const uint32_t BUFFER_SIZE = 512;
-        char buffer[BUFFER_SIZE];
-
         if(earlier_location >= file_bytes_){
             return BAD_LOCATION;
         }
 
-        in_.seekg((std::streampos)earlier_location);
+        ensureIndex_();
 
-        uint64_t last_line_pos = earlier_location; // Assume at start of line
-        bool got_newline = true;
-        while(in_.good()){
-            char chr;
-            in_.get(chr);
-            if(chr == '\n'){
-                last_line_pos = in_.tellg();
-                got_newline = true;
-                continue;
+        // Find the last index entry before which no line can have reached
+        // the requested tick. Scanning can safely start there
+        uint64_t pos = earlier_location; // Assume at start of line
+        size_t lo = 0;
+        size_t hi = index_.size();
+        while(lo < hi){
+            const size_t mid = lo + (hi - lo) / 2;
+            if(index_[mid].max_tick_before < tick){
+                lo = mid + 1;
+            }else{
+                hi = mid;
             }
-            // If prev char was newline
-            if(got_newline){
-                if(chr == '{'){
-                    // Parse out the tick value
-                    char* bufptr = buffer;
-                    while(!in_.eof()){
-                        in_.get(chr);
-                        if(chr == ' '){
-                            break;
-                        }
-                        *bufptr = chr;
-                        bufptr++;
-                    }
-                    const uint64_t tickval = strtoull(buffer, &bufptr, 10);
-                    if(tickval >= tick){
-                        return last_line_pos; // Found a line containing the chosen tick or later!
-                    }
-                }
+        }
+        if(lo > 0 && index_[lo - 1].offset > pos){
+            pos = index_[lo - 1].offset;
+        }
+
+        for(; pos < file_bytes_; pos = nextLine_(pos)){
+            uint64_t tickval;
+            if(parseTick_(pos, tickval) && tickval >= tick){
+                return pos; // Found a line containing the chosen tick or later!
             }
-            got_newline = false;
         }
 
         return BAD_LOCATION;
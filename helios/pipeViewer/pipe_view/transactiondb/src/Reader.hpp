@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <functional>
 #include <iostream>
 #include <fstream>
@@ -18,7 +21,11 @@
 #include <string_view>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include "PipelineDataCallback.hpp"
 #include "sparta/utils/SpartaException.hpp"
@@ -101,6 +108,13 @@ namespace sparta::pipeViewer {
      * The Reader will return the records found on disk by calling
      * methods in PipelineDataCallback, passing pointers to the read
      * transactions.
+     *
+     * The record and index files are memory-mapped. Fixed-size records
+     * (transactions, instructions, memory operations) are handed to the
+     * callback straight out of the mapping when they are suitably aligned.
+     * Annotation and pair records are decoded into structures owned by the
+     * Reader and reused from record to record. In every case the pointer
+     * passed to the callback is only valid for the duration of the call.
      */
     class Reader
     {
@@ -198,6 +212,91 @@ namespace sparta::pipeViewer {
                     }
             };
 
+            /**
+             * \class MappedFile
+             * \brief Read-only memory mapping of an entire file
+             */
+            class MappedFile {
+                private:
+                    std::string filename_;
+                    const char* data_ = nullptr;
+                    int64_t size_ = 0;
+
+                    inline void unmap_() {
+                        if(data_ != nullptr) {
+                            munmap(const_cast<char*>(data_), size_);
+                            data_ = nullptr;
+                        }
+                        size_ = 0;
+                    }
+
+                public:
+                    explicit MappedFile(std::string&& filename) :
+                        filename_(std::move(filename))
+                    {
+                        remap();
+                        sparta_assert(size_ != 0,
+                                      filename_ << " is empty. Did Argos database collection complete?");
+                    }
+
+                    MappedFile(MappedFile&& rhs) :
+                        filename_(std::move(rhs.filename_)),
+                        data_(std::exchange(rhs.data_, nullptr)),
+                        size_(std::exchange(rhs.size_, 0))
+                    {
+                    }
+
+                    MappedFile(const MappedFile&) = delete;
+                    MappedFile& operator=(const MappedFile&) = delete;
+
+                    ~MappedFile() {
+                        unmap_();
+                    }
+
+                    /**
+                     * \brief Map the current contents of the file, replacing
+                     * any previous mapping (e.g. after the file has grown)
+                     */
+                    inline void remap() {
+                        unmap_();
+                        const int fd = open(filename_.c_str(), O_RDONLY);
+                        sparta_assert(fd != -1, "Failed to open file " << filename_);
+                        struct stat stat_result;
+                        const bool stat_ok = (fstat(fd, &stat_result) == 0);
+                        void* addr = MAP_FAILED;
+                        if(stat_ok && stat_result.st_size > 0) {
+                            addr = mmap(nullptr, stat_result.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                        }
+                        close(fd);
+                        sparta_assert(stat_ok, "Failed to stat file " << filename_);
+                        if(stat_result.st_size > 0) {
+                            sparta_assert(addr != MAP_FAILED, "Failed to map file " << filename_);
+                            data_ = static_cast<const char*>(addr);
+                            size_ = stat_result.st_size;
+                        }
+                    }
+
+                    inline const auto& getFilename() const {
+                        return filename_;
+                    }
+
+                    inline const char* data() const {
+                        return data_;
+                    }
+
+                    //! Size of the mapping
+                    inline int64_t size() const {
+                        return size_;
+                    }
+
+                    //! Current size of the file on disk, which may exceed size()
+                    inline int64_t fileSize() const {
+                        struct stat stat_result;
+                        stat(filename_.c_str(), &stat_result);
+                        return stat_result.st_size;
+                    }
+            };
+
             /**
              * \class ColonDelimitedFile
              * \brief Class that knows how to read ':'-delimited files used by the Argos pair format
@@ -433,30 +532,71 @@ namespace sparta::pipeViewer {
                 //Figure out how far we need to seek into our index file.
                 const uint64_t step = first_index_ + (start/heartbeat_ * sizeof(uint64_t));
 
-                //Now read the pointer from this location.
-                if(!index_file_.seekg(step)) {
-                    sparta_assert(!"Could not seekg in for the given position.  Please report bug");
-                }
-                uint64_t pos = size_of_record_file_;
-
                 //It might be the case that our index file is too small
                 //to represent an end time that the user is requesting.
-                //in the above algorythm either reached the end of the index file.
 
-                //notice we look too see if the index file seeker has passed
+                //notice we look too see if the index position has passed
                 //size_of_index_file_ - 8 bytes b/c a special last index is written to the index file
                 //to point to only the start of the last transaction.
-                const int64_t filepos = index_file_.tellg();
-                if(filepos >= size_of_index_file_ - 8 || filepos == -1)
+                if(static_cast<int64_t>(step) >= size_of_index_file_ - 8)
                 {
-                    //We need to reset end of file reach flags for the index file.
-                    index_file_.clear();
+                    index_pos_ = step;
+                    return size_of_record_file_;
                 }
-                else
-                {
-                    index_file_.read(pos);
+
+                index_pos_ = step + sizeof(uint64_t);
+                return readIndex_(step);
+            }
+
+            /**
+             * \brief Read the index entry at byte offset \a pos in the index file
+             */
+            inline uint64_t readIndex_(const uint64_t pos) const
+            {
+                sparta_assert(pos + sizeof(uint64_t) <= static_cast<uint64_t>(index_file_.size()),
+                              "Read past the end of the index file " << index_file_.getFilename());
+                uint64_t val;
+                std::memcpy(&val, index_file_.data() + pos, sizeof(val));
+                return val;
+            }
+
+            /**
+             * \brief Make sure \a num_bytes can be read at record_pos_
+             */
+            inline void checkRecordBounds_(const size_t num_bytes) const
+            {
+                sparta_assert(record_pos_ + num_bytes <= static_cast<uint64_t>(record_file_.size()),
+                              "Read past the end of the argos DB record file. Data might be corrupt.");
+            }
+
+            /**
+             * \brief Copy \a num_bytes of the record file at record_pos_ into
+             * \a buf and advance
+             */
+            template<typename T>
+            inline void readRecordData_(T* const buf, const size_t num_bytes = sizeof(T))
+            {
+                checkRecordBounds_(num_bytes);
+                std::memcpy(buf, record_file_.data() + record_pos_, num_bytes);
+                record_pos_ += num_bytes;
+            }
+
+            /**
+             * \brief Get the T stored at record_pos_ and advance. Returns a
+             * pointer into the mapped record file when it is suitably aligned
+             * for T, otherwise copies the record into \a scratch
+             */
+            template<typename T>
+            inline const T* viewRecord_(T& scratch)
+            {
+                checkRecordBounds_(sizeof(T));
+                const char* const ptr = record_file_.data() + record_pos_;
+                record_pos_ += sizeof(T);
+                if(reinterpret_cast<uintptr_t>(ptr) % alignof(T) == 0) {
+                    return reinterpret_cast<const T*>(ptr);
                 }
-                return pos;
+                std::memcpy(static_cast<void*>(&scratch), ptr, sizeof(T));
+                return &scratch;
             }
 
             /**
@@ -470,10 +610,28 @@ namespace sparta::pipeViewer {
                 return sub_sum - (sub_sum % heartbeat_);
             }
 
-            inline std::string readAnnotation_(const uint16_t length) {
-                std::string annt_buf(length, '\0');
-                record_file_.read(annt_buf.data(), length);
-                return annt_buf;
+            /**
+             * \brief Read a length-prefixed string at record_pos_ into \a str,
+             * reusing its storage
+             */
+            inline void readString_(const uint16_t length, std::string& str) {
+                checkRecordBounds_(length);
+                str.assign(record_file_.data() + record_pos_, length);
+                record_pos_ += length;
+            }
+
+            /**
+             * \brief Set \a str to \a prefix followed by \a value in the given
+             * base, reusing the storage of \a str
+             */
+            static inline void setToChars_(std::string& str,
+                                           const std::string_view prefix,
+                                           const int base,
+                                           const uint64_t value) {
+                char buf[24];
+                const auto result = std::to_chars(buf, buf + sizeof(buf), value, base);
+                str.assign(prefix.data(), prefix.size());
+                str.append(buf, result.ptr);
             }
 
             inline void acquireLock_() {
@@ -490,9 +648,10 @@ namespace sparta::pipeViewer {
             {
                 //Make sure the user is not abusing our NON thread safe method.
                 acquireLock_();
-                record_file_.seekg(0, std::ios::beg);
                 transaction_t transaction;
-                record_file_.read(transaction);
+                if(record_file_.size() >= static_cast<int64_t>(sizeof(transaction_t))) {
+                    std::memcpy(static_cast<void*>(&transaction), record_file_.data(), sizeof(transaction_t));
+                }
                 clearLock();
                 return transaction.time_Start;
             }
@@ -506,34 +665,28 @@ namespace sparta::pipeViewer {
             {
                 //Make sure the user is not abusing our NON thread safe method.
                 acquireLock_();
-                //Notice that we reset the index file, b/c if
-                //we had already read to the end of the file, we need to reset
-                //end of file flags.
-                index_file_.clear();
-                //seek one entry back from the end of the index file
-                index_file_.seekg(size_of_index_file_-sizeof(uint64_t));
-                uint64_t pos = 0;
-                index_file_.read(pos);
+                //read the last entry of the index file
+                const uint64_t pos = readIndex_(size_of_index_file_-sizeof(uint64_t));
                 //read the transaction at the appropriate location.
-                record_file_.seekg(pos, std::ios::beg);
-                transaction_t transaction;
-                record_file_.read(transaction);
                 clearLock();
-                if(record_file_.gcount() != sizeof(transaction_t))
+                if(pos + sizeof(transaction_t) > static_cast<uint64_t>(record_file_.size()))
                 {
                     return highest_cycle_;
                 }
+                transaction_t transaction;
+                std::memcpy(static_cast<void*>(&transaction), record_file_.data() + pos, sizeof(transaction_t));
                 return transaction.time_End - 1;
 
             }
 
             template<bool CountRecords>
-            inline size_t readRecordVersion_(const std::fstream::pos_type end_pos,
+            inline size_t readRecordVersion_(const uint64_t end_pos,
                                              const uint64_t start,
                                              const uint64_t end)
             {
                 size_t recsread = 0;
-                for(auto pos = record_file_.tellg(); pos < end_pos && pos != -1; pos = record_file_.tellg())
+                const uint64_t stop_pos = std::min(end_pos, static_cast<uint64_t>(record_file_.size()));
+                while(record_pos_ < stop_pos)
                 {
                     // Read, checking for chunk_end
                     readRecord_(start, end);
@@ -548,7 +701,7 @@ namespace sparta::pipeViewer {
              * \brief Read a record of any format. Older formats are upconverted to new format.
              */
             template<bool CountRecords = false>
-            inline size_t readRecords_(const std::fstream::pos_type end_pos, const uint64_t start, const uint64_t end) {
+            inline size_t readRecords_(const uint64_t end_pos, const uint64_t start, const uint64_t end) {
                 sparta_assert(version_ == 2, "Only version 2 is currenly supported");
                 return readRecordVersion_<CountRecords>(end_pos, start, end);
             }
@@ -557,17 +710,20 @@ namespace sparta::pipeViewer {
              * \brief Read a single record at \a pos and increment pos
              */
             inline void readRecord_(const uint64_t start, const uint64_t end) {
+                // Peek at the generic transaction to find the record type
                 transaction_t transaction;
-                record_file_.read(transaction);
-                sparta_assert(record_file_.good(), "Previous read of the argos DB failed");
+                checkRecordBounds_(sizeof(transaction_t));
+                std::memcpy(static_cast<void*>(&transaction), record_file_.data() + record_pos_, sizeof(transaction_t));
 
                 switch (transaction.flags & TYPE_MASK)
                 {
                     case is_Annotation :
                     {
-                        annotation_t annot(std::move(transaction));
-                        record_file_.read(annot.length);
-                        annot.annt = readAnnotation_(annot.length);
+                        annotation_t& annot = annotation_;
+                        static_cast<transaction_t&>(annot) = transaction;
+                        record_pos_ += sizeof(transaction_t);
+                        readRecordData_(&annot.length);
+                        readString_(annot.length, annot.annt);
 
                         //// Sanity check the transactions coming out
                         //if(start % heartbeat_ == 0 // Only try this sanity checking if start is a multiple of heartbeat_
@@ -598,24 +754,22 @@ namespace sparta::pipeViewer {
 
                     case is_Instruction:
                     {
-                        instruction_t inst;
-                        record_file_.seekg(-sizeof(transaction_t), std::ios::cur);
-                        record_file_.read(inst);
+                        instruction_t scratch;
+                        const instruction_t* inst = viewRecord_(scratch);
 
-                        READER_DBG_MSG("found inst. start: " << inst.time_Start << " end: " << inst.time_End);
+                        READER_DBG_MSG("found inst. start: " << inst->time_Start << " end: " << inst->time_End);
 
-                        data_callback_->foundInstRecord(&inst);
+                        data_callback_->foundInstRecord(inst);
                     } break;
 
                     case is_MemoryOperation:
                     {
-                        memoryoperation_t memop;
-                        record_file_.seekg(-sizeof(transaction_t), std::ios::cur);
-                        record_file_.read(memop);
+                        memoryoperation_t scratch;
+                        const memoryoperation_t* memop = viewRecord_(scratch);
 
-                        READER_DBG_MSG("found inst. start: " << memop.time_Start << " end: " << memop.time_End);
+                        READER_DBG_MSG("found inst. start: " << memop->time_Start << " end: " << memop->time_End);
 
-                        data_callback_->foundMemRecord(&memop);
+                        data_callback_->foundMemRecord(memop);
                     } break;
 
                     // If we have found a record which is of Pair Type,
@@ -625,7 +779,9 @@ namespace sparta::pipeViewer {
                     // and In-memory data structures and rebuild the pair
                     // record one by one.
                     case is_Pair : {
-                        pair_t pairt(std::move(transaction));
+                        pair_t& pairt = pair_;
+                        static_cast<transaction_t&>(pairt) = transaction;
+                        record_pos_ += sizeof(transaction_t);
 
                         // The loc_map is an In-memory Map which contains a mapping
                         // of Location ID to Pair ID.
@@ -649,17 +805,22 @@ namespace sparta::pipeViewer {
                         // We lookup the length, the name strings and the sizeofs of
                         // every anme string from the retrieved
                         // record of the Data Struture and copy the values into out
-                        // live Pair Transaction record
-                        pairt.length = st.length;
-                        pairt.nameVector = st.names;
-                        pairt.sizeOfVector = st.sizes;
-                        pairt.delimVector = st.formats;
+                        // live Pair Transaction record. The record is reused, so
+                        // this is only needed when the pair type changes
+                        if(pair_type_ != unique_id) {
+                            pairt.length = st.length;
+                            pairt.nameVector = st.names;
+                            pairt.sizeOfVector = st.sizes;
+                            pairt.delimVector = st.formats;
+                            pair_type_ = unique_id;
+                        }
 
-                        pairt.valueVector.reserve(pairt.length);
+                        pairt.valueVector.clear();
                         pairt.valueVector.emplace_back(std::make_pair(unique_id, false));
 
-                        pairt.stringVector.reserve(pairt.length);
-                        pairt.stringVector.emplace_back(std::to_string(unique_id));
+                        // Strings are assigned in place to reuse their storage
+                        pairt.stringVector.resize(pairt.length);
+                        setToChars_(pairt.stringVector[0], "", 10, unique_id);
 
                         for(std::size_t i = 1; i != st.length; ++i){
                             if(st.types[i] == 0) {
@@ -668,7 +829,7 @@ namespace sparta::pipeViewer {
                                 sparta_assert(item_size <= sizeof(pair_t::IntT),
                                               "Data Type not supported for reading/writing.");
                                 pair_t::IntT tmp = 0;
-                                record_file_.read(&tmp, item_size);
+                                readRecordData_(&tmp, item_size);
                                 pairt.valueVector.emplace_back(std::make_pair(tmp, true));
 
                                 // Finally for a certain field "i", we check if there is a string
@@ -680,7 +841,7 @@ namespace sparta::pipeViewer {
                                                                                    i-1, // string map doesn't include the UID field, so index 0 == field index 1
                                                                                    pairt.valueVector[i].first));
                                    it != stringMap_.end()) {
-                                    pairt.stringVector.emplace_back(it->second);
+                                    pairt.stringVector[i] = it->second;
                                     pairt.valueVector[i].second = false;
                                 }
 
@@ -690,38 +851,27 @@ namespace sparta::pipeViewer {
 
                                     if (int_value == std::numeric_limits<pair_t::IntT>::max()) {
                                         // Max value, so probably bad...push empty string
-                                        pairt.stringVector.emplace_back("");
+                                        pairt.stringVector[i].clear();
                                     } else {
                                         const auto& format_str = pairt.delimVector[i];
 
-                                        std::ios_base::fmtflags format_flags = std::ios::dec;
-                                        std::string_view fmt_prefix = "";
-
                                         if(format_str == PairFormatter::HEX) {
-                                            format_flags = std::ios::hex;
-                                            fmt_prefix = "0x";
+                                            setToChars_(pairt.stringVector[i], "0x", 16, int_value);
                                         }
                                         else if(format_str == PairFormatter::OCTAL) {
-                                            format_flags = std::ios::oct;
-                                            fmt_prefix = "0";
+                                            setToChars_(pairt.stringVector[i], "0", 8, int_value);
+                                        }
+                                        else {
+                                            setToChars_(pairt.stringVector[i], "", 10, int_value);
                                         }
-
-                                        std::ostringstream int_str;
-                                        int_str << fmt_prefix;
-                                        int_str.setf(format_flags, std::ios::basefield);
-                                        int_str << int_value;
-                                        pairt.stringVector.emplace_back(int_str.str());
                                     }
                                 }
                             }
                             else if(st.types[i] == 1){
                                 // Type 1 = string
                                 uint16_t annotationLength;
-                                record_file_.read(annotationLength);
-
-                                std::string annot_str(annotationLength, '\0');
-                                record_file_.read(annot_str.data(), annotationLength);
-                                pairt.stringVector.emplace_back(std::move(annot_str));
+                                readRecordData_(&annotationLength);
+                                readString_(annotationLength, pairt.stringVector[i]);
 
                                 // This bool value describes if this field has a string-only value.
                                 // String only values are those values which are stored in database as
@@ -734,7 +884,7 @@ namespace sparta::pipeViewer {
                                     )
                                 );
                             } else {
-                                pairt.stringVector.emplace_back("none");
+                                pairt.stringVector[i] = "none";
                                 pairt.valueVector.emplace_back(std::make_pair(0, false));
                             }
                         }
@@ -753,8 +903,8 @@ namespace sparta::pipeViewer {
 
             inline void checkIndexUpdates_()
             {
-                const auto index_size = index_file_.size();
-                const auto record_size = record_file_.size();
+                const auto index_size = index_file_.fileSize();
+                const auto record_size = record_file_.fileSize();
 
                 if(index_size != size_of_index_file_ && record_size != size_of_record_file_)
                 {
@@ -765,8 +915,8 @@ namespace sparta::pipeViewer {
                         return;
                     }
 
-                    record_file_.reopen();
-                    index_file_.reopen();
+                    record_file_.remap();
+                    index_file_.remap();
                     map_file_.reopen();
                     data_file_.reopen();
 
@@ -794,8 +944,8 @@ namespace sparta::pipeViewer {
              */
             Reader(std::string filepath, std::unique_ptr<PipelineDataCallback>&& data_callback) :
                 filepath_(std::move(filepath)),
-                record_file_(filepath_ + "record.bin", std::fstream::in | std::fstream::binary ),
-                index_file_(filepath_ + "index.bin", std::fstream::in | std::fstream::binary),
+                record_file_(filepath_ + "record.bin"),
+                index_file_(filepath_ + "index.bin"),
                 map_file_(filepath_ + "map.dat", std::fstream::in),
                 data_file_(filepath_ + "data.dat", std::fstream::in),
                 string_file_(filepath_ + "string_map.dat", std::fstream::in),
@@ -816,44 +966,36 @@ namespace sparta::pipeViewer {
                 READER_LOG_MSG("pipeViewer reader opened: " << record_file_.getFilename());
 
                 // Read header from index file
-                char header_buf[HEADER_SIZE];
-                index_file_.read(header_buf, HEADER_SIZE);
+                uint64_t header_end = 0;
                 // Assuming older version until header proves otherwise
                 version_ = 1;
-                if(static_cast<size_t>(index_file_.gcount()) != HEADER_SIZE) {
+                if(static_cast<size_t>(index_file_.size()) < HEADER_SIZE) {
                     // Assume old version because the file is too small to have a header
-                    index_file_.clear(); // Clear error flags after failing to read enough data
-                    index_file_.seekg(0, std::ios::beg); // Restore
                 }
                 else if(HEADER_PREFIX.compare(0,
                                               HEADER_PREFIX.size(),
-                                              header_buf,
+                                              index_file_.data(),
                                               HEADER_PREFIX.size())) {
                     // Header prefix did not match. Assume old version
-                    index_file_.seekg(0, std::ios::beg); // Restore
                 }
                 else {
                     // Header prefix matched. Read version
-                    header_buf[HEADER_SIZE - 1] = '\0'; // Insert null
-                    version_ = sparta::lexicalCast<decltype(version_)>(header_buf + HEADER_PREFIX.size());
+                    const std::string version_str(index_file_.data() + HEADER_PREFIX.size(),
+                                                  HEADER_SIZE - HEADER_PREFIX.size() - 1);
+                    version_ = sparta::lexicalCast<decltype(version_)>(version_str);
+                    header_end = HEADER_SIZE;
                 }
                 sparta_assert(version_ > 0 && version_ <= Outputter::FILE_VERSION,
                               "pipeout file " << filepath_ << " determined to be format "
                               << version_ << " which is not known by this version of SPARTA. Version "
                               "expected to be in range [1, " << Outputter::FILE_VERSION << "]");
-                sparta_assert(index_file_.good(),
-                              "Finished reading index file header for " << filepath_ << " but "
-                              "ended up with non-good file handle somehow. This is a bug in the "
-                              "header-reading logic");
 
                 // Read the heartbeat size from our index file.
                 // This will be the first integer in the file except for the header if there is one
-                // Warning: this must be called while the index_file_ is already seeked to the
-                // start of file, which it is after opening.
-                index_file_.read(heartbeat_);
+                heartbeat_ = readIndex_(header_end);
 
                 // Save the first index entry position
-                first_index_ = index_file_.tellg();
+                first_index_ = header_end + sizeof(uint64_t);
 
                 READER_LOG_MSG("Heartbeat is: " << heartbeat_);
 
@@ -862,11 +1004,9 @@ namespace sparta::pipeViewer {
                               "would be too slow to actually load");
 
                 //Determine the size of our index file
-                index_file_.seekg(0, std::fstream::end);
-                size_of_index_file_ = index_file_.tellg();
+                size_of_index_file_ = index_file_.size();
                 //Determine the size of our record file.
-                record_file_.seekg(0, std::ios::end);
-                size_of_record_file_ = record_file_.tellg();
+                size_of_record_file_ = record_file_.size();
 
                 //cache the earliest start and stop of the record file
                 lowest_cycle_ = findCycleFirst_();
@@ -972,13 +1112,13 @@ namespace sparta::pipeViewer {
 
                 //First we will want to make sure we are ready to read at the correct
                 //position in the record file.
-                record_file_.seekg(findRecordReadPos_(start));
+                record_pos_ = findRecordReadPos_(start);
 
-                const auto read_pos = record_file_.tellg();
+                const uint64_t read_pos = record_pos_;
                 //what space does this interval span in the record file.
-                const std::fstream::pos_type full_data_size = findRecordReadPos_(chunk_end) - read_pos;
+                const uint64_t full_data_size = findRecordReadPos_(chunk_end) - read_pos;
                 //Now start processing the chunk.
-                const std::fstream::pos_type end_pos = read_pos + full_data_size;
+                const uint64_t end_pos = read_pos + full_data_size;
 
                 READER_LOG_MSG("start_pos: " << read_pos << " end_pos: " << end_pos);
 
@@ -1006,7 +1146,7 @@ namespace sparta::pipeViewer {
                 auto prev_cb = std::move(data_callback_);
                 try{
                     uint64_t tick = 0;
-                    index_file_.seekg(0, std::ios::beg);
+                    index_pos_ = 0;
                     while(tick <= getCycleLast() + (heartbeat_-1)){
                         int64_t pos;
 
@@ -1022,12 +1162,12 @@ namespace sparta::pipeViewer {
 
                         const uint64_t chunk_end = roundUp_(tick + heartbeat_);
                         std::cout << "chunk end rounded to: " << chunk_end << std::endl
-                                  << "record file pos before: " << record_file_.tellg() << std::endl;
-                        record_file_.seekg(pos, std::ios::beg);
-                        const auto read_pos = record_file_.tellg();
+                                  << "record file pos before: " << record_pos_ << std::endl;
+                        record_pos_ = pos;
+                        const uint64_t read_pos = record_pos_;
                         std::cout << "record file pos after:  " << read_pos << std::endl;
-                        if(read_pos == EOF) {
-                            std::cerr << "TellG says EOF!" << std::endl;
+                        if(read_pos > static_cast<uint64_t>(record_file_.size())) {
+                            std::cerr << "Position is past the end of the record file!" << std::endl;
                         }
                         else {
 
@@ -1042,7 +1182,7 @@ namespace sparta::pipeViewer {
                             const auto recsread = readRecords_<true>(end_pos, tick, chunk_end);
                             std::cout << "Records: " << recsread << std::endl;
                         }
-                        std::cout << "record file pos after read: " << record_file_.tellg() << std::endl;
+                        std::cout << "record file pos after read: " << record_pos_ << std::endl;
                         std::cout << "pos variable after read:    " << read_pos << std::endl;
                         tick += heartbeat_;
                         std::cout << "\n";
@@ -1056,10 +1196,10 @@ namespace sparta::pipeViewer {
                 // Restore callback
                 data_callback_ = std::move(prev_cb);
 
-                if(uint64_t tmp; index_file_.read(tmp)) {
-                    std::cout << "Read junk at the end of the index file:\n  " << tmp;
-                    while(index_file_.read(tmp)) {
-                        std::cout << "  " << tmp;
+                if(index_pos_ + sizeof(uint64_t) <= static_cast<uint64_t>(index_file_.size())) {
+                    std::cout << "Read junk at the end of the index file:\n ";
+                    for(; index_pos_ + sizeof(uint64_t) <= static_cast<uint64_t>(index_file_.size()); index_pos_ += sizeof(uint64_t)) {
+                        std::cout << "  " << readIndex_(index_pos_);
                     }
                 }
             }
@@ -1127,8 +1267,10 @@ namespace sparta::pipeViewer {
 
         private:
             const std::string filepath_; /*!< Path to this file */
-            FileStream record_file_; /*!< The record file stream */
-            FileStream index_file_;  /*!< The index file stream */
+            MappedFile record_file_; /*!< The mapped record file */
+            MappedFile index_file_;  /*!< The mapped index file */
+            uint64_t record_pos_ = 0; /*!< Read position in the record file */
+            uint64_t index_pos_ = 0;  /*!< Position after the last index entry read */
             ColonDelimitedFile map_file_;    /*!< The map file stream */
             ColonDelimitedFile data_file_;   /*!< The data file stream */
             ColonDelimitedFile string_file_; /*!< The string map file stream */
@@ -1143,6 +1285,9 @@ namespace sparta::pipeViewer {
             uint64_t highest_cycle_; /*!< The highest cycle in the file. */
             bool lock_; /*!< A tool used too assert that this file Reader is not thread safe.*/
             bool file_updated_; /*!< Set to true when the open database has changed */
+            annotation_t annotation_; /*!< Annotation record reused for every annotation read */
+            pair_t pair_; /*!< Pair record reused for every pair read */
+            int32_t pair_type_ = -1; /*!< Pair ID whose names/sizes/formats are loaded in pair_ */
             // In-memory data structure to hold the mapping of Location ID
             // of generic transaction structures
             // and map them to Pair IDs of pair transaction structs.
@@ -3,92 +3,107 @@
 
 #include "transactiondb/src/Reader.hpp"
 #include "transactiondb/src/PipelineDataCallback.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <exception>
+#include <future>
 #include <iostream>
+#include <optional>
 #include <string>
 #include <set>
 #include <regex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 
 namespace sparta {
     namespace pipeViewer {
 
+        /*! \brief Record counts gathered by a search. Summed across search chunks
+         */
+        struct SearchStats {
+            /*! Incremented by one every regular expression match */
+            uint64_t hits = 0;
+
+            uint64_t recs_viewed = 0;
+            uint64_t recs_with_annot = 0;
+            uint64_t recs_with_ins = 0;
+            uint64_t recs_with_mem = 0;
+            uint64_t recs_with_non_null_annot = 0;
+            uint64_t recs_with_pair = 0;
+
+            SearchStats& operator+=(const SearchStats& rhs) {
+                hits += rhs.hits;
+                recs_viewed += rhs.recs_viewed;
+                recs_with_annot += rhs.recs_with_annot;
+                recs_with_ins += rhs.recs_with_ins;
+                recs_with_mem += rhs.recs_with_mem;
+                recs_with_non_null_annot += rhs.recs_with_non_null_annot;
+                recs_with_pair += rhs.recs_with_pair;
+                return *this;
+            }
+        };
+
         /*! \brief Base class for search callbacks that holds configuration parameters and common helper methods
+         *
+         * Results are buffered by the callback rather than written to stdout so
+         * that several callbacks (each searching one chunk of the tick range
+         * in its own thread) can be merged in tick order by the caller.
          */
         class BaseSearchCallback : public PipelineDataCallback {
-            protected:
+            public:
                 static constexpr char RESULT_TAG_ = 'r';
                 static constexpr char PROGRESS_TAG_ = 'p';
                 static constexpr char INFO_TAG_ = 'i';
                 static constexpr char START_DELIMITER_ = ':';
-                static constexpr uint64_t NUMBER_OF_PROGRESS_UPDATES_ = 50;
 
+            protected:
                 /*! Invert search */
                 const bool invert_search_;
 
                 /*! Location IDs to include in the search */
                 std::set<uint32_t> locations_;
 
-                /*! For update progress */
-                uint64_t last_step_number_ = 0;
                 uint64_t search_start_ = 0;
                 uint64_t search_end_ = 0;
-                uint64_t search_width_ = 0;
-                double search_update_stride_ = 0;
-
-                /*! Incremented by one every regular expression match */
-                uint64_t hits_ = 0;
-
-                uint64_t recs_viewed_ = 0;
-                uint64_t recs_with_annot_ = 0;
-                uint64_t recs_with_ins_ = 0;
-                uint64_t recs_with_mem_ = 0;
-                uint64_t recs_with_non_null_annot_ = 0;
-                uint64_t recs_with_pair_ = 0;
-
-                inline void handleProgressOutput_(const uint64_t current_time) {
-                    uint64_t step;
-                    if (search_update_stride_ != 0) {
-                        step = current_time / search_update_stride_;
-                    } else {
-                        // Step is small that the search doesn't really need progress indicators
-                        step = 100000000;
-                    }
-                    if (step > last_step_number_ && current_time > search_start_) {
-                        float fraction = (current_time - search_start_) / static_cast<float>(search_width_);
-                        std::cout << PROGRESS_TAG_ << fraction << std::endl;
-                        last_step_number_ = step;
-                    }
-                }
+
+                SearchStats stats_;
+
+                /*! Results found since the last takeResults() */
+                std::string results_;
 
                 /*!
-                 * \brief Writes a result to stdout in the form:
+                 * \brief Buffers a result in the form:
                  * "<result tag><start time>,<end time>@<location ID><annotation delimiter><annotation>\n"
                  */
                 inline void handleResultOutput_(const uint64_t start_time,
                                                 const uint64_t end_time,
                                                 const uint64_t location_id,
                                                 const std::string& str) {
-                    std::cout << RESULT_TAG_
-                              << start_time << "," << end_time << "@" << location_id
-                              << START_DELIMITER_;
-
-                    if(!str.empty()) {
-                        for(auto c: str) {
-                            if(c == '\n' || c == '\r') {
-                                std::cout << "\\n";
-                            }
-                            else {
-                                std::cout << c;
-                            }
+                    results_ += RESULT_TAG_;
+                    results_ += std::to_string(start_time);
+                    results_ += ',';
+                    results_ += std::to_string(end_time);
+                    results_ += '@';
+                    results_ += std::to_string(location_id);
+                    results_ += START_DELIMITER_;
+
+                    for(auto c: str) {
+                        if(c == '\n' || c == '\r') {
+                            results_ += "\\n";
+                        }
+                        else {
+                            results_ += c;
                         }
                     }
 
-                    std::cout << std::endl;
+                    results_ += '\n';
                 }
 
                 /*!
-                 * \brief Writes a result to stdout in the form:
+                 * \brief Buffers a result in the form:
                  * "<result tag><start time>,<end time>@<location ID><annotation delimiter><annotation>\n"
                  */
                 inline void handleResultOutput_(const annotation_t* annotation) {
@@ -122,8 +137,16 @@ namespace sparta {
                 void setSearchParams(const uint64_t search_start, const uint64_t search_end) {
                     search_start_ = search_start;
                     search_end_ = search_end;
-                    search_width_ = search_end - search_start;
-                    search_update_stride_ = double(search_width_) / NUMBER_OF_PROGRESS_UPDATES_;
+                }
+
+                //! Return the results buffered so far and clear the buffer
+                std::string takeResults() {
+                    return std::exchange(results_, std::string());
+                }
+
+                //! Return the counts gathered so far and reset them
+                SearchStats takeStats() {
+                    return std::exchange(stats_, SearchStats());
                 }
 
                 void startProgress() const {
@@ -138,15 +161,15 @@ namespace sparta {
                               << INFO_TAG_ << "search invert: " << invert_search_ << std::endl;
                 }
 
-                void finishedProgress() const {
+                static void finishedProgress(const SearchStats& stats) {
                     std::cout << PROGRESS_TAG_ << 1 << std::endl //finish off so progress bar doesn't hang
-                              << INFO_TAG_ << "Number of records: " << recs_viewed_ << std::endl
-                              << INFO_TAG_ << "Number of records with annotation: " << recs_with_annot_ << std::endl
-                              << INFO_TAG_ << "Number of records with instruction: " << recs_with_ins_ << std::endl
-                              << INFO_TAG_ << "Number of records with memory: " << recs_with_mem_ << std::endl
-                              << INFO_TAG_ << "Number of records  with pair: " << recs_with_pair_ << std::endl
-                              << INFO_TAG_ << "Number of non-null annotations (searched): " << recs_with_non_null_annot_ << std::endl
-                              << INFO_TAG_ << "Number of hits: " << hits_ << std::endl;
+                              << INFO_TAG_ << "Number of records: " << stats.recs_viewed << std::endl
+                              << INFO_TAG_ << "Number of records with annotation: " << stats.recs_with_annot << std::endl
+                              << INFO_TAG_ << "Number of records with instruction: " << stats.recs_with_ins << std::endl
+                              << INFO_TAG_ << "Number of records with memory: " << stats.recs_with_mem << std::endl
+                              << INFO_TAG_ << "Number of records  with pair: " << stats.recs_with_pair << std::endl
+                              << INFO_TAG_ << "Number of non-null annotations (searched): " << stats.recs_with_non_null_annot << std::endl
+                              << INFO_TAG_ << "Number of hits: " << stats.hits << std::endl;
                 }
         };
 
@@ -165,9 +188,8 @@ namespace sparta {
                 }
 
                 virtual void foundAnnotationRecord(const annotation_t* annotation) override {
-                    handleProgressOutput_(annotation->time_Start);
-                    ++recs_viewed_;
-                    ++recs_with_annot_;
+                    ++stats_.recs_viewed;
+                    ++stats_.recs_with_annot;
 
                     if (annotation->time_Start > search_end_ || annotation->time_End < search_start_) {
                         return;
@@ -179,38 +201,37 @@ namespace sparta {
 
                     std::string_view annt_string(annotation->annt);
                     if (!annt_string.empty()) {
-                        ++recs_with_non_null_annot_;
+                        ++stats_.recs_with_non_null_annot;
                         if (invert_search_) {
                             // Inverted search for string keys is a FULL-STRING match
                             if (annt_string != string_query_) {
                                 handleResultOutput_(annotation);
-                                ++hits_;
+                                ++stats_.hits;
                             }
                         }
                         else {
                             size_t position = annt_string.find(string_query_);
                             if (position != std::string::npos) {
                                 handleResultOutput_(annotation);
-                                ++hits_;
+                                ++stats_.hits;
                             }
                         }
                     }
                 }
 
                 virtual void foundInstRecord(const instruction_t*) override {
-                    ++recs_viewed_;
-                    ++recs_with_ins_;
+                    ++stats_.recs_viewed;
+                    ++stats_.recs_with_ins;
                 }
 
                 virtual void foundMemRecord(const memoryoperation_t*) override {
-                    ++recs_viewed_;
-                    ++recs_with_mem_;
+                    ++stats_.recs_viewed;
+                    ++stats_.recs_with_mem;
                 }
 
                 virtual void foundPairRecord(const pair_t* pair) override {
-                    handleProgressOutput_(pair->time_Start);
-                    ++recs_viewed_;
-                    ++recs_with_pair_;
+                    ++stats_.recs_viewed;
+                    ++stats_.recs_with_pair;
 
                     if (pair->time_Start > search_end_ || pair->time_End < search_start_) {
                         return;
@@ -222,19 +243,19 @@ namespace sparta {
 
                     const auto annt_string = formatPairAsAnnotation(pair);
                     if (!annt_string.empty()) {
-                        ++recs_with_non_null_annot_;
+                        ++stats_.recs_with_non_null_annot;
                         if (invert_search_) {
                             // Inverted search for string keys is a FULL-STRING match
                             if (annt_string != string_query_) {
                                 handleResultOutput_(pair, annt_string);
-                                ++hits_;
+                                ++stats_.hits;
                             }
                         }
                         else {
                             size_t position = annt_string.find(string_query_);
                             if (position != std::string::npos) {
                                 handleResultOutput_(pair, annt_string);
-                                ++hits_;
+                                ++stats_.hits;
                             }
                         }
                     }
@@ -242,23 +263,43 @@ namespace sparta {
         };
 
         /*! \brief Callback that compares annotations to regex
+         *
+         * The expression is compiled once. Expressions without any regex
+         * metacharacters are plain substrings and are matched with a substring
+         * search instead of the regex engine.
          */
         class SearchRegexCallback : public BaseSearchCallback {
             private:
                 /*! Stores regular expression for comparison in callbacks */
-                std::regex regular_expression_;
+                const std::regex regular_expression_;
+
+                /*! Set if the expression is a plain substring */
+                const bool is_literal_;
+                const std::string literal_;
+
+                static bool isLiteral_(const char* regex) {
+                    return std::strpbrk(regex, ".^$|()[]{}*+?\\") == nullptr;
+                }
+
+                inline bool matches_(const std::string& str) const {
+                    if (is_literal_) {
+                        return str.find(literal_) != std::string::npos;
+                    }
+                    return std::regex_search(str, regular_expression_);
+                }
 
             public:
                 SearchRegexCallback(const char* regex, const char* invert_search_str, const char* location_str) :
                     BaseSearchCallback(invert_search_str, location_str),
-                    regular_expression_(regex)
+                    regular_expression_(regex, std::regex::optimize),
+                    is_literal_(isLiteral_(regex)),
+                    literal_(regex)
                 {
                 }
 
                 virtual void foundAnnotationRecord(const annotation_t* annotation) override {
-                    handleProgressOutput_(annotation->time_Start);
-                    ++recs_viewed_;
-                    ++recs_with_annot_;
+                    ++stats_.recs_viewed;
+                    ++stats_.recs_with_annot;
                     if (!locations_.empty() && locations_.count(annotation->location_ID) == 0) {
                         return;
                     }
@@ -266,28 +307,27 @@ namespace sparta {
                         return;
                     }
                     if (!annotation->annt.empty()) {
-                        ++recs_with_non_null_annot_;
-                        if ((!invert_search_) == std::regex_search(annotation->annt, std::regex(regular_expression_))) {
+                        ++stats_.recs_with_non_null_annot;
+                        if ((!invert_search_) == matches_(annotation->annt)) {
                             handleResultOutput_(annotation);
-                            ++hits_;
+                            ++stats_.hits;
                         }
                     }
                 }
 
                 virtual void foundInstRecord(const instruction_t*) override {
-                    ++recs_viewed_;
-                    ++recs_with_ins_;
+                    ++stats_.recs_viewed;
+                    ++stats_.recs_with_ins;
                 }
 
                 virtual void foundMemRecord(const memoryoperation_t*) override {
-                    ++recs_viewed_;
-                    ++recs_with_mem_;
+                    ++stats_.recs_viewed;
+                    ++stats_.recs_with_mem;
                 }
 
                 virtual void foundPairRecord(const pair_t* pair) override {
-                    handleProgressOutput_(pair->time_Start);
-                    ++recs_viewed_;
-                    ++recs_with_pair_;
+                    ++stats_.recs_viewed;
+                    ++stats_.recs_with_pair;
 
                     if (pair->time_Start > search_end_ || pair->time_End < search_start_) {
                         return;
@@ -299,10 +339,10 @@ namespace sparta {
 
                     const auto annt_string = formatPairAsAnnotation(pair);
                     if (!annt_string.empty()) {
-                        ++recs_with_non_null_annot_;
-                        if ((!invert_search_) == std::regex_search(annt_string, std::regex(regular_expression_))) {
+                        ++stats_.recs_with_non_null_annot;
+                        if ((!invert_search_) == matches_(annt_string)) {
                             handleResultOutput_(pair, annt_string);
-                            ++hits_;
+                            ++stats_.hits;
                         }
                     }
                 }
@@ -344,6 +384,156 @@ static sparta::pipeViewer::Reader constructReader(char** argv) {
     throw ConstructReaderException(argv[2]);
 }
 
+/*!
+ * \brief Searches the tick range [search_start, search_end] in chunks.
+ *
+ * The range is split into chunks aligned to the database heartbeat so that
+ * each record in the range is read by exactly one chunk. Worker threads,
+ * each with its own Reader, search chunks concurrently. Results are written
+ * to stdout in chunk (tick) order, as each chunk and all chunks before it
+ * complete, so the output is the same as a single-threaded search.
+ */
+class ChunkedSearch {
+    public:
+        ChunkedSearch(char** argv, const sparta::pipeViewer::Reader& reader, const uint64_t num_threads) :
+            argv_(argv),
+            num_threads_(std::max<uint64_t>(num_threads, 1)),
+            heartbeat_(reader.getChunkSize())
+        {
+        }
+
+        void run(sparta::pipeViewer::Reader& reader, const uint64_t search_start, const uint64_t search_end) {
+            search_start_ = search_start;
+            search_end_ = search_end;
+            buildChunks_();
+
+            auto& cb = reader.getCallbackAs<sparta::pipeViewer::BaseSearchCallback>();
+            cb.setSearchParams(search_start_, search_end_);
+            cb.startProgress();
+
+            const uint64_t num_workers = std::min<uint64_t>(num_threads_, chunks_.size());
+            std::vector<std::thread> workers;
+            for(uint64_t i = 1; i < num_workers; ++i) {
+                workers.emplace_back([this]() { work_(nullptr); });
+            }
+            // The calling thread reuses the Reader it already opened
+            std::thread first_worker([this, &reader]() { work_(&reader); });
+
+            sparta::pipeViewer::SearchStats stats;
+            std::exception_ptr error;
+            try {
+                const uint64_t width = std::max<uint64_t>(search_end_ - std::min(search_start_, search_end_), 1);
+                for(auto& chunk : chunks_) {
+                    ChunkResult result = chunk.result.get_future().get();
+                    std::cout << result.results;
+                    stats += result.stats;
+                    if(chunk.end > search_start_) {
+                        std::cout << sparta::pipeViewer::BaseSearchCallback::PROGRESS_TAG_
+                                  << std::min((chunk.end - search_start_) / static_cast<float>(width), 1.0f) << '\n';
+                    }
+                    std::cout.flush();
+                }
+            }
+            catch(...) {
+                error = std::current_exception();
+            }
+
+            first_worker.join();
+            for(auto& w : workers) {
+                w.join();
+            }
+            if(error) {
+                std::rethrow_exception(error);
+            }
+
+            sparta::pipeViewer::BaseSearchCallback::finishedProgress(stats);
+        }
+
+    private:
+        struct ChunkResult {
+            std::string results;
+            sparta::pipeViewer::SearchStats stats;
+        };
+
+        struct Chunk {
+            uint64_t start;
+            uint64_t end;
+            std::promise<ChunkResult> result;
+        };
+
+        //! Target number of chunks per worker, for load balancing
+        static constexpr uint64_t CHUNKS_PER_THREAD_ = 8;
+
+        //! Progress is reported per chunk. Use at least this many chunks
+        static constexpr uint64_t NUMBER_OF_PROGRESS_UPDATES_ = 50;
+
+        void buildChunks_() {
+            chunks_.clear();
+            const uint64_t num_heartbeats =
+                (search_end_ > search_start_) ? (search_end_ - search_start_) / heartbeat_ : 0;
+            const uint64_t num_chunks = std::max<uint64_t>(
+                std::min<uint64_t>(std::max(num_threads_ * CHUNKS_PER_THREAD_, NUMBER_OF_PROGRESS_UPDATES_),
+                                   num_heartbeats), 1);
+            if(num_chunks == 1) {
+                chunks_.emplace_back(Chunk{search_start_, search_end_, {}});
+                return;
+            }
+
+            // Interior boundaries fall on heartbeats, so the record file
+            // regions read by neighboring chunks do not overlap
+            const uint64_t first_hb = search_start_ / heartbeat_;
+            const uint64_t last_hb = search_end_ / heartbeat_;
+            uint64_t chunk_start = search_start_;
+            for(uint64_t i = 1; i < num_chunks; ++i) {
+                const uint64_t boundary = (first_hb + ((last_hb - first_hb) * i) / num_chunks) * heartbeat_;
+                if(boundary <= chunk_start) {
+                    continue;
+                }
+                chunks_.emplace_back(Chunk{chunk_start, boundary, {}});
+                chunk_start = boundary;
+            }
+            chunks_.emplace_back(Chunk{chunk_start, search_end_, {}});
+        }
+
+        void work_(sparta::pipeViewer::Reader* reader) {
+            uint64_t idx = chunks_.size();
+            try {
+                std::optional<sparta::pipeViewer::Reader> own_reader;
+                if(reader == nullptr) {
+                    own_reader.emplace(constructReader(argv_));
+                    reader = &own_reader.value();
+                }
+                auto& cb = reader->getCallbackAs<sparta::pipeViewer::BaseSearchCallback>();
+                cb.setSearchParams(search_start_, search_end_);
+
+                for(idx = next_chunk_++; idx < chunks_.size(); idx = next_chunk_++) {
+                    auto& chunk = chunks_[idx];
+                    reader->getWindow(chunk.start, chunk.end);
+                    chunk.result.set_value(ChunkResult{cb.takeResults(), cb.takeStats()});
+                }
+            }
+            catch(...) {
+                // Fail the current chunk and every chunk not yet claimed so
+                // the merge loop in run() does not wait forever
+                const auto error = std::current_exception();
+                if(idx < chunks_.size()) {
+                    chunks_[idx].result.set_exception(error);
+                }
+                for(idx = next_chunk_++; idx < chunks_.size(); idx = next_chunk_++) {
+                    chunks_[idx].result.set_exception(error);
+                }
+            }
+        }
+
+        char** const argv_;
+        const uint64_t num_threads_;
+        const uint64_t heartbeat_;
+        uint64_t search_start_ = 0;
+        uint64_t search_end_ = 0;
+        std::vector<Chunk> chunks_;
+        std::atomic<uint64_t> next_chunk_{0};
+};
+
 /*!
  * \brief Location search main.
  *
@@ -358,13 +548,19 @@ static sparta::pipeViewer::Reader constructReader(char** argv) {
  * \li 5: Search Start tick. -1 implies start of file
  * \li 6: Search End tick. -1 implies end of file
  * \li 7: Location filter. Comma-delimited list of location IDs. If empty, no filtering is done
+ * \li 8: (Optional) Number of search threads. Defaults to the number of hardware threads
  */
 int main(int argc, char** argv) {
-    if (argc != 8) {
-        std::cout << "Usage: transactionsearch <transaction db> <string|regex> <query> <invert> <start tick> <end tick> <locations> " << std::endl;
+    if (argc != 8 && argc != 9) {
+        std::cout << "Usage: transactionsearch <transaction db> <string|regex> <query> <invert> <start tick> <end tick> <locations> [threads]" << std::endl;
         return 1;
     }
 
+    uint64_t num_threads = std::thread::hardware_concurrency();
+    if (argc == 9) {
+        num_threads = std::strtoull(argv[8], nullptr, 10);
+    }
+
     try {
         sparta::pipeViewer::Reader reader = constructReader(argv);
 
@@ -396,12 +592,8 @@ int main(int argc, char** argv) {
             return 1;
         }
 
-        auto& cb = reader.getCallbackAs<sparta::pipeViewer::BaseSearchCallback>();
-        cb.setSearchParams(search_start, search_end);
-
-        cb.startProgress();
-        reader.getWindow(search_start, search_end);
-        cb.finishedProgress();
+        ChunkedSearch search(argv, reader, num_threads);
+        search.run(reader, search_start, search_end);
     }
     catch(const ConstructReaderException& e) {
         std::cerr << e.what() << std::endl;
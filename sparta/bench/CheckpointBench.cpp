@@ -0,0 +1,114 @@
+// <CheckpointBench.cpp> -*- C++ -*-
+
+
+/*!
+ * \file CheckpointBench.cpp
+ * \brief Benchmarks of FastCheckpointer save and load
+ */
+
+#include <cstring>
+#include <memory>
+
+#include "SpartaBench.hpp"
+
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/memory/MemoryObject.hpp"
+#include "sparta/serialization/checkpoint/FastCheckpointer.hpp"
+#include "sparta/simulation/RootTreeNode.hpp"
+#include "sparta/simulation/TreeNode.hpp"
+
+namespace
+{
+    using sparta::serialization::checkpoint::FastCheckpointer;
+
+    constexpr uint64_t MEMORY_SIZE   = 1024 * 1024;
+    constexpr uint64_t BLOCK_SIZE    = 64;
+    constexpr uint32_t WRITES_PER_CP = 16;
+
+    //! A finalized tree with a checkpointed 1MB memory
+    class CheckpointedMemory
+    {
+    public:
+        CheckpointedMemory() :
+            device_(&root_, "device", "Checkpointed device"),
+            mem_obj_(&device_, BLOCK_SIZE, MEMORY_SIZE, 0xcc, 1),
+            mem_if_(&device_, "mem", "Memory interface", nullptr, mem_obj_),
+            fcp(root_, &sched_)
+        {
+            root_.enterConfiguring();
+            root_.enterFinalized();
+            sched_.finalize();
+            fcp.createHead();
+        }
+
+        ~CheckpointedMemory() {
+            root_.enterTeardown();
+        }
+
+        // Write blocks spread over the memory, as a running program would
+        void writeBlocks() {
+            for(uint32_t i = 0; i < WRITES_PER_CP; ++i) {
+                std::memset(buf_, static_cast<int>(seq_), sizeof(buf_));
+                mem_if_.write((seq_ * 4099 * BLOCK_SIZE) % MEMORY_SIZE, sizeof(buf_), buf_);
+                ++seq_;
+            }
+        }
+
+    private:
+        sparta::Scheduler sched_;
+        sparta::RootTreeNode root_;
+        sparta::TreeNode device_;
+        sparta::memory::MemoryObject mem_obj_;
+        sparta::memory::BlockingMemoryObjectIFNode mem_if_;
+        uint8_t buf_[BLOCK_SIZE];
+        uint64_t seq_ = 0;
+
+    public:
+        FastCheckpointer fcp;
+    };
+
+    // Checkpoints saved before the memory is rebuilt (untimed) to bound
+    // the memory held by the checkpointer
+    constexpr uint32_t MAX_SAVED_CPS = 1000;
+
+    void benchCheckpointSave(sparta::bench::State & state)
+    {
+        auto cm = std::make_unique<CheckpointedMemory>();
+        uint32_t num_saved = 0;
+        while(state.keepRunning()) {
+            cm->writeBlocks();
+            cm->fcp.createCheckpoint();
+            if(++num_saved == MAX_SAVED_CPS) {
+                state.pauseTiming();
+                cm.reset();
+                cm = std::make_unique<CheckpointedMemory>();
+                num_saved = 0;
+                state.resumeTiming();
+            }
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    SPARTA_BENCHMARK("checkpoint/fast_save", benchCheckpointSave);
+
+    // Alternate between the ends of a chain of deltas (with a snapshot
+    // every 20)
+    void benchCheckpointLoad(sparta::bench::State & state)
+    {
+        CheckpointedMemory cm;
+        cm.fcp.setSnapshotThreshold(20);
+        const auto first_id = cm.fcp.getHeadID();
+        FastCheckpointer::chkpt_id_t last_id = first_id;
+        for(uint32_t i = 0; i < 50; ++i) {
+            cm.writeBlocks();
+            last_id = cm.fcp.createCheckpoint();
+        }
+
+        bool load_first = true;
+        while(state.keepRunning()) {
+            cm.fcp.loadCheckpoint(load_first ? first_id : last_id);
+            load_first = !load_first;
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    SPARTA_BENCHMARK("checkpoint/fast_load", benchCheckpointLoad);
+}
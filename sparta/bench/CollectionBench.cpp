@@ -0,0 +1,70 @@
+// <CollectionBench.cpp> -*- C++ -*-
+
+
+/*!
+ * \file CollectionBench.cpp
+ * \brief Benchmark of pipeline collection
+ */
+
+#include <unistd.h>
+
+#include <filesystem>
+
+#include "SpartaBench.hpp"
+
+#include "sparta/collection/Collectable.hpp"
+#include "sparta/collection/PipelineCollector.hpp"
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/simulation/ClockManager.hpp"
+#include "sparta/simulation/RootTreeNode.hpp"
+
+namespace
+{
+    constexpr uint32_t NUM_COLLECTABLES = 32;
+
+    // Collect a new value on every collectable every cycle, with the
+    // records written to a scratch directory
+    void benchPipelineCollection(sparta::bench::State & state)
+    {
+        const auto out_dir = std::filesystem::temp_directory_path() /
+            ("sparta_bench_collection_" + std::to_string(::getpid()));
+        std::filesystem::create_directories(out_dir);
+
+        {
+            sparta::Scheduler sched;
+            sparta::ClockManager cm(&sched);
+            sparta::RootTreeNode rtn;
+            sparta::Clock::Handle root_clk = cm.makeRoot(&rtn, "root_clk");
+            cm.normalize();
+            rtn.setClock(root_clk.get());
+
+            std::vector<std::unique_ptr<sparta::collection::Collectable<uint64_t>>> collectables;
+            for(uint32_t i = 0; i < NUM_COLLECTABLES; ++i) {
+                collectables.emplace_back(new sparta::collection::Collectable<uint64_t>(&rtn, "c" + std::to_string(i)));
+            }
+
+            rtn.enterConfiguring();
+            rtn.enterFinalized();
+
+            sparta::collection::PipelineCollector pc((out_dir / "bench_").string(), 1000000,
+                                                     root_clk.get(), &rtn);
+            sched.finalize();
+            pc.startCollection(&rtn);
+
+            uint64_t dat = 0;
+            while(state.keepRunning()) {
+                for(auto & c : collectables) {
+                    c->collect(dat++);
+                }
+                sched.run(1, true, false);
+            }
+            state.setItemsProcessed(state.iterations() * NUM_COLLECTABLES);
+
+            pc.destroy();
+            rtn.enterTeardown();
+        }
+
+        std::filesystem::remove_all(out_dir);
+    }
+    SPARTA_BENCHMARK("collection/pipeline_collect", benchPipelineCollection);
+}
@@ -0,0 +1,58 @@
+// <CoreModelBench.cpp> -*- C++ -*-
+
+
+/*!
+ * \file CoreModelBench.cpp
+ * \brief End-to-end benchmark running the CoreModel example simulator
+ *
+ * The simulator is found at the path given by the SPARTA_BENCH_CORE_MODEL
+ * environment variable or, by default, the sparta_core_example built
+ * alongside sparta_bench.  Its wall time includes startup and teardown.
+ */
+
+#include <sys/wait.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include "SpartaBench.hpp"
+
+namespace
+{
+    constexpr const char * CORE_MODEL_INSTS = "100k";
+    constexpr uint64_t CORE_MODEL_NUM_INSTS = 100000;
+
+    std::string getCoreModelPath()
+    {
+        if(const char * env = std::getenv("SPARTA_BENCH_CORE_MODEL")) {
+            return env;
+        }
+#ifdef SPARTA_BENCH_CORE_MODEL
+        return SPARTA_BENCH_CORE_MODEL;
+#else
+        return "";
+#endif
+    }
+
+    void benchCoreModel(sparta::bench::State & state)
+    {
+        const std::string exe = getCoreModelPath();
+        if(exe.empty() || !std::filesystem::exists(exe)) {
+            state.skip("CoreModel simulator not found (set SPARTA_BENCH_CORE_MODEL)");
+            return;
+        }
+        const std::string cmd = "'" + exe + "' -i " + CORE_MODEL_INSTS + " > /dev/null 2>&1";
+
+        while(state.keepRunning()) {
+            const int status = std::system(cmd.c_str());
+            if(status == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                state.skip("'" + cmd + "' failed");
+                return;
+            }
+        }
+        state.setItemsProcessed(state.iterations() * CORE_MODEL_NUM_INSTS);
+        state.setLabel(std::string("-i ") + CORE_MODEL_INSTS);
+    }
+    SPARTA_BENCHMARK("end_to_end/core_model", benchCoreModel, 1);
+}
@@ -0,0 +1,122 @@
+// <EventBench.cpp> -*- C++ -*-
+
+
+/*!
+ * \file EventBench.cpp
+ * \brief Benchmarks of the Scheduler and of the event types
+ */
+
+#include "SpartaBench.hpp"
+
+#include "sparta/events/EventSet.hpp"
+#include "sparta/events/Event.hpp"
+#include "sparta/events/PayloadEvent.hpp"
+#include "sparta/events/UniqueEvent.hpp"
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/simulation/Clock.hpp"
+#include "sparta/simulation/RootTreeNode.hpp"
+
+namespace
+{
+    class EventCounter
+    {
+    public:
+        void handle() { ++count; }
+        void handlePayload(const uint64_t & dat) { ++count; sum += dat; }
+
+        uint64_t count = 0;
+        uint64_t sum = 0;
+    };
+
+    constexpr uint32_t EVENTS_PER_CYCLE = 8;
+
+    // Schedule events at several delays each cycle and fire them
+    void benchScheduleFire(sparta::bench::State & state)
+    {
+        sparta::Scheduler    sched;
+        sparta::Clock        clk("clk", &sched);
+        sparta::RootTreeNode rtn;
+        rtn.setClock(&clk);
+        sparta::EventSet     es(&rtn);
+
+        EventCounter counter;
+        sparta::Event<> ev(&es, "ev", CREATE_SPARTA_HANDLER_WITH_OBJ(EventCounter, &counter, handle));
+        sched.finalize();
+        rtn.enterConfiguring();
+        rtn.enterFinalized();
+
+        while(state.keepRunning()) {
+            for(uint32_t i = 0; i < EVENTS_PER_CYCLE; ++i) {
+                ev.schedule(i % 4);
+            }
+            sched.run(1, true, false);
+        }
+        sched.run(4, true, false);
+        sparta::bench::doNotOptimize(counter.count);
+        state.setItemsProcessed(state.iterations() * EVENTS_PER_CYCLE);
+
+        rtn.enterTeardown();
+    }
+    SPARTA_BENCHMARK("scheduler/schedule_fire", benchScheduleFire);
+
+    // Schedule a UniqueEvent many times per cycle; it fires once
+    void benchUniqueEvent(sparta::bench::State & state)
+    {
+        sparta::Scheduler    sched;
+        sparta::Clock        clk("clk", &sched);
+        sparta::RootTreeNode rtn;
+        rtn.setClock(&clk);
+        sparta::EventSet     es(&rtn);
+
+        EventCounter counter;
+        sparta::UniqueEvent<> ev(&es, "ev", CREATE_SPARTA_HANDLER_WITH_OBJ(EventCounter, &counter, handle), 1);
+        sched.finalize();
+        rtn.enterConfiguring();
+        rtn.enterFinalized();
+
+        while(state.keepRunning()) {
+            for(uint32_t i = 0; i < EVENTS_PER_CYCLE; ++i) {
+                ev.schedule();
+            }
+            sched.run(1, true, false);
+        }
+        sched.run(2, true, false);
+        sparta::bench::doNotOptimize(counter.count);
+        state.setItemsProcessed(state.iterations() * EVENTS_PER_CYCLE);
+
+        rtn.enterTeardown();
+    }
+    SPARTA_BENCHMARK("scheduler/unique_event", benchUniqueEvent);
+
+    // Prepare, schedule and deliver payloads
+    void benchPayloadEvent(sparta::bench::State & state)
+    {
+        sparta::Scheduler    sched;
+        sparta::Clock        clk("clk", &sched);
+        sparta::RootTreeNode rtn;
+        rtn.setClock(&clk);
+        sparta::EventSet     es(&rtn);
+
+        EventCounter counter;
+        sparta::PayloadEvent<uint64_t> pe(&es, "pe",
+                                          CREATE_SPARTA_HANDLER_WITH_DATA_WITH_OBJ(EventCounter, &counter,
+                                                                                  handlePayload, uint64_t), 1);
+        sched.finalize();
+        rtn.enterConfiguring();
+        rtn.enterFinalized();
+
+        uint64_t dat = 0;
+        while(state.keepRunning()) {
+            for(uint32_t i = 0; i < EVENTS_PER_CYCLE; ++i) {
+                pe.preparePayload(dat++)->schedule();
+            }
+            sched.run(1, true, false);
+        }
+        sched.run(2, true, false);
+        sparta::bench::doNotOptimize(counter.sum);
+        state.setItemsProcessed(state.iterations() * EVENTS_PER_CYCLE);
+
+        rtn.enterTeardown();
+    }
+    SPARTA_BENCHMARK("events/payload_event", benchPayloadEvent);
+}
@@ -0,0 +1,70 @@
+// <PortBench.cpp> -*- C++ -*-
+
+
+/*!
+ * \file PortBench.cpp
+ * \brief Benchmarks of DataOutPort/DataInPort delivery
+ */
+
+#include "SpartaBench.hpp"
+
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/ports/DataPort.hpp"
+#include "sparta/ports/PortSet.hpp"
+#include "sparta/simulation/Clock.hpp"
+#include "sparta/simulation/RootTreeNode.hpp"
+
+namespace
+{
+    class DataReceiver
+    {
+    public:
+        DataReceiver(sparta::PortSet * ps, const std::string & name, sparta::Clock::Cycle delay) :
+            in(ps, name, delay)
+        {
+            in.registerConsumerHandler(CREATE_SPARTA_HANDLER_WITH_DATA(DataReceiver, receive, uint64_t));
+        }
+
+        void receive(const uint64_t & dat) { sum += dat; }
+
+        sparta::DataInPort<uint64_t> in;
+        uint64_t sum = 0;
+    };
+
+    // One send per cycle into a port with the given number of receivers
+    void benchDataPortSend(sparta::bench::State & state, uint32_t fanout)
+    {
+        sparta::Scheduler    sched;
+        sparta::Clock        clk("clk", &sched);
+        sparta::RootTreeNode rtn;
+        rtn.setClock(&clk);
+        sparta::PortSet      ps(&rtn);
+
+        sparta::DataOutPort<uint64_t> out(&ps, "out");
+        std::vector<std::unique_ptr<DataReceiver>> receivers;
+        for(uint32_t i = 0; i < fanout; ++i) {
+            receivers.emplace_back(new DataReceiver(&ps, "in" + std::to_string(i), 1));
+            sparta::bind(out, receivers.back()->in);
+        }
+        sched.finalize();
+        rtn.enterConfiguring();
+        rtn.enterFinalized();
+
+        uint64_t dat = 0;
+        while(state.keepRunning()) {
+            out.send(dat++);
+            sched.run(1, true, false);
+        }
+        sched.run(2, true, false);
+        sparta::bench::doNotOptimize(receivers.front()->sum);
+        state.setItemsProcessed(state.iterations());
+
+        rtn.enterTeardown();
+    }
+    SPARTA_BENCHMARK("ports/data_port_send", [](sparta::bench::State & state) {
+        benchDataPortSend(state, 1);
+    });
+    SPARTA_BENCHMARK("ports/data_port_send_fanout4", [](sparta::bench::State & state) {
+        benchDataPortSend(state, 4);
+    });
+}
@@ -0,0 +1,257 @@
+// <ResourceBench.cpp> -*- C++ -*-
+
+
+/*!
+ * \file ResourceBench.cpp
+ * \brief Benchmarks of the sparta resources: Buffer, Queue, Array and
+ *        Pipeline
+ */
+
+#include "SpartaBench.hpp"
+
+#include "sparta/events/EventSet.hpp"
+#include "sparta/events/UniqueEvent.hpp"
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/resources/Array.hpp"
+#include "sparta/resources/Buffer.hpp"
+#include "sparta/resources/Pipeline.hpp"
+#include "sparta/resources/Queue.hpp"
+#include "sparta/simulation/Clock.hpp"
+#include "sparta/simulation/RootTreeNode.hpp"
+
+namespace
+{
+    constexpr uint32_t RESOURCE_SIZE = 64;
+
+    // Fill to capacity, then retire the oldest entry and an entry from
+    // the middle (as a ROB and an issue queue would) for every two pushes
+    void benchBufferPushErase(sparta::bench::State & state)
+    {
+        sparta::Scheduler sched;
+        sparta::Clock     clk("clk", &sched);
+        sparta::Buffer<uint64_t> buf("bench_buffer", RESOURCE_SIZE, &clk);
+
+        uint64_t dat = 0;
+        while(state.keepRunning()) {
+            if(buf.size() == buf.capacity()) {
+                buf.erase(0);
+                buf.erase(buf.size() / 2);
+            }
+            buf.push_back(dat++);
+        }
+        sparta::bench::doNotOptimize(buf.read(0));
+        state.setItemsProcessed(state.iterations());
+    }
+    SPARTA_BENCHMARK("resources/buffer_push_erase", benchBufferPushErase);
+
+    // Walk a full Buffer front to back
+    void benchBufferIterate(sparta::bench::State & state)
+    {
+        sparta::Scheduler sched;
+        sparta::Clock     clk("clk", &sched);
+        sparta::Buffer<uint64_t> buf("bench_buffer", RESOURCE_SIZE, &clk);
+        for(uint32_t i = 0; i < RESOURCE_SIZE; ++i) {
+            buf.push_back(i);
+        }
+
+        uint64_t sum = 0;
+        while(state.keepRunning()) {
+            for(const auto & dat : buf) {
+                sum += dat;
+            }
+        }
+        sparta::bench::doNotOptimize(sum);
+        state.setItemsProcessed(state.iterations() * RESOURCE_SIZE);
+    }
+    SPARTA_BENCHMARK("resources/buffer_iterate", benchBufferIterate);
+
+    void benchQueuePushPop(sparta::bench::State & state)
+    {
+        sparta::Scheduler sched;
+        sparta::Clock     clk("clk", &sched);
+        sparta::Queue<uint64_t> queue("bench_queue", RESOURCE_SIZE, &clk);
+        for(uint32_t i = 0; i < RESOURCE_SIZE / 2; ++i) {
+            queue.push(i);
+        }
+
+        uint64_t dat = 0;
+        while(state.keepRunning()) {
+            queue.push(dat++);
+            queue.pop();
+        }
+        sparta::bench::doNotOptimize(queue.front());
+        state.setItemsProcessed(state.iterations());
+    }
+    SPARTA_BENCHMARK("resources/queue_push_pop", benchQueuePushPop);
+
+    // Write an entry and erase the oldest one of an aged Array
+    void benchArrayWriteErase(sparta::bench::State & state)
+    {
+        sparta::Scheduler sched;
+        sparta::Clock     clk("clk", &sched);
+        sparta::Array<uint64_t> array("bench_array", RESOURCE_SIZE, &clk);
+        for(uint32_t i = 0; i < RESOURCE_SIZE / 2; ++i) {
+            array.write(i, i);
+        }
+
+        uint64_t dat = 0;
+        uint32_t idx = RESOURCE_SIZE / 2;
+        while(state.keepRunning()) {
+            array.write(idx, dat++);
+            array.erase(array.getOldestIndex().getIndex());
+            idx = (idx + 1) % RESOURCE_SIZE;
+        }
+        sparta::bench::doNotOptimize(array.numValid());
+        state.setItemsProcessed(state.iterations());
+    }
+    SPARTA_BENCHMARK("resources/array_write_erase", benchArrayWriteErase);
+
+    // Append and advance a Pipeline updated by its owner (no stage handlers)
+    void benchPipelineUpdate(sparta::bench::State & state)
+    {
+        sparta::Scheduler sched;
+        sparta::Clock     clk("clk", &sched);
+        sparta::Pipeline<uint64_t> pipeline("bench_pipeline", 16, &clk);
+
+        uint64_t dat = 0;
+        while(state.keepRunning()) {
+            pipeline.append(dat++);
+            pipeline.update();
+        }
+        sparta::bench::doNotOptimize(pipeline.numValid());
+        state.setItemsProcessed(state.iterations());
+    }
+    SPARTA_BENCHMARK("resources/pipeline_update", benchPipelineUpdate);
+
+    // A Pipeline with a handler on every stage, advanced by the scheduler
+    class PipelineDriver
+    {
+    public:
+        PipelineDriver(sparta::EventSet * es, uint32_t num_stages) :
+            pipeline_(es, "bench_pipeline", num_stages, es->getClock()),
+            ev_append_(es, "ev_append", CREATE_SPARTA_HANDLER(PipelineDriver, append_))
+        {
+            for(uint32_t stage = 0; stage < num_stages; ++stage) {
+                pipeline_.registerHandlerAtStage(stage, CREATE_SPARTA_HANDLER(PipelineDriver, stage_));
+            }
+            pipeline_.performOwnUpdates();
+            ev_append_.setContinuing(true);
+        }
+
+        void start() { ev_append_.schedule(); }
+
+        uint64_t stage_calls = 0;
+
+    private:
+        void append_() {
+            pipeline_.append(next_item_++);
+            ev_append_.schedule(1);
+        }
+
+        void stage_() { ++stage_calls; }
+
+        sparta::Pipeline<uint64_t> pipeline_;
+        sparta::UniqueEvent<> ev_append_;
+        uint64_t next_item_ = 0;
+    };
+
+    void benchPipelineHandlers(sparta::bench::State & state)
+    {
+        sparta::Scheduler    sched;
+        sparta::Clock        clk("clk", &sched);
+        sparta::RootTreeNode rtn;
+        rtn.setClock(&clk);
+        sparta::EventSet     es(&rtn);
+
+        PipelineDriver driver(&es, 16);
+        sched.finalize();
+        rtn.enterConfiguring();
+        rtn.enterFinalized();
+        driver.start();
+
+        while(state.keepRunning()) {
+            sched.run(1, true, false);
+        }
+        sparta::bench::doNotOptimize(driver.stage_calls);
+        state.setItemsProcessed(state.iterations());
+
+        rtn.enterTeardown();
+    }
+    SPARTA_BENCHMARK("resources/pipeline_stage_handlers", benchPipelineHandlers);
+
+    // A deep Pipeline with a handler every handler_stride stages and a
+    // periodic stall in the middle.  test/Pipeline/PipelineStall_test
+    // checks the stage handler counts of the same pipelines
+    class StallingPipelineDriver
+    {
+    public:
+        StallingPipelineDriver(sparta::EventSet * es, uint32_t num_stages, uint32_t handler_stride) :
+            pipeline_(es, "bench_pipeline", num_stages, es->getClock()),
+            ev_append_(es, "ev_append", CREATE_SPARTA_HANDLER(StallingPipelineDriver, append_))
+        {
+            for(uint32_t stage = 0; stage < num_stages; stage += handler_stride) {
+                pipeline_.registerHandlerAtStage(stage, CREATE_SPARTA_HANDLER(StallingPipelineDriver, stage_));
+            }
+            pipeline_.setDefaultStagePrecedence(sparta::Pipeline<uint64_t>::Precedence::BACKWARD);
+            pipeline_.performOwnUpdates();
+            ev_append_.setContinuing(true);
+        }
+
+        void start() { ev_append_.schedule(); }
+
+        uint64_t stage_calls = 0;
+
+    private:
+        void append_() {
+            // The front of the pipeline holds still while stalled
+            if(!pipeline_.isAppended()) {
+                pipeline_.append(next_item_);
+            }
+            ++next_item_;
+
+            const uint32_t stall_stage = pipeline_.capacity() / 2;
+            if(((next_item_ % 97) == 0) && !pipeline_.isStalledOrStalling() && pipeline_.isValid(stall_stage)) {
+                pipeline_.stall(stall_stage, 3);
+            }
+            ev_append_.schedule(1);
+        }
+
+        void stage_() { ++stage_calls; }
+
+        sparta::Pipeline<uint64_t> pipeline_;
+        sparta::UniqueEvent<> ev_append_;
+        uint64_t next_item_ = 0;
+    };
+
+    void benchPipelineStalls(sparta::bench::State & state, uint32_t num_stages, uint32_t handler_stride)
+    {
+        sparta::Scheduler    sched;
+        sparta::Clock        clk("clk", &sched);
+        sparta::RootTreeNode rtn;
+        rtn.setClock(&clk);
+        sparta::EventSet     es(&rtn);
+
+        StallingPipelineDriver driver(&es, num_stages, handler_stride);
+        sched.finalize();
+        rtn.enterConfiguring();
+        rtn.enterFinalized();
+        driver.start();
+
+        while(state.keepRunning()) {
+            sched.run(1, true, false);
+        }
+        sparta::bench::doNotOptimize(driver.stage_calls);
+        state.setItemsProcessed(state.iterations());
+
+        rtn.enterTeardown();
+    }
+    SPARTA_BENCHMARK("resources/pipeline_stalls_24_stages", [](sparta::bench::State & state) {
+        benchPipelineStalls(state, 24, 1);
+    });
+    SPARTA_BENCHMARK("resources/pipeline_stalls_64_stages_every_8th", [](sparta::bench::State & state) {
+        benchPipelineStalls(state, 64, 8);
+    });
+    SPARTA_BENCHMARK("resources/pipeline_stalls_128_stages_every_32nd", [](sparta::bench::State & state) {
+        benchPipelineStalls(state, 128, 32);
+    });
+}
@@ -0,0 +1,64 @@
+// <SharedPointerBench.cpp> -*- C++ -*-
+
+
+/*!
+ * \file SharedPointerBench.cpp
+ * \brief Benchmarks of SpartaSharedPointer allocation and copies
+ */
+
+#include "SpartaBench.hpp"
+
+#include "sparta/utils/SpartaSharedPointer.hpp"
+#include "sparta/utils/SpartaSharedPointerAllocator.hpp"
+
+namespace
+{
+    // Roughly the size of an instruction object of a performance model
+    struct BenchInst
+    {
+        explicit BenchInst(uint64_t id) : uid(id) {}
+        uint64_t uid;
+        uint64_t pc = 0;
+        uint32_t opcode = 0;
+        uint32_t src_regs[4] = {0};
+        uint32_t dst_regs[2] = {0};
+        uint64_t timestamps[6] = {0};
+    };
+
+    sparta::SpartaSharedPointerAllocator<BenchInst> bench_inst_allocator(100000, 50000);
+
+    void benchMakeShared(sparta::bench::State & state)
+    {
+        uint64_t id = 0;
+        while(state.keepRunning()) {
+            auto inst = sparta::SpartaSharedPointer<BenchInst>(new BenchInst(id++));
+            sparta::bench::doNotOptimize(inst->uid);
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    SPARTA_BENCHMARK("shared_pointer/new", benchMakeShared);
+
+    void benchAllocate(sparta::bench::State & state)
+    {
+        uint64_t id = 0;
+        while(state.keepRunning()) {
+            auto inst = sparta::allocate_sparta_shared_pointer<BenchInst>(bench_inst_allocator, id++);
+            sparta::bench::doNotOptimize(inst->uid);
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    SPARTA_BENCHMARK("shared_pointer/allocator", benchAllocate);
+
+    // Copy and release references, as passing an instruction down a
+    // pipeline does
+    void benchCopy(sparta::bench::State & state)
+    {
+        auto inst = sparta::allocate_sparta_shared_pointer<BenchInst>(bench_inst_allocator, 0);
+        while(state.keepRunning()) {
+            sparta::SpartaSharedPointer<BenchInst> copy(inst);
+            sparta::bench::doNotOptimize(copy->uid);
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    SPARTA_BENCHMARK("shared_pointer/copy", benchCopy);
+}
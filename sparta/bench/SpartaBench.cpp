@@ -0,0 +1,349 @@
+// <SpartaBench.cpp> -*- C++ -*-
+
+
+/*!
+ * \file SpartaBench.cpp
+ * \brief Runner of the sparta_bench benchmark suite
+ *
+ * Usage: sparta_bench [--filter REGEX] [--json FILE] [--min-time SEC]
+ *                     [--repetitions N] [--list]
+ */
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "SpartaBench.hpp"
+#include "sparta/app/SimulationInfo.hpp"
+#include "sparta/utils/SpartaException.hpp"
+
+namespace sparta
+{
+namespace bench
+{
+    namespace
+    {
+        struct Benchmark
+        {
+            std::string name;
+            BenchmarkFunction func;
+            uint64_t fixed_iterations;
+        };
+
+        // Function-local so benchmarks can register from static
+        // initializers of any translation unit
+        std::vector<Benchmark> & getRegistry()
+        {
+            static std::vector<Benchmark> registry;
+            return registry;
+        }
+
+        struct Result
+        {
+            std::string name;
+            uint64_t iterations = 0;
+            uint32_t repetitions = 0;
+            double real_ns = 0; // Per iteration
+            double cpu_ns = 0;  // Per iteration
+            double items_per_second = 0;
+            std::string label;
+            std::string error_message;
+        };
+
+        struct Options
+        {
+            std::string filter;
+            std::string json_file;
+            double min_time = 0.5;
+            uint32_t repetitions = 3;
+            bool list = false;
+        };
+
+        // Run the benchmark once with the given number of iterations
+        State runOnce(const Benchmark & bm, uint64_t iterations)
+        {
+            State state(iterations);
+            bm.func(state);
+            return state;
+        }
+
+        Result runBenchmark(const Benchmark & bm, const Options & opts)
+        {
+            Result result;
+            result.name = bm.name;
+
+            // Grow the iteration count until a run lasts the minimum time
+            uint64_t iterations = bm.fixed_iterations;
+            if(iterations == 0)
+            {
+                iterations = 1;
+                while(true)
+                {
+                    const State state = runOnce(bm, iterations);
+                    if(!state.errorMessage().empty()) {
+                        result.error_message = state.errorMessage();
+                        return result;
+                    }
+                    if(state.realSeconds() >= opts.min_time || iterations >= 1000000000ull) {
+                        break;
+                    }
+                    const double scale = (state.realSeconds() > 0) ?
+                        (opts.min_time * 1.4 / state.realSeconds()) : 10.0;
+                    iterations = std::max<uint64_t>(iterations + 1,
+                                                    iterations * std::min(scale, 10.0));
+                }
+            }
+
+            // Report the repetition with the median real time
+            std::vector<State> runs;
+            for(uint32_t i = 0; i < std::max(opts.repetitions, 1u); ++i)
+            {
+                runs.emplace_back(runOnce(bm, iterations));
+                if(!runs.back().errorMessage().empty()) {
+                    result.error_message = runs.back().errorMessage();
+                    return result;
+                }
+            }
+            std::sort(runs.begin(), runs.end(), [](const State & a, const State & b) {
+                return a.realSeconds() < b.realSeconds();
+            });
+            const State & median = runs[runs.size() / 2];
+
+            result.iterations  = iterations;
+            result.repetitions = runs.size();
+            result.real_ns     = median.realSeconds() * 1e9 / iterations;
+            result.cpu_ns      = median.cpuSeconds() * 1e9 / iterations;
+            if(median.itemsProcessed() != 0 && median.realSeconds() > 0) {
+                result.items_per_second = median.itemsProcessed() / median.realSeconds();
+            }
+            result.label = median.label();
+            return result;
+        }
+
+        std::string jsonEscape(const std::string & s)
+        {
+            std::ostringstream o;
+            for(const char c : s) {
+                switch(c) {
+                case '"':  o << "\\\""; break;
+                case '\\': o << "\\\\"; break;
+                case '\n': o << "\\n";  break;
+                case '\t': o << "\\t";  break;
+                default:
+                    if(static_cast<unsigned char>(c) < 0x20) {
+                        o << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                          << static_cast<int>(c) << std::dec;
+                    } else {
+                        o << c;
+                    }
+                }
+            }
+            return o.str();
+        }
+
+        // Write the results in the JSON layout of Google Benchmark
+        void writeJSON(std::ostream & o, const std::vector<Result> & results)
+        {
+            char host[256] = {0};
+            gethostname(host, sizeof(host) - 1);
+            char date[64] = {0};
+            const std::time_t now = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+            o << std::setprecision(12);
+            o << "{\n"
+              << "  \"context\": {\n"
+              << "    \"date\": \"" << date << "\",\n"
+              << "    \"host_name\": \"" << jsonEscape(host) << "\",\n"
+              << "    \"executable\": \"sparta_bench\",\n"
+              << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+              << "    \"sparta_version\": \"" << jsonEscape(sparta::SimulationInfo::sparta_version) << "\",\n"
+#ifdef NDEBUG
+              << "    \"library_build_type\": \"release\"\n"
+#else
+              << "    \"library_build_type\": \"debug\"\n"
+#endif
+              << "  },\n"
+              << "  \"benchmarks\": [";
+            bool first = true;
+            for(const auto & r : results)
+            {
+                o << (first ? "\n" : ",\n") << "    {\n"
+                  << "      \"name\": \"" << jsonEscape(r.name) << "\",\n"
+                  << "      \"run_name\": \"" << jsonEscape(r.name) << "\",\n"
+                  << "      \"run_type\": \"iteration\",\n";
+                if(!r.error_message.empty()) {
+                    o << "      \"error_occurred\": true,\n"
+                      << "      \"error_message\": \"" << jsonEscape(r.error_message) << "\"\n";
+                }
+                else {
+                    o << "      \"repetitions\": " << r.repetitions << ",\n"
+                      << "      \"iterations\": " << r.iterations << ",\n"
+                      << "      \"real_time\": " << r.real_ns << ",\n"
+                      << "      \"cpu_time\": " << r.cpu_ns << ",\n"
+                      << "      \"time_unit\": \"ns\"";
+                    if(r.items_per_second != 0) {
+                        o << ",\n      \"items_per_second\": " << r.items_per_second;
+                    }
+                    if(!r.label.empty()) {
+                        o << ",\n      \"label\": \"" << jsonEscape(r.label) << "\"";
+                    }
+                    o << "\n";
+                }
+                o << "    }";
+                first = false;
+            }
+            o << "\n  ]\n}\n";
+        }
+
+        void printResult(std::ostream & o, const Result & r)
+        {
+            o << std::left << std::setw(40) << r.name << std::right;
+            if(!r.error_message.empty()) {
+                o << " SKIPPED: " << r.error_message << std::endl;
+                return;
+            }
+            o << std::fixed << std::setprecision(1)
+              << std::setw(14) << r.real_ns << " ns"
+              << std::setw(14) << r.cpu_ns << " ns"
+              << std::setw(12) << r.iterations;
+            if(r.items_per_second != 0) {
+                o << std::setprecision(3) << std::setw(12) << r.items_per_second / 1e6 << " M/s";
+            }
+            if(!r.label.empty()) {
+                o << "  " << r.label;
+            }
+            o << std::defaultfloat << std::endl;
+        }
+
+        int usage(const char* exe)
+        {
+            std::cerr << "Usage: " << exe << " [--filter REGEX] [--json FILE] [--min-time SEC]\n"
+                      << "           [--repetitions N] [--list]\n"
+                      << "Runs the SPARTA benchmark suite.  --json writes the results in the\n"
+                      << "Google Benchmark JSON format (\"-\" for stdout)" << std::endl;
+            return 1;
+        }
+    }
+
+    void State::pauseTiming()
+    {
+        if(timing_) {
+            real_seconds_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - real_start_).count();
+            cpu_seconds_  += processCpuSeconds() - cpu_start_;
+            timing_ = false;
+        }
+    }
+
+    void State::resumeTiming()
+    {
+        if(!timing_) {
+            cpu_start_  = processCpuSeconds();
+            real_start_ = std::chrono::steady_clock::now();
+            timing_ = true;
+        }
+    }
+
+    double State::processCpuSeconds()
+    {
+        auto seconds = [](const struct rusage & ru) {
+            return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec +
+                (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+        };
+        struct rusage self, children;
+        getrusage(RUSAGE_SELF, &self);
+        getrusage(RUSAGE_CHILDREN, &children);
+        return seconds(self) + seconds(children);
+    }
+
+    bool registerBenchmark(const std::string & name,
+                           const BenchmarkFunction & func,
+                           uint64_t fixed_iterations)
+    {
+        getRegistry().emplace_back(Benchmark{name, func, fixed_iterations});
+        return true;
+    }
+
+} // namespace bench
+} // namespace sparta
+
+int main(int argc, char** argv)
+{
+    using namespace sparta::bench;
+
+    Options opts;
+    for(int i = 1; i < argc; ++i){
+        const bool has_value = (i + 1 < argc);
+        if(std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0){
+            return usage(argv[0]);
+        }else if(std::strcmp(argv[i], "--filter") == 0 && has_value){
+            opts.filter = argv[++i];
+        }else if(std::strcmp(argv[i], "--json") == 0 && has_value){
+            opts.json_file = argv[++i];
+        }else if(std::strcmp(argv[i], "--min-time") == 0 && has_value){
+            opts.min_time = std::stod(argv[++i]);
+        }else if(std::strcmp(argv[i], "--repetitions") == 0 && has_value){
+            opts.repetitions = std::stoul(argv[++i]);
+        }else if(std::strcmp(argv[i], "--list") == 0){
+            opts.list = true;
+        }else{
+            return usage(argv[0]);
+        }
+    }
+
+    try{
+        const std::regex filter(opts.filter.empty() ? ".*" : opts.filter);
+        std::vector<Benchmark> selected;
+        for(const auto & bm : getRegistry()) {
+            if(std::regex_search(bm.name, filter)) {
+                selected.emplace_back(bm);
+            }
+        }
+        std::sort(selected.begin(), selected.end(), [](const Benchmark & a, const Benchmark & b) {
+            return a.name < b.name;
+        });
+
+        if(opts.list){
+            for(const auto & bm : selected) {
+                std::cout << bm.name << std::endl;
+            }
+            return 0;
+        }
+
+        // With JSON on stdout, the table goes to stderr
+        std::ostream & table = (opts.json_file == "-") ? std::cerr : std::cout;
+        table << std::left << std::setw(40) << "Benchmark" << std::right
+              << std::setw(17) << "Time" << std::setw(17) << "CPU"
+              << std::setw(12) << "Iterations" << std::setw(16) << "Items" << std::endl;
+
+        std::vector<Result> results;
+        for(const auto & bm : selected) {
+            results.emplace_back(runBenchmark(bm, opts));
+            printResult(table, results.back());
+        }
+
+        if(opts.json_file == "-"){
+            writeJSON(std::cout, results);
+        }else if(!opts.json_file.empty()){
+            std::ofstream out(opts.json_file);
+            if(!out){
+                throw sparta::SpartaException("Could not open \"") << opts.json_file << "\" for write";
+            }
+            writeJSON(out, results);
+        }
+    }catch(std::exception& ex){
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
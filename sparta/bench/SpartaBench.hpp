@@ -0,0 +1,143 @@
+// <SpartaBench.hpp> -*- C++ -*-
+
+
+/*!
+ * \file SpartaBench.hpp
+ * \brief Lightweight benchmark harness used by the sparta_bench target
+ *
+ * A benchmark is a function taking a sparta::bench::State and running
+ * its timed loop while State::keepRunning() is true:
+ *
+ * \code
+ * void benchFoo(sparta::bench::State & state)
+ * {
+ *     Foo foo;                       // Setup, not timed
+ *     while(state.keepRunning()) {
+ *         foo.doIt();                // Timed
+ *     }
+ *     state.setItemsProcessed(state.iterations());
+ * }
+ * SPARTA_BENCHMARK("foo/do_it", benchFoo);
+ * \endcode
+ *
+ * The runner grows the iteration count until a run lasts the minimum
+ * time, repeats the run and reports the median.  Results can be written
+ * as JSON in the layout used by Google Benchmark so its comparison
+ * tools can track regressions across SPARTA versions.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cinttypes>
+#include <functional>
+#include <string>
+
+namespace sparta
+{
+namespace bench
+{
+    /*!
+     * \brief Iteration control and timing of one benchmark run
+     */
+    class State
+    {
+    public:
+        explicit State(uint64_t iterations) :
+            iterations_(iterations),
+            remaining_(iterations)
+        {}
+
+        //! Number of iterations of this run
+        uint64_t iterations() const { return iterations_; }
+
+        /*!
+         * \brief Loop condition of the timed loop.  The timer starts on
+         *        the first call and stops when it returns false
+         */
+        bool keepRunning() {
+            if(__builtin_expect(remaining_ != 0, 1)) {
+                if(__builtin_expect(remaining_ == iterations_, 0)) {
+                    resumeTiming();
+                }
+                --remaining_;
+                return true;
+            }
+            pauseTiming();
+            return false;
+        }
+
+        //! Stop the timer, e.g. around per-iteration setup
+        void pauseTiming();
+
+        //! Restart the timer
+        void resumeTiming();
+
+        //! Items (events, packets, ...) handled by the run; reported per second
+        void setItemsProcessed(uint64_t items) { items_processed_ = items; }
+
+        //! Free text shown alongside the result
+        void setLabel(const std::string & label) { label_ = label; }
+
+        //! Mark the benchmark as skipped (e.g. a missing executable)
+        void skip(const std::string & reason) {
+            remaining_ = 0;
+            error_message_ = reason;
+        }
+
+        double realSeconds() const { return real_seconds_; }
+        double cpuSeconds() const { return cpu_seconds_; }
+        uint64_t itemsProcessed() const { return items_processed_; }
+        const std::string & label() const { return label_; }
+        const std::string & errorMessage() const { return error_message_; }
+
+        //! CPU time of this process plus any waited-for child processes
+        static double processCpuSeconds();
+
+    private:
+        uint64_t iterations_;
+        uint64_t remaining_;
+        bool timing_ = false;
+        std::chrono::steady_clock::time_point real_start_;
+        double cpu_start_ = 0;
+        double real_seconds_ = 0;
+        double cpu_seconds_ = 0;
+        uint64_t items_processed_ = 0;
+        std::string label_;
+        std::string error_message_;
+    };
+
+    using BenchmarkFunction = std::function<void(State &)>;
+
+    /*!
+     * \brief Register a benchmark with the runner
+     * \param name Name, by convention "<component>/<operation>"
+     * \param func The benchmark
+     * \param fixed_iterations If non-zero, always run this many iterations
+     *        instead of growing them to the minimum time (for long
+     *        end-to-end runs)
+     * \return true, to allow registration from a static initializer
+     */
+    bool registerBenchmark(const std::string & name,
+                           const BenchmarkFunction & func,
+                           uint64_t fixed_iterations = 0);
+
+    /*!
+     * \brief Prevent the compiler from optimizing away a value computed
+     *        by the timed loop
+     */
+    template<class T>
+    inline void doNotOptimize(const T & value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+} // namespace bench
+} // namespace sparta
+
+#define SPARTA_BENCH_CONCAT_IMPL_(a, b) a##b
+#define SPARTA_BENCH_CONCAT_(a, b) SPARTA_BENCH_CONCAT_IMPL_(a, b)
+
+//! Register a benchmark function under the given name
+#define SPARTA_BENCHMARK(name, ...)                                     \
+    static const bool SPARTA_BENCH_CONCAT_(sparta_bench_registered_, __LINE__) = \
+        sparta::bench::registerBenchmark(name, __VA_ARGS__)
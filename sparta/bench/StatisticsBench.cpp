@@ -0,0 +1,135 @@
+// <StatisticsBench.cpp> -*- C++ -*-
+
+
+/*!
+ * \file StatisticsBench.cpp
+ * \brief Benchmarks of counter updates and report generation
+ */
+
+#include <sstream>
+
+#include "SpartaBench.hpp"
+
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/report/Report.hpp"
+#include "sparta/report/format/CSV.hpp"
+#include "sparta/report/format/JSON.hpp"
+#include "sparta/simulation/ClockManager.hpp"
+#include "sparta/simulation/RootTreeNode.hpp"
+#include "sparta/simulation/TreeNode.hpp"
+#include "sparta/statistics/Counter.hpp"
+#include "sparta/statistics/StatisticDef.hpp"
+#include "sparta/statistics/StatisticSet.hpp"
+
+namespace
+{
+    constexpr uint32_t NUM_COUNTERS = 64;
+
+    //! A finalized tree with a report on a set of counters and ratios
+    class StatisticsTree
+    {
+    public:
+        StatisticsTree() :
+            root_(sched_.getSearchScope()),
+            cm_(&sched_),
+            core_(&root_, "core0", "Core 0"),
+            sset_(&core_),
+            report("bench report", &root_)
+        {
+            clk_ = cm_.makeRoot();
+            root_.setClock(clk_.get());
+
+            for(uint32_t i = 0; i < NUM_COUNTERS; ++i) {
+                counters.emplace_back(new sparta::Counter(&sset_, "c" + std::to_string(i), "Bench counter",
+                                                          sparta::Counter::COUNT_NORMAL));
+                report.add(counters.back().get());
+            }
+            for(uint32_t i = 0; i + 1 < NUM_COUNTERS; i += 2) {
+                stat_defs_.emplace_back(new sparta::StatisticDef(&sset_, "s" + std::to_string(i), "Bench ratio",
+                                                                 &sset_, "c" + std::to_string(i) + "/c" +
+                                                                 std::to_string(i + 1)));
+                report.add(stat_defs_.back().get());
+            }
+
+            root_.enterConfiguring();
+            root_.enterFinalized();
+            sched_.finalize();
+            sched_.run(1, true, false);
+            report.start();
+        }
+
+        ~StatisticsTree() {
+            root_.enterTeardown();
+        }
+
+        void incrementAll() {
+            for(uint32_t i = 0; i < NUM_COUNTERS; ++i) {
+                *counters[i] += i + 1;
+            }
+        }
+
+    private:
+        sparta::Scheduler     sched_;
+        sparta::RootTreeNode  root_;
+        sparta::ClockManager  cm_;
+        sparta::Clock::Handle clk_;
+        sparta::TreeNode      core_;
+        sparta::StatisticSet  sset_;
+        std::vector<std::unique_ptr<sparta::StatisticDef>> stat_defs_;
+
+    public:
+        std::vector<std::unique_ptr<sparta::Counter>> counters;
+        sparta::Report report;
+    };
+
+    void benchCounterIncrement(sparta::bench::State & state)
+    {
+        StatisticsTree tree;
+        while(state.keepRunning()) {
+            tree.incrementAll();
+        }
+        sparta::bench::doNotOptimize(tree.counters.front()->get());
+        state.setItemsProcessed(state.iterations() * NUM_COUNTERS);
+    }
+    SPARTA_BENCHMARK("statistics/counter_increment", benchCounterIncrement);
+
+    // Append one row to a periodic CSV report
+    void benchCSVUpdate(sparta::bench::State & state)
+    {
+        StatisticsTree tree;
+        std::ostringstream out;
+        sparta::report::format::CSV csv(&tree.report, out);
+        csv.writeHeader();
+
+        uint64_t rows = 0;
+        while(state.keepRunning()) {
+            tree.incrementAll();
+            csv.update();
+            if((++rows % 1024) == 0) {
+                state.pauseTiming();
+                out.str("");
+                state.resumeTiming();
+            }
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    SPARTA_BENCHMARK("statistics/report_csv_update", benchCSVUpdate);
+
+    // Evaluate and write the whole report as JSON
+    void benchJSONWrite(sparta::bench::State & state)
+    {
+        StatisticsTree tree;
+        std::ostringstream out;
+        sparta::report::format::JSON json(&tree.report, out);
+
+        while(state.keepRunning()) {
+            tree.incrementAll();
+            json.write();
+            state.pauseTiming();
+            out.str("");
+            state.resumeTiming();
+        }
+        state.setItemsProcessed(state.iterations());
+    }
+    SPARTA_BENCHMARK("statistics/report_json_write", benchJSONWrite);
+}
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""
+End-to-end performance regression runner for the CoreModel example.
+
+Runs sparta_core_example for fixed instruction counts, once on a single
+core and on scaled N-core topologies (--num-cores, built by CPUFactory from
+CPUTopology), and measures:
+
+  events_per_sec      Scheduler events fired per second of run wall time
+  sim_cycles_per_sec  Root clock cycles simulated per second of run wall time
+  startup_s           Build/configure/finalize/bind time (--startup-profile)
+  peak_rss_mb         Peak resident set size of the simulator process
+  run_wall_s          Wall time of the run phase
+
+The event and cycle counts are deterministic; they are checked exactly so
+that a change in model behavior is not mistaken for a speedup.  Each
+workload is repeated and the median is kept.
+
+Typical use:
+
+  # Record a baseline on the reference machine
+  core_model_perf_regress.py --sim-exe-path build/example/CoreModel/sparta_core_example \\
+      --write-baseline core_model_baseline.json
+
+  # Later, fail (exit code 1) if any metric is more than 10% worse
+  core_model_perf_regress.py --sim-exe-path ... --baseline core_model_baseline.json --threshold 10
+"""
+
+import argparse
+import json
+import os
+import re
+import statistics
+import subprocess
+import sys
+import tempfile
+
+# Metrics compared against the baseline, and whether higher is better
+COMPARED_METRICS = {
+    "events_per_sec":     True,
+    "sim_cycles_per_sec": True,
+    "startup_s":          False,
+    "peak_rss_mb":        False,
+}
+
+# Counts which must match the baseline exactly
+DETERMINISTIC_METRICS = ["events_fired", "sim_cycles"]
+
+RE_RUN_WALL      = re.compile(r"Simulation Performance\s*:\s*wall\(\s*([0-9.eE+-]+)")
+RE_EVENTS_FIRED  = re.compile(r"Scheduler Events Fired:\s*(\d+)")
+RE_CYCLES        = re.compile(r"Root Clock Cycles Elapsed:\s*(\d+)")
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description="Run the CoreModel example for fixed instruction counts and "
+                                     "compare its throughput against a baseline.")
+    parser.add_argument("--sim-exe-path", type=str, default="release/example/CoreModel/sparta_core_example",
+                        help="Path to the sparta_core_example executable.")
+    parser.add_argument("--insts", type=str, default="200k",
+                        help="Instruction limit (-i) of each run.")
+    parser.add_argument("--cores", type=int, nargs='+', default=[1, 4],
+                        help="Core counts to run (each is a separate workload).")
+    parser.add_argument("--repetitions", type=int, default=3,
+                        help="Runs of each workload; the median is reported.")
+    parser.add_argument("--baseline", type=str, help="Baseline JSON file to compare against.")
+    parser.add_argument("--write-baseline", type=str, help="Write the results as a baseline JSON file.")
+    parser.add_argument("--output", type=str, help="Write the results (and comparison) to this JSON file.")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="Fail when a metric is worse than the baseline by more than this percentage.")
+    parser.add_argument("--allow-behavior-change", action="store_true",
+                        help="Do not fail when event or cycle counts differ from the baseline.")
+    return parser.parse_args()
+
+
+def run_once(exe, sim_args, work_dir):
+    """Run the simulator once and return its raw measurements"""
+    profile = os.path.join(work_dir, "startup_profile.json")
+    log = os.path.join(work_dir, "sim.log")
+    # The verbose summary also prints the root clock cycles elapsed
+    cmd = [exe] + sim_args + ["--startup-profile", profile, "--auto-summary", "verbose"]
+    with open(log, "w") as out:
+        proc = subprocess.Popen(cmd, stdout=out, stderr=subprocess.STDOUT, cwd=work_dir)
+        _, status, rusage = os.wait4(proc.pid, 0)
+        proc.returncode = os.waitstatus_to_exitcode(status)
+    with open(log) as f:
+        output = f.read()
+    if proc.returncode != 0:
+        raise RuntimeError(f"'{' '.join(cmd)}' failed with exit code {proc.returncode}:\n{output[-2000:]}")
+
+    def find(regex, what):
+        m = regex.search(output)
+        if m is None:
+            raise RuntimeError(f"Could not find the {what} in the output of '{' '.join(cmd)}'")
+        return m.group(1)
+
+    with open(profile) as f:
+        phases = json.load(f)["phases"]
+
+    run_wall_s   = float(find(RE_RUN_WALL, "run time"))
+    events_fired = int(find(RE_EVENTS_FIRED, "number of events fired"))
+    sim_cycles   = int(find(RE_CYCLES, "number of cycles"))
+    return {
+        "run_wall_s":         run_wall_s,
+        "events_fired":       events_fired,
+        "sim_cycles":         sim_cycles,
+        "events_per_sec":     events_fired / run_wall_s if run_wall_s > 0 else 0.0,
+        "sim_cycles_per_sec": sim_cycles / run_wall_s if run_wall_s > 0 else 0.0,
+        "startup_s":          sum(p["time_s"] for p in phases.values()),
+        "peak_rss_mb":        rusage.ru_maxrss / 1024.0,  # ru_maxrss is in KB on Linux
+    }
+
+
+def run_workload(exe, sim_args, repetitions):
+    runs = []
+    with tempfile.TemporaryDirectory(prefix="sparta_perf_") as work_dir:
+        for _ in range(max(repetitions, 1)):
+            runs.append(run_once(exe, sim_args, work_dir))
+
+    for metric in DETERMINISTIC_METRICS:
+        values = set(r[metric] for r in runs)
+        if len(values) != 1:
+            raise RuntimeError(f"'{metric}' differs between repetitions of {sim_args}: {sorted(values)}. "
+                               "The simulation is not deterministic")
+
+    return {metric: statistics.median(r[metric] for r in runs) for metric in runs[0]}
+
+
+def compare(name, metrics, baseline, threshold, allow_behavior_change):
+    """Return a list of failure messages for one workload"""
+    failures = []
+    for metric in DETERMINISTIC_METRICS:
+        if metric in baseline and metrics[metric] != baseline[metric] and not allow_behavior_change:
+            failures.append(f"{name}: {metric} is {metrics[metric]}, baseline {baseline[metric]} "
+                            "(model behavior changed; regenerate the baseline)")
+    for metric, higher_is_better in COMPARED_METRICS.items():
+        base = baseline.get(metric)
+        if not base:
+            continue
+        change_pct = (metrics[metric] - base) / base * 100.0
+        worse_pct = -change_pct if higher_is_better else change_pct
+        status = "FAIL" if worse_pct > threshold else "ok"
+        print(f"  {name:24} {metric:20} {metrics[metric]:14.4g} baseline {base:14.4g} "
+              f"({change_pct:+6.1f}%) {status}")
+        if worse_pct > threshold:
+            failures.append(f"{name}: {metric} is {worse_pct:.1f}% worse than the baseline "
+                            f"(threshold {threshold}%)")
+    return failures
+
+
+def main():
+    args = parse_args()
+    exe = os.path.abspath(args.sim_exe_path)
+    if not os.path.exists(exe):
+        print(f"ERROR: {exe} does not exist")
+        return 2
+
+    results = {"insts": args.insts, "workloads": {}}
+    for num_cores in args.cores:
+        name = f"core_model_{num_cores}c_{args.insts}"
+        sim_args = ["-i", args.insts, "--num-cores", str(num_cores)]
+        print(f"Running {name} ({args.repetitions} repetitions)...")
+        metrics = run_workload(exe, sim_args, args.repetitions)
+        results["workloads"][name] = {"args": sim_args, "metrics": metrics}
+        print(f"  events/s {metrics['events_per_sec']:.4g}, cycles/s {metrics['sim_cycles_per_sec']:.4g}, "
+              f"startup {metrics['startup_s']:.3f}s, peak RSS {metrics['peak_rss_mb']:.1f}MB")
+
+    failures = []
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        print(f"Comparing against {args.baseline} (threshold {args.threshold}%)")
+        for name, result in results["workloads"].items():
+            if name not in baseline.get("workloads", {}):
+                print(f"  {name}: not in the baseline, skipped")
+                continue
+            failures += compare(name, result["metrics"], baseline["workloads"][name]["metrics"],
+                                args.threshold, args.allow_behavior_change)
+        results["failures"] = failures
+
+    if args.write_baseline:
+        with open(args.write_baseline, "w") as f:
+            json.dump({"insts": results["insts"], "workloads": results["workloads"]}, f, indent=2)
+        print(f"Wrote baseline {args.write_baseline}")
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(results, f, indent=2)
+
+    if failures:
+        print("Performance regressions:")
+        for failure in failures:
+            print("  " + failure)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -360,6 +360,13 @@ protected:
      * \brief The file to read from for reading in a final config file
      */
     std::string read_final_config_ = "";
+
+    /*!
+     * \brief Directory of ConfigImages reused across runs with the same
+     * arch, configuration and parameter inputs ("" if not caching)
+     */
+    std::string config_cache_dir_;
+
     /*!
      * \brief number of non-final configuration applications used to modify parameters.
      * A tally of all -p, --arch, --config-file. Does not include --read-final-config
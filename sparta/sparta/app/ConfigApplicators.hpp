@@ -219,6 +219,14 @@ public:
      * \brief Render this parameter action as a string
      */
     virtual std::string stringize() const = 0;
+
+    /*!
+     * \brief Files read by the latest applyUnbound (configuration files and
+     * the files they include). Empty for applicators which read no files
+     */
+    virtual std::vector<std::string> getConsumedFiles() const {
+        return {};
+    }
 };
 
 /*!
@@ -547,6 +555,11 @@ class NodeConfigFileApplicator : public ConfigApplicator
      */
     bool verbose_;
 
+    /*!
+     * \brief Files read by the latest applyUnbound
+     */
+    mutable std::vector<std::string> consumed_files_;
+
 public:
 
     NodeConfigFileApplicator(const std::string& loc_pattern,
@@ -608,9 +621,14 @@ public:
         sparta::ConfigParser::YAML param_file(filename_, include_paths_);
         param_file.allowMissingNodes(true);
         param_file.consumeParameters(&dummy, verbose);
+        consumed_files_ = param_file.getConsumedFiles();
         //param_file.getParameterTree().recursePrint(std::cout);
         ptree.create(loc_pattern_, false)->appendTree(param_file.getParameterTree().getRoot()); // Apply to existing ptree
     }
+
+    std::vector<std::string> getConsumedFiles() const override {
+        return consumed_files_;
+    }
 };
 
 /*!
@@ -635,6 +653,11 @@ class ArchNodeConfigFileApplicator : public ConfigApplicator
      */
     const std::vector<std::string> include_paths_;
 
+    /*!
+     * \brief Files read by the latest applyUnbound
+     */
+    mutable std::vector<std::string> consumed_files_;
+
 public:
 
     ArchNodeConfigFileApplicator(const std::string& loc_pattern,
@@ -670,9 +693,14 @@ public:
         sparta::ConfigParser::YAML param_file(filename_, include_paths_);
         param_file.allowMissingNodes(true);
         param_file.consumeParameters(&dummy, verbose);
+        consumed_files_ = param_file.getConsumedFiles();
         //param_file.getParameterTree().recursePrint(std::cout);
         ptree.create(loc_pattern_, false)->appendTree(param_file.getParameterTree().getRoot()); // Apply to existing ptree
     }
+
+    std::vector<std::string> getConsumedFiles() const override {
+        return consumed_files_;
+    }
 };
 
 
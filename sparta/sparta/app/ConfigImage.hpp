@@ -0,0 +1,165 @@
+// <ConfigImage> -*- C++ -*-
+
+
+/*!
+ * \file ConfigImage.hpp
+ * \brief Binary image of the unbound parameter trees built from a
+ * simulation's arch and configuration files
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "sparta/simulation/ParameterTree.hpp"
+
+namespace sparta {
+namespace app {
+
+/*!
+ * \class ConfigImage
+ * \brief Flattened snapshot of unbound ParameterTrees and of the files they
+ * were built from, which can be saved to and loaded from a binary file.
+ *
+ * Applying arch and configuration files parses YAML and merges each file
+ * into a ParameterTree, matching patterns against the nodes already in the
+ * tree. A ConfigImage stores the resulting trees node by node, keeping the
+ * order of children (and therefore the precedence of patterns), so that a
+ * later run with the same inputs can rebuild identical trees without
+ * parsing or merging anything.
+ *
+ * An image is saved with a key: a hash of every input other than file
+ * content (command line options, search paths, ...). The content of each
+ * file read is hashed into the image and checked when loading so that an
+ * edited file invalidates the image.
+ *
+ * Images are a cache local to a host: integers are stored in native byte
+ * order and values are kept as strings.
+ */
+class ConfigImage
+{
+public:
+
+    //! Initial value of hash
+    static constexpr uint64_t HASH_SEED = 0xcbf29ce484222325ull;
+
+    /*!
+     * \brief A file read while building the trees
+     */
+    struct Dependency
+    {
+        std::string filename;  //!< Name of the file as it was opened
+        uint64_t content_hash; //!< Hash of the file's content
+    };
+
+    /*!
+     * \brief 64-bit FNV-1a hash of \a data
+     * \param seed Hash to continue from, to hash several strings
+     */
+    static uint64_t hash(const std::string & data, uint64_t seed = HASH_SEED);
+
+    /*!
+     * \brief Hash the content of a file
+     * \return false if the file cannot be read
+     */
+    static bool hashFile(const std::string & filename, uint64_t & hash);
+
+    /*!
+     * \brief Construct an empty image
+     * \param key Hash of the inputs, other than files, the trees are built from
+     */
+    explicit ConfigImage(uint64_t key) :
+        key_(key)
+    { }
+
+    //! Key this image was created with
+    uint64_t getKey() const { return key_; }
+
+    /*!
+     * \brief Record a file which was read while building the trees.
+     * Files already recorded are ignored
+     * \throw SpartaException if the file cannot be read
+     */
+    void addDependency(const std::string & filename);
+
+    //! Files read while building the trees
+    const std::vector<Dependency> & getDependencies() const {
+        return dependencies_;
+    }
+
+    //! Are all dependencies still readable and unchanged?
+    bool isUpToDate() const;
+
+    //! Set a named string saved with the image (e.g. the arch name)
+    void setAttribute(const std::string & name, const std::string & value) {
+        attributes_[name] = value;
+    }
+
+    //! Get a named string saved with the image. "" if not set
+    std::string getAttribute(const std::string & name) const;
+
+    /*!
+     * \brief Flatten a tree into this image
+     * \return Index of the tree in this image
+     */
+    uint32_t addTree(const ParameterTree & tree);
+
+    //! Number of trees in this image
+    uint32_t getNumTrees() const {
+        return static_cast<uint32_t>(trees_.size());
+    }
+
+    /*!
+     * \brief Replace the content of \a tree with a tree of this image
+     * \param idx Index returned by addTree
+     * \post \a tree has the same nodes, values, origins and required
+     * counts, in the same order, as the tree which was added
+     */
+    void restoreTree(uint32_t idx, ParameterTree & tree) const;
+
+    /*!
+     * \brief Write this image to a file. The image is written to a
+     * temporary file which is then renamed so that other processes never
+     * read a partial image
+     * \throw SpartaException if the file cannot be written
+     */
+    void save(const std::string & filename) const;
+
+    /*!
+     * \brief Read an image from a file
+     * \return nullptr if the file does not exist, is not a valid image or
+     * was saved with a key other than \a key
+     * \note Does not check dependencies. See isUpToDate
+     */
+    static std::unique_ptr<ConfigImage> load(const std::string & filename, uint64_t key);
+
+private:
+
+    //! A ParameterTree::Node. Parents always precede their children
+    struct FlatNode
+    {
+        uint32_t parent;     //!< Index of the parent. The root (index 0) is its own parent
+        std::string name;
+        std::string value;
+        std::string origin;
+        bool has_value;
+        uint32_t required;   //!< Required count
+    };
+
+    typedef std::vector<FlatNode> FlatTree;
+
+    //! Append \a node and its subtree to \a flat
+    static void flatten_(const ParameterTree::Node * node, uint32_t parent, FlatTree & flat);
+
+    const uint64_t key_;
+    std::vector<Dependency> dependencies_;
+    std::map<std::string, std::string> attributes_;
+    std::vector<FlatTree> trees_;
+};
+
+} // namespace app
+} // namespace sparta
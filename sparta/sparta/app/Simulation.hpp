@@ -37,6 +37,7 @@ namespace sparta {
 
 class Clock;
 class MemoryProfiler;
+class StartupProfiler;
 
 namespace python {
     class PythonInterpreter;
@@ -740,6 +741,12 @@ protected:
      */
     std::shared_ptr<sparta::MemoryProfiler> memory_profiler_;
 
+    /*!
+     * \brief Startup time/heap profiler, if enabled. Active from buildTree
+     * until the end of finalizeTree
+     */
+    std::unique_ptr<sparta::StartupProfiler> startup_profiler_;
+
     /*!
      * \brief Repository of all reports for this simulation
      */
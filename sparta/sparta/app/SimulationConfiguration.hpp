@@ -79,6 +79,7 @@ public:
      * Values:
      *    "on" or "normal" -- write summary after simulation run
      *    "verbose"        -- write summary after simulation run with description
+     *                        and print the root clock cycles elapsed
      *    "off"            -- do nothing
      */
     std::string auto_summary_default = "off";
@@ -152,6 +153,25 @@ public:
                        const std::string & category,
                        const std::string & destination);
 
+    /*!
+     * \brief Save the unbound arch and configuration parameter trees built
+     * so far, with the files they were read from, to a ConfigImage file
+     * \param key Hash of all inputs other than files (see ConfigImage)
+     * \throw SpartaException if the image cannot be written
+     */
+    void saveConfigImage(const std::string & filename, uint64_t key) const;
+
+    /*!
+     * \brief Replace the unbound arch and configuration parameter trees with
+     * those saved by saveConfigImage instead of processing arch and
+     * configuration files
+     * \param key Hash of all inputs other than files (see ConfigImage)
+     * \return false (and this configuration is unchanged) if the file is
+     * not an image saved with this key or if any file it was built from has
+     * changed
+     */
+    bool loadConfigImage(const std::string & filename, uint64_t key);
+
     //! Was a final configuration file provided?
     bool hasFinalConfig() const { return !final_config_file_.empty(); }
 
@@ -278,6 +298,9 @@ public:
         if(archFileProvided()) {
             os << arch_applicator_->stringize();
         }
+        else if(!config_image_file_.empty()) {
+            os << "<from config image \"" << config_image_file_ << "\">";
+        }
         else {
             os << "<not provided>";
         }
@@ -336,6 +359,9 @@ public:
         for(auto & cp : config_applicators_) {
             os << "    " << cp->stringize() << '\n';
         }
+        if(!config_image_file_.empty()) {
+            os << "    Config image: \"" << config_image_file_ << "\"\n";
+        }
     }
 
     /*!
@@ -462,6 +488,24 @@ public:
      */
     bool validate_post_run = false;
 
+    /*!
+     * Number of threads used to prepare resources (invoke
+     * ResourceFactoryBase::prepareResource) when finalizing the tree.
+     * Parameters are still validated and resources created in tree order on
+     * the main thread
+     * \see RootTreeNode::setNumFinalizeThreads
+     */
+    uint32_t finalize_threads = 1;
+
+    /*!
+     * File to which the startup profile (time and heap growth per subtree
+     * for the build, configure, finalize and bind phases) is written once
+     * the tree is finalized. Written as JSON if the name ends in ".json" or
+     * to stdout if "1". Empty to disable
+     * \see sparta::StartupProfiler
+     */
+    std::string startup_profile_file;
+
     /*!
      * File to which warnings should be logged by default
      */
@@ -661,6 +705,9 @@ private:
     //! The created Node/Parameter applicators for informative messages
     ConfigVec     config_applicators_;
 
+    //! ConfigImage the unbound trees were loaded from ("" if none)
+    std::string config_image_file_;
+
     //
     ////////////////////////////////////////////////////////////////////////////////
 
@@ -0,0 +1,187 @@
+// <IdleSleeper.hpp> -*- C++ -*-
+
+
+/**
+ * \file   IdleSleeper.hpp
+ *
+ * \brief  File that defines the IdleSleeper class
+ */
+
+#pragma once
+
+#include <string>
+
+#include "sparta/events/EventNode.hpp"
+#include "sparta/events/Scheduleable.hpp"
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/ports/Port.hpp"
+#include "sparta/resources/Buffer.hpp"
+#include "sparta/resources/Scoreboard.hpp"
+#include "sparta/simulation/Clock.hpp"
+#include "sparta/statistics/Counter.hpp"
+#include "sparta/statistics/StatisticSet.hpp"
+#include "sparta/utils/SpartaAssert.hpp"
+
+namespace sparta
+{
+    /**
+     * \class IdleSleeper
+     * \brief Put a unit's per-cycle event to sleep until one of its
+     *        wake sources has work for it
+     *
+     * Many units schedule an event every cycle just to look for work.
+     * While such a unit is idle the Scheduler still has to stop on
+     * every cycle.  An IdleSleeper lets the unit declare what can give
+     * it work (InPorts, Buffers, ScoreboardView readiness) and stop
+     * rescheduling its event when it has none.  The event is scheduled
+     * again when a wake source fires, so the Scheduler can jump over
+     * the idle cycles in between.
+     *
+     * The unit's handler calls sleep() instead of rescheduling itself
+     * when it finds no work:
+     *
+     * \code
+     * MyUnit::MyUnit(sparta::TreeNode * node, const MyUnitParameterSet * p) :
+     *     sparta::Unit(node),
+     *     idle_sleeper_(getStatisticSet(), "tick", ev_tick_)
+     * {
+     *     idle_sleeper_.addWakeSource(in_req_);
+     *     idle_sleeper_.addWakeSource(req_buffer_);
+     * }
+     *
+     * void MyUnit::tick_()
+     * {
+     *     // ... process req_buffer_
+     *     if(req_buffer_.empty()) {
+     *         idle_sleeper_.sleep();
+     *     }
+     *     else {
+     *         ev_tick_.schedule(1);
+     *     }
+     * }
+     * \endcode
+     *
+     * A wake source wakes the event in the same cycle if it fires in
+     * an earlier SchedulingPhase than the event, as polling would have
+     * seen the work, and on the next cycle otherwise.  For example,
+     * data delivered on a port in PortUpdate wakes a Tick event in the
+     * same cycle but an Update event on the next one.  A DataInPort with
+     * no delay delivers in Tick, so it wakes a Tick event on the next
+     * cycle.
+     *
+     * Two counters are added to the given StatisticSet:
+     * <name>_idle_cycles_skipped (cycles the event did not fire
+     * because the unit was asleep) and <name>_wakeups.
+     */
+    class IdleSleeper
+    {
+    public:
+
+        /**
+         * \brief Create an IdleSleeper for the given event
+         * \param stats StatisticSet for the sleep counters
+         * \param name  Prefix of the counter names
+         * \param event The unit's per-cycle event (typically a UniqueEvent)
+         */
+        IdleSleeper(StatisticSet * stats,
+                    const std::string & name,
+                    EventNode & event) :
+            event_(event.getScheduleable()),
+            clk_(event.getClock()),
+            cycles_skipped_(stats, name + "_idle_cycles_skipped",
+                            "Cycles " + name + " did not fire because its unit was asleep",
+                            Counter::COUNT_NORMAL),
+            wakeups_(stats, name + "_wakeups",
+                     "Number of times " + name + " was woken from sleep",
+                     Counter::COUNT_NORMAL)
+        {
+            sparta_assert(clk_ != nullptr, "IdleSleeper " << name << ": the event has no clock");
+        }
+
+        IdleSleeper(const IdleSleeper &) = delete;
+        IdleSleeper & operator=(const IdleSleeper &) = delete;
+
+        //! Wake the event when data arrives on this port
+        void addWakeSource(InPort & in_port) {
+            in_port.registerArrivalCallback(CREATE_SPARTA_HANDLER(IdleSleeper, wake));
+        }
+
+        //! Wake the event when an entry is added to this Buffer
+        template<class DataT>
+        void addWakeSource(Buffer<DataT> & buffer) {
+            buffer.registerAppendCallback(CREATE_SPARTA_HANDLER(IdleSleeper, wake));
+        }
+
+        /**
+         * \brief Wake the event when the given registers become ready
+         * \param view    The ScoreboardView to watch
+         * \param bits    The registers to wait on
+         * \param inst_id The ID for the callback; see
+         *                ScoreboardView::clearCallbacks
+         *
+         * Like any ScoreboardView ready callback, this is a one-shot.
+         */
+        void wakeWhenReady(ScoreboardView & view,
+                           const Scoreboard::RegisterBitMask & bits,
+                           const Scoreboard::InstID inst_id)
+        {
+            view.registerReadyCallback(bits, inst_id,
+                                       [this](const Scoreboard::RegisterBitMask &) { wake(); });
+        }
+
+        /**
+         * \brief Put the event to sleep
+         *
+         * Call from the event's handler instead of scheduling it for
+         * the next cycle.  The event must not be scheduled again by
+         * the unit until it is woken.
+         */
+        void sleep() {
+            asleep_ = true;
+            sleep_cycle_ = clk_->currentCycle();
+        }
+
+        /**
+         * \brief Wake the event if it is asleep
+         *
+         * Can be called directly for wake sources not covered by
+         * addWakeSource.  Does nothing if the event is awake.
+         */
+        void wake() {
+            if(asleep_) {
+                const Scheduler * scheduler = clk_->getScheduler();
+                const bool later_phase = scheduler->isRunning() &&
+                    (scheduler->getCurrentSchedulingPhase() >= event_.getSchedulingPhase());
+                wake_(later_phase ? 1 : 0);
+            }
+        }
+
+        //! \return true if the event is asleep
+        bool isAsleep() const {
+            return asleep_;
+        }
+
+    private:
+
+        void wake_(Clock::Cycle delay) {
+            asleep_ = false;
+            const Clock::Cycle fire_cycle = clk_->currentCycle() + delay;
+
+            // Polling would have fired the event every cycle from the
+            // one after it went to sleep
+            if(fire_cycle > sleep_cycle_ + 1) {
+                cycles_skipped_ += fire_cycle - (sleep_cycle_ + 1);
+            }
+            ++wakeups_;
+            event_.schedule(delay, clk_);
+        }
+
+        Scheduleable & event_;
+        const Clock * clk_ = nullptr;
+        bool asleep_ = false;
+        Clock::Cycle sleep_cycle_ = 0;
+
+        Counter cycles_skipped_;
+        Counter wakeups_;
+    };
+}
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include "sparta/events/EventNode.hpp"
 #include "sparta/events/Scheduleable.hpp"
 #include "sparta/events/SchedulingPhases.hpp"
@@ -101,10 +102,12 @@ namespace sparta
                 reclaim_();
             }
 
-            // Set a payload for a delayed delivery
-            void setPayload_(const DataT & pl) {
+            // Set a payload for a delayed delivery.  An rvalue payload
+            // is moved into the proxy storage
+            template<class PayloadT>
+            void setPayload_(PayloadT && pl) {
                 sparta_assert(scheduled_ == false);
-                payload_ = new (&payload_storage_) DataT(pl);
+                payload_ = new (&payload_storage_) DataT(std::forward<PayloadT>(pl));
             }
 
             // Destroy payload
@@ -148,7 +151,8 @@ namespace sparta
 
 
         //! Allocate a delivering proxy for the payload.
-        ScheduleableHandle allocateProxy_(const DataT & dat)
+        template<class PayloadT>
+        ScheduleableHandle allocateProxy_(PayloadT && dat)
         {
             PayloadDeliveringProxy * proxy = nullptr;
             if(SPARTA_EXPECT_TRUE(free_idx_ != 0)) {
@@ -171,7 +175,7 @@ namespace sparta
                               " outstanding events -- does that seem right?");
             }
             proxy->setInFlightLocation_(inflight_pl_.emplace_back(proxy));
-            proxy->setPayload_(dat);
+            proxy->setPayload_(std::forward<PayloadT>(dat));
 
             return proxy;
         }
@@ -251,6 +255,21 @@ namespace sparta
             return allocateProxy_(payload);
         }
 
+        /**
+         * \brief Prepare a Scheduleable Payload for scheduling either
+         *        now or later, moving the payload into the event
+         * \param payload The payload to eventually deliver
+         * \return A handle the Scheduleable item.  Can be scheduled
+         *         now or sometime in the future
+         *
+         * Same as preparePayload(const DataT &), but the payload is
+         * move-constructed into the event's storage instead of
+         * copied.  Use this for payloads that are expensive to copy.
+         */
+        ScheduleableHandle preparePayload(DataT && payload) {
+            return allocateProxy_(std::move(payload));
+        }
+
         //! Overload precedence operator for PhasedPayloadEvents since they
         //! are not Scheduleables
         Scheduleable& operator>>(Scheduleable & consumer)
@@ -125,6 +125,14 @@ namespace sparta
          * link(v,w) will introduce an edge from source to dest, so
          * that source precedes dest (and after sort, source's group
          * ID will be less than dest's)
+         *
+         * Once the DAG is finalized, new links (for example, from
+         * units created by a DynamicResourceTreeNode) are added
+         * incrementally: only the vertices reachable from dest whose
+         * group IDs must grow are visited, and the Scheduler is told
+         * if the number of groups grows.  A link that would create a
+         * cycle is not added.  Links cannot be added while the
+         * Scheduler is running.
          */
 
         void link(Vertex *v, Vertex *w, const std::string & reason = "");
@@ -203,6 +211,10 @@ namespace sparta
         // Just mark one cycle for now...
         typename Vertex::VertexList getCycles_();
 
+        // Raise the group IDs of dest and the vertices after it
+        // after a link made once the DAG is finalized
+        void updateGroupsAfterLink_(Vertex * source, Vertex * dest);
+
         // Transfer Global Ordering Point GID's to associates
         void finalizeGOPs_()
         {
@@ -10,6 +10,7 @@
 #include <sstream>
 #include <memory>
 #include <vector>
+#include <unordered_set>
 
 namespace sparta
 {
@@ -37,19 +38,34 @@ public:
     /**
      * \brief Factory method to create new Vertices
      */
-    template<typename ...ArgTypes>
-    Edge* newFactoryEdge(ArgTypes&&... args)
+    Edge* newFactoryEdge(const Vertex * source, const Vertex * dest, const std::string & label)
     {
         Edge*   new_edge = nullptr;
-        edges_.emplace_back(new_edge = new Edge(std::forward<ArgTypes>(args)...));
+        edges_.emplace_back(new_edge = new Edge(source, dest, label));
+        edge_keys_.insert(edgeKey_(source, dest));
         return new_edge;
     }
 
+    //! \return true if there is an edge from source to dest
+    bool hasEdge(const Vertex * source, const Vertex * dest) const
+    {
+        return edge_keys_.count(edgeKey_(source, dest)) != 0;
+    }
+
     void removeEdge(const Edge* e);
     void dumpToCSV(std::ostream& os) const;
 
 private:
+    static uint64_t edgeKey_(const Vertex * source, const Vertex * dest)
+    {
+        return (uint64_t(source->getID()) << 32) | dest->getID();
+    }
+
     std::vector<std::unique_ptr<Edge>> edges_;
+
+    //! (source ID, dest ID) of every edge, so a duplicate link is
+    //! found without searching the source's edges
+    std::unordered_set<uint64_t> edge_keys_;
 };
 
 
@@ -251,9 +251,31 @@ private:
          * tick groups)
          */
         TickQuantum(uint32_t num_firing_groups) :
-            groups(num_firing_groups)
+            groups(num_firing_groups),
+            occupied_groups((num_firing_groups + 63) / 64, 0)
         { }
 
+        /**
+         * \brief Resize to the given number of firing groups, keeping
+         *        the last group (group zero) last
+         * \param num_firing_groups The new number of firing groups.
+         *                          Cannot be fewer than now.
+         */
+        void resizeGroups(uint32_t num_firing_groups) {
+            const uint32_t old_group_zero = groups.size() - 1;
+            const uint32_t new_group_zero = num_firing_groups - 1;
+            sparta_assert(new_group_zero >= old_group_zero);
+            groups.resize(num_firing_groups);
+            occupied_groups.resize((num_firing_groups + 63) / 64, 0);
+            if(new_group_zero != old_group_zero) {
+                std::swap(groups[old_group_zero], groups[new_group_zero]);
+                if(groups[new_group_zero].size() > 0) {
+                    markEmpty(old_group_zero);
+                    markOccupied(new_group_zero);
+                }
+            }
+        }
+
         /**
          * \brief Add an event to the timequantum
          * \param firing_group The Firing group (dag_group + 1) to add the
@@ -264,7 +286,7 @@ private:
             sparta_assert(firing_group > 0);
             sparta_assert(firing_group < groups.size());
             groups[firing_group].addScheduleable(scheduleable);
-            first_group_idx = std::min(first_group_idx, firing_group);
+            markOccupied(firing_group);
         }
 
         void addEventIfNotScheduled(uint32_t firing_group, Scheduleable * scheduleable) {
@@ -278,12 +300,45 @@ private:
                 }
             }
             grp.addScheduleable(scheduleable);
-            first_group_idx = std::min(first_group_idx, firing_group);
+            markOccupied(firing_group);
+        }
+
+        //! Mark the given firing group as having events
+        void markOccupied(uint32_t firing_group) {
+            occupied_groups[firing_group >> 6] |= (uint64_t(1) << (firing_group & 63));
+        }
+
+        //! Mark the given firing group as empty (after it is fired or cleared)
+        void markEmpty(uint32_t firing_group) {
+            occupied_groups[firing_group >> 6] &= ~(uint64_t(1) << (firing_group & 63));
+        }
+
+        /**
+         * \brief Find the first firing group with events at or after
+         *        the given group
+         * \param firing_group The group to start searching from
+         * \return The index of the group or groups.size() if there are
+         *         no more groups with events
+         */
+        uint32_t nextOccupiedGroup(uint32_t firing_group) const {
+            const uint32_t num_words = occupied_groups.size();
+            uint32_t word_idx = firing_group >> 6;
+            if(word_idx >= num_words) {
+                return groups.size();
+            }
+            uint64_t word = occupied_groups[word_idx] & (~uint64_t(0) << (firing_group & 63));
+            while(word == 0) {
+                if(++word_idx == num_words) {
+                    return groups.size();
+                }
+                word = occupied_groups[word_idx];
+            }
+            return (word_idx << 6) + static_cast<uint32_t>(__builtin_ctzll(word));
         }
 
         Tick               tick = 0; //!< The tick this quantum represents
         ScheduleableGroups groups;   //!< The list of firing groups. This is indexed by dag_group+1
-        uint32_t first_group_idx = std::numeric_limits<uint32_t>::max(); //!< The first group idx with events
+        std::vector<uint64_t> occupied_groups; //!< Bit per firing group, set if the group has events
         TickQuantum * next = nullptr;
     };
 
@@ -900,6 +955,9 @@ private:
     // The startup event adds itself to internal structures
     friend class StartupEvent;
 
+    // The DAG reports groups added after finalization
+    friend class DAG;
+
     /**
      * \brief A temporary queue used for "cranking" the simulation
      * \param event_del The event delegate to call
@@ -919,6 +977,10 @@ private:
     void throwPrecedenceIssue_(const Scheduleable * scheduleable, const uint32_t firing_group) const;
     const char * getScheduleableLabel_(const Scheduleable * sched) const;
 
+    //! Write the event about to fire to the debug and call trace
+    //! loggers (kept out of the run loop)
+    void logFiringEvent_(const Scheduleable * sched);
+
     /*!
      * \brief Determines whick tick quantum a new tick will land in
      * \param rel_time Relative time
@@ -927,6 +989,33 @@ private:
      */
     TickQuantum* determineTickQuantum_(Tick rel_time);
 
+    //! Get a TickQuantum from the allocator sized for the current
+    //! number of firing groups
+    TickQuantum* allocateTickQuantum_();
+
+    /**
+     * \brief Called by the DAG when links made after finalization
+     *        increase the number of groups
+     * \param dag_group_count The new number of DAG groups
+     *
+     * Group zero stays the last firing group, so events already
+     * scheduled there are moved to its new position.
+     */
+    void growDAGGroups_(uint32_t dag_group_count);
+
+    /**
+     * \brief Called by the DAG when links made after finalization
+     *        raise the group of a Scheduleable
+     * \param scheduleable The Scheduleable, already in its new group
+     * \param old_dag_group The group it was in when its pending
+     *                      events were scheduled
+     *
+     * Pending events are moved to the new firing group so they still
+     * fire after their new producers and isScheduled/cancelEvent can
+     * find them.  The old slots are replaced by the cancelled event.
+     */
+    void moveScheduledEvents_(const Scheduleable * scheduleable, uint32_t old_dag_group);
+
     //! The DAG used for grouping
     std::unique_ptr<DAG> dag_;
 
@@ -0,0 +1,233 @@
+// <StartupProfiler.hpp> -*- C++ -*-
+
+/**
+ * \file   StartupProfiler.hpp
+ * \brief  Records wall time and heap growth per TreeNode during the
+ *         startup phases of a simulation
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sparta {
+
+class TreeNode;
+
+/**
+ * \brief Utility which attributes the wall time and heap allocations of
+ *        simulator startup (build, configure, finalize and bind) to the
+ *        TreeNodes doing the work, and reports them per subtree.
+ *
+ * The framework opens a NodeScope around the per-node work it does in each
+ * phase: creating a ResourceTreeNode's parameters (build), configuring
+ * (configure), creating resources (finalize) and binding (bind). Costs are
+ * exclusive: work inside a nested scope (e.g. a resource constructor that
+ * creates child nodes) is charged to the nested node. Work done outside of
+ * any scope during a phase (e.g. in app::Simulation::bindTree_) is reported
+ * as unattributed for that phase.
+ *
+ * Heap usage is the growth of allocated bytes, measured with tcmalloc if
+ * SPARTA_TCMALLOC_SUPPORT is defined or with mallinfo2 on glibc.
+ * Elsewhere only time is reported.
+ *
+ * Only one profiler can be active at a time and it must only be used from
+ * the thread building the tree. When no profiler is active, a NodeScope
+ * costs one pointer check.
+ *
+ * See the command line option '--startup-profile'.
+ */
+class StartupProfiler
+{
+public:
+
+    //! Startup phases, in the order in which a simulation goes through them
+    enum class Phase {
+        Build = 0,
+        Configure,
+        Finalize,
+        Bind,
+        NUM_PHASES
+    };
+
+    //! Name of a phase (e.g. "build")
+    static const char * getPhaseName(Phase phase);
+
+    //! Cost of some work
+    struct Cost
+    {
+        std::chrono::nanoseconds time{0}; //!< Wall time
+        int64_t alloc_bytes = 0;          //!< Net growth of allocated heap bytes
+
+        Cost & operator+=(const Cost & other) {
+            time += other.time;
+            alloc_bytes += other.alloc_bytes;
+            return *this;
+        }
+    };
+
+    //! Costs of each phase
+    typedef std::array<Cost, static_cast<size_t>(Phase::NUM_PHASES)> PhaseCosts;
+
+    /**
+     * \brief Charges the work done during its lifetime, in the current phase,
+     *        to a node (excluding work in nested scopes). Has no effect if no
+     *        profiler is active or no phase has been entered
+     */
+    class NodeScope
+    {
+    public:
+        explicit NodeScope(const TreeNode * node) :
+            profiler_(active_)
+        {
+            if (profiler_) {
+                profiler_->openScope_(node);
+            }
+        }
+
+        ~NodeScope() {
+            if (profiler_) {
+                profiler_->closeScope_();
+            }
+        }
+
+        NodeScope(const NodeScope &) = delete;
+        NodeScope & operator=(const NodeScope &) = delete;
+
+    private:
+        StartupProfiler * const profiler_;
+    };
+
+    /**
+     * \brief Enters a phase of a (possibly null) profiler for its lifetime
+     */
+    class PhaseScope
+    {
+    public:
+        PhaseScope(StartupProfiler * profiler, Phase phase) :
+            profiler_(profiler),
+            phase_(phase)
+        {
+            if (profiler_) {
+                profiler_->enteringPhase(phase_);
+            }
+        }
+
+        ~PhaseScope() {
+            if (profiler_) {
+                profiler_->exitingPhase(phase_);
+            }
+        }
+
+        PhaseScope(const PhaseScope &) = delete;
+        PhaseScope & operator=(const PhaseScope &) = delete;
+
+    private:
+        StartupProfiler * const profiler_;
+        const Phase phase_;
+    };
+
+    StartupProfiler() = default;
+
+    //! Deactivates this profiler if it is active
+    ~StartupProfiler();
+
+    StartupProfiler(const StartupProfiler &) = delete;
+    StartupProfiler & operator=(const StartupProfiler &) = delete;
+
+    /**
+     * \brief Make this the profiler charged by NodeScopes
+     * \throw SpartaException if another profiler is active
+     */
+    void activate();
+
+    //! Stop charging NodeScopes to this profiler
+    void deactivate();
+
+    //! The active profiler, if any
+    static StartupProfiler * getActive() {
+        return active_;
+    }
+
+    //! Is heap usage measured on this platform?
+    static bool measuresAllocations();
+
+    /**
+     * \brief Start timing a phase. Phases can be entered more than once
+     * \throw SpartaException if another phase has been entered and not exited
+     */
+    void enteringPhase(Phase phase);
+
+    //! Stop timing a phase
+    void exitingPhase(Phase phase);
+
+    //! Total cost of each phase, including unattributed work
+    const PhaseCosts & getPhaseCosts() const {
+        return phase_costs_;
+    }
+
+    /**
+     * \brief Costs charged to \a node itself (not including its subtree)
+     * \return nullptr if nothing was charged to the node
+     */
+    const PhaseCosts * getNodeCosts(const TreeNode * node) const;
+
+    /**
+     * \brief Write a report of the costs of each phase and of each subtree
+     *        of \a root, with the children of each node sorted by decreasing
+     *        cost. Subtrees costing less than 0.1% of the total time and
+     *        allocations are omitted
+     */
+    void writeReport(std::ostream & os, const TreeNode * root) const;
+
+    /**
+     * \brief Write the costs of each phase and of each subtree of \a root with
+     *        a non-zero cost as JSON, with the children of each node sorted
+     *        by decreasing cost
+     */
+    void writeJSON(std::ostream & os, const TreeNode * root) const;
+
+    /**
+     * \brief Save the report to a file, as JSON if the filename ends in
+     *        ".json". A filename of "1" writes the report to stdout
+     * \throw SpartaException if the file cannot be opened
+     */
+    void saveReport(const std::string & filename, const TreeNode * root) const;
+
+private:
+
+    //! Subtree costs of a node, computed when reporting
+    struct SubtreeCosts;
+
+    //! Scope which has been opened but not closed
+    struct OpenScope
+    {
+        const TreeNode * node;
+        std::chrono::steady_clock::time_point start;
+        int64_t start_bytes;
+        Cost nested; //!< Cost of scopes nested in this one
+    };
+
+    void openScope_(const TreeNode * node);
+    void closeScope_();
+
+    //! Compute the costs of the subtree at \a node
+    void computeSubtree_(const TreeNode * node, SubtreeCosts & costs) const;
+
+    static StartupProfiler * active_;
+
+    std::unordered_map<const TreeNode *, PhaseCosts> node_costs_;
+    std::vector<OpenScope> open_scopes_;
+    PhaseCosts phase_costs_;
+    Phase current_phase_ = Phase::NUM_PHASES; //!< NUM_PHASES when not in a phase
+    std::chrono::steady_clock::time_point phase_start_;
+    int64_t phase_start_bytes_ = 0;
+};
+
+}
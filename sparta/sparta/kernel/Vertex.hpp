@@ -8,7 +8,8 @@
 #include <sstream>
 #include <memory>
 #include <list>
-#include <map>
+#include <set>
+#include <vector>
 
 #include "sparta/events/Scheduleable.hpp"
 
@@ -53,6 +54,16 @@ namespace sparta
             return label_;
         }
 
+        //! The vertex this edge starts from
+        const Vertex * getSource() const {
+            return source_;
+        }
+
+        //! The vertex this edge ends in
+        const Vertex * getDest() const {
+            return dest_;
+        }
+
         explicit operator std::string() const;
 
         void dumpToCSV(std::ostream& os, bool dump_header=false) const;
@@ -81,7 +92,6 @@ namespace sparta
     class Vertex
     {
 
-        typedef std::map<Vertex*, const Edge*>      EdgeMap;
         typedef std::list<Scheduleable*>            AssociateList;
 
     public:
@@ -95,6 +105,7 @@ namespace sparta
         static const PrecedenceGroup                INVALID_GROUP;
         typedef std::list<Vertex *>                 VertexList;
         typedef std::set<Vertex *>                  VertexSet;
+        typedef std::vector<Vertex *>               VertexVector;
 
 
         /**
@@ -209,6 +220,24 @@ namespace sparta
             }
         }
 
+        /**
+         * \brief Transfer the GroupID of this GOP again after a
+         *        link made after finalization raised it
+         * \return The associated Scheduleables, now in this GOP's group
+         */
+        const AssociateList & retransferGID() const
+        {
+            Scheduleable::PrecedenceGroup gid = getGroupID();
+            for (auto i : associates_) {
+                sparta_assert(i->isOrphan(),
+                            "GOPoint::retransferGID() -- Attempt to set GID " << gid
+                            << "on non-orphan object '" << i->getLabel()
+                            << "'");
+                i->setGroupID(gid);
+            }
+            return associates_;
+        }
+
         /**
          * \brief Have this Vertex precede another
          * \param consumer The Scheduleable to follow this Vertex
@@ -228,21 +257,23 @@ namespace sparta
         uint32_t getNumInboundEdgesForSorting() const { return sorted_num_inbound_edges_; }
         void setNumInboundEdgesForSorting(uint32_t edges) { sorted_num_inbound_edges_ = edges; }
 
-        const Edge* getEdgeTo(Vertex * w) const
+        //! Get the edge to the given vertex (a linear search; used
+        //! for reporting cycles)
+        const Edge* getEdgeTo(const Vertex * w) const
         {
-            const auto & ei = outbound_edge_map_.find(w);
-            if (ei == outbound_edge_map_.end()) {
-                return nullptr;
+            for (size_t i = 0; i < outbound_vertices_.size(); ++i) {
+                if (outbound_vertices_[i] == w) {
+                    return outbound_edges_[i];
+                }
             }
-            return ei->second;
+            return nullptr;
         }
 
-        // const EdgeMap & edges() const { return outbound_edge_map_; }
-        const VertexList & edges() const { return outbound_edge_list_; }
+        const VertexVector & edges() const { return outbound_vertices_; }
         const Scheduleable * getScheduleable() const { return scheduleable_; }
         void setScheduleable(Scheduleable * s) { scheduleable_ = s; }
-        EdgeMap::size_type numOutboundEdges() const { return outbound_edge_list_.size(); }
-        bool isOrphan() const { return ((num_inbound_edges_ == 0) && outbound_edge_list_.empty()); }
+        VertexVector::size_type numOutboundEdges() const { return outbound_vertices_.size(); }
+        bool isOrphan() const { return ((num_inbound_edges_ == 0) && outbound_vertices_.empty()); }
         bool isInDAG() const { return in_dag_; }
         void setInDAG(bool v) { in_dag_ = v; }
 
@@ -282,8 +313,8 @@ namespace sparta
         sparta::Scheduler*      my_scheduler_ = nullptr;
         uint32_t                id_ = 0;  // A unique global ID not associated with GroupID
         uint32_t                num_inbound_edges_ = 0;
-        EdgeMap                 outbound_edge_map_;             // MAP of outbound edges
-        VertexList              outbound_edge_list_;            // LIST of destination vertices
+        VertexVector            outbound_vertices_;             // Destination vertices
+        std::vector<const Edge*> outbound_edges_;               // Edges to outbound_vertices_ (same index)
         uint32_t                sorted_num_inbound_edges_ = num_inbound_edges_; // Number of inbound edges
         CycleMarker             marker_ = CycleMarker::WHITE;
         AssociateList           associates_;
@@ -298,7 +329,6 @@ namespace sparta
         label_(label)
     {
         id_ = global_id_++;
-        std::stringstream ss_id;
         if (label.empty()) {
             std::stringstream ss_lb;
             ss_lb << source->getLabel() << ":" << dest->getLabel();
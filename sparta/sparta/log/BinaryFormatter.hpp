@@ -0,0 +1,256 @@
+// <BinaryFormatter> -*- C++ -*-
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "sparta/log/Destination.hpp"
+
+/*!
+ * \file BinaryFormatter.hpp
+ * \brief Asynchronous binary log formatter (".log.bin") and the matching
+ * offline renderer which turns binary logs back into text
+ */
+
+namespace sparta
+{
+    namespace log
+    {
+        /*!
+         * \brief Byte ring shared by exactly one producer (the simulator
+         * thread holding the Destination write mutex) and one consumer (the
+         * writer thread). No locks are taken on either side.
+         */
+        class ByteRing
+        {
+        public:
+
+            /*!
+             * \brief Construct the ring
+             * \param capacity Size of the ring in bytes. Must be a power of 2
+             */
+            explicit ByteRing(uint64_t capacity) :
+                buf_(capacity),
+                mask_(capacity - 1)
+            {
+                sparta_assert(capacity != 0 && (capacity & mask_) == 0,
+                              "ByteRing capacity must be a power of 2, not " << capacity);
+            }
+
+            //! Number of bytes which can be pushed without waiting
+            uint64_t freeSpace() const {
+                return buf_.size() - (head_.load(std::memory_order_relaxed) -
+                                      tail_.load(std::memory_order_acquire));
+            }
+
+            //! Number of bytes available to the consumer
+            uint64_t available() const {
+                return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_relaxed);
+            }
+
+            /*!
+             * \brief Copy up to \a size bytes into the ring. Returns the
+             * number of bytes actually pushed (bounded by freeSpace)
+             * \note Producer side only
+             */
+            uint64_t push(const char* data, uint64_t size) {
+                const uint64_t n = std::min(size, freeSpace());
+                const uint64_t head = head_.load(std::memory_order_relaxed);
+                const uint64_t off = head & mask_;
+                const uint64_t first = std::min(n, buf_.size() - off);
+                std::memcpy(&buf_[off], data, first);
+                std::memcpy(&buf_[0], data + first, n - first);
+                head_.store(head + n, std::memory_order_release);
+                return n;
+            }
+
+            /*!
+             * \brief Write all available bytes to \a o and release them
+             * \return Number of bytes drained
+             * \note Consumer side only
+             */
+            uint64_t drainTo(std::ostream& o) {
+                const uint64_t n = available();
+                if(n == 0){
+                    return 0;
+                }
+                const uint64_t tail = tail_.load(std::memory_order_relaxed);
+                const uint64_t off = tail & mask_;
+                const uint64_t first = std::min(n, buf_.size() - off);
+                o.write(&buf_[off], first);
+                o.write(&buf_[0], n - first);
+                tail_.store(tail + n, std::memory_order_release);
+                return n;
+            }
+
+        private:
+            std::vector<char> buf_;
+            const uint64_t mask_;
+            alignas(64) std::atomic<uint64_t> head_{0}; //!< Total bytes pushed
+            alignas(64) std::atomic<uint64_t> tail_{0}; //!< Total bytes drained
+        };
+
+        /*!
+         * \brief Formatter writing compact binary records. Selected by the
+         * ".log.bin" file extension.
+         *
+         * Formatting and stream I/O are moved off of the simulator thread:
+         * write() only encodes a small record (times, origin node UID,
+         * interned category ID and the message content) into a lock-free
+         * ByteRing. A writer thread drains the ring into the stream in large
+         * chunks. Origin locations and category names are written once, as
+         * definition records, the first time they are seen.
+         *
+         * Use sparta_log_render (or BinaryLogRenderer) to convert the file
+         * into the text format produced by DefaultFormatter.
+         */
+        class BinaryFormatter : public Formatter
+        {
+        public:
+
+            //! Identifies the start of a binary log file
+            static constexpr char MAGIC[8] = {'S','P','L','O','G','B','I','N'};
+
+            //! Binary format version. Bump when a record layout changes
+            static constexpr uint32_t VERSION = 1;
+
+            //! Default size of the ring between the simulator and writer thread
+            static constexpr uint64_t DEFAULT_RING_BYTES = 1 << 22;
+
+            //! Value stored in place of a cycle when the origin has no clock
+            static constexpr uint64_t NO_CYCLE = ~uint64_t(0);
+
+            //! Record type tags. Each record begins with one of these bytes
+            enum RecordType : uint8_t {
+                REC_HEADER   = 0, //!< u32 length, header text
+                REC_LOCATION = 1, //!< u64 node uid, u32 length, location text
+                REC_CATEGORY = 2, //!< u32 category id, u32 length, category name
+                REC_MESSAGE  = 3  //!< See BinaryFormatter::write
+            };
+
+            BinaryFormatter(std::ostream& stream,
+                            uint64_t ring_bytes=DEFAULT_RING_BYTES);
+
+            //! Drains all pending records and joins the writer thread
+            ~BinaryFormatter();
+
+            /*!
+             * \brief Encode a message into the ring.
+             *
+             * Message record layout: u8 REC_MESSAGE, u64 sim time, u64 cycle
+             * (NO_CYCLE if no clock), f64 wall time, u64 origin node UID,
+             * u32 category id, u32 thread id, i64 sequence number,
+             * u32 content length, content bytes.
+             */
+            void write(const sparta::log::Message& msg) override;
+
+            void writeHeader(const SimulationInfo& sim_info) override;
+
+            /*!
+             * \brief Block until the writer thread has written every record
+             * encoded so far to the stream and the stream is flushed.
+             */
+            void flush() override;
+
+        private:
+
+            //! Writer thread body
+            void writerLoop_();
+
+            //! Push all of scratch_ into the ring, waiting on the writer if full
+            void commit_();
+
+            //! Rethrow an error raised in the writer thread, if any
+            void checkWriterError_();
+
+            template <typename T>
+            void put_(const T& val) {
+                const char* p = reinterpret_cast<const char*>(&val);
+                scratch_.insert(scratch_.end(), p, p + sizeof(T));
+            }
+
+            void putString_(const std::string& s) {
+                put_(static_cast<uint32_t>(s.size()));
+                scratch_.insert(scratch_.end(), s.begin(), s.end());
+            }
+
+            ByteRing ring_;
+            std::vector<char> scratch_; //!< Reused encoding buffer (producer side)
+
+            //! Nodes whose location has already been emitted
+            std::unordered_set<TreeNode::node_uid_type> known_nodes_;
+
+            //! Interned category string -> category id in this file
+            std::unordered_map<MessageInfo::category_id_type, uint32_t> categories_;
+
+            //! Bytes handed to the ring by the producer
+            uint64_t bytes_committed_ = 0;
+
+            //! Bytes written to the stream (and flushed) by the writer thread
+            std::atomic<uint64_t> bytes_written_{0};
+
+            std::atomic<bool> stop_{false};
+            std::exception_ptr writer_error_;
+            std::atomic<bool> writer_failed_{false};
+            std::thread writer_;
+        };
+
+        /*!
+         * \brief Renders a file written by BinaryFormatter back into the text
+         * formats produced by the text formatters.
+         */
+        class BinaryLogRenderer
+        {
+        public:
+
+            //! Text formats which can be reproduced from a binary log
+            enum class Format {
+                DEFAULT, //!< Same as DefaultFormatter
+                BASIC,   //!< Same as BasicFormatter
+                RAW      //!< Same as RawFormatter
+            };
+
+            /*!
+             * \brief Render an entire binary log
+             * \param in Stream positioned at the start of a ".log.bin" file
+             * \param out Stream receiving text lines
+             * \param fmt Text format to emit
+             * \return Number of messages rendered
+             * \throw SpartaException if the input is not a binary log or is
+             * truncated/corrupt
+             */
+            static uint64_t render(std::istream& in, std::ostream& out, Format fmt=Format::DEFAULT);
+
+            /*!
+             * \brief Write one message as a line of text in the given format
+             * \param cycle Clock cycle of the origin or
+             * BinaryFormatter::NO_CYCLE if the origin has no clock
+             * \note Newlines in content are removed as the text formatters do
+             */
+            static void writeMessage(std::ostream& out, Format fmt,
+                                     uint64_t sim_time, uint64_t cycle,
+                                     const std::string& location,
+                                     const std::string& category,
+                                     const std::string& content);
+
+            /*!
+             * \brief Convert a format name ("default", "basic", "raw") into
+             * a Format.
+             * \throw SpartaException if the name is not recognized
+             */
+            static Format parseFormat(const std::string& name);
+        };
+
+    } // namespace log
+} // namespace sparta
@@ -157,8 +157,9 @@ namespace sparta
 
                 ++num_msgs_received_;
 
-                // Filter by sequence. Get last sequence ID on this message's thread
-                seq_num_type last_seq = getLastSequenceNum_(msg.info.thread_id);
+                // Filter by sequence. Get last sequence ID on this message's
+                // thread with a single lookup (-1 if the thread is new)
+                seq_num_type& last_seq = last_seq_map_.emplace(msg.info.thread_id, -1).first->second;
                 if(msg.info.seq_num <= last_seq){
                     // Duplicate (same msg from a different tap), do not write
                     ++num_msg_duplicates_;
@@ -168,9 +169,20 @@ namespace sparta
                 ++num_msgs_written_;
                 write_(msg);
 
-                last_seq_map_[msg.info.thread_id] = msg.info.seq_num; // Update latest sequence
+                last_seq = msg.info.seq_num; // Update latest sequence
             };
 
+            /*!
+             * \brief Block until every message written so far has reached the
+             * underlying output stream. Only relevant for destinations which
+             * write asynchronously.
+             * \note This method IS thread-safe
+             */
+            void flush() {
+                std::lock_guard<std::mutex> lock(write_mutex_);
+                flush_();
+            }
+
             /*!
              * \brief Get the total number of messages logged through this
              * destination.
@@ -199,17 +211,6 @@ namespace sparta
 
         private:
 
-            //! Gets tthe last sequence number for this destintion for the given thread ID
-            //! \note This method is not thread-safe
-            seq_num_type getLastSequenceNum_(thread_id_type tid) const {
-
-                auto itr = last_seq_map_.find(tid);
-                if(itr != last_seq_map_.end()){
-                    return itr->second;
-                }
-                return -1;
-            };
-
             //! Write handler. Must be overridden by subclasses to serialize the log Message
             //! \pre Write mutex will be held on this destination
             //! Destinations will implement this method with a newline and flush (if applicable)
@@ -217,6 +218,10 @@ namespace sparta
             //! desired.
             virtual void write_(const sparta::log::Message& msg) = 0;
 
+            //! Flush handler. Overridden by destinations with buffered output
+            //! \pre Write mutex will be held on this destination
+            virtual void flush_() { }
+
 
             uint64_t num_msgs_received_;  //!< Total messages received
             uint64_t num_msgs_written_;   //!< Total messages written to the destination (received - duplicates)
@@ -269,6 +274,15 @@ namespace sparta
              */
             virtual void writeHeader(const SimulationInfo& sim_info) = 0;
 
+            /*!
+             * \brief Ensure all messages written so far have reached the
+             * stream. Formatters which buffer or write asynchronously must
+             * override this.
+             */
+            virtual void flush() {
+                stream_.flush();
+            }
+
             /*!
              * \brief Formatter list terminated with a Info having an empty name
              * which is interpreted as the default formatter.
@@ -524,6 +538,10 @@ namespace sparta
             virtual void write_(const sparta::log::Message& msg) override {
                 formatter_->write(msg);
             };
+
+            virtual void flush_() override {
+                formatter_->flush();
+            }
         };
 
 
@@ -597,6 +615,17 @@ namespace sparta
                 return new DestinationInstance<DestT>(arg);
             }
 
+            /*!
+             * \brief Flush every destination. Call this before reading a log
+             * file written by an asynchronous destination while the simulator
+             * is still running.
+             */
+            static void flushDestinations() {
+                for(auto& d : dests_){
+                    d->flush();
+                }
+            }
+
             /*!
              * \brief Returns vector containing all destinations
              */
@@ -2,10 +2,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <sstream>
+#include <streambuf>
 #include <utility>
 
 #include "sparta/simulation/TreeNode.hpp"
@@ -116,6 +120,116 @@ namespace sparta
             //! @{
             ////////////////////////////////////////////////////////////////////////
 
+            /*!
+             * \brief Stream buffer formatting directly into a reusable
+             * std::string. The string keeps its capacity between messages, so
+             * once it has grown to fit the typical message, building a message
+             * performs no heap allocation.
+             */
+            class FormatBuffer : public std::streambuf
+            {
+            public:
+
+                //! Initial capacity. Covers the vast majority of log messages
+                static constexpr std::size_t INITIAL_CAPACITY = 256;
+
+                FormatBuffer() {
+                    buf_.resize(INITIAL_CAPACITY);
+                    resetPut_(0);
+                }
+
+                /*!
+                 * \brief Trim the buffer to the formatted content and return it
+                 * \post Must call clear() before writing the next message
+                 */
+                const std::string& str() {
+                    buf_.resize(pptr() - pbase());
+                    return buf_;
+                }
+
+                //! Discard the content, keeping the allocated capacity
+                void clear() {
+                    buf_.resize(buf_.capacity());
+                    resetPut_(0);
+                }
+
+            protected:
+
+                int_type overflow(int_type ch) override {
+                    if(traits_type::eq_int_type(ch, traits_type::eof())){
+                        return traits_type::not_eof(ch);
+                    }
+                    grow_(1);
+                    *pptr() = traits_type::to_char_type(ch);
+                    pbump(1);
+                    return ch;
+                }
+
+                std::streamsize xsputn(const char* s, std::streamsize n) override {
+                    if(epptr() - pptr() < n){
+                        grow_(n);
+                    }
+                    std::memcpy(pptr(), s, n);
+                    pbump(static_cast<int>(n));
+                    return n;
+                }
+
+            private:
+
+                //! Grow so that at least n more bytes fit, preserving content
+                void grow_(std::streamsize n) {
+                    const std::size_t used = pptr() - pbase();
+                    buf_.resize(std::max(buf_.size() * 2, used + n));
+                    resetPut_(used);
+                }
+
+                void resetPut_(std::size_t used) {
+                    setp(&buf_[0], &buf_[0] + buf_.size());
+                    pbump(static_cast<int>(used));
+                }
+
+                std::string buf_;
+            };
+
+            /*!
+             * \brief ostream over a FormatBuffer which is reused by every
+             * message built on one thread. Constructing a std::ostream
+             * (locale, ios_base state) per message is the dominant cost of
+             * short log messages, so it is only done once per thread.
+             */
+            class FormatStream
+            {
+            public:
+
+                FormatStream() :
+                    os_(&buf_)
+                { }
+
+                std::ostream& stream() { return os_; }
+
+                FormatBuffer& buffer() { return buf_; }
+
+                /*!
+                 * \brief Discard content and restore default formatting so
+                 * manipulators from one message (e.g. std::hex) cannot leak
+                 * into the next
+                 */
+                void reset() {
+                    buf_.clear();
+                    os_.clear();
+                    os_.flags(std::ios_base::dec | std::ios_base::skipws);
+                    os_.fill(' ');
+                    os_.precision(6);
+                    os_.width(0);
+                }
+
+                bool in_use = false; //!< Owned by a live LogObject on this thread
+
+            private:
+                FormatBuffer buf_;
+                std::ostream os_;
+            };
+
             /*!
              * \brief Temporary object for constructing a log message with a
              * ostream-like interface. Emits a message to the message source
@@ -127,6 +241,11 @@ namespace sparta
              * insertions together just like cout waiting until the LogObject
              * is destroyed to actually send the message to its destination
              *
+             * The message is formatted into the calling thread's FormatStream,
+             * which is reused across messages, so the common case allocates
+             * nothing. If that stream is already held by another live
+             * LogObject on the same thread, this LogObject falls back to a
+             * private std::ostringstream.
              */
             class LogObject
             {
@@ -137,20 +256,46 @@ namespace sparta
                 const sparta::log::MessageSource* src_;
 
                 /*!
-                 * \brief Temporary string buffer
+                 * \brief Thread's reusable stream if this object owns it
                  */
-                std::ostringstream s_;
+                FormatStream* shared_ = nullptr;
+
+                /*!
+                 * \brief Private buffer used only when shared_ is unavailable
+                 */
+                std::unique_ptr<std::ostringstream> fallback_;
+
+                /*!
+                 * \brief Stream being formatted into (shared_ or fallback_)
+                 */
+                std::ostream* os_ = nullptr;
+
+                void acquire_() {
+                    shared_ = MessageSource::acquireFormatStream_();
+                    if(SPARTA_EXPECT_TRUE(shared_ != nullptr)){
+                        os_ = &shared_->stream();
+                    }else{
+                        fallback_.reset(new std::ostringstream);
+                        os_ = fallback_.get();
+                    }
+                }
 
             public:
 
                 //! \brief Not default-constructable
                 LogObject() = delete;
 
-                //! Move constructor
+                //! Move constructor. Takes over the buffer without copying
                 LogObject(LogObject&& rhp) :
                     src_(rhp.src_),
-                    s_(rhp.s_.str()) // May unfortunately involve a copy
-                { }
+                    shared_(rhp.shared_),
+                    fallback_(std::move(rhp.fallback_)),
+                    os_(rhp.os_)
+                {
+                    rhp.src_ = nullptr;
+                    rhp.shared_ = nullptr;
+                    rhp.os_ = nullptr;
+                }
 
                 //! \brief Not Copy-constructable
                 LogObject(const LogObject& rhp) = delete;
@@ -160,7 +305,9 @@ namespace sparta
                  */
                 LogObject(const MessageSource& src) :
                     src_(&src)
-                { }
+                {
+                    acquire_();
+                }
 
                 /*!
                  * \brief Construct with an initial value
@@ -169,7 +316,8 @@ namespace sparta
                 LogObject(const MessageSource& src, const T& init) :
                     src_(&src)
                 {
-                    s_ << init;
+                    acquire_();
+                    *os_ << init;
                 }
 
                 /*!
@@ -179,18 +327,25 @@ namespace sparta
                 LogObject(const MessageSource& src, std::ostream& (*f)(std::ostream&)) :
                     src_(&src)
                 {
-                    f(s_);
+                    acquire_();
+                    f(*os_);
                 }
 
                 /*!
                  * \brief Destructor
                  *
                  * Sends the message constructed within this object through
-                 * MessageSource::emit_
+                 * MessageSource::emit_ and releases the thread's stream
                  */
                 ~LogObject() {
-                    if(src_){
-                        src_->emit_(s_.str());
+                    if(shared_){
+                        if(src_){
+                            src_->emit_(shared_->buffer().str());
+                        }
+                        shared_->reset();
+                        shared_->in_use = false;
+                    }else if(src_ && fallback_){
+                        src_->emit_(fallback_->str());
                     }
                 }
 
@@ -205,11 +360,11 @@ namespace sparta
                  * \brief Insertion operator on this LogObject.
                  * \return This LogObject
                  *
-                 * Appends object to internal ostringstream
+                 * Appends object to the message being built
                  */
                 template <class T>
                 LogObject& operator<<(const T& t) {
-                    s_ << t;
+                    *os_ << t;
                     return *this;
                 }
 
@@ -217,7 +372,7 @@ namespace sparta
                  * \brief Handler for stream modifiers (e.g. endl)
                  */
                 LogObject& operator<<(std::ostream& (*f)(std::ostream&)) {
-                    f(s_);
+                    f(*os_);
                     return *this;
                 }
             };
@@ -255,6 +410,21 @@ namespace sparta
 
         private:
 
+            /*!
+             * \brief Hand out the calling thread's reusable FormatStream.
+             * It is per-thread rather than per-source because the global
+             * message sources can be logged to from several threads.
+             * \return nullptr if it is already owned by another LogObject
+             */
+            static FormatStream* acquireFormatStream_() {
+                static thread_local FormatStream format_stream;
+                if(SPARTA_EXPECT_FALSE(format_stream.in_use)){
+                    return nullptr;
+                }
+                format_stream.in_use = true;
+                return &format_stream;
+            }
+
             /*!
              * \brief Sends a message to the destination immediately. Also adds
              * data from this message source and simulator thread.
@@ -191,6 +191,7 @@ namespace sparta
                 bool allow_missing_nodes_;         //!< Allow missing nodes
                 bool write_to_default_;            //!< Write to default values instead of current values
                 ApplyFilterPredicate filter_predicate_; //!< Callback for applying the filter?
+                std::vector<std::string> included_files_; //!< Files read through include directives
 
             public:
 
@@ -266,6 +267,12 @@ namespace sparta
                     return ptree_;
                 }
 
+                //! Files read through include directives (directly or indirectly), in the
+                //! order in which they were read
+                const std::vector<std::string>& getIncludedFiles() const {
+                    return included_files_;
+                }
+
                 //! Dummy method that returns self in order to make log statements within code more readable.
                 EventHandler& verbose()
                 {
@@ -478,6 +485,7 @@ namespace sparta
                 allow_missing_nodes_(false),
                 filter_predicate_([](const TreeNode*){return true;})
             {
+                consumed_files_.emplace_back(filename_);
                 if(!fin_.is_open()){
                     if(include_search_dirs_.empty()){
                         include_search_dirs_.emplace_back(".");
@@ -486,6 +494,7 @@ namespace sparta
                         const std::string full_filename = search_dir + "/" + filename_;
                         fin_.open(full_filename, std::ios_base::in);
                         if (fin_.is_open()) {
+                            consumed_files_.back() = full_filename;
                             break;
                         }
                     }
@@ -583,6 +592,10 @@ namespace sparta
                     throw  ex;
                 }
 
+                consumed_files_.insert(consumed_files_.end(),
+                                       handler.getIncludedFiles().begin(),
+                                       handler.getIncludedFiles().end());
+
                 if(verbose){
                     std::cout << "Done reading parameters from \"" << filename_ << "\"" << std::endl;
                 }
@@ -592,6 +605,15 @@ namespace sparta
                 return ptree_;
             }
 
+            /*!
+             * \brief Files read by this parser: the file it was constructed
+             * with (as found in the include search directories) followed by
+             * all files included by it, directly or indirectly
+             */
+            const std::vector<std::string>& getConsumedFiles() const {
+                return consumed_files_;
+            }
+
         private:
 
             std::ifstream fin_;          //!< Input file stream. Opened at construction
@@ -601,6 +623,7 @@ namespace sparta
             std::vector<std::string> include_search_dirs_; //!< The include paths for include directives found in yaml files
             bool allow_missing_nodes_; //!< Allow missing TreeNodes when parsing
             ApplyFilterPredicate filter_predicate_; //!< Callback for applying the filter?
+            std::vector<std::string> consumed_files_; //!< Files read. See getConsumedFiles
 
         }; // class YAML
 
@@ -0,0 +1,208 @@
+// <BinaryPeventWriter> -*- C++ -*-
+
+
+/**
+ * \file BinaryPeventWriter.hpp
+ * \brief Binary pevent output. Pevent taps whose file name ends in ".bin"
+ * write through a BinaryPeventWriter instead of a text log destination.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "sparta/pairs/SpartaKeyPairs.hpp"
+#include "sparta/simulation/TreeNode.hpp"
+
+namespace sparta{
+namespace pevents{
+
+    /**
+     * \class BinaryPeventWriter
+     * \brief Writes pevents as binary records to one file.
+     *
+     * Each pevent type (one per collector writing to the file) is described
+     * once by a schema record holding the collector location, the pevent
+     * name and the key names/formatters of its PairDefinition. Every pevent
+     * is then a fixed-width record for its type: type id, tick, clock cycle,
+     * pevent cycle and one 9-byte slot per key. String values are interned
+     * and referenced by id, so no value is formatted during simulation.
+     *
+     * Use sparta_pevent_render (or BinaryPeventRenderer) to convert the
+     * file into the text format written by a text pevent tap.
+     *
+     * Writers are shared by all collectors tapping the same file and live
+     * until the end of the process, like log destinations.
+     */
+    class BinaryPeventWriter
+    {
+    public:
+
+        //! Identifies the start of a binary pevent file
+        static constexpr char MAGIC[8] = {'S','P','P','E','V','B','I','N'};
+
+        //! Binary format version. Bump when a record layout changes
+        static constexpr uint32_t VERSION = 1;
+
+        //! Value stored in place of a cycle when the collector has no clock
+        static constexpr uint64_t NO_CYCLE = ~uint64_t(0);
+
+        //! Maximum number of distinct string values interned per file.
+        //! Beyond this, strings are written inline (FIELD_INLINE_STRING)
+        static constexpr uint32_t MAX_INTERNED_STRINGS = 1 << 20;
+
+        //! Record type tags. Each record begins with one of these bytes
+        enum RecordType : uint8_t {
+            REC_HEADER = 0, //!< u32 length, header text
+            REC_SCHEMA = 1, //!< See registerEventType
+            REC_STRING = 2, //!< u32 string id, u32 length, string
+            REC_EVENT  = 3  //!< See writeEvent
+        };
+
+        //! Kind of each 9-byte key slot in an event record (u8 kind, u64 value)
+        enum FieldKind : uint8_t {
+            FIELD_ABSENT = 0,       //!< Key has no value; not printed
+            FIELD_NUMBER = 1,       //!< Value is the number
+            FIELD_STRING = 2,       //!< Value is an interned string id
+            FIELD_INLINE_STRING = 3 //!< Value is a length; string bytes follow the record
+        };
+
+        /**
+         * \brief Get the writer for a file, opening it on first request
+         * \throw SpartaException if the file cannot be opened
+         */
+        static BinaryPeventWriter* getWriter(const std::string& filename);
+
+        //! Should a pevent tap to this file be written in binary?
+        static bool isBinaryFile(const std::string& filename);
+
+        //! Flush every open writer (e.g. before reading a file mid-run)
+        static void flushAll();
+
+        explicit BinaryPeventWriter(const std::string& filename);
+
+        ~BinaryPeventWriter();
+
+        /**
+         * \brief Describe a pevent type.
+         *
+         * Schema record layout: u8 REC_SCHEMA, u32 type id, location,
+         * category, event name (each u32 length + bytes), u32 key count,
+         * then per key: name (u32 length + bytes), u8 PairFormatter.
+         *
+         * \return The type id to pass to writeEvent
+         */
+        uint32_t registerEventType(const TreeNode& origin,
+                                   const std::string& category,
+                                   const std::string& event_name,
+                                   const std::vector<std::string>& keys,
+                                   const PairFormatterVector& formats);
+
+        /**
+         * \brief Write one pevent with the values currently in \a cache.
+         *
+         * Event record layout: u8 REC_EVENT, u32 type id, u64 tick,
+         * u64 clock cycle of the collector (NO_CYCLE if none), u64 pevent
+         * cycle, then one slot per schema key (u8 FieldKind, u64 value),
+         * then the bytes of any FIELD_INLINE_STRING values in key order.
+         */
+        void writeEvent(uint32_t type_id,
+                        uint64_t tick,
+                        uint64_t clock_cycle,
+                        uint64_t pevent_cycle,
+                        const PairCache& cache);
+
+        //! Write buffered records to the file
+        void flush();
+
+        const std::string& getFilename() const { return filename_; }
+
+    private:
+
+        template <typename T>
+        void put_(const T& val) {
+            const char* p = reinterpret_cast<const char*>(&val);
+            buf_.insert(buf_.end(), p, p + sizeof(T));
+        }
+
+        void putString_(const std::string& s) {
+            put_(static_cast<uint32_t>(s.size()));
+            buf_.insert(buf_.end(), s.begin(), s.end());
+        }
+
+        //! Flush once the staging buffer holds this many bytes
+        static constexpr std::size_t FLUSH_THRESHOLD = 1 << 20;
+
+        const std::string filename_;
+        std::ofstream file_;
+        std::vector<char> buf_;   //!< Records staged for the next write
+        uint32_t num_types_ = 0;
+        std::unordered_map<std::string, uint32_t> strings_; //!< Interned string values
+        std::vector<const std::string*> inline_strings_;    //!< Scratch for writeEvent
+
+        static std::map<std::string, std::unique_ptr<BinaryPeventWriter>> writers_;
+    };
+
+    /**
+     * \class BinaryPeventTap
+     * \brief The set of binary files one pevent collector writes to. Used by
+     * PeventCollector and NestedPeventCollector next to their text log taps.
+     */
+    class BinaryPeventTap
+    {
+    public:
+
+        /**
+         * \brief Add a binary output file
+         * \return false if this collector already writes to the file
+         */
+        bool addFile(const std::string& filename);
+
+        bool empty() const { return writers_.empty(); }
+
+        /**
+         * \brief Write the current contents of \a cache as one pevent to
+         * every file, registering the event type with each writer on first
+         * use.
+         */
+        void write(const TreeNode& origin,
+                   const std::string& category,
+                   const std::string& event_name,
+                   const PairCache& cache,
+                   uint64_t pevent_cycle);
+
+    private:
+        static constexpr uint32_t UNREGISTERED = ~uint32_t(0);
+
+        //! Writer and the id of this collector's event type in that writer
+        std::vector<std::pair<BinaryPeventWriter*, uint32_t>> writers_;
+    };
+
+    /**
+     * \class BinaryPeventRenderer
+     * \brief Converts a binary pevent file back into the text written by a
+     * text pevent tap (default log formatter).
+     */
+    class BinaryPeventRenderer
+    {
+    public:
+        /**
+         * \brief Render an entire binary pevent file
+         * \return Number of pevents rendered
+         * \throw SpartaException if the input is not a binary pevent file or
+         * is truncated/corrupt
+         */
+        static uint64_t render(std::istream& in, std::ostream& out);
+    };
+
+} // namespace pevents
+} // namespace sparta
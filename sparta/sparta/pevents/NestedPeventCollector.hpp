@@ -13,6 +13,7 @@
 #include "sparta/pairs/SpartaKeyPairs.hpp"
 #include "sparta/pevents/PeventTreeNode.hpp"
 #include "sparta/log/MessageSource.hpp"
+#include "sparta/pevents/BinaryPeventWriter.hpp"
 #include "sparta/utils/MetaStructs.hpp"
 
 #include <boost/algorithm/string.hpp>
@@ -117,6 +118,11 @@ namespace pevents {
                 // Make sure they cannot add taps after the trigger has fired.
                 sparta_assert(running_ == false, "Cannot turnOn a pevent collector for which go() has already been called.");
 
+                // Binary pevent files are written directly from the pair cache
+                if(BinaryPeventWriter::isBinaryFile(file)) {
+                    return binary_tap_.addFile(file);
+                }
+
                 // only create a custom tap if we don't already have this one.
                 // we could potentially end up with duplicates since the user can turn collection
                 // on at treenodes that overlap
@@ -164,7 +170,7 @@ namespace pevents {
          * or the trigger is reached.
          */
         virtual void go() override final {
-            if(taps_.size() > 0) {
+            if(taps_.size() > 0 || !binary_tap_.empty()) {
                 running_ = true;
                 // Mark the pair collector running
                 turnOn_();
@@ -184,24 +190,33 @@ namespace pevents {
          */
         virtual void generateCollectionString_() override final {
 
-            // Write the pevent to the log.
-            std::stringstream ss;
+            const uint64_t cyc = f_skew_(clk_->currentCycle(), skew_);
+            if(!binary_tap_.empty()) {
+                binary_tap_.write(*this, message_src_.getCategoryName(), event_name_,
+                                  this->pair_cache_, cyc);
+            }
 
-            // Write the event name.
-            ss << "ev=" << "\"" << event_name_ << "\" ";
+            // Only format the text pevent if a log tap will receive it
+            if(message_src_.observed()) {
+                // Write the pevent to the log.
+                std::stringstream ss;
 
-            // Now write the cached key values.
-            for(const auto & pair : getPEventLogVector())
-            {
-                ss << pair.first << "=" << "\"" << pair.second << "\" ";
-            }
+                // Write the event name.
+                ss << "ev=" << "\"" << event_name_ << "\" ";
 
-            // Write the time
-            ss << "cyc=" << f_skew_(clk_->currentCycle(), skew_);
+                // Now write the cached key values.
+                for(const auto & pair : getPEventLogVector())
+                {
+                    ss << pair.first << "=" << "\"" << pair.second << "\" ";
+                }
+
+                // Write the time
+                ss << "cyc=" << cyc;
 
-            // Finish the line
-            ss << ";";
-            message_src_ << ss.str();
+                // Finish the line
+                ss << ";";
+                message_src_ << ss.str();
+            }
         }
 
     private:
@@ -214,6 +229,9 @@ namespace pevents {
         // Log taps that this pevent is being outputted too.
         std::vector<std::unique_ptr<log::Tap > > taps_;
 
+        // Binary pevent files this pevent is being outputted too.
+        BinaryPeventTap binary_tap_;
+
         // We do need a clock b/c each pevent records it's time.
         const Clock* clk_;
         std::function<uint64_t(const uint64_t &, const uint32_t &)> f_skew_;
@@ -13,6 +13,7 @@
 #include "sparta/pairs/SpartaKeyPairs.hpp"
 #include "sparta/pevents/PeventTreeNode.hpp"
 #include "sparta/log/MessageSource.hpp"
+#include "sparta/pevents/BinaryPeventWriter.hpp"
 #include <boost/algorithm/string.hpp>
 
 #define PEVENT_COLLECTOR_NOTE "_pevent"
@@ -136,6 +137,12 @@ namespace pevents{
                 // Make sure they cannot add taps after the trigger has fired.
                 sparta_assert(running_ == false, "Cannot turnOn a pevent collector for which go() has already been called.");
 
+                // Binary pevent files are written directly from the pair cache
+                if(BinaryPeventWriter::isBinaryFile(file))
+                {
+                    return binary_tap_.addFile(file);
+                }
+
                 // only create a custom tap if we don't already have this one.
                 // we could potentially end up with duplicates since the user can turn collection
                 // on at treenodes that overlap
@@ -192,7 +199,7 @@ namespace pevents{
         virtual void go() override final
         {
 
-            if(taps_.size() > 0)
+            if(taps_.size() > 0 || !binary_tap_.empty())
             {
                 running_ = true;
                 // Mark the pair collector running
@@ -211,22 +218,33 @@ namespace pevents{
          */
         virtual void generateCollectionString_() override
         {
-            // Write the pevent to the log.
-            std::stringstream ss;
-            // Write the event name.
-            ss << "ev=" << "\"" << event_name_ << "\" ";
-
-            // Now write the cached key values.
-            for(const auto & pair : getPEventLogVector())
+            const uint64_t cyc = f_skew_(clk_->currentCycle(), skew_);
+            if(!binary_tap_.empty())
             {
-                ss << pair.first << "=" << "\"" << pair.second << "\" ";
+                binary_tap_.write(*this, message_src_.getCategoryName(), event_name_,
+                                  this->pair_cache_, cyc);
             }
 
-            // Write the time
-            ss << "cyc=" << f_skew_(clk_->currentCycle(), skew_);
-            // Finish the line
-            ss << ";";
-            message_src_ << ss.str();
+            // Only format the text pevent if a log tap will receive it
+            if(message_src_.observed())
+            {
+                // Write the pevent to the log.
+                std::stringstream ss;
+                // Write the event name.
+                ss << "ev=" << "\"" << event_name_ << "\" ";
+
+                // Now write the cached key values.
+                for(const auto & pair : getPEventLogVector())
+                {
+                    ss << pair.first << "=" << "\"" << pair.second << "\" ";
+                }
+
+                // Write the time
+                ss << "cyc=" << cyc;
+                // Finish the line
+                ss << ";";
+                message_src_ << ss.str();
+            }
         }
 
         const std::string event_name_;
@@ -234,6 +252,8 @@ namespace pevents{
         log::MessageSource message_src_;
         // Log taps that this pevent is being outputted too.
         std::vector<std::unique_ptr<log::Tap > > taps_;
+        // Binary pevent files this pevent is being outputted too.
+        BinaryPeventTap binary_tap_;
         // We do need a clock b/c each pevent records it's time.
         const Clock* clk_;
         std::function<uint64_t(const uint64_t &, const uint32_t &)> f_skew_;
@@ -9,6 +9,12 @@
 
 #include <iostream>
 #include <fstream>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <unordered_set>
 #include <unordered_map>
 #include <tuple>
@@ -39,6 +45,14 @@ namespace sparta::pipeViewer
      * (Note) the last entry in the index file will always point to the last record
      * written to file.
      *
+     * Records are not written to the record file on the simulation
+     * thread. They are staged in large in-memory blocks which are handed
+     * to a writer thread once full, and at every index (heartbeat) so
+     * that a live pipeViewer sees all records up to the last heartbeat.
+     * The index file is flushed on every heartbeat and the record file
+     * whenever the writer thread catches up. Record file positions (for
+     * the index) are tracked by counting staged bytes, so the record
+     * stream is never queried during collection.
      */
     class Outputter
     {
@@ -62,6 +76,40 @@ namespace sparta::pipeViewer
             writeData_(ss, &data, sizeof(T));
         }
 
+        /**
+         * \brief Stage data for the record file. Hands the current block to
+         * the writer thread once it is full.
+         */
+        void writeRecord_(const char* const data, const std::size_t size)
+        {
+            record_block_.insert(record_block_.end(), data, data + size);
+            record_pos_ += size;
+            if(SPARTA_EXPECT_FALSE(record_block_.size() >= BLOCK_SIZE)) {
+                submitBlock_();
+            }
+        }
+
+        template<typename T>
+        void writeRecord_(const T* const data, const std::size_t size = sizeof(T))
+        {
+            writeRecord_(reinterpret_cast<const char* const>(data), size);
+        }
+
+        template<typename T>
+        void writeRecord_(const T& data)
+        {
+            writeRecord_(&data, sizeof(T));
+        }
+
+        //! Queue record_block_ for the writer thread and start a new block
+        void submitBlock_();
+
+        //! Writer thread body. Writes queued blocks to the record file
+        void writerLoop_();
+
+        //! Rethrow an error raised by the writer thread. Must hold block_mutex_
+        void checkWriterError_();
+
     public:
 
         /*!
@@ -72,6 +120,13 @@ namespace sparta::pipeViewer
          */
         static constexpr uint32_t FILE_VERSION = 2;
 
+        //! Size of the record blocks handed to the writer thread
+        static constexpr std::size_t BLOCK_SIZE = 4 * 1024 * 1024;
+
+        //! Number of full blocks which may wait for the writer thread
+        //! before the simulation thread blocks on it
+        static constexpr std::size_t MAX_PENDING_BLOCKS = 8;
+
         /**
          * \brief Construct an Outputter
          * \param file_path the path to the folder to store output files.
@@ -92,17 +147,19 @@ namespace sparta::pipeViewer
         template<class R_Type>
         void writeTransaction(const R_Type& dat)
         {
-            last_record_pos_ = record_file_.tellp();
+            last_record_pos_ = record_pos_;
 #ifdef PIPELINE_DBG
             std::cout << "writing transaction at: " << last_record_pos_ << " TMST: "
                       << dat.time_Start << " TMEN: " << dat.time_End <<  std::endl;
 #endif
-            writeData_(record_file_, dat);
+            writeRecord_(dat);
         }
 
         /**
          * \brief A method that marks a pointer to the record file's current location.
          * This method will likely be set to run on the schedular on a given interval.
+         * Hands the records staged so far to the writer thread and flushes
+         * the index file.
          */
         void writeIndex();
     private:
@@ -114,6 +171,16 @@ namespace sparta::pipeViewer
         std::ofstream display_format_file_;
 
         uint64_t last_record_pos_; /*!< A pointer to the last record written */
+        uint64_t record_pos_ = 0;  /*!< Size of the record file once all staged blocks are written */
+
+        std::vector<char> record_block_;              /*!< Block currently being filled */
+        std::deque<std::vector<char>> full_blocks_;   /*!< Blocks waiting for the writer thread */
+        std::vector<std::vector<char>> free_blocks_;  /*!< Written blocks available for reuse */
+        std::mutex block_mutex_;                      /*!< Guards the block queues and writer state */
+        std::condition_variable block_cond_;
+        bool stop_writer_ = false;
+        std::exception_ptr writer_error_;
+        std::thread writer_;
     };
 
     /*!
@@ -127,8 +194,8 @@ namespace sparta::pipeViewer
     {
 
         writeTransaction<transaction_t>(static_cast<transaction_t>(dat));
-        writeData_(record_file_, dat.length);
-        writeData_(record_file_, dat.annt.data(), dat.length);
+        writeRecord_(dat.length);
+        writeRecord_(dat.annt.data(), dat.length);
     }
 
     /*!
@@ -178,9 +245,8 @@ namespace sparta::pipeViewer
 
                     // We write the Value for field "i" and only write as much Bytes
                     // as it needs to by checking Sizes[i].
-                    writeData_(record_file_,
-                               &dat.valueVector[i].first,
-                               dat.sizeOfVector[i]);
+                    writeRecord_(&dat.valueVector[i].first,
+                                 dat.sizeOfVector[i]);
 
                     // We check if the value at field "i" has any String Representation.
                     // If it has, then its corresponding string vector field will not be empty.
@@ -205,8 +271,8 @@ namespace sparta::pipeViewer
                     // as it needs to by checking Sizes[i].
                     const auto& str = dat.stringVector[i];
                     const uint16_t length = str.size();
-                    writeData_(record_file_, length);
-                    writeData_(record_file_, str.data(), length);
+                    writeRecord_(length);
+                    writeRecord_(str.data(), length);
                 }
             }
             data_file_ << '\n';
@@ -229,9 +295,8 @@ namespace sparta::pipeViewer
                 if(dat.valueVector[i].second){
                     // We write the Value for field "i" and only write as much Bytes
                     // as it needs to by checking Sizes[i].
-                    writeData_(record_file_,
-                               &dat.valueVector[i].first,
-                               dat.sizeOfVector[i]);
+                    writeRecord_(&dat.valueVector[i].first,
+                                 dat.sizeOfVector[i]);
 
                     // We check if the value at field "i" has any String Representation.
                     // If it has, then its corresponding string vector field will not be empty.
@@ -253,8 +318,8 @@ namespace sparta::pipeViewer
                     // as it needs to by checking Sizes[i].
                     const auto& str = dat.stringVector[i];
                     const uint16_t length = str.size();
-                    writeData_(record_file_, length);
-                    writeData_(record_file_, str.data(), length);
+                    writeRecord_(length);
+                    writeRecord_(str.data(), length);
                 }
             }
         }
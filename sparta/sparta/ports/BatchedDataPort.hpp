@@ -0,0 +1,472 @@
+// <BatchedDataPort> -*- C++ -*-
+
+
+/**
+ * \file   BatchedDataPort.hpp
+ *
+ * \brief  File that defines BatchedData[In,Out]Port<DataT>
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "sparta/ports/Port.hpp"
+#include "sparta/events/EventSet.hpp"
+#include "sparta/events/PhasedPayloadEvent.hpp"
+#include "sparta/events/Scheduleable.hpp"
+
+namespace sparta
+{
+
+    //////////////////////////////////////////////////////////////////////
+    // Batched Data Ports
+    //////////////////////////////////////////////////////////////////////
+
+    // Forward declaration
+    template<class DataT>
+    class BatchedDataInPort;
+
+    /**
+     * \class PortBatch
+     * \brief Read-only view of the items delivered together by a
+     *        BatchedDataInPort, in the order they were sent.
+     *
+     * The view (and the items) are only valid for the duration of
+     * the consumer's handler.
+     */
+    template<class DataT>
+    class PortBatch
+    {
+    public:
+        typedef DataT value_type;
+        typedef const DataT * const_iterator;
+
+        PortBatch(const DataT * items, uint32_t size) :
+            items_(items), size_(size)
+        {}
+
+        const_iterator begin() const { return items_; }
+        const_iterator end()   const { return items_ + size_; }
+        uint32_t size()        const { return size_; }
+        bool empty()           const { return size_ == 0; }
+
+        const DataT & operator[](uint32_t idx) const {
+            sparta_assert(idx < size_, "PortBatch index " << idx << " out of range " << size_);
+            return items_[idx];
+        }
+
+    private:
+        const DataT * items_;
+        uint32_t      size_;
+    };
+
+    /**
+     * \class BatchedDataOutPort
+     *
+     * \brief A DataOutPort flavor for sending several items per cycle,
+     *        e.g. one per instruction in a fetch or dispatch group.
+     *
+     * Items sent on the same cycle with the same delay are collected
+     * by each bound BatchedDataInPort into one batch, delivered by a
+     * single scheduled event.  Where a DataOutPort/DataInPort pair
+     * schedules N events for N items, this pair schedules one.
+     *
+     * <br>
+     * Example:
+     * \code
+     *     sparta::BatchedDataOutPort<InstPtr> dispatch_out(&port_set, "dispatch_out");
+     *     sparta::BatchedDataInPort<InstPtr>  dispatch_in (&port_set, "dispatch_in", 1);
+     *     sparta::bind(dispatch_out, dispatch_in);
+     *
+     *     dispatch_in.registerConsumerHandler(
+     *         CREATE_SPARTA_HANDLER_WITH_DATA(MyClass, receiveInsts_, sparta::PortBatch<InstPtr>));
+     *
+     *     // Signature of handler:
+     *     //void MyClass::receiveInsts_(const sparta::PortBatch<InstPtr> & insts) {}
+     *
+     *     // Both delivered to receiveInsts_ next cycle in one batch
+     *     dispatch_out.send(inst0);
+     *     dispatch_out.send(inst1);
+     * \endcode
+     */
+    template<class DataT>
+    class BatchedDataOutPort final : public OutPort
+    {
+    public:
+        //! A typedef for the type of data this port passes.
+        typedef DataT DataType;
+
+        /**
+         * \brief Construct a BatchedDataOutPort within the given PortSet
+         * \param portset Name of the sparta::PortSet this port belongs to
+         * \param name Name of the port
+         * \param presume_zero_delay For precedence, presume a
+         *        zero-delay send() on this OutPort
+         */
+        BatchedDataOutPort(TreeNode* portset, const std::string & name,
+                           bool presume_zero_delay = true) :
+            OutPort(portset, name, presume_zero_delay)
+        {
+            sparta_assert(name.length() != 0, "You cannot have an unnamed port.");
+            sparta_assert(getClock() != nullptr, "BatchedDataOutPort '" << name << "' created without a clock");
+        }
+
+        //! No making copies!
+        BatchedDataOutPort(const BatchedDataOutPort &) = delete;
+
+        //! No making assignments!
+        BatchedDataOutPort & operator=(const BatchedDataOutPort &) = delete;
+
+        /**
+         * \brief Bind to a BatchedDataInPort
+         * \param in The BatchedDataInPort to bind to. The data types must be the same
+         */
+        void bind(Port * in) override
+        {
+            BatchedDataInPort<DataT> * inp;
+            if((inp = dynamic_cast<BatchedDataInPort<DataT> *>(in)) == 0) {
+                throw SpartaException("ERROR: Attempt to bind BatchedDataInPort of a disparate types: '" +
+                                      in->getLocation() + "' to '" + getLocation() + "'");
+            }
+            OutPort::bind(in);
+            bound_in_ports_.push_back(inp);
+        }
+
+        //! Promote base class bind method for references
+        using Port::bind;
+
+        /**
+         * \brief Add an item to the batch delivered \a rel_time cycles
+         *        (plus the port delay) from now
+         * \param dat The data to send
+         * \param rel_time The relative time for sending
+         */
+        void send(const DataT & dat, sparta::Clock::Cycle rel_time = 0)
+        {
+            sparta_assert(!bound_in_ports_.empty(),
+                          "ERROR! Attempt to send data on unbound port: " << getLocation());
+            for(BatchedDataInPort<DataT>* itr : bound_in_ports_) {
+                itr->send_(dat, rel_time);
+            }
+        }
+
+        /**
+         * \brief Add an item to the batch, moving it into the last (or
+         *        only) bound BatchedDataInPort
+         * \param dat The data to send.  Left in a moved-from state
+         * \param rel_time The relative time for sending
+         */
+        void send(DataT && dat, sparta::Clock::Cycle rel_time = 0)
+        {
+            sparta_assert(!bound_in_ports_.empty(),
+                          "ERROR! Attempt to send data on unbound port: " << getLocation());
+            const auto last = std::prev(bound_in_ports_.end());
+            for(auto itr = bound_in_ports_.begin(); itr != last; ++itr) {
+                (*itr)->send_(dat, rel_time);
+            }
+            (*last)->send_(std::move(dat), rel_time);
+        }
+
+        //! \brief Is there a batch to be delivered \a rel_cycle from now?
+        bool isDriven(Clock::Cycle rel_cycle) const override {
+            for(BatchedDataInPort<DataT>* itr : bound_in_ports_) {
+                if(itr->isDriven(rel_cycle)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        //! \brief Is there any batch not yet delivered?
+        bool isDriven() const override {
+            for(BatchedDataInPort<DataT>* itr : bound_in_ports_) {
+                if(itr->isDriven()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * \brief Cancel all batches not yet delivered
+         * \return The number of canceled items (could include duplicates if multiply bound)
+         */
+        uint32_t cancel()
+        {
+            uint32_t cancel_cnt = 0;
+            for(BatchedDataInPort<DataT>* itr : bound_in_ports_) {
+                cancel_cnt += itr->cancel();
+            }
+            return cancel_cnt;
+        }
+
+    private:
+        //! The bound BatchedDataIn ports
+        std::vector <BatchedDataInPort<DataT>*> bound_in_ports_;
+    };
+
+    /**
+     * \class BatchedDataInPort
+     * \brief Receives items sent by a BatchedDataOutPort, delivering
+     *        all items sent on the same cycle with the same delay to
+     *        the consumer handler in one call as a sparta::PortBatch.
+     *
+     * Delays and delivery phases behave as for sparta::DataInPort.
+     * Unlike a DataInPort, a zero-delay send is never delivered
+     * immediately (that would deliver one item at a time); the
+     * batch is delivered by an event in the delivery phase, which
+     * must follow the producers' events.
+     *
+     * Batch storage is recycled, so steady state sends do not
+     * allocate.
+     */
+    template<class DataT>
+    class BatchedDataInPort final : public InPort
+    {
+    public:
+
+        //! Expected typedef for DataT
+        typedef DataT DataType;
+
+        /**
+         * \brief Construct a BatchedDataInPort with a specific delivery phase
+         * \param portset Name of the sparta::PortSet this port belongs to
+         * \param name The name of the BatchedDataInPort
+         * \param delivery_phase The phase where the registered callback is called
+         * \param delay Delay added to the sender
+         */
+        BatchedDataInPort(TreeNode* portset, const std::string & name,
+                          sparta::SchedulingPhase delivery_phase, sparta::Clock::Cycle delay) :
+            InPort(portset, name, delivery_phase),
+            batched_in_port_events_(this),
+            port_delay_(delay)
+        {
+            receiver_clock_ = getClock();
+            sparta_assert(receiver_clock_ != nullptr,
+                          "BatchedDataInPort " << name << " does not have a clock");
+            sparta_assert(name.length() != 0, "You cannot have an unnamed port.");
+            scheduler_ = receiver_clock_->getScheduler();
+
+            batch_delivery_.reset(new PhasedPayloadEvent<uint32_t>(&batched_in_port_events_, name + "_batch_event",
+                                                                   delivery_phase,
+                                                                   CREATE_SPARTA_HANDLER_WITH_DATA(BatchedDataInPort<DataT>,
+                                                                                                   deliverBatch_, uint32_t)));
+        }
+
+        /**
+         * \brief Construct a BatchedDataInPort with a default delivery
+         *        phase based on the delay (Tick if 0, PortUpdate otherwise)
+         * \param portset Pointer to the portset to drop the port into
+         * \param name    The name of this port
+         * \param delay   Delay added to the sender
+         */
+        BatchedDataInPort(TreeNode* portset, const std::string & name, sparta::Clock::Cycle delay = 0) :
+            BatchedDataInPort(portset, name, (delay == 0 ? sparta::SchedulingPhase::Tick : sparta::SchedulingPhase::PortUpdate), delay)
+        {}
+
+        //! No making copies
+        BatchedDataInPort(const BatchedDataInPort &) = delete;
+
+        //! No assignments
+        BatchedDataInPort & operator=(const BatchedDataInPort &) = delete;
+
+        //! Check the Data types
+        void bind(Port * out) override
+        {
+            BatchedDataOutPort<DataT> * outp;
+            if((outp = dynamic_cast<BatchedDataOutPort<DataT> *>(out)) == 0) {
+                throw SpartaException("ERROR: Attempt to bind BatchedDataOutPort of a disparate types: '" +
+                                      out->getLocation() + "' to '" + getLocation() + "'");
+            }
+            InPort::bind(out);
+        }
+
+        //! Promote base class bind method for references
+        using Port::bind;
+
+        //! Get the port delay associated with this port
+        Clock::Cycle getPortDelay() const override final {
+            return port_delay_;
+        }
+
+        //! \brief Do events from this port keep simulation going?
+        void setContinuing(bool continuing) override final {
+            Port::setContinuing(continuing);
+            batch_delivery_->getScheduleable().setContinuing(continuing);
+        }
+
+        //! \brief Is there a batch to be delivered \a rel_cycle from now?
+        bool isDriven(Clock::Cycle rel_cycle) const override {
+            return batch_delivery_->isScheduled(rel_cycle);
+        }
+
+        //! \brief Is there any batch not yet delivered?
+        bool isDriven() const override {
+            return batch_delivery_->isScheduled();
+        }
+
+        /**
+         * \brief Cancel all batches not yet delivered
+         * \return The number of canceled items
+         */
+        uint32_t cancel()
+        {
+            batch_delivery_->cancel();
+            uint32_t cancel_cnt = 0;
+            for(uint32_t idx : open_batches_) {
+                cancel_cnt += batches_[idx].items.size();
+                releaseBatch_(idx);
+            }
+            open_batches_.clear();
+            return cancel_cnt;
+        }
+
+    private:
+
+        //! Items sent on one cycle for one delivery
+        struct Batch
+        {
+            Scheduler::Tick      send_tick = 0;
+            Clock::Cycle         delay = 0;
+            std::vector<DataT>   items;
+        };
+
+        Scheduleable & getScheduleable_() override final {
+            return batch_delivery_->getScheduleable();
+        }
+
+        void setProducerPrecedence_(Scheduleable * pd) override final {
+            if(pd->getSchedulingPhase() == batch_delivery_->getSchedulingPhase()) {
+                pd->precedes(batch_delivery_->getScheduleable(), "Port::bind of OutPort to " + getName() + ": '" +
+                             pd->getLabel() + "' is a registered driver");
+            }
+        }
+
+        void registerConsumerHandler_(const SpartaHandler & handler) override final
+        {
+            sparta_assert(handler.argCount() == 1,
+                          "BatchedDataInPort: " << getName()
+                          << ": The handler associated with the BatchedDataInPort must take one argument: "
+                          << handler.getName());
+            handler_name_ = getName() + "<BatchedDataInPort>[" + handler.getName() + "]";
+            batch_delivery_->getScheduleable().setLabel(handler_name_.c_str());
+        }
+
+        void bind_(Port * outp) override final
+        {
+            InPort::bind_(outp);
+            for(auto & consumer : port_consumers_)
+            {
+                if(consumer->getSchedulingPhase() == batch_delivery_->getSchedulingPhase()) {
+                    batch_delivery_->getScheduleable().precedes(consumer, "Port::bind(" + getName() + "->" + outp->getName() + "),'"
+                                                                + consumer->getLabel() + "' is registered consumer");
+                }
+            }
+        }
+
+        //! The BatchedDataOutPort will send the items over as well as bind
+        friend class BatchedDataOutPort<DataT>;
+
+        /*!
+         * \brief Called by BatchedDataOutPort.  Append the item to the
+         *        batch for this cycle and delay, scheduling the batch's
+         *        delivery if this is its first item.
+         */
+        template<class PayloadT>
+        void send_(PayloadT && dat, sparta::Clock::Cycle rel_time)
+        {
+            const Clock::Cycle total_delay = rel_time + port_delay_;
+            const Scheduler::Tick now = scheduler_->getCurrentTick();
+
+            // Senders typically use one or two distinct delays, so
+            // there are very few open batches
+            for(uint32_t idx : open_batches_) {
+                Batch & batch = batches_[idx];
+                if(batch.send_tick == now && batch.delay == total_delay) {
+                    batch.items.emplace_back(std::forward<PayloadT>(dat));
+                    return;
+                }
+            }
+
+            if(SPARTA_EXPECT_FALSE(total_delay == 0)) {
+                checkSchedulerPhaseForZeroCycleDelivery_(batch_delivery_->getSchedulingPhase());
+            }
+
+            const uint32_t idx = allocateBatch_();
+            Batch & batch = batches_[idx];
+            batch.send_tick = now;
+            batch.delay = total_delay;
+            batch.items.emplace_back(std::forward<PayloadT>(dat));
+            open_batches_.emplace_back(idx);
+            batch_delivery_->preparePayload(idx)->schedule(total_delay, receiver_clock_);
+        }
+
+        //! Delivery event handler: hand the batch to the consumer
+        void deliverBatch_(const uint32_t & idx)
+        {
+            for(auto itr = open_batches_.begin(); itr != open_batches_.end(); ++itr) {
+                if(*itr == idx) {
+                    open_batches_.erase(itr);
+                    break;
+                }
+            }
+            const Batch & batch = batches_[idx];
+            if(SPARTA_EXPECT_TRUE(explicit_consumer_handler_)) {
+                const PortBatch<DataT> view(batch.items.data(), batch.items.size());
+                explicit_consumer_handler_((const void*)&view);
+            }
+            releaseBatch_(idx);
+            notifyArrival_();
+        }
+
+        uint32_t allocateBatch_()
+        {
+            if(free_batches_.empty()) {
+                batches_.emplace_back();
+                return batches_.size() - 1;
+            }
+            const uint32_t idx = free_batches_.back();
+            free_batches_.pop_back();
+            return idx;
+        }
+
+        //! Clear the batch, keeping its capacity for reuse
+        void releaseBatch_(uint32_t idx)
+        {
+            batches_[idx].items.clear();
+            free_batches_.emplace_back(idx);
+        }
+
+        //! Event Set for this port
+        sparta::EventSet batched_in_port_events_;
+
+        //! Delivers a batch (by index into batches_)
+        std::unique_ptr<PhasedPayloadEvent<uint32_t>> batch_delivery_;
+
+        //! The handler name for scheduler debug
+        std::string handler_name_;
+
+        //! The receiving clock
+        const Clock * receiver_clock_ = nullptr;
+
+        //! All batches ever used; recycled through free_batches_.  A
+        //! deque so that the batch being delivered stays put if the
+        //! consumer sends more items to this port
+        std::deque<Batch> batches_;
+
+        //! Batches not yet delivered
+        std::vector<uint32_t> open_batches_;
+
+        //! Batches available for reuse
+        std::vector<uint32_t> free_batches_;
+
+        //! This port's additional delay for receiving the data
+        const Clock::Cycle port_delay_;
+    };
+}
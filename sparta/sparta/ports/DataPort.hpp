@@ -9,7 +9,9 @@
 
 #pragma once
 
+#include <iterator>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include "sparta/ports/Port.hpp"
@@ -44,7 +46,10 @@ namespace sparta
      * bind.
      *
      * The modeler must expect the data being sent to be _copied_ into
-     * the port for future (or immediate) delivery.
+     * the port for future (or immediate) delivery.  Data sent as an
+     * rvalue (e.g. <tt>send(std::move(data))</tt>) is instead moved
+     * into the last bound DataInPort; only the other bound DataInPorts
+     * receive copies.
      *
      * <br>
      * Example:
@@ -151,6 +156,27 @@ namespace sparta
             }
         }
 
+        /**
+         * \brief Send data to bound receivers, moving it into the last
+         *        (or only) bound DataInPort
+         * \param dat The data to send.  Left in a moved-from state
+         * \param rel_time The relative time for sending
+         *
+         * Same as send(const DataT &, sparta::Clock::Cycle), but avoids
+         * a copy of the data for the common case of a single bound
+         * DataInPort.  Every other bound DataInPort receives a copy.
+         */
+        void send(DataT && dat, sparta::Clock::Cycle rel_time = 0)
+        {
+            sparta_assert(!bound_in_ports_.empty(),
+                          "ERROR! Attempt to send data on unbound port: " << getLocation());
+            const auto last = std::prev(bound_in_ports_.end());
+            for(auto itr = bound_in_ports_.begin(); itr != last; ++itr) {
+                (*itr)->send_(dat, rel_time);
+            }
+            (*last)->send_(std::move(dat), rel_time);
+        }
+
         /*! \brief Determine if this DataOutPort has any connected
          *        DataInPort where the data is to be delivered on the
          *        given cycle.
@@ -500,8 +526,11 @@ namespace sparta
          * SchedulingPhase MUST be either equal to or greater than the
          * phase of the sender.  Otherwise, the user will get a
          * sparta::Scheduler precedence issue.
+         *
+         * An rvalue \a dat is moved into the delivery event.
          */
-        void send_(const DataT & dat, sparta::Clock::Cycle rel_time)
+        template<class PayloadT>
+        void send_(PayloadT && dat, sparta::Clock::Cycle rel_time)
         {
             const uint32_t total_delay = rel_time + port_delay_;
 
@@ -515,7 +544,7 @@ namespace sparta
                     return;
                 }
             }
-            user_payload_delivery_->preparePayload(dat)->schedule(total_delay, receiver_clock_);
+            user_payload_delivery_->preparePayload(std::forward<PayloadT>(dat))->schedule(total_delay, receiver_clock_);
         }
 
         //! Event Set for this port
@@ -540,6 +569,7 @@ namespace sparta
             if(SPARTA_EXPECT_TRUE(explicit_consumer_handler_)) {
                 explicit_consumer_handler_((const void*)&dat);
             }
+            notifyArrival_();
             if(SPARTA_EXPECT_FALSE(collector_ != nullptr)) {
                 if(SPARTA_EXPECT_FALSE(collector_->isCollected())) {
                     collector_->collect(dat);
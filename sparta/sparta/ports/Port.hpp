@@ -395,6 +395,24 @@ namespace sparta
             out->bind(this);
         }
 
+        /**
+         * \brief Register a handler called whenever data arrives on
+         *        this port, after the registered consumer handler
+         * \param handler A handler taking no arguments
+         *
+         * Unlike the consumer handler, any number of these can be
+         * registered.  Used to wake a sleeping consumer (see
+         * sparta::IdleSleeper).
+         */
+        void registerArrivalCallback(const SpartaHandler & handler)
+        {
+            sparta_assert(getDirection() == Direction::IN);
+            sparta_assert(handler.argCount() == 0,
+                          "Port " << getName() << ": arrival callback "
+                          << handler.getName() << " must not take arguments");
+            arrival_callbacks_.emplace_back(handler);
+        }
+
         /**
          * \brief Get the list of port tick consumers
          * \return The list of consumer of this Port
@@ -477,6 +495,19 @@ namespace sparta
         //! received by this port. Only valid on Direction::In ports.
         ScheduleableList port_consumers_;
 
+        //! Handlers called after data is received by this port
+        std::vector<SpartaHandler> arrival_callbacks_;
+
+        //! Call the arrival callbacks; derived ports call this after
+        //! delivering data to the consumer handler
+        void notifyArrival_() const {
+            if(SPARTA_EXPECT_FALSE(!arrival_callbacks_.empty())) {
+                for(const auto & handler : arrival_callbacks_) {
+                    handler();
+                }
+            }
+        }
+
         //! The scheduler used
         Scheduler * scheduler_ = nullptr;
 
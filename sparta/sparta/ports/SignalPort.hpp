@@ -306,6 +306,7 @@ namespace sparta
             if(SPARTA_EXPECT_TRUE(explicit_consumer_handler_)) {
                 explicit_consumer_handler_();
             }
+            notifyArrival_();
         }
 
         //! The handler name for scheduler debug
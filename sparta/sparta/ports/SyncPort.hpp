@@ -808,6 +808,7 @@ namespace sparta
                 if(SPARTA_EXPECT_TRUE(explicit_consumer_handler_)) {
                     explicit_consumer_handler_((const void*)&dat);
                 }
+                notifyArrival_();
 
                 // Show the data that has arrived on this OutPort that
                 // the receiver now sees
@@ -22,6 +22,7 @@
 #include "sparta/collection/IterableCollector.hpp"
 #include "sparta/statistics/Counter.hpp"
 #include "sparta/utils/IteratorTraits.hpp"
+#include "sparta/kernel/SpartaHandler.hpp"
 
 namespace sparta
 {
@@ -509,6 +510,21 @@ namespace sparta
             return capacity() - size();
         }
 
+        /**
+         * \brief Register a handler called after an entry is added to
+         *        the Buffer (push_back or insert)
+         * \param handler A handler taking no arguments
+         *
+         * Used to wake a sleeping consumer (see sparta::IdleSleeper).
+         */
+        void registerAppendCallback(const SpartaHandler & handler)
+        {
+            sparta_assert(handler.argCount() == 0,
+                          "Buffer '" << getName() << "': append callback "
+                          << handler.getName() << " must not take arguments");
+            append_callbacks_.emplace_back(handler);
+        }
+
         /**
          * \brief Append data to the end of Buffer, and return a BufferIterator
          * \param dat Data to be pushed back into the buffer
@@ -922,6 +938,16 @@ namespace sparta
             validator_->resizeIteratorValidator(resize_delta_, data_pool_);
         }
 
+        //! Call the append callbacks after an entry is added
+        void notifyAppend_() const
+        {
+            if(SPARTA_EXPECT_FALSE(!append_callbacks_.empty())) {
+                for(const auto & handler : append_callbacks_) {
+                    handler();
+                }
+            }
+        }
+
         template<typename U>
         iterator push_backImpl_(U&& dat)
         {
@@ -952,6 +978,7 @@ namespace sparta
             ++num_valid_;
             free_position_ = free_position_->next_free;
             updateUtilizationCounters_();
+            notifyAppend_();
 
             return entry;
         }
@@ -999,6 +1026,7 @@ namespace sparta
             ++num_valid_;
             free_position_ = free_position_->next_free;
             updateUtilizationCounters_();
+            notifyAppend_();
             return entry;
         }
 
@@ -1033,6 +1061,9 @@ namespace sparta
 
         //! A map which holds indexes from buffer_map_ to indexes in data_pool_.
         std::unordered_map<uint32_t, uint32_t> address_map_;
+
+        //! Handlers called after an entry is added
+        std::vector<SpartaHandler> append_callbacks_;
     };
 
     ////////////////////////////////////////////////////////////////////////////////
@@ -1088,7 +1119,8 @@ namespace sparta
         collector_(std::move(rval.collector_)),
         is_infinite_mode_(rval.is_infinite_mode_),
         resize_delta_(std::move(rval.resize_delta_)),
-        address_map_(std::move(rval.address_map_)){
+        address_map_(std::move(rval.address_map_)),
+        append_callbacks_(std::move(rval.append_callbacks_)){
         rval.clk_ = nullptr;
         rval.num_entries_ = 0;
         rval.data_pool_size_ = 0;
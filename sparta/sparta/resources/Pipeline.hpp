@@ -83,6 +83,59 @@ namespace sparta
         template<typename DataT2, typename EventT2>
         friend class Pipeline;
 
+    private:
+        /*!
+         * \class StageMask
+         * \brief One bit per pipeline stage, packed in 64-bit words so
+         *        that per-cycle scans skip whole runs of clear stages
+         */
+        class StageMask
+        {
+        public:
+            StageMask(const uint32_t num_stages, const bool value) :
+                words_((num_stages + 63) / 64, value ? ~uint64_t(0) : 0),
+                num_stages_(num_stages)
+            {
+                clearUnused_();
+            }
+
+            bool test(const uint32_t id) const {
+                return (words_[id >> 6] >> (id & 63)) & 1;
+            }
+
+            void set(const uint32_t id) {
+                words_[id >> 6] |= (uint64_t(1) << (id & 63));
+            }
+
+            void reset(const uint32_t id) {
+                words_[id >> 6] &= ~(uint64_t(1) << (id & 63));
+            }
+
+            //! Call func(stage_id) for every set stage, in stage order
+            template<typename FuncT>
+            void forEachSet(FuncT && func) const {
+                for (uint32_t w = 0; w < words_.size(); ++w) {
+                    uint64_t bits = words_[w];
+                    while (bits != 0) {
+                        func((w << 6) + static_cast<uint32_t>(__builtin_ctzll(bits)));
+                        bits &= (bits - 1);
+                    }
+                }
+            }
+
+        private:
+            void clearUnused_() {
+                if ((num_stages_ & 63) != 0) {
+                    words_.back() &= (uint64_t(1) << (num_stages_ & 63)) - 1;
+                }
+            }
+
+            std::vector<uint64_t> words_;
+            const uint32_t num_stages_;
+        };
+
+    public:
+
         /*!
          * \class PipelineIterator
          *
@@ -241,7 +294,10 @@ namespace sparta
             name_(name),
             clock_(clk),
             pipe_(name, num_stages, clk),
-            event_list_at_stage_(num_stages),
+            stage_event_offset_(num_stages + 1, 0),
+            has_events_at_stage_(num_stages, false),
+            events_valid_at_stage_(num_stages, false),
+            advance_into_stage_(num_stages, true),
             event_matrix_at_stage_(num_stages),
             es_((es == nullptr) ? &dummy_es_ : es),
             ev_pipeline_update_
@@ -257,8 +313,6 @@ namespace sparta
             static_assert(std::is_same_v<EventT, PhasedUniqueEvent> || std::is_same_v<EventT, PhasedPayloadEvent<DataT>>,
                           "Error: Pipeline is templated on a unsupported Event type. Supported Event types: "
                           "UniqueEvent, PayloaodEvent (where DataT == DataT of the Pipeline).");
-            events_valid_at_stage_.resize(num_stages, false);
-            advance_into_stage_.resize(num_stages, true);
 
             ev_pipeline_update_.setScheduleableClock(clk);
             ev_pipeline_update_.setScheduler(clk->getScheduler());
@@ -295,25 +349,33 @@ namespace sparta
             sparta_assert(static_cast<uint32_t>(default_precedence_) == static_cast<uint32_t>(Precedence::NONE),
                           "You have specified a default precedence (" << static_cast<uint32_t>(default_precedence_)
                           << ") between stages. No new handlers can be registered any more!");
-            sparta_assert(id < event_list_at_stage_.size(),
+            sparta_assert(id < num_stages_,
                           "Attempt to register handler for invalid pipeline stage[" << id << "]!");
 
-            // Create a new stage event handler, and add it to its event list
-            auto & event_list = event_list_at_stage_[id];
+            // Create a new stage event handler
+            const std::string event_idx = std::to_string(numEventsAtStage_(id));
             if constexpr (std::is_same_v<EventT, PhasedPayloadEvent<DataT>>) {
                 sparta_assert(handler.argCount() == 1, "Expecting Sparta Handler with 1 data parameter!");
-                event_list.emplace_back(new EventT(es_,
-                                            "pev_" + name_ + "_stage_" + std::to_string(id) + "_" + std::to_string(event_list_at_stage_[id].size()),
-                                            sched_phase,
-                                            handler));
+                owned_events_.emplace_back(new EventT(es_,
+                                                      "pev_" + name_ + "_stage_" + std::to_string(id) + "_" + event_idx,
+                                                      sched_phase,
+                                                      handler));
             } else {
                 sparta_assert(handler.argCount() == 0, "Expecting Sparta Handler with no data parameter!");
-                event_list.emplace_back(new EventT(es_,
-                                            "uev_" + name_ + "_stage_" + std::to_string(id) + "_" + std::to_string(event_list_at_stage_[id].size()),
-                                            sched_phase,
-                                            handler));
+                owned_events_.emplace_back(new EventT(es_,
+                                                      "uev_" + name_ + "_stage_" + std::to_string(id) + "_" + event_idx,
+                                                      sched_phase,
+                                                      handler));
             }
-            auto new_event = event_list.back().get();
+            auto new_event = owned_events_.back().get();
+
+            // Insert into the stage's firing list, after the stage's
+            // existing events
+            stage_events_.insert(stage_events_.begin() + stage_event_offset_[id + 1], new_event);
+            for (uint32_t i = id + 1; i <= num_stages_; ++i) {
+                ++stage_event_offset_[i];
+            }
+            has_events_at_stage_.set(id);
 
             // Set clock for this new event handler
             if constexpr (std::is_same_v<EventT, PhasedPayloadEvent<DataT>>) {
@@ -336,7 +398,7 @@ namespace sparta
                     producer_event->precedes(*new_event);
                 }
             } else {
-                events_valid_at_stage_[id] = true;
+                events_valid_at_stage_.set(id);
             }
 
             // Add the raw pointer of newly added event to the stage event list on 'sched_phase'
@@ -357,9 +419,9 @@ namespace sparta
                           "You have specified a default precedence (" << static_cast<uint32_t>(default_precedence_)
                           << "). No more precedence between stages can be set!");
             sparta_assert(pid != cid, "Cannot specify precedence with yourself!");
-            sparta_assert((pid < event_list_at_stage_.size()) && (event_list_at_stage_[pid].size() > 0),
+            sparta_assert((pid < num_stages_) && has_events_at_stage_.test(pid),
                           "Precedence setup fails: No handler for pipeline stage[" << pid << "]!");
-            sparta_assert((cid < event_list_at_stage_.size()) && (event_list_at_stage_[cid].size() > 0),
+            sparta_assert((cid < num_stages_) && has_events_at_stage_.test(cid),
                           "Precedence setup fails: No handler for pipeline stage[" << cid << "]!");
 
             for (uint32_t phase_id = 0; phase_id < NUM_SCHEDULING_PHASES; phase_id++) {
@@ -393,9 +455,9 @@ namespace sparta
         {
             sparta_assert(static_cast<void*>(&c_pipeline) != static_cast<void*>(this),
                           "Cannot use this function to set precedence between stages within the same pipeline instance!");
-            sparta_assert((pid < event_list_at_stage_.size()) && (event_list_at_stage_[pid].size() > 0),
+            sparta_assert((pid < num_stages_) && has_events_at_stage_.test(pid),
                           "Precedence setup fails: No handler for pipeline stage[" << pid << "]!");
-            sparta_assert((cid < c_pipeline.event_list_at_stage_.size()) && (c_pipeline.event_list_at_stage_[cid].size() > 0),
+            sparta_assert((cid < c_pipeline.num_stages_) && c_pipeline.has_events_at_stage_.test(cid),
                           "Precedence setup fails: No handler for pipeline stage[" << cid << "]!");
 
             for (uint32_t phase_id = 0; phase_id < NUM_SCHEDULING_PHASES; phase_id++) {
@@ -435,10 +497,10 @@ namespace sparta
 
             uint32_t pid = 0;
             uint32_t cid = pid + 1;
-            while (cid < event_list_at_stage_.size()) {
-                if (event_list_at_stage_[pid].empty()) {
+            while (cid < num_stages_) {
+                if (!has_events_at_stage_.test(pid)) {
                     ++pid;
-                } else if (event_list_at_stage_[cid].empty()) {
+                } else if (!has_events_at_stage_.test(cid)) {
                     ++cid;
                 } else {
                     if (forward) {
@@ -501,7 +563,7 @@ namespace sparta
         template<typename EventType>
         void setProducerForStage(const uint32_t & id, EventType & ev_handler)
         {
-            sparta_assert((id < event_list_at_stage_.size()) && (event_list_at_stage_[id].size() > 0),
+            sparta_assert((id < num_stages_) && has_events_at_stage_.test(id),
                           "Precedence setup fails: No handler for pipeline stage[" << id << "]!");
 
             auto phase_id = static_cast<uint32_t>(ev_handler.getScheduleable().getSchedulingPhase());
@@ -525,7 +587,7 @@ namespace sparta
         template<typename EventType>
         void setConsumerForStage(const uint32_t & id, EventType & ev_handler)
         {
-            sparta_assert((id < event_list_at_stage_.size()) && (event_list_at_stage_[id].size() > 0),
+            sparta_assert((id < num_stages_) && has_events_at_stage_.test(id),
                           "Precedence setup fails: No handler for pipeline stage[" << id << "]!");
 
             auto phase_id = static_cast<uint32_t>(ev_handler.getScheduleable().getSchedulingPhase());
@@ -571,10 +633,10 @@ namespace sparta
          *       registered with any event.
          */
         bool isEventRegisteredAtStage(const uint32_t & id) const {
-            sparta_assert(id < event_list_at_stage_.size(),
+            sparta_assert(id < num_stages_,
                           "Attempt to check event handler for invalid pipeline stage[" << id << "]!");
 
-            return (event_list_at_stage_[id].size() > 0);
+            return has_events_at_stage_.test(id);
         }
 
         /*!
@@ -588,12 +650,12 @@ namespace sparta
          */
         void activateEventAtStage(const uint32_t & id)
         {
-            sparta_assert(id < event_list_at_stage_.size(),
+            sparta_assert(id < num_stages_,
                           "Attempt to activate event handler for invalid pipeline stage[" << id << "]!");
-            sparta_assert((event_list_at_stage_[id].size() > 0),
+            sparta_assert(has_events_at_stage_.test(id),
                           "Activation fails: No registered event handler for stage[" << id << "]!");
 
-            events_valid_at_stage_[id] = true;
+            events_valid_at_stage_.set(id);
         }
 
         /*!
@@ -606,12 +668,12 @@ namespace sparta
          */
         void deactivateEventAtStage(const uint32_t & id)
         {
-            sparta_assert(id < event_list_at_stage_.size(),
+            sparta_assert(id < num_stages_,
                           "Attempt to deactivate event handler for invalid pipeline stage[" << id << "]!");
-            sparta_assert((event_list_at_stage_[id].size() > 0),
+            sparta_assert(has_events_at_stage_.test(id),
                           "Deactivation fails: No registered event handler for stage[" << id << "]!");
 
-            events_valid_at_stage_[id] = false;
+            events_valid_at_stage_.reset(id);
         }
 
         /*!
@@ -1004,7 +1066,7 @@ namespace sparta
             // The stage before the stall cannot advance because the stall stage is occupied
             // So, there are two useless loops here
             while (stage_id > 0) {
-                if (advance_into_stage_[stage_id - 1] &&
+                if (advance_into_stage_.test(stage_id - 1) &&
                     !pipe_.isValid(stage_id) && pipe_.isValid(stage_id - 1)) {
                     pipe_.writePS(stage_id, pipe_.access(stage_id - 1));
                     pipe_.invalidatePS(stage_id - 1);
@@ -1026,31 +1088,34 @@ namespace sparta
         {
             sparta_assert(stage_id < num_stages_,
                           "Try to cancel events for invalid pipeline stage[" << stage_id << "]");
-            if (pipe_.isValid(stage_id) && events_valid_at_stage_[stage_id]) {
-                sparta_assert(event_list_at_stage_[stage_id].size());
-                for (const auto & ev_ptr :  event_list_at_stage_[stage_id]) {
-                    ev_ptr->cancel(sparta::Clock::Cycle(0));
+            if (pipe_.isValid(stage_id) && events_valid_at_stage_.test(stage_id)) {
+                sparta_assert(numEventsAtStage_(stage_id));
+                for (uint32_t e = stage_event_offset_[stage_id]; e < stage_event_offset_[stage_id + 1]; ++e) {
+                    stage_events_[e]->cancel(sparta::Clock::Cycle(0));
                 }
             }
         }
 
-        //! Schedule events for active pipeline stages
+        //! Schedule events for active pipeline stages.  Only stages
+        //! with active events are visited
         void scheduleEventForEachStage_()
         {
-            sparta_assert(num_stages_ == event_list_at_stage_.size());
-
-            for (uint32_t i = 0; i < num_stages_; i++) {
-                if (pipe_.isValid(i) && events_valid_at_stage_[i]) {
-                    sparta_assert(event_list_at_stage_[i].size());
-                    for (const auto & ev_ptr :  event_list_at_stage_[i]) {
+            events_valid_at_stage_.forEachSet([this](const uint32_t i) {
+                if (pipe_.isValid(i)) {
+                    for (uint32_t e = stage_event_offset_[i]; e < stage_event_offset_[i + 1]; ++e) {
                         if constexpr (std::is_same_v<EventT, PhasedPayloadEvent<DataT>>) {
-                            ev_ptr->preparePayload(at(i))->schedule(sparta::Clock::Cycle(0));
+                            stage_events_[e]->preparePayload(at(i))->schedule(sparta::Clock::Cycle(0));
                         } else {
-                            ev_ptr->schedule(sparta::Clock::Cycle(0));
+                            stage_events_[e]->schedule(sparta::Clock::Cycle(0));
                         }
                     }
                 }
-            }
+            });
+        }
+
+        //! Number of events registered at a stage
+        uint32_t numEventsAtStage_(const uint32_t id) const {
+            return stage_event_offset_[id + 1] - stage_event_offset_[id];
         }
 
         //! Deactivate the pipeline stage handling events up to the stall causing stage
@@ -1067,10 +1132,10 @@ namespace sparta
                     return; // bubble, crush it by allowing earlier stages to advance
                 }
 
-                if (suppress_events && event_list_at_stage_[stage_id].size() > 0) {
-                    events_valid_at_stage_[stage_id] = false;
+                if (suppress_events && has_events_at_stage_.test(stage_id)) {
+                    events_valid_at_stage_.reset(stage_id);
                 }
-                advance_into_stage_[stage_id] = false;
+                advance_into_stage_.reset(stage_id);
             }
         }
 
@@ -1080,10 +1145,10 @@ namespace sparta
             for (uint32_t stage_id = 0; stage_id <= stall_stage_id; stage_id++) {
                 sparta_assert(stage_id < num_stages_,
                               "Try to restart invalid pipeline stage[" << stage_id << "]");
-                if (event_list_at_stage_[stage_id].size() > 0) {
-                    events_valid_at_stage_[stage_id] = true;
+                if (has_events_at_stage_.test(stage_id)) {
+                    events_valid_at_stage_.set(stage_id);
                 }
-                advance_into_stage_[stage_id] = true;
+                advance_into_stage_.set(stage_id);
             }
         }
 
@@ -1096,18 +1161,29 @@ namespace sparta
         //! Internal data movement pipe
         sparta::Pipe<DataT> pipe_;
 
-        //! A vector of pipeline stage event handler pointers
-        std::vector<EventHandleList> event_list_at_stage_;
+        //! All pipeline stage event handlers, in registration order
+        std::vector<EventHandle> owned_events_;
         // NOTE:
         // (1) One advantage of using PhasedUniqueEvent instead of UnqiueEvent is:
         //     The pipeline stage events could potentially be scheduled in different phases.
         // (2) Scheduleable also works, but EventNode doesn't work (no scheduleable)
-        //     std::vector<std::unique_ptr<Scheduleable>> event_list_at_stage_; // OK
-        //     std::vector<std::unique_ptr<EventNode>> event_list_at_stage_; // oops
+        //     std::vector<std::unique_ptr<Scheduleable>> owned_events_; // OK
+        //     std::vector<std::unique_ptr<EventNode>> owned_events_; // oops
+
+        //! Stage event handlers grouped by stage, in registration order
+        //! within a stage.  Events of stage i are
+        //! stage_events_[stage_event_offset_[i] .. stage_event_offset_[i+1])
+        std::vector<EventT*> stage_events_;
+        std::vector<uint32_t> stage_event_offset_;
+
+        //! Stages with at least one registered event handler
+        StageMask has_events_at_stage_;
+
+        //! Valid/active bits for pipeline stage events
+        StageMask events_valid_at_stage_;
 
-        //! A vector of valid/active bits for pipeline stage events
-        std::vector<bool> events_valid_at_stage_;
-        std::vector<bool> advance_into_stage_;
+        //! Stages that data may advance into while stalled
+        StageMask advance_into_stage_;
 
         //! A vector of event index matrix for every pipeline stage
         std::vector<EventMatrix> event_matrix_at_stage_;
@@ -7,6 +7,11 @@
 
 #pragma once
 
+#include <array>
+#include <bitset>
+#include <functional>
+#include <limits>
+#include <utility>
 #include <vector>
 #include <cinttypes>
 #include <string>
@@ -296,26 +301,71 @@ namespace sparta
         //! Pointer to the master scoreboard
         Scoreboard * master_scoreboard_ = nullptr;
 
-        struct CallbackData
+        //! Index of a pooled Waiter or WaitLink
+        using PoolIndex = uint32_t;
+        static constexpr PoolIndex INVALID_INDEX = std::numeric_limits<PoolIndex>::max();
+
+        /**
+         * \brief A registered ready callback.  Pooled: slots are reused
+         *        once the callback is called or cleared
+         */
+        struct Waiter
         {
-            CallbackData(const Scoreboard::RegisterBitMask & bv,
-                         const Scoreboard::InstID iid,
-                         const ReadinessCallback & cb,
-                         sparta::Clock::Cycle cyc) :
-                needed_bits(bv), inst_id(iid), callback(cb), registered_time(cyc)
+            Scoreboard::RegisterBitMask needed_bits;
+            Scoreboard::InstID          inst_id = 0;
+            ReadinessCallback           callback;
+            sparta::Clock::Cycle        registered_time = 0;
+            uint64_t                    seq = 0;           ///< Registration order
+            uint32_t                    num_not_ready = 0; ///< Needed registers not ready in this view
+            PoolIndex                   first_link = INVALID_INDEX; ///< WaitLinks of this waiter
+            bool                        active = false;
+        };
 
-            {}
+        /**
+         * \brief Membership of a Waiter in the wait list of one of its
+         *        registers.  Each register's list is doubly linked so a
+         *        waiter is removed from all its lists in O(operands)
+         */
+        struct WaitLink
+        {
+            PoolIndex waiter;
+            uint32_t  reg;
+            PoolIndex prev;
+            PoolIndex next;
+            PoolIndex next_of_waiter; ///< Next link of the same waiter
+        };
 
-            CallbackData(CallbackData&&) = default;
+        //! Remove a waiter from its registers' wait lists and free its slot
+        void releaseWaiter_(PoolIndex widx);
 
-            const Scoreboard::RegisterBitMask needed_bits;
-            const Scoreboard::InstID          inst_id;
-            ReadinessCallback                 callback;
-            sparta::Clock::Cycle              registered_time;
-        };
+        std::vector<Waiter>    waiters_;
+        std::vector<PoolIndex> free_waiters_;
+        std::vector<WaitLink>  links_;
+        std::vector<PoolIndex> free_links_;
+
+        using WaitListHeads = std::array<PoolIndex, Scoreboard::MAX_REGISTERS>;
+        static WaitListHeads emptyWaitLists_() {
+            WaitListHeads heads;
+            heads.fill(INVALID_INDEX);
+            return heads;
+        }
+
+        //! Head of the wait list of each register.  Initialized here since
+        //! the master scoreboard sends an update while constructing the view
+        WaitListHeads register_waiters_ = emptyWaitLists_();
+
+        //! Waiters (registration sequence number, index) queued to be called
+        using ReadyWaiters = std::vector<std::pair<uint64_t, PoolIndex>>;
+
+        //! Waiters whose operands are all ready, to be called on the next
+        //! update in registration order
+        ReadyWaiters ready_waiters_;
+
+        //! Scratch list of waiters being called by an update (kept to reuse
+        //! its storage)
+        ReadyWaiters calling_waiters_;
 
-        using ReadinessCallbacks = std::list<CallbackData>;
-        ReadinessCallbacks ready_callbacks_;
+        uint64_t next_waiter_seq_ = 0;
 
         const sparta::Clock    * clock_;
         const std::string        unit_name_;
@@ -139,7 +139,7 @@ namespace sparta
         {
             sparta_assert(!isFinalized(),
                               "Should not be setting period on a sparta::Clock after device tree finalization");
-            period_ = uint32_t(root_ratio_ * norm);
+            setPeriod_(uint32_t(root_ratio_ * norm));
         }
 
         /*!
@@ -158,7 +158,14 @@ namespace sparta
          */
         Cycle getCycle(const Scheduler::Tick& tick) const
         {
-            return (tick / period_);
+            if(period_shift_ != NOT_POW2_PERIOD) {
+                return (tick >> period_shift_);
+            }
+
+            // The reciprocal estimate is low by at most one
+            const Cycle cycle = static_cast<Cycle>
+                ((static_cast<TickProduct>(tick) * period_reciprocal_) >> 64);
+            return cycle + ((tick - cycle * period_) >= period_);
         }
 
         /**
@@ -168,7 +175,12 @@ namespace sparta
          */
         Cycle currentCycle() const
         {
-            return getCycle(scheduler_->getCurrentTick());
+            const Scheduler::Tick tick = scheduler_->getCurrentTick();
+            if(SPARTA_EXPECT_FALSE(tick != cached_tick_)) {
+                cached_cycle_ = getCycle(tick);
+                cached_tick_  = tick;
+            }
+            return cached_cycle_;
         }
 
         /**
@@ -188,6 +200,12 @@ namespace sparta
         void updateElapsedCycles(const Scheduler::Tick elapsed_ticks)
         {
             elapsed_cycles_ = getCycle(elapsed_ticks);
+
+            // The Scheduler calls this as time advances; refresh the
+            // current cycle here so currentCycle() rarely converts
+            cached_tick_  = scheduler_->getCurrentTick();
+            cached_cycle_ = (cached_tick_ == elapsed_ticks) ?
+                elapsed_cycles_ : getCycle(cached_tick_);
         }
 
         /**
@@ -239,7 +257,7 @@ namespace sparta
          */
         bool isPosedge() const
         {
-            return ((scheduler_->getCurrentTick() % period_) == 0);
+            return ((scheduler_->getCurrentTick() - getTick(currentCycle())) == 0);
         }
 
         //! Used for printing the clock information
@@ -314,15 +332,46 @@ namespace sparta
         //! @}
 
     private:
+
+        //! Full 128-bit product of a tick and period_reciprocal_
+        __extension__ typedef unsigned __int128 TickProduct;
+
+        //! period_shift_ value for periods that are not a power of two
+        static constexpr uint32_t NOT_POW2_PERIOD = 0xFFFFFFFF;
+
+        /*!
+         * \brief Set period_ and precompute what getCycle needs to
+         *        convert ticks without dividing
+         */
+        void setPeriod_(Period period)
+        {
+            sparta_assert(period != 0, "Clock " << getName() << " cannot have a period of 0");
+            period_ = period;
+            if((period & (period - 1)) == 0) {
+                period_shift_      = __builtin_ctz(period);
+                period_reciprocal_ = 0;
+            }
+            else {
+                period_shift_      = NOT_POW2_PERIOD;
+                period_reciprocal_ = UINT64_MAX / period;
+            }
+            cached_tick_  = 0;
+            cached_cycle_ = 0;
+        }
+
         Handle                    parent_;              //!< Parent clock (NULL if root)
         Scheduler           *     scheduler_ = nullptr; //!< Scheduler on which this clock operates
         RefList                   children_;            //!< Child clocks
         utils::Rational<uint32_t> parent_ratio_  = 1;   //!< For debugging
         utils::Rational<uint32_t> root_ratio_    = 1;
         Period                    period_        = 1;
+        uint32_t                  period_shift_  = 0;   //!< log2(period_) if a power of two
+        uint64_t                  period_reciprocal_ = 0; //!< floor((2^64-1) / period_) otherwise
         StatisticSet              sset_ = {this};
         const double              frequency_mhz_ = 0.0;
         Cycle                     elapsed_cycles_ = 0;
+        mutable Scheduler::Tick   cached_tick_   = 0;   //!< Tick of cached_cycle_
+        mutable Cycle             cached_cycle_  = 0;   //!< currentCycle() at cached_tick_
 
         class CurrentCycleCounter : public ReadOnlyCounter {
             Clock& clk_;
@@ -161,6 +161,19 @@ namespace sparta
             }
         }
 
+        /*!
+         * \brief Sum of the write-counts of all Parameters in this set. Used
+         * to detect whether any Parameter was written since some earlier point
+         * \see sparta::ParameterBase::getWriteCount
+         */
+        uint64_t getTotalWriteCount() const {
+            uint64_t total = 0;
+            for(const ParameterPairs::value_type & pair : keys_) {
+                total += pair.second->getWriteCount();
+            }
+            return total;
+        }
+
         /*!
          * \brief Reset the write-count on all Parameters in this set
          */
@@ -4,13 +4,13 @@
 
 #include <vector>
 #include <sstream>
-#include <regex>
 #include <memory>
 #include <string>
 
 #include "sparta/utils/Utils.hpp"
 #include "sparta/simulation/Parameter.hpp"
 #include "sparta/simulation/TreeNode.hpp"
+#include "sparta/utils/GlobPattern.hpp"
 #include "sparta/utils/LexicalCast.hpp"
 
 namespace sparta
@@ -358,9 +358,7 @@ namespace sparta
              * \erturn true if \a pattern matches \a other, false if not/
              */
             static bool matches(const std::string& pattern, const std::string& other) {
-                std::regex expr(TreeNode::createSearchRegexPattern(pattern));
-                std::smatch what;
-                return std::regex_match(other, what, expr);
+                return utils::GlobPattern::get(pattern)->match(other);
             }
 
             /*!
@@ -121,6 +121,32 @@ namespace sparta
          */
         virtual void onConfiguring(sparta::ResourceTreeNode* n) = 0;
 
+        /*!
+         * \brief Optional hook for expensive work needed by a resource (e.g.
+         * reading input files or building lookup tables) which can be done
+         * before the resource is constructed.
+         * \param node TreeNode with which the resource will be associated
+         * \param params ParameterSet created by createParameters, already
+         * validated. Results can be stored in it for the resource constructor
+         * to use since it is specific to \a node
+         *
+         * Called once per node while the tree is finalizing, before
+         * createResource. When the tree is finalized with multiple threads
+         * (see RootTreeNode::setNumFinalizeThreads) this is called
+         * concurrently for different nodes, so implementations must:
+         * \li Only read \a node, its ancestors, and parameters of \a params
+         * \li Only write to \a params (or data owned by this call)
+         * \li Not create or modify TreeNodes, Events, Ports, Clocks or
+         * Counters, register with the Scheduler, post notifications, or log
+         *
+         * Exceptions thrown here are rethrown when createResource would have
+         * been called for \a node, so errors are reported in tree order.
+         */
+        virtual void prepareResource(const TreeNode* node, ParameterSet* params) {
+            (void) node;
+            (void) params;
+        }
+
         /*!
          * \brief Instanitates a new Resource of the type described by this
          * factory.
@@ -168,6 +194,7 @@ namespace sparta
 
     GENERATE_HAS_ATTR(name)
     GENERATE_HAS_ATTR(ParameterSet)
+    GENERATE_HAS_ATTR(prepareResource)
 
     /*!
      * \brief Templated ResourceFactoryBase implementation which can be used to
@@ -256,6 +283,15 @@ namespace sparta
             (void) n;
         }
 
+        /*!
+         * \brief Calls ResourceT::prepareResource(const TreeNode*, ParamsT*)
+         * if ResourceT declares that static method
+         * \see ResourceFactoryBase::prepareResource for thread-safety rules
+         */
+        virtual void prepareResource(const TreeNode* node, ParameterSet* params) override {
+            prepareResource_<ResourceT>(node, params);
+        }
+
         // This can easily be overridden for additional building or configuring
         virtual void onBuilding(sparta::ResourceTreeNode* n) override {
             (void) n;
@@ -297,6 +333,23 @@ namespace sparta
 
     private:
 
+        template <typename RT>
+        typename std::enable_if<has_attr_prepareResource<RT>::value>::type
+        prepareResource_(const TreeNode* node, ParameterSet* params) {
+            ParamsT* sps = dynamic_cast<ParamsT*>(params);
+            if(nullptr == sps){
+                throw SpartaException("Failed to cast ParameterSet ")
+                    << params << " to type " << typeid(ParamsT).name()
+                    << " when preparing resource for node " << node->getLocation();
+            }
+            RT::prepareResource(node, sps);
+        }
+
+        template <typename RT>
+        typename std::enable_if<!has_attr_prepareResource<RT>::value>::type
+        prepareResource_(const TreeNode*, ParameterSet*) {
+        }
+
         template <typename RT>
         typename std::enable_if<has_attr_name<RT>::value, std::string>::type
         getResourceType_() const {
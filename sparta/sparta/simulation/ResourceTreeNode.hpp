@@ -4,8 +4,10 @@
 
 #include <iostream>
 #include <string>
+#include <exception>
 
 #include "sparta/functional/ArchData.hpp"
+#include "sparta/kernel/StartupProfiler.hpp"
 #include "sparta/simulation/TreeNode.hpp"
 #include "sparta/log/MessageSource.hpp"
 #include "sparta/utils/SpartaException.hpp"
@@ -83,6 +85,7 @@ namespace sparta
                 parent->addChild(this); // Do not inherit parent state
             }
 
+            StartupProfiler::NodeScope profile(this);
             initConfigurables_();
         }
 
@@ -209,6 +212,74 @@ namespace sparta
             return getResource_();
         }
 
+        /*!
+         * \brief Validate this node's parameters, once, ahead of creating
+         * the resource.
+         * \pre Tree is finalizing
+         * \note Does not throw. Any error is held and rethrown when the
+         * resource is created, so that errors are reported in tree order.
+         *
+         * This is invoked by prepareResource if it has not been done yet.
+         * Validation callbacks read other nodes' parameters and may log, so
+         * RootTreeNode::enterFinalized always invokes this from its own
+         * thread, in tree order, before preparing resources concurrently.
+         */
+        void validateParameters() noexcept {
+            if(validated_){
+                return;
+            }
+            validated_ = true;
+
+            try{
+                std::string errs;
+                if(!params_->validateIndependently(errs)){
+                    throw SpartaException("Parameter limits violated:")
+                        << errs;
+                }
+
+                if(!params_->validateDependencies(this, errs)){
+                    throw SpartaException("Parameter validation callbacks indicated invalid parameters: ")
+                        << errs;
+                }
+            }catch(...){
+                prepare_error_ = std::current_exception();
+            }
+        }
+
+        /*!
+         * \brief Validate this node's parameters (unless already done) and
+         * invoke ResourceFactoryBase::prepareResource, once, ahead of
+         * creating the resource.
+         * \pre Tree is finalizing, node is attached and has a clock
+         * \note Does not throw. Any error is held and rethrown when the
+         * resource is created, so that errors are reported in tree order
+         * regardless of which thread prepared which node.
+         *
+         * This is invoked by createResource_ if it has not been done yet.
+         * RootTreeNode::enterFinalized invokes it concurrently for all
+         * resource nodes when using multiple finalize threads, after calling
+         * validateParameters on each of them from its own thread. Only
+         * ResourceFactoryBase::prepareResource runs on the other threads.
+         */
+        void prepareResource() noexcept {
+            if(prepared_){
+                return;
+            }
+            validateParameters();
+            prepared_ = true;
+
+            if(!prepare_error_){
+                try{
+                    res_fact_->prepareResource(this, params_);
+                }catch(...){
+                    prepare_error_ = std::current_exception();
+                }
+            }
+
+            // Taken after preparing since results can be stored in params_
+            prepared_write_count_ = params_->getTotalWriteCount();
+        }
+
     protected:
 
         /*!
@@ -267,15 +338,22 @@ namespace sparta
                     << "must have at least one clock associated with a node in their ancestry";
             }
 
-            std::string errs;
-            if(!params_->validateIndependently(errs)){
-                throw SpartaException("Parameter limits violated:")
-                    << errs;
+            // Validate parameters and prepare the resource unless this was
+            // already done (possibly on another thread) while finalizing. If
+            // parameters were written since (e.g. by an ancestor's resource),
+            // prepare again with the new values
+            if(prepared_ && params_->getTotalWriteCount() != prepared_write_count_){
+                prepared_ = false;
+                validated_ = false;
+                prepare_error_ = nullptr;
             }
-
-            if(!params_->validateDependencies(this, errs)){
-                throw SpartaException("Parameter validation callbacks indicated invalid parameters: ")
-                    << errs;
+            prepareResource();
+            prepared_ = false; // Consumed. Prepare again if finalization is retried after an error
+            validated_ = false;
+            if(prepare_error_){
+                std::exception_ptr err = prepare_error_;
+                prepare_error_ = nullptr;
+                std::rethrow_exception(err);
             }
 
             // Note, parameters have been reset to 0 read-counts when the
@@ -387,6 +465,10 @@ namespace sparta
         bool created_resource_; //!< Did this factory actually create a resource. Used to catch other
         ResourceFactoryBase* const res_fact_; //!< ResourceFactory used to construct resources for this node
         ParameterSet* params_; //!< This node's parameters
+        bool validated_ = false; //!< Has validateParameters been invoked since the last createResource_
+        bool prepared_ = false; //!< Has prepareResource been invoked since the last createResource_
+        uint64_t prepared_write_count_ = 0; //!< Total parameter write-count when prepared
+        std::exception_ptr prepare_error_; //!< Error from prepareResource, rethrown on createResource_
 
         /*!
          * \brief Data space for this ResourceTreeNode because these nodes tend
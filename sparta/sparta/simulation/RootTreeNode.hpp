@@ -266,6 +266,32 @@ namespace sparta
          */
         void enterFinalized(sparta::python::PythonInterpreter* pyshell = nullptr);
 
+        /*!
+         * \brief Set the number of threads used by enterFinalized.
+         * \param num_threads Number of threads, including the calling thread.
+         * 0 and 1 (default) finalize entirely on the calling thread.
+         *
+         * With more than one thread, parameters of all ResourceTreeNodes in
+         * the tree are validated on the calling thread and then
+         * ResourceFactoryBase::prepareResource runs concurrently for them
+         * before resources are created.
+         * Resources are still created one at a time in tree order, so the
+         * finalized tree is identical regardless of the number of threads.
+         * Errors are also reported in tree order.
+         * \see ResourceTreeNode::prepareResource
+         */
+        void setNumFinalizeThreads(uint32_t num_threads) {
+            num_finalize_threads_ = num_threads;
+        }
+
+        /*!
+         * \brief Get the number of threads used by enterFinalized
+         * \see setNumFinalizeThreads
+         */
+        uint32_t getNumFinalizeThreads() const {
+            return num_finalize_threads_;
+        }
+
         /*!
          * \brief Public method for recursively giving all resources and nodes a
          * chance to bind ports locally. Recurses depth first by order of
@@ -473,6 +499,12 @@ namespace sparta
         // No effect on root
         virtual void createResource_() override {};
 
+        /*!
+         * \brief Prepare all ResourceTreeNodes in this tree which have yet
+         * to create their resources, using num_finalize_threads_ threads
+         */
+        void prepareResourcesConcurrently_();
+
         /*!
          * \brief Disallow assigning a parent to this node except for the
          * GlobalTreeNode.
@@ -539,6 +571,11 @@ namespace sparta
          */
         GlobalTreeNode* search_node_;
 
+        /*!
+         * \brief Number of threads used by enterFinalized
+         */
+        uint32_t num_finalize_threads_ = 1;
+
         /*!
          * \brief Simulator associated with this tree
          */
@@ -15,14 +15,16 @@
 #include "sparta/statistics/EnumHistogram.hpp"
 #include "sparta/utils/ValidValue.hpp"
 
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
 namespace sparta
 {
 
-// type for the shared_ptr of a map of vectors. The map use state_set_hash_code,
-// the vector contains the state_set_delta_ for each StateSet
-typedef std::shared_ptr<std::unordered_map<uint32_t, std::vector<sparta::Clock::Cycle> *>>
-        StateTimerDataContainerPtr;
-
 /**
  * \class StateTimerUnit
  * \brief A high level wrapper contains the StateTimerPool and StateTimerHistogram
@@ -33,6 +35,52 @@ private:
     // forward declaration
     class StateTimerPool;
 
+    /**
+     * \struct StateSetLayout
+     * \brief Where each state set (enum class) lives in the flat
+     *        per-state arrays of the timers and histograms
+     *
+     * A state set is found by comparing its enum class' type_info,
+     * so starting and ending states does not hash.  Units have a
+     * handful of state sets, so the search is a short scan.  The
+     * type_info addresses are compared first; type_info equality
+     * (which also holds across shared objects) is the fallback.
+     */
+    struct StateSetLayout
+    {
+        //! Value returned by findSet() for an unknown state set
+        static constexpr uint32_t NOT_FOUND = 0xFFFFFFFF;
+
+        //! The type of each state set
+        std::vector<const std::type_info *> keys;
+        //! The number of states in each set
+        std::vector<uint32_t> num_states;
+        //! The index of the first state of each set in the flat arrays
+        std::vector<uint32_t> offsets;
+        //! The total number of states in all sets
+        uint32_t total_states = 0;
+
+        //! The index of the given enum class' set, or NOT_FOUND
+        template<class EnumClassT>
+        uint32_t findSet() const
+        {
+            const std::type_info & key = typeid(EnumClassT);
+            for (uint32_t i = 0; i < keys.size(); ++i)
+            {
+                if (keys[i] == &key) {
+                    return i;
+                }
+            }
+            for (uint32_t i = 0; i < keys.size(); ++i)
+            {
+                if (*keys[i] == key) {
+                    return i;
+                }
+            }
+            return NOT_FOUND;
+        }
+    };
+
 public:
 
     /**
@@ -49,7 +97,6 @@ public:
 
         typedef uint32_t TimerId;
         typedef std::shared_ptr<StateTimer> Handle;
-        typedef std::shared_ptr<std::unordered_map<uint32_t, uint32_t>> StateSetInfo;
 
         ~StateTimer() {}
 
@@ -60,28 +107,14 @@ public:
         template<class EnumClassT>
         void startState(EnumClassT state_enum)
         {
-            uint32_t state_set_hash_code;
-            uint32_t state_index;
-            uint32_t active_state_in_set;
-            std::shared_ptr<StateSet> state_set;
-
-            // using state_set_hash_code as state set identifier,
-            // and state_index for state in the set.
-            state_set_hash_code = typeid(EnumClassT).hash_code();
-            state_index = static_cast<uint32_t>(state_enum);
-
-            // find the state set in the timer.
-            auto it = state_set_map_.find(state_set_hash_code);
-            sparta_assert(it != state_set_map_.end(),
-                    "Can not find state enum class in timer.");
-            state_set = it->second;
+            StateSet & state_set = getStateSet_<EnumClassT>();
+            const uint32_t state_index = static_cast<uint32_t>(state_enum);
 
-            if (state_set->active_state_index_.isValid())
+            if (state_set.active_state_index_.isValid())
             {
-                active_state_in_set = state_set->active_state_index_.getValue();
-                sparta_assert(active_state_in_set != state_index ,
+                sparta_assert(state_set.active_state_index_.getValue() != state_index ,
                         "State aleady started");
-                sparta_assert(state_set->active_state_starting_time_ > 0,
+                sparta_assert(state_set.active_state_starting_time_ > 0,
                         "Wrong active state starting time.");
 
                 // implicitly update the time delta of the active state in the set, if there is one.
@@ -89,10 +122,10 @@ public:
             }
 
             // set the new state to the active state in set.
-            sparta_assert(state_index < state_set->state_set_delta_.size(),
+            sparta_assert(state_index < state_set.num_states_,
                     "State enum out of range.")
-            state_set->active_state_index_ = state_index;
-            state_set->active_state_starting_time_ = clk_->currentCycle();
+            state_set.active_state_index_ = state_index;
+            state_set.active_state_starting_time_ = clk_->currentCycle();
         }
 
         /**
@@ -102,34 +135,20 @@ public:
         template<class EnumClassT>
         void endState(EnumClassT state_enum)
         {
-            uint32_t state_set_hash_code;
-            uint32_t state_index;
-            int32_t active_state_in_set;
-            std::shared_ptr<StateSet> state_set;
-
-            // using state_set_hash_code as state set identifier,
-            // and state_index for state in the set.
-            state_set_hash_code = typeid(EnumClassT).hash_code();
-            state_index = static_cast<uint32_t>(state_enum);
-
-            // find the state set in the timer.
-            auto it = state_set_map_.find(state_set_hash_code);
-            sparta_assert(it != state_set_map_.end(),
-                    "Can not find state enum class in timer.");
-            state_set = it->second;
+            StateSet & state_set = getStateSet_<EnumClassT>();
+            const uint32_t state_index = static_cast<uint32_t>(state_enum);
 
             // the end state needs to be the active one
-            sparta_assert(state_set->active_state_index_.isValid() ,
+            sparta_assert(state_set.active_state_index_.isValid() ,
                     "No active state in the set when endState.");
-            active_state_in_set = state_set->active_state_index_.getValue();
-            sparta_assert((uint32_t)active_state_in_set==state_index,
+            sparta_assert(state_set.active_state_index_.getValue() == state_index,
                     "State does not match active state in the set when endState.");
 
             // end the state
             endTimerState_(state_set);
 
-            state_set->active_state_index_.clearValid();
-            state_set->active_state_starting_time_ = 0;
+            state_set.active_state_index_.clearValid();
+            state_set.active_state_starting_time_ = 0;
         }
 
 
@@ -147,24 +166,18 @@ public:
 
         /**
          * \struct StateSet
-         * \brief Contains the delta time info for a set of states (one enum class)
+         * \brief The active state of a set of states (one enum class)
          */
         struct StateSet
         {
             //  The state index for the active state
             utils::ValidValue<uint32_t> active_state_index_;
             //  The starting time for the active state
-            sparta::Clock::Cycle active_state_starting_time_;
-            //  Delta time of all the states
-            std::vector<sparta::Clock::Cycle> state_set_delta_;
-
-            StateSet(uint32_t num_state):
-                active_state_starting_time_(0),
-                state_set_delta_(std::vector<sparta::Clock::Cycle>(num_state, 0))
-            {
-                // Initial active_state_index_ to invalid
-                active_state_index_.clearValid();
-            }
+            sparta::Clock::Cycle active_state_starting_time_ = 0;
+            //  The index of the first state of this set in state_deltas_
+            uint32_t offset_ = 0;
+            //  The number of states in this set
+            uint32_t num_states_ = 0;
         };
 
         /*!
@@ -172,44 +185,53 @@ public:
          *
          * \param clk The pointer to Clock for the timer to get timestamp
          * \param timer_id The id, also the vector index in the timer pool
-         * \param state_set_info_map_ptr A map using the state set hashcode,
-         *                               and contains the number of states in the set,
-         *                               used to initialize the timers
+         * \param layout The state sets of the StateTimerUnit
          * \param state_timer_unit_ptr A pointer to the StateTimerUnit,
          *                             used when query or release
          */
         StateTimer(const sparta::Clock * clk, TimerId timer_id,
-                StateSetInfo state_set_info_map_ptr,
+                const StateSetLayout & layout,
                 StateTimerUnit * state_timer_unit_ptr):
             clk_(clk),
             timer_id_(timer_id),
             state_timer_unit_ptr_(state_timer_unit_ptr),
+            layout_(layout),
+            state_sets_(layout.keys.size()),
+            state_deltas_(layout.total_states, 0),
             last_query_time_(0)
         {
-            // use state_set_info_map_ptr to initial state_set_map_.
-            for (auto it = state_set_info_map_ptr->begin(); it != state_set_info_map_ptr->end(); ++it)
+            for (uint32_t i = 0; i < state_sets_.size(); ++i)
             {
-                state_set_map_.insert(std::map<uint32_t, std::shared_ptr<StateSet>>::value_type
-                        (it->first, std::shared_ptr<StateSet>(new StateSet(it->second))));
+                state_sets_[i].offset_ = layout.offsets[i];
+                state_sets_[i].num_states_ = layout.num_states[i];
             }
         }
 
+        //! Get the state set of the given enum class
+        template<class EnumClassT>
+        StateSet & getStateSet_()
+        {
+            const uint32_t set_index = layout_.findSet<EnumClassT>();
+            sparta_assert(set_index != StateSetLayout::NOT_FOUND,
+                    "Can not find state enum class in timer.");
+            return state_sets_[set_index];
+        }
+
         /**
          * \brief End the timer, used in start, end, release function
          *        the histogram is updated.
          */
-        void endTimerState_(std::shared_ptr<StateSet> &state_set)
+        void endTimerState_(const StateSet & state_set)
         {
-            uint32_t active_state_in_set = state_set->active_state_index_.getValue();
-            if (state_set->active_state_starting_time_ > last_query_time_)
+            const uint32_t active_state_in_set = state_set.active_state_index_.getValue();
+            sparta::Clock::Cycle & delta = state_deltas_[state_set.offset_ + active_state_in_set];
+            if (state_set.active_state_starting_time_ > last_query_time_)
             {
-                state_set->state_set_delta_[active_state_in_set] +=
-                        clk_->currentCycle() -  state_set->active_state_starting_time_;
+                delta += clk_->currentCycle() - state_set.active_state_starting_time_;
             }
             else
             {
-                state_set->state_set_delta_[active_state_in_set] +=
-                        clk_->currentCycle() -  last_query_time_;
+                delta += clk_->currentCycle() - last_query_time_;
             }
         }
 
@@ -225,6 +247,114 @@ public:
          */
         void releaseStateTimer_();
 
+        /**
+         * \struct HandleArena
+         * \brief Recycles the shared_ptr control blocks of the pool's
+         *        StateTimer::Handles, so allocating a timer does not
+         *        allocate once the pool has warmed up
+         *
+         * A Handle can outlive its pool, and its control block is
+         * freed after its deleter runs, so the arena is only deleted
+         * once the pool is gone and no control block is outstanding.
+         */
+        struct HandleArena
+        {
+            //! The pool Handles release their timers to, nullptr once destroyed
+            StateTimerPool * pool = nullptr;
+            //! Size of the recycled control blocks
+            size_t block_size = 0;
+            //! Control blocks available for reuse
+            std::vector<void *> free_blocks;
+            //! Control blocks held by live Handles
+            uint32_t num_outstanding = 0;
+
+            explicit HandleArena(StateTimerPool * state_timer_pool) :
+                pool(state_timer_pool)
+            {}
+
+            ~HandleArena()
+            {
+                for (void * block : free_blocks) {
+                    ::operator delete(block);
+                }
+            }
+
+            void * allocate(size_t bytes)
+            {
+                ++num_outstanding;
+                if (bytes == block_size && !free_blocks.empty()) {
+                    void * block = free_blocks.back();
+                    free_blocks.pop_back();
+                    return block;
+                }
+                if (block_size == 0) {
+                    block_size = bytes;
+                }
+                return ::operator new(bytes);
+            }
+
+            void deallocate(void * block, size_t bytes)
+            {
+                --num_outstanding;
+                if (pool != nullptr && bytes == block_size) {
+                    free_blocks.emplace_back(block);
+                    return;
+                }
+                ::operator delete(block);
+                if (pool == nullptr && num_outstanding == 0) {
+                    delete this;
+                }
+            }
+
+            //! Called by the pool's destructor
+            void orphan()
+            {
+                pool = nullptr;
+                if (num_outstanding == 0) {
+                    delete this;
+                }
+            }
+        };
+
+        /**
+         * \struct HandleAllocator
+         * \brief Allocator for the control blocks of StateTimer::Handle
+         */
+        template<class T>
+        struct HandleAllocator
+        {
+            using value_type = T;
+
+            explicit HandleAllocator(HandleArena * handle_arena) :
+                arena(handle_arena)
+            {}
+
+            template<class U>
+            HandleAllocator(const HandleAllocator<U> & other) :
+                arena(other.arena)
+            {}
+
+            T * allocate(size_t n) {
+                return static_cast<T *>(arena->allocate(n * sizeof(T)));
+            }
+
+            void deallocate(T * ptr, size_t n) {
+                arena->deallocate(ptr, n * sizeof(T));
+            }
+
+            template<class U>
+            bool operator==(const HandleAllocator<U> & other) const {
+                return arena == other.arena;
+            }
+
+            template<class U>
+            bool operator!=(const HandleAllocator<U> & other) const {
+                return arena != other.arena;
+            }
+
+            HandleArena * arena;
+        };
+
         /**
          * \struct CustomDeleter
          * \brief Custom deleter for StateTimer::Handle, checks it the timer outlives the pool
@@ -232,19 +362,20 @@ public:
         struct CustomDeleter
         {
         public:
-            CustomDeleter(const std::weak_ptr<StateTimerPool> & pool_ptr):
-                state_timer_pool_ptr_(pool_ptr)
+            CustomDeleter(const HandleArena * arena):
+                arena_(arena)
             {}
 
             void operator()(StateTimer *ptr)
             {
-                if(!state_timer_pool_ptr_.expired())
+                // The arena outlives every Handle's control block
+                if(arena_->pool != nullptr)
                 {
                     ptr->releaseStateTimer_();
                 }
             }
         private:
-            std::weak_ptr<StateTimerPool> state_timer_pool_ptr_;
+            const HandleArena * arena_;
         };
 
         // sparta::Clock used to get current time
@@ -253,10 +384,16 @@ public:
         TimerId timer_id_;
         // Pointer to StateTimerUnit, used when query or release
         StateTimerUnit * state_timer_unit_ptr_;
-        // A map contains all the state sets
-        std::unordered_map<uint32_t, std::shared_ptr<StateSet>> state_set_map_;
+        // The state sets of the StateTimerUnit
+        const StateSetLayout & layout_;
+        // The active state of each state set, in layout_ order
+        std::vector<StateSet> state_sets_;
+        // Delta time of every state of every set, indexed by set offset + state
+        std::vector<sparta::Clock::Cycle> state_deltas_;
         // last query time used for dynamic query
         sparta::Clock::Cycle last_query_time_;
+        // Position of this timer in the pool's active timer list, if active
+        uint32_t active_index_ = 0;
 
     }; // class StateTimer
 
@@ -311,14 +448,16 @@ public:
     template<class EnumClassT>
     std::string dynamicQuery(EnumClassT state_enum)
     {
-        uint32_t state_set_hash_code;
-        uint32_t state_index;
-
-        state_set_hash_code = typeid(EnumClassT).hash_code();
-        state_index = static_cast<uint32_t>(state_enum);
+        const uint32_t set_index = layout_.findSet<EnumClassT>();
+        sparta_assert(set_index != StateSetLayout::NOT_FOUND,
+                "Can not find state enum class in histogram map.");
+        const uint32_t state_index = static_cast<uint32_t>(state_enum);
+        sparta_assert(state_index < layout_.num_states[set_index],
+                "State enum out of range.")
 
         state_timer_pool_ptr_->queryAllActiveTimer();
-        return state_timer_histogram_ptr_->getDisplayStringCumulativeOneState(state_set_hash_code, state_index);
+        return state_timer_histogram_ptr_->getDisplayStringCumulativeOneState(
+            layout_.offsets[set_index] + state_index);
     }
 
 private:
@@ -326,6 +465,12 @@ private:
     /**
      *  \class StateTimerPool
      *  \brief A pool to maintain all the StateTimers, as well as active and available ones.
+     *
+     *  The pool owns every StateTimer.  Available timers are kept on
+     *  a free list of IDs, and active timers in a dense list in which
+     *  each timer knows its own position.  The Handles' control blocks
+     *  are recycled through a HandleArena, so allocating and releasing
+     *  a timer does not hash or allocate.
      */
     class StateTimerPool
     {
@@ -335,50 +480,49 @@ private:
          * \brief StateTimerPool constructor
          *
          * \param parent The parent of StateTimerUnit
-         * \param state_set_info_map_ptr A map using the state set hashcode,
-         *                               and contains the number of states in the set,
-         *                               used to initialize the timers
+         * \param layout The state sets used to initialize the timers
          * \param state_timer_unit_ptr The pointer to StateTimerUnit, where the pool belongs to
          * \param num_state_timer_init Initial number of total StateTimers in pool, used as incremental interval
          */
         StateTimerPool(TreeNode * parent,
-                StateTimer::StateSetInfo state_set_info_map_ptr,
+                const StateSetLayout & layout,
                 StateTimerUnit * state_timer_unit_ptr,
                 uint32_t num_state_timer_init);
 
+        ~StateTimerPool()
+        {
+            handle_arena_->orphan();
+        }
+
+        StateTimerPool(const StateTimerPool &) = delete;
+        StateTimerPool & operator=(const StateTimerPool &) = delete;
+
         /**
          * \brief Allocate a StateTimer from the pool
          * \return StateTimer::Handle of the allocated StateTimer
          */
         StateTimer::Handle allocateTimer()
         {
-            StateTimer::TimerId timer_id;
             // check avalability in timer_list
-            if(available_timer_vec_ptr_->size()==0)
+            if(available_timers_.empty())
             {
                 // create more time if not exceed MAX_NUM_STATETIMER
-                uint32_t current_num_timer = timer_list_ptr_->size();
+                const uint32_t current_num_timer = timer_list_.size();
                 sparta_assert(current_num_timer < MAX_NUM_STATETIMER,
                         "No timer available, pool exceeds MAX capacity.")
                 std::cout << "Warining: "<< current_num_timer <<
                         " StateTimers are inflight, creating more." << std::endl;
-                for (uint32_t i = current_num_timer; i < current_num_timer + num_state_timer_init_; i++)
-                {
-                    timer_list_ptr_->push_back(StateTimer::Handle
-                                (new StateTimer(clk_, i, state_set_info_map_ptr_, state_timer_unit_ptr_)));
-                    available_timer_vec_ptr_->push_back(std::make_pair(i, timer_list_ptr_->at(i)));
-                }
-                sparta_assert(current_num_timer + num_state_timer_init_ == timer_list_ptr_->size(),
-                        "Number of Timers created does not add up.")
+                addTimers_(num_state_timer_init_);
             }
 
-            timer_id = available_timer_vec_ptr_->back().first;
-            active_timer_map_ptr_->insert(std::map<StateTimer::TimerId, StateTimer::Handle>::value_type
-                            (timer_id, available_timer_vec_ptr_->back().second));
-            available_timer_vec_ptr_->pop_back();
-            sparta_assert(active_timer_map_ptr_->size() + available_timer_vec_ptr_->size()
-                    == timer_list_ptr_->size(), "Number of Timers does not add up.")
-            return StateTimer::Handle(timer_list_ptr_->at(timer_id).get(), StateTimer::CustomDeleter(my_life_));
+            StateTimer * timer = timer_list_[available_timers_.back()].get();
+            available_timers_.pop_back();
+            timer->active_index_ = active_timers_.size();
+            active_timers_.emplace_back(timer);
+            sparta_assert(active_timers_.size() + available_timers_.size()
+                    == timer_list_.size(), "Number of Timers does not add up.")
+            return StateTimer::Handle(timer, StateTimer::CustomDeleter(handle_arena_),
+                                      StateTimer::HandleAllocator<StateTimer>(handle_arena_));
         }
 
         /**
@@ -387,14 +531,20 @@ private:
          */
         void releaseTimer(StateTimer::TimerId timer_id)
         {
-            // check it should be in the active timer map
-            auto it = active_timer_map_ptr_->find(timer_id);
-            sparta_assert(it != active_timer_map_ptr_->end(),
-                    "Timer not in active timer map when release. ");
-            available_timer_vec_ptr_->push_back(std::make_pair(timer_id, it->second));
-            active_timer_map_ptr_->erase(it);
-            sparta_assert(active_timer_map_ptr_->size() + available_timer_vec_ptr_->size()
-                    == timer_list_ptr_->size(), "Number of Timers does not add up.")
+            // check it should be in the active timer list
+            StateTimer * timer = timer_list_[timer_id].get();
+            const uint32_t active_index = timer->active_index_;
+            sparta_assert(active_index < active_timers_.size() &&
+                          active_timers_[active_index] == timer,
+                    "Timer not in active timer list when release. ");
+
+            // Move the last active timer into the released one's place
+            active_timers_[active_index] = active_timers_.back();
+            active_timers_[active_index]->active_index_ = active_index;
+            active_timers_.pop_back();
+            available_timers_.emplace_back(timer_id);
+            sparta_assert(active_timers_.size() + available_timers_.size()
+                    == timer_list_.size(), "Number of Timers does not add up.")
         }
 
         /**
@@ -409,20 +559,29 @@ private:
 
     private:
 
-        // pointer to a vector of all StateTimer
-        std::unique_ptr<std::vector<StateTimer::Handle>> timer_list_ptr_;
-        // pointer to a map of active StateTimer: <timer_id, StateTimer pointer>
-        std::unique_ptr<std::unordered_map<StateTimer::TimerId, StateTimer::Handle>>
-            active_timer_map_ptr_;
-        // pointer to a vector of available StateTimer: <timer_id, StateTimer pointer>
-        std::unique_ptr<std::vector<std::pair<StateTimer::TimerId, StateTimer::Handle>>>
-            available_timer_vec_ptr_;
-        // A shared_ptr point to it self, used to track its life time
-        std::shared_ptr<StateTimerPool> my_life_;
+        //! Create num_timers more timers and make them available
+        void addTimers_(uint32_t num_timers)
+        {
+            const uint32_t current_num_timer = timer_list_.size();
+            for (uint32_t i = current_num_timer; i < current_num_timer + num_timers; i++)
+            {
+                timer_list_.emplace_back(new StateTimer(clk_, i, layout_, state_timer_unit_ptr_));
+                available_timers_.emplace_back(i);
+            }
+        }
+
+        // All StateTimers, indexed by TimerId
+        std::vector<std::unique_ptr<StateTimer>> timer_list_;
+        // The active StateTimers; each knows its position (StateTimer::active_index_)
+        std::vector<StateTimer *> active_timers_;
+        // The Ids of the available StateTimers
+        std::vector<StateTimer::TimerId> available_timers_;
+        // Control blocks of this pool's Handles; orphaned when the pool is destroyed
+        StateTimer::HandleArena * handle_arena_;
         // Initial number of total StateTimers in pool, used as incremental interval
         uint32_t num_state_timer_init_;
-        // A map uses the state set hash_code, contains the number of state in the set
-        StateTimer::StateSetInfo state_set_info_map_ptr_;
+        // The state sets of the StateTimerUnit
+        const StateSetLayout & layout_;
         // sparta::Clock used to get current time
         const sparta::Clock * clk_ = nullptr;
         // Pointer to StateTimerUnit, used when query or release
@@ -435,6 +594,9 @@ private:
     /**
      * \class StateTimerHistogram
      * \brief Maintains all the sparta::Histogram used. Each state has on sparta::Histogram
+     *
+     * The histograms are kept in the same flat order as the
+     * StateTimer deltas, so a timer's deltas are added in one pass.
      */
     class StateTimerHistogram
     {
@@ -445,57 +607,43 @@ private:
          *
          * \param parent The parent of StateTimerUnit, passed to each histogram
          * \param state_timer_unit_name The name string of the state timer unit
-         * \param state_set_name_map A map contains the name string of each state set
-         * \param state_timer_data_container_ptr The pointer to the timer data container,
-         *                                       which is used for passing the timer delta value
-         * \param state_set_info_map_ptr A map using the state set hashcode,
-         *                               and contains the number of states in the set,
-         *                               used to initialize the histogram map
+         * \param state_set_names The name string of each state set, in layout order
+         * \param layout The state sets, used to create one histogram per state
          * \param lower Lower value of histogram
          * \param upper Upper value of histogram
          * \param bin_size Bin size of histogram
          */
         StateTimerHistogram(TreeNode * parent,
                 std::string state_timer_unit_name,
-                std::unordered_map<uint32_t, std::string> state_set_name_map,
-                StateTimerDataContainerPtr state_timer_data_container_ptr,
-                StateTimer::StateSetInfo state_set_info_map_ptr,
-                uint32_t lower, uint32_t upper, uint32_t bin_size):
-            state_timer_data_container_ptr_(state_timer_data_container_ptr)
+                const std::vector<std::string> & state_set_names,
+                const StateSetLayout & layout,
+                uint32_t lower, uint32_t upper, uint32_t bin_size)
         {
-            // use state_set_info_map_ptr  to initial timer_histogram_map_, they have the same states.
-            for (auto it = state_set_info_map_ptr->begin(); it != state_set_info_map_ptr->end(); ++it)
+            histograms_.reserve(layout.total_states);
+            for (uint32_t set = 0; set < layout.keys.size(); ++set)
             {
-                std::shared_ptr<std::vector<std::shared_ptr<sparta::Histogram>>>
-                        histogram_vector(new std::vector<std::shared_ptr<sparta::Histogram>>);
-                for (uint32_t i = 0; i < it->second; i++)
+                for (uint32_t i = 0; i < layout.num_states[set]; i++)
                 {
-                    histogram_vector->push_back(std::shared_ptr<sparta::Histogram>
-                            (new sparta::Histogram(parent,
-                            state_timer_unit_name + "_histogram_set_" + state_set_name_map[it->first] +
+                    histograms_.emplace_back(new sparta::Histogram(parent,
+                            state_timer_unit_name + "_histogram_set_" + state_set_names[set] +
                             "_state_" + std::to_string(i), "state timer histogram" ,
-                            /*lower*/ lower, /*upper*/ upper , /*bin size*/ bin_size)));
+                            /*lower*/ lower, /*upper*/ upper , /*bin size*/ bin_size));
                 }
-                timer_histogram_map_.insert(std::unordered_map<uint32_t,
-                        std::shared_ptr<std::vector<std::shared_ptr<sparta::Histogram>>>>::value_type
-                        (it->first, histogram_vector));
             }
         }
 
         /**
-        * \brief Update the histograms using the info in the container
+        * \brief Add a timer's delta of every state to the histograms,
+        *        then reset the deltas
+        * \param state_deltas The timer's deltas, in layout order
         */
-        void updateHistogram()
+        void addStateDeltas(std::vector<sparta::Clock::Cycle> & state_deltas)
         {
-            for (auto it = timer_histogram_map_.begin(); it != timer_histogram_map_.end(); ++it)
+            sparta_assert(state_deltas.size() == histograms_.size());
+            for (uint32_t i = 0; i < histograms_.size(); i++)
             {
-                for (uint32_t i = 0; i < it->second->size(); i++)
-                {
-                    // add the delta of each state in the container to histogram, then reset the container.
-                    // Since the container has the pointers to the timer, this will actually reset the timer.
-                    (*it->second)[i]->addValue((*(*state_timer_data_container_ptr_)[it->first])[i]);
-                    (*(*state_timer_data_container_ptr_)[it->first])[i] = 0;
-                }
+                histograms_[i]->addValue(state_deltas[i]);
+                state_deltas[i] = 0;
             }
         }
 
@@ -505,36 +653,25 @@ private:
         std::string getDisplayStringCumulativeAllState()
         {
             std::string histogram_string = "";
-            for (auto it = timer_histogram_map_.begin(); it != timer_histogram_map_.end(); ++it)
+            for (const auto & histogram : histograms_)
             {
-                for (uint32_t i = 0; i < it->second->size(); i++)
-                {
-                    histogram_string += (*it->second)[i]->getDisplayStringCumulative();
-                }
+                histogram_string += histogram->getDisplayStringCumulative();
             }
             return histogram_string;
         }
 
         /**
         * \brief Get the cumulative histogram string of one state
+        * \param state_offset The state's set offset plus its index in the set
         */
-        std::string getDisplayStringCumulativeOneState(uint32_t state_set_hash_code, uint32_t state_index)
+        std::string getDisplayStringCumulativeOneState(uint32_t state_offset)
         {
-            std::string histogram_string = "";
-            auto it = timer_histogram_map_.find(state_set_hash_code);
-            sparta_assert(it != timer_histogram_map_.end(),
-                    "Can not find state enum class in histogram map.");
-            histogram_string = (*it->second)[state_index]->getDisplayStringCumulative();
-            return histogram_string;
+            return histograms_[state_offset]->getDisplayStringCumulative();
         }
 
     private:
-        // A map of sparta::Histogram, using the hash_code of each state set (enum class), each set has
-        // a vector of sparta::Histogram, each of them represent a state in the set.
-        std::unordered_map<uint32_t, std::shared_ptr<std::vector<std::shared_ptr<sparta::Histogram>>>>
-                timer_histogram_map_;
-        // A pointer to the container used for updating the histograms
-        StateTimerDataContainerPtr state_timer_data_container_ptr_;
+        // One sparta::Histogram per state, in layout order (set offset + state)
+        std::vector<std::unique_ptr<sparta::Histogram>> histograms_;
     };  // class StateTimerHistogram
 
     /**
@@ -545,15 +682,15 @@ private:
     template<class ArgsHeadT, class... ArgsTailT>
     void addStateSet_(ArgsHeadT state_sets_head, ArgsTailT... state_sets_tail)
     {
-        uint32_t state_set_hash_code = typeid(state_sets_head).hash_code();
-        uint32_t num_state = static_cast<uint32_t>(state_sets_head);
-        sparta_assert(state_set_info_map_ptr_->find(state_set_hash_code) == state_set_info_map_ptr_->end(),
+        const uint32_t num_state = static_cast<uint32_t>(state_sets_head);
+        sparta_assert(layout_.findSet<ArgsHeadT>() == StateSetLayout::NOT_FOUND,
                 "Same enum class exists.");
-        state_set_info_map_ptr_->insert(std::unordered_map<uint32_t,uint32_t>::value_type
-                (state_set_hash_code, num_state));
+        layout_.keys.emplace_back(&typeid(ArgsHeadT));
+        layout_.num_states.emplace_back(num_state);
+        layout_.offsets.emplace_back(layout_.total_states);
+        layout_.total_states += num_state;
         // using typeid().name() as state set name for now
-        state_set_name_map_.insert(std::unordered_map<uint32_t, std::string>::value_type
-                (state_set_hash_code, typeid(state_sets_head).name()));
+        state_set_names_.emplace_back(typeid(state_sets_head).name());
 
         addStateSet_(state_sets_tail...);
     }
@@ -565,12 +702,15 @@ private:
     * \brief The interface for StateTimer to update histograms, StateTimer only call this once
     *        to update all the states
     * \param timer_id The id of the StateTimer wants to update histograms
+    * \param state_deltas The deltas of the StateTimer, reset once added
     * \param is_release_timer Whether release the StateTimer after updating the histograms
     */
-    void updateStateHistogram_(StateTimer::TimerId timer_id, bool is_release_timer)
+    void updateStateHistogram_(StateTimer::TimerId timer_id,
+                               std::vector<sparta::Clock::Cycle> & state_deltas,
+                               bool is_release_timer)
     {
         // update the histogram
-        state_timer_histogram_ptr_->updateHistogram();
+        state_timer_histogram_ptr_->addStateDeltas(state_deltas);
         // release timer if needed
         if (is_release_timer)
         {
@@ -578,25 +718,14 @@ private:
         }
     }
 
-    /**
-    * \brief Pass the container to StateTimer
-    * \return The pointer of the container
-    */
-    StateTimerDataContainerPtr getStateTimerInfoContainer_()
-    {
-        return state_timer_data_container_ptr_;
-    }
-
-    // The pointer to the container
-    StateTimerDataContainerPtr state_timer_data_container_ptr_;
-    // A map uses the state set hash_code, contains the number of state in the set
-    StateTimer::StateSetInfo state_set_info_map_ptr_;
+    // The state sets of this unit, shared by all of its timers
+    StateSetLayout layout_;
     // The pointer to StateTimerPool
     std::unique_ptr<StateTimerPool> state_timer_pool_ptr_;
     // The pointer to StateTimerHistogram
     std::unique_ptr<StateTimerHistogram> state_timer_histogram_ptr_;
-    // A map uses the state set hash_code, contains the name string of each set
-    std::unordered_map<uint32_t, std::string> state_set_name_map_;
+    // The name string of each state set, in layout order
+    std::vector<std::string> state_set_names_;
 
 }; // class StateTimerUnit
 
@@ -609,29 +738,21 @@ inline void StateTimerUnit::StateTimer::queryStateTimer_()
     // already queried in the same cycle, should not update the timer and histogram again
     if (last_query_time_ == clk_->currentCycle())
         return;
-    std::shared_ptr<StateTimerUnit::StateTimer::StateSet> state_set;
-    // get the container pointer
-    StateTimerDataContainerPtr
-            timer_info_container = state_timer_unit_ptr_->getStateTimerInfoContainer_();
-    // put the address of state_set_delta_ vector of each state set in the container
-    for (auto it=state_set_map_.begin(); it!=state_set_map_.end(); ++it)
+    for (const auto & state_set : state_sets_)
     {
         // update the time delta if there is active state
-        state_set = it->second;
-        if (state_set->active_state_index_.isValid())
+        if (state_set.active_state_index_.isValid())
         {
-            sparta_assert(clk_->currentCycle() >= state_set->active_state_starting_time_,
+            sparta_assert(clk_->currentCycle() >= state_set.active_state_starting_time_,
                     "Wrong timing: current cycle less than state start time");
 
             // do not reset active state since this is query,
-            // state_set_delta_ will be reset after the the histograms are updated
+            // state_deltas_ will be reset after the the histograms are updated
             endTimerState_(state_set);
         }
-        (*timer_info_container)[it->first] = & state_set->state_set_delta_;
     }
-    // let StateTimerUnit know when the container is ready,
     // "false" in updateStateHistogram_() means do not release timer
-    state_timer_unit_ptr_->updateStateHistogram_(timer_id_, false);
+    state_timer_unit_ptr_->updateStateHistogram_(timer_id_, state_deltas_, false);
     last_query_time_ = clk_->currentCycle();
 }
 
@@ -641,32 +762,24 @@ inline void StateTimerUnit::StateTimer::queryStateTimer_()
  */
 inline void StateTimerUnit::StateTimer::releaseStateTimer_()
 {
-    std::shared_ptr<StateTimerUnit::StateTimer::StateSet> state_set;
-    // get the container pointer
-    StateTimerDataContainerPtr
-            timer_info_container = state_timer_unit_ptr_->getStateTimerInfoContainer_();
-    // put the address of state_set_delta_ vector of each state set in the container
-    for (auto it=state_set_map_.begin(); it!=state_set_map_.end(); ++it)
+    for (auto & state_set : state_sets_)
     {
         // update the time delta if there is active state
-        state_set = it->second;
-        if (state_set->active_state_index_.isValid())
+        if (state_set.active_state_index_.isValid())
         {
-            sparta_assert(clk_->currentCycle() >= state_set->active_state_starting_time_,
+            sparta_assert(clk_->currentCycle() >= state_set.active_state_starting_time_,
                     "Wrong timing: current cycle less than state start time");
 
             // end the active state,
-            // state_set_delta_ will be reset after the the histograms are updated
+            // state_deltas_ will be reset after the the histograms are updated
             endTimerState_(state_set);
 
-            state_set->active_state_index_.clearValid();
-            state_set->active_state_starting_time_ = 0;
+            state_set.active_state_index_.clearValid();
+            state_set.active_state_starting_time_ = 0;
         }
-        (*timer_info_container)[it->first] = & state_set->state_set_delta_;
     }
-    // let StateTimerUnit know when the container is ready,
     // "true" in updateStateHistogram_() means release timer
-    state_timer_unit_ptr_->updateStateHistogram_(timer_id_, true);
+    state_timer_unit_ptr_->updateStateHistogram_(timer_id_, state_deltas_, true);
 }
 
 /**
@@ -675,9 +788,9 @@ inline void StateTimerUnit::StateTimer::releaseStateTimer_()
 inline void StateTimerUnit::StateTimerPool::queryAllActiveTimer()
 {
     // query all the active timer in pool
-    for (auto it=active_timer_map_ptr_->begin(); it!=active_timer_map_ptr_->end(); ++it)
+    for (StateTimer * timer : active_timers_)
     {
-        it->second->queryStateTimer_();
+        timer->queryStateTimer_();
     }
 }
 
@@ -687,10 +800,9 @@ inline void StateTimerUnit::StateTimerPool::queryAllActiveTimer()
 inline void StateTimerUnit::StateTimerPool::releaseAllActiveTimer()
 {
     // release all the active timer in pool
-    while (active_timer_map_ptr_->size()>0)
+    while (!active_timers_.empty())
     {
-        auto it= active_timer_map_ptr_->begin();
-        it->second->releaseStateTimer_();
+        active_timers_.back()->releaseStateTimer_();
     }
 }
 
@@ -698,34 +810,24 @@ inline void StateTimerUnit::StateTimerPool::releaseAllActiveTimer()
  * \brief StateTimerPool constructor
  *
  * \param parent The parent of StateTimerUnit
- * \param state_set_info_map_ptr A map using the state set hashcode,
- *                               and contains the number of states in the set,
- *                               used to initialize the timers
+ * \param layout The state sets used to initialize the timers
  * \param state_timer_unit_ptr The pointer to StateTimerUnit, where the pool belongs to
  * \param num_state_timer_init Initial number of total StateTimers in pool,
  *                             used as incremental interval
  */
 inline StateTimerUnit::StateTimerPool::StateTimerPool(TreeNode * parent,
-        StateTimerUnit::StateTimer::StateSetInfo state_set_info_map_ptr,
+        const StateTimerUnit::StateSetLayout & layout,
         StateTimerUnit * state_timer_unit_ptr, uint32_t num_state_timer_init):
-    timer_list_ptr_(new std::vector<StateTimerUnit::StateTimer::Handle>),
-    active_timer_map_ptr_(new std::unordered_map<StateTimerUnit::StateTimer::TimerId,
-                          StateTimerUnit::StateTimer::Handle>),
-    available_timer_vec_ptr_(new std::vector<std::pair<StateTimerUnit::StateTimer::TimerId,
-                             StateTimerUnit::StateTimer::Handle>>),
-    my_life_(this, [](void*){}),
+    handle_arena_(new StateTimer::HandleArena(this)),
     num_state_timer_init_(num_state_timer_init),
-    state_set_info_map_ptr_(state_set_info_map_ptr),
+    layout_(layout),
     clk_(parent->getClock()),
     state_timer_unit_ptr_(state_timer_unit_ptr)
 {
-    for (uint32_t i = 0; i < num_state_timer_init_; i++)
-    {
-        timer_list_ptr_->push_back(StateTimerUnit::StateTimer::Handle
-                    (new StateTimerUnit::StateTimer(clk_, i, state_set_info_map_ptr_,
-                                                    state_timer_unit_ptr_)));
-        available_timer_vec_ptr_->push_back(std::make_pair(i, timer_list_ptr_->at(i)));
-    }
+    timer_list_.reserve(num_state_timer_init_);
+    active_timers_.reserve(num_state_timer_init_);
+    available_timers_.reserve(num_state_timer_init_);
+    addTimers_(num_state_timer_init_);
 }
 
 /*!
@@ -757,19 +859,14 @@ inline StateTimerUnit::StateTimerUnit(TreeNode * parent,
     {
         parent->addChild(this);
     }
-    state_timer_data_container_ptr_ = StateTimerDataContainerPtr
-            (new std::unordered_map<uint32_t, std::vector<sparta::Clock::Cycle> *>);
-    state_set_info_map_ptr_ = StateTimerUnit::StateTimer::StateSetInfo
-            (new std::unordered_map<uint32_t, uint32_t>);
     static_assert(sizeof...(state_sets)>0,
             "At least one state enum set need to be provided.");
     addStateSet_(state_sets...);
     state_timer_pool_ptr_ = std::unique_ptr<StateTimerPool>
-            (new StateTimerPool(parent, state_set_info_map_ptr_, this, num_timer_init));
+            (new StateTimerPool(parent, layout_, this, num_timer_init));
     state_timer_histogram_ptr_ = std::unique_ptr<StateTimerHistogram>
         (new StateTimerHistogram(parent->getChild(state_timer_unit_name),
-                                 state_timer_unit_name, state_set_name_map_,
-                                 state_timer_data_container_ptr_, state_set_info_map_ptr_,
+                                 state_timer_unit_name, state_set_names_, layout_,
                                  lower, upper, bin_size));
 }
 
@@ -6,8 +6,6 @@
 #include <inttypes.h>
 #include <memory>
 #include <vector>
-#include <functional>
-#include <deque>
 #include <type_traits>
 #include <algorithm>
 #include <map>
@@ -87,39 +85,27 @@ namespace sparta {
         template<typename T> struct StateSet;
 
         //! Custom Deleter of individual State Tracker Units.
-        //  It contains a weak pointer pointing to the pool
-        //  from where the state tracker unit was dispatched.
-        //  If the weak pointer has not expired, the pool is still
-        //  alive and the tracker unit gets recycled and enqueued
-        //  back at the Dispatch Queue in the pool again. If the
-        //  weak pointer is expired, then the tracker unit is freed.
+        //  Each dispatched tracker unit points back to the pool it
+        //  came from.  If the pool is still alive, the tracker unit
+        //  gets recycled and put back on the pool's available list.
+        //  When the pool is torn down it clears that pointer in every
+        //  unit still out, and those units are freed instead.  The
+        //  deleter itself is stateless, so a state_tracker_ptr is
+        //  the size of a pointer.
         template<typename T>
         struct StateTrackerDeleter {
         public:
-
-            //! Construct the internal weak_ptr from a shared_ptr
-            //  reference.
-            explicit StateTrackerDeleter(
-                const std::weak_ptr<StatePool<T>> & weak_pool) :
-                weak_pool_ptr_(weak_pool) {}
-
-            StateTrackerDeleter() : valid_(false) {}
-
             inline void operator()(StateTrackerUnit<T> * ptr) const {
-                if(!valid_ || !ptr) {
+                if(!ptr) {
                     return;
                 }
-                if(!weak_pool_ptr_.expired()) {
-                    weak_pool_ptr_.lock()->releaseToPool(ptr);
+                if(ptr->pool_ != nullptr) {
+                    ptr->pool_->releaseToPool(ptr);
                 }
                 else {
                     delete ptr;
-                    ptr = nullptr;
                 }
             }
-
-            std::weak_ptr<StatePool<T>> weak_pool_ptr_;
-            bool valid_ {true};
         };
 
         //! Custom type for Unique Pointers to State Tracker Units.
@@ -133,21 +119,6 @@ namespace sparta {
         using state_tracker_ptr =
             std::unique_ptr<StateTrackerUnit<T>, StateTrackerDeleter<T>>;
 
-        //! Custom type of Unique Pointers to Queues which hold these
-        //  State Tracker Units. StatePool is a class template, templatized
-        //  on the enum class type which we are tracking. Each StatePool class
-        //  template contains its dedicated Tracker Queue, templatized on the
-        //  same enum type. This Tracker Queue holds all the available,
-        //  ready-to-go tracker units, ready for dispatching when the call comes.
-        //  The State Tracker Units, upon deletion, come back to this queue during
-        //  simulation and make themselves available again for tracking. Only when
-        //  the Simulation class is torn down, this Tracker Queue gets destroyed and
-        //  finally its custom deleter, which is TransferQueueData(), is called.
-        template<typename T>
-        using tracker_queue_ptr =
-            std::unique_ptr<std::deque<state_tracker_ptr<T>>,
-                std::function<void(std::deque<state_tracker_ptr<T>> *)>>;
-
         //! This is the polymorphic base class for the StatePool template class.
         //  This class has been designed to solve the problem of storing StatePool
         //  instances in a single homogenous container. This is difficult because
@@ -167,11 +138,13 @@ namespace sparta {
         };
 
         //! StatePool class template is templatized on the enum type we are tracking.
-        //  The basic functionality of this class is to maintain a Ready-To-Go Queue of
-        //  State Tracker Units of the same enum type. It also contains the running
-        //  number of all the State Tracker Units it has dispatched and a shared_ptr to
-        //  itself. The Pool class also contains the state tracking filename, passed
-        //  on from the StatePoolManager.
+        //  The basic functionality of this class is to maintain a Ready-To-Go list of
+        //  State Tracker Units of the same enum type, recycled as the State objects
+        //  holding them are destroyed. It also contains the running number of all the
+        //  State Tracker Units it has dispatched and the list of units currently out,
+        //  in which each unit knows its own position. The Pool class also contains the
+        //  state tracking filename, passed on from the StatePoolManager. When the pool
+        //  is destroyed, the available units' stats are aggregated and written out.
         template<typename T>
         class StatePool : public StatePoolBase {
         public:
@@ -186,18 +159,25 @@ namespace sparta {
                 //! We initialize instance count to 0 during construction.
                 instance_count_(0),
 
-                //! We set the pointer to refer to itself.
-                //  This is used later on when deleting Tracker Units.
-                pool_existence_reference_(this, [](void *){}),
-
                 //! Store the output filename.
-                tracking_filename_(tracking_filename),
+                tracking_filename_(tracking_filename) {}
 
-                //! We create a new queue and pass in the custom deleter for this queue
-                //  which is transferQueueData() API.
-                available_tracker_queue_(new std::deque<state_tracker_ptr<T>>(),
-                    [this](std::deque<state_tracker_ptr<T>> * raw_queue){
-                        transferQueueData(raw_queue);}) {}
+            StatePool(const StatePool &) = delete;
+            StatePool & operator=(const StatePool &) = delete;
+
+            //! Units still held by State objects are orphaned (they
+            //  are freed when released), and the available units are
+            //  aggregated into the tracking file.
+            ~StatePool() {
+                for(StateTrackerUnit<T> * unit : dispatched_units_) {
+                    unit->pool_ = nullptr;
+                }
+                dispatched_units_.clear();
+                transferPoolData_();
+                for(StateTrackerUnit<T> * unit : available_units_) {
+                    delete unit;
+                }
+            }
 
             //! Method which associates this StatePool template instantiation
             //  with a Unique ID. This is not a Thread Safe method.
@@ -214,52 +194,54 @@ namespace sparta {
                 //  increases by 1.
                 ++instance_count_;
 
-                //! If the Queue of tracker units is empty, we create a new
-                //  Tracker Unit on the fly and dispatch it.
-                if(available_tracker_queue_->empty()) {
-                    state_tracker_ptr<T> state_tracker_unit(
-                        new StateTrackerUnit<T>(scheduler),
-                        StateTrackerDeleter<T>(pool_existence_reference_));
-                    return state_tracker_unit;
+                //! If there are available Tracker Units to go, we just take the
+                //  most recently released one and dispatch it. This is where the
+                //  recycling of state tracker units happens. Otherwise, we create
+                //  a new Tracker Unit on the fly and dispatch it.
+                StateTrackerUnit<T> * unit = nullptr;
+                if(available_units_.empty()) {
+                    unit = new StateTrackerUnit<T>(scheduler);
                 }
-
-                //! If the Queue has available Tracker Units to go, we just pop
-                //  one from the front and dispatch it. This is where the recycling
-                //  state tracker units happen.
-                state_tracker_ptr<T> state_tracker_unit {
-                    std::move(available_tracker_queue_->front())};
-                available_tracker_queue_->pop_front();
-                return state_tracker_unit;
+                else {
+                    unit = available_units_.back();
+                    available_units_.pop_back();
+                }
+                unit->pool_ = this;
+                unit->dispatched_index_ = dispatched_units_.size();
+                dispatched_units_.emplace_back(unit);
+                return state_tracker_ptr<T>(unit);
             }
 
             //! Method which is invoked when individual State Tracker Units
             //  need to be returned back to the pool during recycling.
-            void releaseToPool(StateTrackerUnit<T> *& raw_ptr){
-
-                //! Wrap this raw pointer into a unique pointer.
-                //  This makes the code safe from unexpected memory leaks.
-                state_tracker_ptr<T> tracker_unique_ptr(raw_ptr,
-                    StateTrackerDeleter<T>(pool_existence_reference_));
+            void releaseToPool(StateTrackerUnit<T> * unit){
 
                 //! This tracker unit cannot be a nullptr.
-                sparta_assert(tracker_unique_ptr);
+                sparta_assert(unit != nullptr);
+                sparta_assert(unit->dispatched_index_ < dispatched_units_.size() &&
+                              dispatched_units_[unit->dispatched_index_] == unit);
+
+                //! Move the last dispatched unit into this one's place.
+                StateTrackerUnit<T> * last = dispatched_units_.back();
+                last->dispatched_index_ = unit->dispatched_index_;
+                dispatched_units_[unit->dispatched_index_] = last;
+                dispatched_units_.pop_back();
 
                 //! If this tracker unit has some un-processed data in it
                 //  from its last tracking run, we collect and process it
                 //  before releasing it back in the pool.
-                tracker_unique_ptr->updateLastDeltas();
+                unit->updateLastDeltas();
 
-                //! Finally, push the Tracker Unit at the back of the queue.
-                available_tracker_queue_->push_back(std::move(tracker_unique_ptr));
+                //! Finally, put the Tracker Unit on the available list.
+                available_units_.emplace_back(unit);
             }
 
-            //! This is the main method, the custom deleter of the Tracker Queues.
+        private:
+
+            //! This is the main method, called by the destructor.
             //  This method gets called once and only once for each tracked enum type,
             //  when the StatePool instantiation is getting destroyed.
-            void transferQueueData(std::deque<state_tracker_ptr<T>> * raw_queue) {
-
-                //! Wrap the raw pointer into a unique_ptr, a good practise.
-                std::unique_ptr<std::deque<state_tracker_ptr<T>>> queue_ptr(raw_queue);
+            void transferPoolData_() {
 
                 //! If we have reached this point, instance count cannot be 0.
                 sparta_assert(instance_count_);
@@ -267,29 +249,22 @@ namespace sparta {
                 //! Open the state tracking file.
                 std::fstream data_file(tracking_filename_, std::ios_base::app);
 
-                //! We need to reset this self-reference pointer so that the
-                //  weak_pointer in StateTrackerDeleter pointing here, expires,
-                //  and stops tracker units to come back to the queue.
-                pool_existence_reference_.reset();
-
                 //! Create a vector to hold the results.
                 std::vector<sparta::Scheduler::Tick> stats_vector(
                     static_cast<uint64_t>(T::__LAST) + 1, 0);
 
-                //! We process each and every State Tracker Unit in the queue.
-                std::for_each(queue_ptr->begin(), queue_ptr->end(),
-                    [&stats_vector](const state_tracker_ptr<T> & item) {
+                //! We process each and every available State Tracker Unit.
+                for(const StateTrackerUnit<T> * item : available_units_) {
 
                     //! Grab the Calculation Engine from the tracker unit being processed.
                     const StateSet<T> & state_set {item->getStateSet()};
                     sparta_assert(state_set.state_delta_set.size() == stats_vector.size());
 
                     // Accumulate the data from this tracker unit into the result vector.
-                    std::transform(stats_vector.begin(), stats_vector.end(),
-                                   state_set.state_delta_set.begin(), stats_vector.begin(),
-                                   std::plus<sparta::Scheduler::Tick>()); });
-
-                queue_ptr->clear();
+                    for(size_t i = 0; i < stats_vector.size(); ++i) {
+                        stats_vector[i] += state_set.state_delta_set[i];
+                    }
+                }
 
                 //! Calculate average stats from the aggregate stats by using
                 //  total instance count.
@@ -339,25 +314,19 @@ namespace sparta {
                 data_file << "\n\n";
             }
 
-            private:
-
                 //! The total number of State Tracker Units dispatched.
                 uint64_t instance_count_;
 
-                //! Shared Pointer to itself which gets passed into StateTrackerDeleter.
-                //  If this self-reference is reset, the StateTrackerDeleter knows the
-                //  pool is going through destruction and that State Tracker Units
-                //  should not be recycled anymore. If the reference is still valid,
-                //  the State Tracker Units need to com back to the queue, recycled.
-                std::shared_ptr<StatePool<T>> pool_existence_reference_;
-
                 //! This is the State Tracking filename where all the histogram
                 //  data will be written to.
                 std::string tracking_filename_;
 
-                //! This is the Queue which holds all the available State Tracker
-                //  Units. It has a custom type with its own custom deleter.
-                tracker_queue_ptr<T> available_tracker_queue_;
+                //! The available State Tracker Units, owned by the pool.
+                std::vector<StateTrackerUnit<T> *> available_units_;
+
+                //! The State Tracker Units held by State objects. Each unit
+                //  knows its position here (StateTrackerUnit::dispatched_index_).
+                std::vector<StateTrackerUnit<T> *> dispatched_units_;
 
                 //! This method extracts the name of the enum class type as a string.
                 //  We put this string in our output text file to label the various
@@ -585,6 +554,9 @@ namespace sparta {
         //  to perform arithmetical calculations.
         template<typename EnumT>
         class StateTrackerUnit {
+            friend struct StateTrackerDeleter<EnumT>;
+            friend class StatePool<EnumT>;
+
         public:
             StateTrackerUnit(Scheduler * scheduler) :
                 scheduler_instance_(scheduler),
@@ -679,6 +651,13 @@ namespace sparta {
             const sparta::Scheduler * scheduler_instance_ {nullptr};
             sparta::Scheduler::Tick time_assigned_ {0};
             StateSet<EnumT> state_set_ {};
+
+            //! The pool this unit was dispatched from, or nullptr if
+            //  that pool has been torn down
+            StatePool<EnumT> * pool_ {nullptr};
+
+            //! Position of this unit in the pool's dispatched list
+            size_t dispatched_index_ {0};
         };
     }
 
@@ -19,6 +19,7 @@
 #include <set>
 #include <map>
 #include <unordered_map>
+#include <string_view>
 #include <regex>
 #include <functional>
 #include <memory>
@@ -34,6 +35,7 @@
 #include "sparta/utils/SpartaAssert.hpp"
 #include "sparta/utils/Printing.hpp"
 #include "sparta/utils/StringManager.hpp"
+#include "sparta/utils/GlobPattern.hpp"
 #include "sparta/kernel/PhasedObject.hpp"
 
 namespace sparta {
@@ -255,6 +257,14 @@ namespace sparta
          */
         typedef std::multimap<std::string, TreeNode*> ChildNameMapping;
 
+        /*!
+         * \brief Hashed index over the keys of a ChildNameMapping for O(1)
+         * lookup of children by name, alias, or group+index. Keys view the
+         * strings owned by the ChildNameMapping entries. Iteration order is
+         * unspecified; use ChildNameMapping when order matters.
+         */
+        typedef std::unordered_multimap<std::string_view, TreeNode*> ChildNameIndex;
+
         /*!
          * \brief Index within a group
          */
@@ -440,10 +450,11 @@ namespace sparta
         static const std::map<const TreeNode*, WeakPtr>& getParentlessNodes();
 
         /*!
-         * \brief Gets the vector of all TreeNodes currently known to be
-         * constructed
+         * \brief Gets all TreeNodes currently known to be constructed
+         * \return A copy of the node registry, in pointer order. The
+         * registry itself is hashed, so this is meant for debugging only
          */
-        static const std::map<const TreeNode*, WeakPtr>& getAllNodes();
+        static std::map<const TreeNode*, WeakPtr> getAllNodes();
 
         /*!
          * \brief Prints the list of all TreeNodes currently known to be
@@ -1436,14 +1447,14 @@ namespace sparta
 
         /*!
          * \brief Finds immediate children with some identity (name or alias)
-         * matching a regex.
-         * \param expr Expression to match with child node identities
+         * matching a pattern.
+         * \param expr Compiled pattern to match with child node identities
          * \param found All nodes with matching identities are appended to this
          * vector. This vector is not cleared
          * \return Number of children found in this call
          * \note Does not recurse
          */
-        virtual uint32_t findImmediateChildren_(std::regex& expr,
+        virtual uint32_t findImmediateChildren_(const utils::GlobPattern& expr,
                                                 std::vector<TreeNode*>& found,
                                                 std::vector<std::vector<std::string>>& replacements,
                                                 bool allow_private=false);
@@ -1451,14 +1462,14 @@ namespace sparta
         /*!
          * \brief Variant of findImmediateChildren_ with no replacements vector
          */
-        uint32_t findImmediateChildren_(std::regex& expr,
+        uint32_t findImmediateChildren_(const utils::GlobPattern& expr,
                                         std::vector<TreeNode*>& found,
                                         bool allow_private=false);
 
         /*!
          * \brief Const-qualified variant of findImmediateChildren_
          */
-        virtual uint32_t findImmediateChildren_(std::regex& expr,
+        virtual uint32_t findImmediateChildren_(const utils::GlobPattern& expr,
                                                 std::vector<const TreeNode*>& found,
                                                 std::vector<std::vector<std::string>>& replacements,
                                                 bool allow_private=false) const;
@@ -1467,7 +1478,7 @@ namespace sparta
          * \brief Variant of const-qualified findImmediateChildren_ with no
          * replacements vector
          */
-        uint32_t findImmediateChildren_(std::regex& expr,
+        uint32_t findImmediateChildren_(const utils::GlobPattern& expr,
                                         std::vector<const TreeNode*>& found,
                                         bool allow_private=false) const;
 
@@ -2479,7 +2490,7 @@ namespace sparta
          * expression
          */
         static bool identityMatchesPattern_(const std::string& ident,
-                                            std::regex& expr,
+                                            const utils::GlobPattern& expr,
                                             std::vector<std::string>& replacements);
 
 
@@ -2487,7 +2498,7 @@ namespace sparta
          * \brief Variant of identityMatchesPattern_ with no replacements vector
          */
         static bool identityMatchesPattern_(const std::string& ident,
-                                            std::regex& expr);
+                                            const utils::GlobPattern& expr);
 
         /*!
          * \brief Gets the previous name between two '.' chars in a string starting
@@ -3931,6 +3942,19 @@ namespace sparta
         void addChildNameMapping_(const std::string& name,
                                   TreeNode* child);
 
+        /*!
+         * \brief Removes all child name mappings for the given identifier
+         */
+        void removeChildNameMapping_(const std::string& name);
+
+        /*!
+         * \brief Looks up the child mapped to an identifier (name, alias or
+         * group+index) through names_index_.
+         * \return The first child mapped to name (in mapping insertion
+         * order) or nullptr if there is none
+         */
+        TreeNode* findChildNameMapping_(const std::string& name) const;
+
         /*!
          * \brief Implements locateNotificationSources using a name string
          * interned with StringManager.
@@ -4434,6 +4458,12 @@ namespace sparta
          */
         ChildNameMapping names_;
 
+        /*!
+         * \brief Hashed index of names_ (excluding null mappings) used for
+         * child lookup and collision checks
+         */
+        ChildNameIndex names_index_;
+
         /*!
          * \brief Map of observers registered on this node.
          *
@@ -4520,7 +4550,7 @@ namespace sparta
              * \li Can be used to detect whether a node causing an error/segfault
              * has already been deallocated or not.
              */
-            std::map<const TreeNode*, WeakPtr> node_map_;
+            std::unordered_map<const TreeNode*, WeakPtr> node_map_;
         };
         static TreeNodeStatics *statics_;
 
@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <vector>
 #include <numeric>
@@ -17,6 +19,7 @@
 #include "sparta/utils/SpartaAssert.hpp"
 #include "sparta/statistics/Counter.hpp"
 #include "sparta/statistics/CycleCounter.hpp"
+#include "sparta/statistics/ReadOnlyCounter.hpp"
 #include "sparta/statistics/StatisticDef.hpp"
 #include "sparta/statistics/StatisticSet.hpp"
 #include "sparta/simulation/Resource.hpp"
@@ -36,6 +39,11 @@ namespace sparta
      * This is possible because this histogram only deals with positive integer
      * values.
      *
+     * Each bin keeps its accumulated cycles and the cycle it started
+     * counting at in plain arrays; addValue closes one interval, adds one
+     * cycle to a bin and opens the next without touching any TreeNode.  The
+     * bin counters in the StatisticSet are ReadOnlyCounter views which add
+     * the open interval when read.
      */
     class CycleHistogramBase
     {
@@ -76,10 +84,14 @@ namespace sparta
          */
         void addValue(uint64_t val)
         {
-            stopCounting_(last_value_);
-            startCounting_(val);
-            stopCounting_(val, 1);
-            startCounting_(idle_value_, 1);
+            // Same as stopping the last value, counting val from now to
+            // now + 1 and starting the idle value at now + 1
+            const Clock::Cycle now = clk_->elapsedCycles();
+            stopBin_(last_idx_, now);
+            ++bin_cycles_[getBinIndex_(val)];
+            startBin_(idle_idx_, now + 1);
+            last_value_ = idle_value_;
+            last_idx_ = idle_idx_;
 
             updateMaxValues_(val);
         }
@@ -92,23 +104,24 @@ namespace sparta
         double getStandardDeviation() const {
 
             // Summation of counts in normal bins plus underflow bin and
-            // overflow bin.
-            const double sum = std::accumulate(bin_.begin(), bin_.end(), 0.0)
-                + (*underflow_bin_) + (*overflow_bin_);
+            // overflow bin, in that order so the floating point result
+            // matches the per-bin counters this replaced.
+            const std::vector<uint64_t> counts = getBinCycles_();
+            const double sum = std::accumulate(counts.begin() + 1, counts.end() - 1, 0.0)
+                + counts.front() + counts.back();
 
             // Total number of bins is number of regular bins
             // plus one for underflow bin and plus one for
             // overflow bin.
-            const std::size_t total_num_bins = bin_.size() + 2;
+            const std::size_t total_num_bins = counts.size();
 
             const double mean = sum / total_num_bins;
             double accum = 0.0;
-            std::for_each(bin_.begin(), bin_.end(), [&](const sparta::CycleCounter& c) {
-                auto c_get = c.get();
-                accum += pow(c_get - mean, 2);
+            std::for_each(counts.begin() + 1, counts.end() - 1, [&](const uint64_t c) {
+                accum += pow(c - mean, 2);
             });
-            accum += pow((*underflow_bin_ - mean), 2);
-            accum += pow((*overflow_bin_ - mean), 2);
+            accum += pow((counts.front() - mean), 2);
+            accum += pow((counts.back() - mean), 2);
             return std::sqrt(accum / (total_num_bins - 1));
         }
 
@@ -121,13 +134,14 @@ namespace sparta
 
             // Summation of counts in normal bins plus underflow bin and
             // overflow bin.
-            const double sum = std::accumulate(bin_.begin(), bin_.end(), 0.0)
-                + (*underflow_bin_) + (*overflow_bin_);
+            const std::vector<uint64_t> counts = getBinCycles_();
+            const double sum = std::accumulate(counts.begin() + 1, counts.end() - 1, 0.0)
+                + counts.front() + counts.back();
 
             // Total number of bins is number of regular bins
             // plus one for underflow bin and plus one for
             // overflow bin.
-            const std::size_t total_num_bins = bin_.size() + 2;
+            const std::size_t total_num_bins = counts.size();
 
             return  sum / total_num_bins;
         }
@@ -142,36 +156,39 @@ namespace sparta
         /*!
          * \brief Return vector of regular bin counts.
          */
-        const std::vector<sparta::CycleCounter>& getRegularBin() const{
-            return bin_;
+        std::vector<uint64_t> getRegularBin() const{
+            std::vector<uint64_t> counts = getBinCycles_();
+            counts.pop_back();
+            counts.erase(counts.begin());
+            return counts;
         }
 
         /*!
          * \brief Return count of underflow bin.
          */
-        const sparta::CycleCounter& getUnderflowBin() const{
-            return *underflow_bin_;
+        uint64_t getUnderflowBin() const{
+            return getBinCycles_(0);
         }
 
         /*!
          * \brief Return count of overflow bin.
          */
-        const sparta::CycleCounter& getOverflowBin() const{
-            return *overflow_bin_;
+        uint64_t getOverflowBin() const{
+            return getBinCycles_(num_bins_ + 1);
         }
 
         /*!
          * \brief Return underflow probability.
          */
         double getUnderflowProbability() const{
-            return ((static_cast<double>(*underflow_bin_))/(static_cast<double>(*total_)));
+            return ((static_cast<double>(getUnderflowBin()))/(static_cast<double>(*total_)));
         }
 
         /*!
          * \brief Return overflow probability.
          */
         double getOverflowProbability() const{
-            return ((static_cast<double>(*overflow_bin_))/(static_cast<double>(*total_)));
+            return ((static_cast<double>(getOverflowBin()))/(static_cast<double>(*total_)));
         }
 
         /*!
@@ -179,8 +196,9 @@ namespace sparta
          */
         const std::vector<double>& recomputeRegularBinProbabilities() const{
             bin_prob_vector_.clear();
-            for(const auto& b : bin_){
-                bin_prob_vector_.emplace_back(((static_cast<double>(b))/(static_cast<double>(*total_))));
+            const double total = static_cast<double>(*total_);
+            for(uint64_t i = 1; i <= num_bins_; ++i){
+                bin_prob_vector_.emplace_back(((static_cast<double>(getBinCycles_(i)))/total));
             }
             return bin_prob_vector_;
         }
@@ -193,8 +211,11 @@ namespace sparta
         void setValue(uint64_t val)
         {
             if (last_value_ != val) {
-                stopCounting_(last_value_);
-                startCounting_(val);
+                const Clock::Cycle now = clk_->elapsedCycles();
+                stopBin_(last_idx_, now);
+                last_idx_ = getBinIndex_(val);
+                startBin_(last_idx_, now);
+                last_value_ = val;
 
                 updateMaxValues_(val);
             }
@@ -240,6 +261,12 @@ namespace sparta
             sparta_assert_context(actual_num_bins == num_bins_,
                                 "CycleHistogramBase: Actual number of bins (" << actual_num_bins
                                 << ") is not an integer");
+
+            // Underflow, regular bins, overflow
+            bin_cycles_.assign(num_bins_ + 2, 0);
+            bin_start_.assign(num_bins_ + 2, NOT_COUNTING);
+            idle_idx_ = getBinIndex_(idle_value_);
+            last_idx_ = getBinIndex_(last_value_);
         }
 
         /*!
@@ -250,7 +277,8 @@ namespace sparta
         {
             std::stringstream str;
             str << std::dec;
-            uint64_t running_sum = *underflow_bin_;
+            const std::vector<uint64_t> counts = getBinCycles_();
+            uint64_t running_sum = counts.front();
             str << "\t" <<  name << "[ UF ] = " << running_sum << std::endl;
             uint64_t start_val = lower_val_;
             uint64_t end_val  = start_val + num_vals_per_bin_ - 1;
@@ -258,13 +286,13 @@ namespace sparta
                 if (end_val > upper_val_) {
                     end_val = upper_val_;
                 }
-                running_sum +=  (bin_[i]);
+                running_sum +=  counts[i + 1];
                 str << "\t" << name
                     << "[ " << start_val << "-" << end_val << " ] = "
                     << running_sum << '\n';
                 end_val  += num_vals_per_bin_;
             }
-            running_sum += *overflow_bin_;
+            running_sum += counts.back();
             str << "\t" << name << "[ OF ] = " << running_sum << std::endl;
             return str.str();
         }
@@ -278,17 +306,8 @@ namespace sparta
          */
         void startCounting_(uint64_t val, uint64_t delay = 0)
         {
-            if (val < lower_val_) {
-                (*underflow_bin_).startCounting(delay);
-            }
-            else if (val > upper_val_) {
-                (*overflow_bin_).startCounting(delay);
-            }
-            else {
-                uint64_t idx = (val - lower_val_) >> idx_shift_amount_;
-                (bin_.at(idx)).startCounting(delay);
-            }
-
+            last_idx_ = getBinIndex_(val);
+            startBin_(last_idx_, clk_->elapsedCycles() + delay);
             last_value_ = val;
         }
 
@@ -302,16 +321,59 @@ namespace sparta
          */
         void stopCounting_(uint64_t val, uint64_t delay = 0)
         {
-            if (val < lower_val_) {
-                (*underflow_bin_).stopCounting(delay);
-            }
-            else if (val > upper_val_) {
-                (*overflow_bin_).stopCounting(delay);
+            stopBin_(getBinIndex_(val), clk_->elapsedCycles() + delay);
+        }
+
+        /*!
+         * \brief Index of the bin in bin_cycles_ that val falls into
+         *
+         * 0 is the underflow bin and num_bins_ + 1 the overflow bin.  Written
+         * as selects rather than branches; the index computed for an out of
+         * range value is discarded.
+         */
+        uint64_t getBinIndex_(uint64_t val) const
+        {
+            uint64_t idx = ((val - lower_val_) >> idx_shift_amount_) + 1;
+            idx = (val < lower_val_) ? 0 : idx;
+            idx = (val > upper_val_) ? (num_bins_ + 1) : idx;
+            return idx;
+        }
+
+        //! Start counting bin idx at the given cycle
+        void startBin_(uint64_t idx, Clock::Cycle start)
+        {
+            sparta_assert(bin_start_[idx] == NOT_COUNTING);
+            bin_start_[idx] = start;
+        }
+
+        //! Stop counting bin idx at the given cycle
+        void stopBin_(uint64_t idx, Clock::Cycle stop)
+        {
+            sparta_assert(bin_start_[idx] != NOT_COUNTING);
+            sparta_assert(stop >= bin_start_[idx]);
+            bin_cycles_[idx] += stop - bin_start_[idx];
+            bin_start_[idx] = NOT_COUNTING;
+        }
+
+        //! Cycles counted in bin idx, including a bin still counting
+        uint64_t getBinCycles_(uint64_t idx) const
+        {
+            uint64_t cycles = bin_cycles_[idx];
+            const Clock::Cycle elapsed = clk_->elapsedCycles();
+            if (elapsed > bin_start_[idx]) {
+                cycles += elapsed - bin_start_[idx];
             }
-            else {
-                const uint64_t idx = (val - lower_val_) >> idx_shift_amount_;
-                (bin_.at(idx)).stopCounting(delay);
+            return cycles;
+        }
+
+        //! Cycles counted in every bin, underflow first and overflow last
+        std::vector<uint64_t> getBinCycles_() const
+        {
+            std::vector<uint64_t> counts(bin_cycles_.size());
+            for (uint64_t i = 0; i < counts.size(); ++i) {
+                counts[i] = getBinCycles_(i);
             }
+            return counts;
         }
 
         /*!
@@ -320,9 +382,7 @@ namespace sparta
          */
         void updateMaxValues_(uint64_t val)
         {
-            if (val > max_value_->get()) {
-                max_value_->set(val);
-            }
+            max_value_ = std::max(max_value_, val);
         }
 
         void initializeStats_(StatisticSet* sset,
@@ -335,17 +395,18 @@ namespace sparta
                               InstrumentationNode::visibility_t stat_vis_avg = InstrumentationNode::AUTO_VISIBILITY,
                               const std::vector<std::string>& histogram_state_names = {})
         {
-            // Reserve to use emplacement without tree child reordering
-            bin_.reserve(num_bins_);
+            clk_ = clk;
+            bin_ctrs_.reserve(bin_cycles_.size());
 
             const std::string name_total = name.empty() ? std::string("total") : (name + "_total");
 
             // Setup the underflow bins
             const std::string name_uf = name.empty() ? std::string("UF") : (name + "_UF");
-            underflow_bin_ = &sset->createCounter<sparta::CycleCounter>(name_uf,
-                                                                      "underflow bin",
-                                                                      Counter::COUNT_NORMAL,
-                                                                      clk);
+            bin_ctrs_.emplace_back(new BinCounter(sset, name_uf,
+                                                  TreeNode::GROUP_NAME_NONE, TreeNode::GROUP_IDX_NONE,
+                                                  "underflow bin",
+                                                  InstrumentationNode::DEFAULT_VISIBILITY,
+                                                  *this, 0));
             underflow_probability_.reset(new StatisticDef(sset,
                                                           name_uf + "_probability",
                                                           "Probability of underflow",
@@ -357,7 +418,7 @@ namespace sparta
             // Setup the normal bins
             uint64_t start_val = lower_val_;
             uint64_t end_val   = start_val + num_vals_per_bin_ - 1;
-            std::string weighted_total_str = "( " + std::to_string(lower_val_) + " * " + underflow_bin_->getName() + " )";
+            std::string weighted_total_str = "( " + std::to_string(lower_val_) + " * " + bin_ctrs_.front()->getName() + " )";
             std::string weighted_total_nonzero_str;
             std::string count0_statistic_str;
             for (uint64_t i = 0; i < num_bins_; ++i)
@@ -418,12 +479,11 @@ namespace sparta
                     count_visibility = visibility;
                 }
 
-                bin_.emplace_back(sparta::CycleCounter(sset,
-                                                       str.str(),
-                                                       name.empty() ? std::string("cycle_count") : name, i,
-                                                       description + " histogram bin",
-                                                       sparta::Counter::COUNT_NORMAL,
-                                                       clk, visibility));
+                bin_ctrs_.emplace_back(new BinCounter(sset,
+                                                      str.str(),
+                                                      name.empty() ? std::string("cycle_count") : name, i,
+                                                      description + " histogram bin",
+                                                      visibility, *this, i + 1));
                 probabilities_.emplace_back(new StatisticDef(sset,
                                                              str.str() + "_probability",
                                                              str.str() + " bin probability",
@@ -449,19 +509,20 @@ namespace sparta
 
             // Setup the overflow bins
             const std::string name_of = name.empty() ? std::string("OF") : (name + "_OF");
-            overflow_bin_ = &sset->createCounter<sparta::CycleCounter>(name_of,
-                                                                     "overflow bin",
-                                                                     Counter::COUNT_NORMAL,
-                                                                     clk);
+            bin_ctrs_.emplace_back(new BinCounter(sset, name_of,
+                                                  TreeNode::GROUP_NAME_NONE, TreeNode::GROUP_IDX_NONE,
+                                                  "overflow bin",
+                                                  InstrumentationNode::DEFAULT_VISIBILITY,
+                                                  *this, num_bins_ + 1));
             overflow_probability_.reset(new StatisticDef(sset,
                                                          name_of + "_probability",
                                                          "Probability of overflow",
                                                          sset,
                                                          name_of + " / " + name_total));
 
-            weighted_total_str += " + ( " + std::to_string(upper_val_) + " * " + overflow_bin_->getName() + " )";
+            weighted_total_str += " + ( " + std::to_string(upper_val_) + " * " + bin_ctrs_.back()->getName() + " )";
             if (!count0_statistic_str.empty()) {
-                weighted_total_nonzero_str += " + ( " + std::to_string(upper_val_) + " * " + overflow_bin_->getName() + " )";
+                weighted_total_nonzero_str += " + ( " + std::to_string(upper_val_) + " * " + bin_ctrs_.back()->getName() + " )";
             }
 
             if(stat_vis_avg == InstrumentationNode::AUTO_VISIBILITY) {
@@ -478,11 +539,12 @@ namespace sparta
             if(stat_vis_max == InstrumentationNode::AUTO_VISIBILITY) {
                 stat_vis_max = InstrumentationNode::DEFAULT_VISIBILITY;
             }
-            max_value_.reset(new Counter(sset,
-                                         name.empty() ? std::string("max_value") : (name + "_max"),
-                                         "The maximum value in the histogram",
-                                         CounterBase::COUNT_LATEST,
-                                         stat_vis_max));
+            max_value_ctr_.reset(new ReadOnlyCounter(sset,
+                                                     name.empty() ? std::string("max_value") : (name + "_max"),
+                                                     "The maximum value in the histogram",
+                                                     CounterBase::COUNT_LATEST,
+                                                     &max_value_,
+                                                     stat_vis_max));
 
             // Compute weighted average if single value per bin
             if (SPARTA_EXPECT_TRUE(num_vals_per_bin_ == 1)) {
@@ -525,9 +587,9 @@ namespace sparta
                 }
             }
 
-            if (!bin_.empty()) {
+            if (num_bins_ > 0) {
                 std::ostringstream fullness_equation;
-                fullness_equation << bin_.back().getName() + " + " + name_of;
+                fullness_equation << bin_ctrs_[num_bins_]->getName() + " + " + name_of;
                 const std::string fullness_equation_str = fullness_equation.str();
 
                 const std::string full_name = name.empty() ? std::string("full") : (name + "_full");
@@ -555,15 +617,50 @@ namespace sparta
         const uint64_t num_vals_per_bin_; //!< Number of values captured by each bin
         const uint64_t idle_value_; //!< Value to capture when nothing is captured
 
+        /*!
+         * \brief View of one bin of the histogram, including the cycles of
+         * an interval that is still open
+         */
+        class BinCounter final : public ReadOnlyCounter
+        {
+        public:
+            BinCounter(StatisticSet * sset,
+                       const std::string & name,
+                       const std::string & group,
+                       TreeNode::group_idx_type group_idx,
+                       const std::string & desc,
+                       visibility_t visibility,
+                       const CycleHistogramBase & hist,
+                       uint64_t idx) :
+                ReadOnlyCounter(sset, name, group, group_idx, desc,
+                                Counter::COUNT_NORMAL, nullptr, visibility),
+                hist_(hist),
+                idx_(idx)
+            { }
+
+            counter_type get() const override {
+                return hist_.getBinCycles_(idx_);
+            }
+
+        private:
+            const CycleHistogramBase & hist_;
+            const uint64_t idx_;
+        };
+
+        //! bin_start_ of a bin which is not counting
+        static constexpr Clock::Cycle NOT_COUNTING = std::numeric_limits<Clock::Cycle>::max();
+
+        const Clock * clk_ = nullptr; //!< Clock the bins count cycles of
         std::unique_ptr<sparta::CycleCounter> total_; //!< Total values
-        sparta::CycleCounter* underflow_bin_; //!< Bin for all underflow
-        sparta::CycleCounter* overflow_bin_; //!< Bin for all overflow
-        std::vector<sparta::CycleCounter> bin_; //!< Regular bins
+        std::vector<uint64_t> bin_cycles_; //!< Closed cycles of the underflow bin, regular bins, overflow bin
+        std::vector<Clock::Cycle> bin_start_; //!< Start of each bin's open interval or NOT_COUNTING
+        std::vector<std::unique_ptr<BinCounter>> bin_ctrs_; //!< Views of the bins, in bin_cycles_ order
         std::unique_ptr<sparta::StatisticDef> underflow_probability_; //!< Probability of underflow
         std::unique_ptr<sparta::StatisticDef> overflow_probability_; //!< Probability of overflow
         std::vector<std::unique_ptr<sparta::StatisticDef>> probabilities_; //!< Probabilities of each normal bin
         std::unique_ptr<sparta::StatisticDef> weighted_non_zero_average_;
-        std::unique_ptr<sparta::Counter> max_value_; //!< The maximum value in the histogram
+        uint64_t max_value_ = 0; //!< The maximum value in the histogram
+        std::unique_ptr<sparta::ReadOnlyCounter> max_value_ctr_; //!< View of max_value_
         std::unique_ptr<sparta::StatisticDef> weighted_average_; //!< The weighted average
         std::unique_ptr<sparta::StatisticDef> fullness_; //!< Sum of the max bin and the overflow bin
         std::unique_ptr<sparta::StatisticDef> fullness_probability_; //!< Probability of the histogram being in a full state
@@ -571,6 +668,8 @@ namespace sparta
         uint64_t num_bins_; //!< Number of bins
         uint64_t idx_shift_amount_; //!< Number of bits which cannot distinguish between bins for a given input value
         uint64_t last_value_ = 0; //!< Last value updated
+        uint64_t last_idx_ = 0; //!< Bin of last_value_
+        uint64_t idle_idx_ = 0; //!< Bin of idle_value_
         mutable std::vector<double> bin_prob_vector_;
     }; // class CycleHistogramBase
 
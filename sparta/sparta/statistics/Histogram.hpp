@@ -17,6 +17,7 @@
 #include "sparta/simulation/TreeNode.hpp"
 #include "sparta/utils/SpartaAssert.hpp"
 #include "sparta/statistics/Counter.hpp"
+#include "sparta/statistics/ReadOnlyCounter.hpp"
 #include "sparta/statistics/StatisticDef.hpp"
 #include "sparta/statistics/StatisticSet.hpp"
 #include "sparta/simulation/Resource.hpp"
@@ -37,9 +38,31 @@ namespace sparta
  *
  * This class is the base class for two different Histograms:  one which is
  * a TreeNode, and one which is not.
+ *
+ * Bin counts are kept in a plain array so that addValue is a shift, two
+ * selects and an increment.  The bin, total, sum and maxval counters in
+ * the StatisticSet are ReadOnlyCounter views onto these plain integers,
+ * and the probability and average StatisticDefs are only evaluated when
+ * a report reads them.
  */
 class HistogramBase
 {
+public:
+    /*!
+     * \brief Not copy-constructable
+     */
+    HistogramBase(const HistogramBase&) = delete;
+
+    /*!
+     * \brief Not move-constructable
+     */
+    HistogramBase(HistogramBase&&) = delete;
+
+    /*!
+     * \brief Not assignable
+     */
+    void operator=(const HistogramBase&) = delete;
+
 protected:
     /*!
      * \brief HistogramBase constructor
@@ -67,6 +90,9 @@ protected:
         sparta_assert_context(actual_num_bins == num_bins_,
                             "Histogram: Actual number of bins (" << actual_num_bins
                             << ") is not an integer");
+
+        // Underflow, regular bins, overflow
+        counts_.assign(num_bins_ + 2, 0);
     }
 
 public:
@@ -78,20 +104,11 @@ public:
      */
     void addValue(uint64_t val)
     {
-        ++(*total_values_);
-        *running_sum_ += val;
+        ++total_values_;
+        running_sum_ += val;
+        ++counts_[getBinIndex_(val)];
 
-        if (val < lower_val_) {
-            ++ (*underflow_bin_);
-        }
-        else if (val > upper_val_) {
-            ++ (*overflow_bin_);
-        }
-        else {
-            uint32_t idx = (val - lower_val_) >> idx_shift_amount_;
-            ++ (bin_.at(idx));
-        }
-        if (max_counters_.size()) {
+        if (max_values_.size()) {
             updateMaxValues_(val);
         }
 
@@ -106,22 +123,20 @@ public:
 
         // Summation of counts in normal bins plus underflow bin and
         // overflow bin.
-        const double sum = std::accumulate(bin_.begin(), bin_.end(), 0.0)
-            + (*underflow_bin_) + (*overflow_bin_);
+        const double sum = sumCounts_();
 
         // Total number of bins is number of regular bins
         // plus one for underflow bin and plus one for
         // overflow bin.
-        const std::size_t total_num_bins = bin_.size() + 2;
+        const std::size_t total_num_bins = counts_.size();
 
         const double mean = sum / total_num_bins;
         double accum = 0.0;
-        std::for_each(bin_.begin(), bin_.end(), [&](const sparta::Counter& c) {
-            auto c_get = c.get();
-            accum += pow(c_get - mean, 2);
+        std::for_each(counts_.begin() + 1, counts_.end() - 1, [&](const uint64_t c) {
+            accum += pow(c - mean, 2);
         });
-        accum += (*underflow_bin_ - mean) * (*underflow_bin_ - mean);
-        accum += (*overflow_bin_ - mean) * (*overflow_bin_ - mean);
+        accum += (counts_.front() - mean) * (counts_.front() - mean);
+        accum += (counts_.back() - mean) * (counts_.back() - mean);
         return std::sqrt(accum / (total_num_bins - 1));
     }
 
@@ -134,13 +149,12 @@ public:
 
         // Summation of counts in normal bins plus underflow bin and
         // overflow bin.
-        const double sum = std::accumulate(bin_.begin(), bin_.end(), 0.0)
-            + (*underflow_bin_) + (*overflow_bin_);
+        const double sum = sumCounts_();
 
         // Total number of bins is number of regular bins
         // plus one for underflow bin and plus one for
         // overflow bin.
-        const std::size_t total_num_bins = bin_.size() + 2;
+        const std::size_t total_num_bins = counts_.size();
 
         return  sum / total_num_bins;
     }
@@ -148,43 +162,43 @@ public:
     /*!
      * \brief Return aggregate of this histogram
      */
-    const sparta::Counter& getAggValues() const{
-        return *total_values_;
+    uint64_t getAggValues() const{
+        return total_values_;
     }
 
     /*!
      * \brief Return vector of regular bin counts.
      */
-    const std::vector<sparta::Counter>& getRegularBin() const{
-        return bin_;
+    std::vector<uint64_t> getRegularBin() const{
+        return std::vector<uint64_t>(counts_.begin() + 1, counts_.end() - 1);
     }
 
     /*!
      * \brief Return count of underflow bin.
      */
-    const sparta::Counter& getUnderflowBin() const{
-        return *underflow_bin_;
+    uint64_t getUnderflowBin() const{
+        return counts_.front();
     }
 
     /*!
      * \brief Return count of overflow bin.
      */
-    const sparta::Counter& getOverflowBin() const{
-        return *overflow_bin_;
+    uint64_t getOverflowBin() const{
+        return counts_.back();
     }
 
     /*!
      * \brief Return underflow probability.
      */
     double getUnderflowProbability() const{
-        return ((static_cast<double>(*underflow_bin_))/(static_cast<double>(*total_values_)));
+        return ((static_cast<double>(counts_.front()))/(static_cast<double>(total_values_)));
     }
 
     /*!
      * \brief Return overflow probability.
      */
     double getOverflowProbability() const{
-        return ((static_cast<double>(*overflow_bin_))/(static_cast<double>(*total_values_)));
+        return ((static_cast<double>(counts_.back()))/(static_cast<double>(total_values_)));
     }
 
     /*!
@@ -192,8 +206,8 @@ public:
      */
     const std::vector<double>& recomputeRegularBinProbabilities() const{
         bin_prob_vector_.clear();
-        for(const auto& b : bin_){
-            bin_prob_vector_.emplace_back(((static_cast<double>(b))/(static_cast<double>(*total_values_))));
+        for(uint32_t i = 1; i <= num_bins_; ++i){
+            bin_prob_vector_.emplace_back(((static_cast<double>(counts_[i]))/(static_cast<double>(total_values_))));
         }
         return bin_prob_vector_;
     }
@@ -205,6 +219,32 @@ public:
 
 protected:
 
+    /*!
+     * \brief Index of the bin in counts_ that val falls into
+     *
+     * 0 is the underflow bin and num_bins_ + 1 the overflow bin.  Written
+     * as selects rather than branches; the index computed for an out of
+     * range value is discarded.
+     */
+    uint32_t getBinIndex_(uint64_t val) const
+    {
+        uint32_t idx = static_cast<uint32_t>((val - lower_val_) >> idx_shift_amount_) + 1;
+        idx = (val < lower_val_) ? 0 : idx;
+        idx = (val > upper_val_) ? (num_bins_ + 1) : idx;
+        return idx;
+    }
+
+    /*!
+     * \brief Sum of all bin counts: regular bins first, then underflow
+     * and overflow, so the floating point result matches the per-bin
+     * counters this replaced
+     */
+    double sumCounts_() const
+    {
+        return std::accumulate(counts_.begin() + 1, counts_.end() - 1, 0.0)
+            + counts_.front() + counts_.back();
+    }
+
     /*!
      *  Keep track of the maximum 'N' values seen
      *  \param val The value currently being added to the histogram
@@ -213,20 +253,18 @@ protected:
 
         // If the new value is less than everything already tracked, then
         // there's nothing to update
-        auto min_it = max_values_.begin();
-        if (*min_it >= val) {
+        if (max_values_.front() >= val) {
             return;
         }
 
-        max_values_.erase(min_it);
-        max_values_.insert(val);
-
-        uint32_t idx = 0;
-        for (auto it = max_values_.begin(); it != max_values_.end(); it++) {
-            sparta_assert(idx < max_counters_.size());
-            max_counters_[idx].set(*it);
-            idx++;
+        // Drop the smallest value and shift the smaller ones down to
+        // keep max_values_ sorted
+        uint32_t idx = 1;
+        while (idx < max_values_.size() && max_values_[idx] < val) {
+            max_values_[idx - 1] = max_values_[idx];
+            ++idx;
         }
+        max_values_[idx - 1] = val;
     }
 
     /*!
@@ -237,20 +275,20 @@ protected:
     {
         std::stringstream str;
         str << std::dec;
-        uint64_t running_sum = *underflow_bin_;
+        uint64_t running_sum = counts_.front();
         str << "\t" <<  name << "[ UF ] = " << running_sum << std::endl;
         uint64_t start_val = lower_val_;
         uint64_t end_val  = start_val + num_vals_per_bin_ - 1;
         for (uint32_t i=0; i<num_bins_; ++i) {
             if (end_val > upper_val_)
                 end_val = upper_val_;
-            running_sum +=  (bin_[i]);
+            running_sum +=  counts_[i + 1];
             str << "\t" << name
                 << "[ " << start_val << "-" << end_val << " ] = "
                 << running_sum << std::endl;
             end_val  += num_vals_per_bin_;
         }
-        running_sum += *overflow_bin_;
+        running_sum += counts_.back();
         str << "\t" << name << "[ OF ] = " << running_sum << std::endl;
         return str.str();
     }
@@ -271,25 +309,28 @@ protected:
                           InstrumentationNode::Visibility max_vis = InstrumentationNode::VIS_SUMMARY)
 
     {
-        total_values_.reset(new sparta::Counter(sset,
-                                       stat_prefix + "total",
-                                       "Total values added to the histogram",
-                                       Counter::COUNT_NORMAL,
-                                       bin_vis));
-
-        running_sum_.reset(new sparta::Counter(sset,
-                                            stat_prefix + "sum",
-                                            "Sum of all values added to the histogram",
-                                            Counter::COUNT_NORMAL,
-                                            bin_vis));
-
-        // Reserve to use emplacement without tree child reordering
-        bin_.reserve(num_bins_);
-
-        underflow_bin_ = &sset->createCounter<sparta::Counter>(stat_prefix + "UF",
-                                                              "underflow bin",
-                                                              Counter::COUNT_NORMAL,
-                                                              bin_vis);
+        total_values_ctr_.reset(new sparta::ReadOnlyCounter(sset,
+                                                            stat_prefix + "total",
+                                                            "Total values added to the histogram",
+                                                            Counter::COUNT_NORMAL,
+                                                            &total_values_,
+                                                            bin_vis));
+
+        running_sum_ctr_.reset(new sparta::ReadOnlyCounter(sset,
+                                                           stat_prefix + "sum",
+                                                           "Sum of all values added to the histogram",
+                                                           Counter::COUNT_NORMAL,
+                                                           &running_sum_,
+                                                           bin_vis));
+
+        bin_ctrs_.reserve(counts_.size());
+
+        bin_ctrs_.emplace_back(new sparta::ReadOnlyCounter(sset,
+                                                           stat_prefix + "UF",
+                                                           "underflow bin",
+                                                           Counter::COUNT_NORMAL,
+                                                           &counts_.front(),
+                                                           bin_vis));
         underflow_probability_.reset(new StatisticDef(sset,
                                                       stat_prefix + "UF_probability",
                                                       "Probability of underflow",
@@ -304,11 +345,12 @@ protected:
                 end_val = upper_val_;
             std::stringstream str;
             str << stat_prefix << "bin_" << start_val << "_" << end_val;
-            bin_.emplace_back(sparta::Counter(sset,
-                                            str.str(),
-                                            str.str() + " histogram bin",
-                                            sparta::Counter::COUNT_NORMAL,
-                                            bin_vis));
+            bin_ctrs_.emplace_back(new sparta::ReadOnlyCounter(sset,
+                                                               str.str(),
+                                                               str.str() + " histogram bin",
+                                                               sparta::Counter::COUNT_NORMAL,
+                                                               &counts_[i + 1],
+                                                               bin_vis));
             probabilities_.emplace_back(new StatisticDef(sset,
                                                          str.str() + "_probability",
                                                          str.str() + " bin probability",
@@ -319,10 +361,12 @@ protected:
             start_val = end_val + 1;
             end_val  += num_vals_per_bin_;
         }
-        overflow_bin_  = &sset->createCounter<sparta::Counter>(stat_prefix + "OF",
-                                                              stat_prefix + "overflow bin",
-                                                              Counter::COUNT_NORMAL,
-                                                              bin_vis);
+        bin_ctrs_.emplace_back(new sparta::ReadOnlyCounter(sset,
+                                                           stat_prefix + "OF",
+                                                           stat_prefix + "overflow bin",
+                                                           Counter::COUNT_NORMAL,
+                                                           &counts_.back(),
+                                                           bin_vis));
         overflow_probability_.reset(new StatisticDef(sset,
                                                      stat_prefix + "OF_probability",
                                                      "Probability of overflow",
@@ -340,17 +384,18 @@ protected:
                                         sparta::InstrumentationNode::VIS_NORMAL));;
 
         if (num_max_values > 0) {
-            max_counters_.reserve(num_max_values);
+            // Counters can't have -1, so use '0' for uninitialized :-/
+            max_values_.assign(num_max_values, 0);
+            max_ctrs_.reserve(num_max_values);
             for (uint32_t idx = 0; idx < num_max_values; idx++) {
                 std::stringstream mvtext;
                 mvtext << "maxval" << idx;
-                max_counters_.emplace_back(sset,
-                                           stat_prefix + mvtext.str(),
-                                           stat_prefix + " maximum value",
-                                           Counter::COUNT_LATEST,
-                                           max_vis);
-                max_counters_[idx].set(0); // Counters can't have -1, so use '0' for uninitialized :-/
-                max_values_.insert(0);
+                max_ctrs_.emplace_back(new sparta::ReadOnlyCounter(sset,
+                                                                   stat_prefix + mvtext.str(),
+                                                                   stat_prefix + " maximum value",
+                                                                   Counter::COUNT_LATEST,
+                                                                   &max_values_[idx],
+                                                                   max_vis));
             }
         }
     }
@@ -361,18 +406,20 @@ private:
     const uint64_t upper_val_; //!< Highest value vaptured in normal bins
     const uint32_t num_vals_per_bin_; //!< Number of values captured by each bin
 
-    std::unique_ptr<sparta::Counter> total_values_; //!< Total number of values
-    std::unique_ptr<sparta::Counter> running_sum_; //!< Sum of all values that have been logged
-    sparta::Counter* underflow_bin_; //!< Bin for all underflow
-    sparta::Counter* overflow_bin_; //!< Bin for all overflow
-    std::vector<sparta::Counter> bin_; //!< Regular bins
+    uint64_t total_values_ = 0; //!< Total number of values
+    uint64_t running_sum_ = 0; //!< Sum of all values that have been logged
+    std::vector<uint64_t> counts_; //!< Underflow bin, regular bins, overflow bin
+
+    std::unique_ptr<sparta::ReadOnlyCounter> total_values_ctr_; //!< View of total_values_
+    std::unique_ptr<sparta::ReadOnlyCounter> running_sum_ctr_; //!< View of running_sum_
+    std::vector<std::unique_ptr<sparta::ReadOnlyCounter>> bin_ctrs_; //!< Views of counts_
     std::unique_ptr<sparta::StatisticDef> underflow_probability_; //!< Probability of underflow
     std::unique_ptr<sparta::StatisticDef> overflow_probability_; //!< Probability of overflow
     std::vector<std::unique_ptr<sparta::StatisticDef>> probabilities_; //!< Probabilities of each normal bin
     std::unique_ptr<sparta::StatisticDef> average_; //!< Average of all values in the histogram
 
-    std::vector<sparta::Counter> max_counters_;
-    std::multiset<uint64_t>         max_values_;
+    std::vector<uint64_t> max_values_; //!< Largest values seen, smallest first
+    std::vector<std::unique_ptr<sparta::ReadOnlyCounter>> max_ctrs_; //!< Views of max_values_
 
     uint32_t num_bins_; //!< Number of bins
 
@@ -12,6 +12,8 @@
 #include "sparta/statistics/CounterBase.hpp"
 #include "sparta/statistics/InstrumentationNode.hpp"
 
+#include <memory>
+#include <regex>
 #include <string>
 
 
@@ -102,6 +104,7 @@ public:
         visibility_ = rhp.visibility_;
         tag_ = rhp.tag_;
         name_ = rhp.name_;
+        regex_ = rhp.regex_;
         vis_comparison_ = rhp.vis_comparison_;
         type_comparison_ = rhp.type_comparison_;
         tag_comparison_ = rhp.tag_comparison_;
@@ -118,6 +121,7 @@ public:
         visibility_ = rhp.visibility_;
         tag_ = rhp.tag_;
         name_ = rhp.name_;
+        regex_ = rhp.regex_;
         vis_comparison_ = rhp.vis_comparison_;
         type_comparison_ = rhp.type_comparison_;
         tag_comparison_ = rhp.tag_comparison_;
@@ -165,6 +169,9 @@ public:
         tag_ = tag;
         tag_comparison_ = tcomp;
         op_ = OP_EVAL_TAG;
+        if(tcomp == TAGCOMP_REM){
+            regex_ = std::make_shared<const std::regex>(tag_);
+        }
     }
 
     /*!
@@ -175,6 +182,9 @@ public:
         name_ = name;
         name_comparison_ = ncomp;
         op_ = OP_EVAL_NAME;
+        if(ncomp == NAMECOMP_REM){
+            regex_ = std::make_shared<const std::regex>(name_);
+        }
     }
 
 
@@ -202,6 +212,7 @@ public:
         visibility_ = rhp.visibility_;
         tag_ = rhp.tag_;
         name_ = rhp.name_;
+        regex_ = rhp.regex_;
         vis_comparison_ = rhp.vis_comparison_;
         type_comparison_ = rhp.type_comparison_;
         tag_comparison_ = rhp.tag_comparison_;
@@ -400,6 +411,13 @@ private:
      */
     std::string name_ = "";
 
+    /*!
+     * \brief Compiled tag_ or name_ for regex comparisons (TAGCOMP_REM or
+     * NAMECOMP_REM). Compiled once on construction instead of on every
+     * evaluation and shared between copies
+     */
+    std::shared_ptr<const std::regex> regex_;
+
     /*!
      * \brief Type of visibility comparison to perfom
      */
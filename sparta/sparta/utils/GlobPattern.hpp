@@ -0,0 +1,113 @@
+// <GlobPattern> -*- C++ -*-
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sparta
+{
+    namespace utils
+    {
+        /*!
+         * \brief Compiled SPARTA TreeNode name pattern (a single location
+         * element, no '.' separators) supporting the glob-like wildcards
+         * '*' (any number of characters), '?' (zero or one character) and
+         * '+' (one or more characters).
+         *
+         * Matching is done directly on the pattern tokens rather than through
+         * std::regex, with the same results (including wildcard captures) as
+         * the expression produced by TreeNode::createSearchRegexPattern. A
+         * pattern containing other characters that are special in that
+         * expression falls back to std::regex.
+         *
+         * Compiled patterns are shared through a cache keyed by the pattern
+         * string (see get), so repeatedly applying the same pattern (e.g. in
+         * configuration files and report definitions) compiles it once.
+         */
+        class GlobPattern
+        {
+        public:
+
+            /*!
+             * \brief Compile a pattern
+             * \param pattern Pattern for matching node identifiers (e.g.
+             * "core*" or "core0")
+             */
+            explicit GlobPattern(const std::string& pattern);
+
+            GlobPattern(const GlobPattern&) = delete;
+            GlobPattern& operator=(const GlobPattern&) = delete;
+
+            /*!
+             * \brief Get the compiled pattern for a string from the global
+             * pattern cache, compiling it if not yet cached
+             */
+            static std::shared_ptr<const GlobPattern> get(const std::string& pattern);
+
+            /*!
+             * \brief The pattern string this was compiled from
+             */
+            const std::string& getPattern() const {
+                return pattern_;
+            }
+
+            /*!
+             * \brief Does this pattern contain any wildcards? If not, it
+             * matches only a string equal to getPattern()
+             */
+            bool hasWildcards() const {
+                return num_wildcards_ > 0 || fallback_ != nullptr;
+            }
+
+            /*!
+             * \brief Does \a str match this pattern in its entirety
+             */
+            bool match(const std::string& str) const;
+
+            /*!
+             * \brief Does \a str match this pattern in its entirety
+             * \param captures Appended with the text matched by each wildcard
+             * in the pattern, in order, if \a str matches
+             */
+            bool match(const std::string& str, std::vector<std::string>& captures) const;
+
+        private:
+
+            //! Kind of a pattern token
+            enum class TokenType {
+                LITERAL,     //!< Text which must match exactly
+                ANY,         //!< '*'
+                ZERO_OR_ONE, //!< '?'
+                ONE_OR_MORE  //!< '+'
+            };
+
+            //! Element of a compiled pattern
+            struct Token {
+                TokenType type;
+                std::string literal; //!< Text of a LITERAL token
+                uint32_t capture;    //!< Capture index of a wildcard token
+            };
+
+            /*!
+             * \brief Match tokens from \a tok onward against \a rest, trying
+             * the longest text for each wildcard first (as a greedy regex would)
+             */
+            bool matchTokens_(size_t tok, std::string_view rest,
+                              std::vector<std::string_view>* captures) const;
+
+            const std::string pattern_;
+            std::vector<Token> tokens_;
+            uint32_t num_wildcards_ = 0;
+
+            //! Regex for patterns which cannot be tokenized
+            std::unique_ptr<std::regex> fallback_;
+        };
+
+    } // namespace utils
+} // namespace sparta
@@ -32,7 +32,8 @@ namespace sparta::pipeViewer
                       "Failed to open the path to write pipeline collection files."
                       " It may be possible that the directory does not exist."
                       " at filepath: FILEPATH+PREFIX=" << filepath);
-        // Throw on write failure
+        // Throw on write failure. Record file failures are raised in the
+        // writer thread and rethrown on the simulation thread
         record_file_.exceptions(std::ostream::eofbit | std::ostream::badbit | std::ostream::failbit | std::ostream::goodbit);
         index_file_.exceptions(std::ostream::eofbit | std::ostream::badbit | std::ostream::failbit | std::ostream::goodbit);
         // Write the index file version first. The index file should naturally skip this
@@ -49,8 +50,32 @@ namespace sparta::pipeViewer
         // Notice that we write the interval offset first.
         writeData_(index_file_, interval);
         index_file_.flush();
+
+        record_block_.reserve(BLOCK_SIZE + sizeof(transaction_t));
+        writer_ = std::thread([this]() { writerLoop_(); });
     }
     Outputter::~Outputter(){
+        // Hand the partial block to the writer thread and wait for it to
+        // write everything out
+        {
+            std::unique_lock<std::mutex> lock(block_mutex_);
+            if(!record_block_.empty() && !writer_error_) {
+                full_blocks_.emplace_back(std::move(record_block_));
+            }
+            stop_writer_ = true;
+        }
+        block_cond_.notify_all();
+        writer_.join();
+        if(writer_error_) {
+            try {
+                std::rethrow_exception(writer_error_);
+            }
+            catch(const std::exception& ex) {
+                std::cerr << "Failed to write the pipeline collection record file: "
+                          << ex.what() << std::endl;
+            }
+        }
+
         //Write an index for the end of the record file, so that the last record
         //is always easily accessable reguardless of indexing.
         writeData_(index_file_, last_record_pos_);
@@ -66,8 +91,82 @@ namespace sparta::pipeViewer
         std::cout << "The outputter is done destructing." << std::endl;
     }
     void Outputter::writeIndex(){
-        const uint64_t current_record_pos = record_file_.tellp();
-        writeData_(index_file_, current_record_pos);
+        // Hand over the partial block so that a live pipeViewer sees every
+        // record up to this heartbeat. The writer flushes the record file
+        // once it has caught up
+        if(!record_block_.empty()) {
+            submitBlock_();
+        }
+        // record_pos_ is where the next record will land in the record file
+        // once every staged block has been written
+        writeData_(index_file_, record_pos_);
         index_file_.flush();
     }
+
+    void Outputter::submitBlock_(){
+        {
+            std::unique_lock<std::mutex> lock(block_mutex_);
+            checkWriterError_();
+            // Bound the memory held by blocks the writer has not caught up with
+            block_cond_.wait(lock, [this]() {
+                return full_blocks_.size() < MAX_PENDING_BLOCKS || writer_error_;
+            });
+            checkWriterError_();
+            full_blocks_.emplace_back(std::move(record_block_));
+            if(!free_blocks_.empty()) {
+                record_block_ = std::move(free_blocks_.back());
+                free_blocks_.pop_back();
+            }
+            else {
+                record_block_ = std::vector<char>();
+                record_block_.reserve(BLOCK_SIZE + sizeof(transaction_t));
+            }
+        }
+        block_cond_.notify_all();
+    }
+
+    void Outputter::checkWriterError_(){
+        if(SPARTA_EXPECT_FALSE(writer_error_ != nullptr)) {
+            std::rethrow_exception(writer_error_);
+        }
+    }
+
+    void Outputter::writerLoop_(){
+        std::unique_lock<std::mutex> lock(block_mutex_);
+        while(true) {
+            block_cond_.wait(lock, [this]() { return !full_blocks_.empty() || stop_writer_; });
+            if(full_blocks_.empty()) {
+                // Stopping and everything has been written
+                break;
+            }
+            std::vector<char> block = std::move(full_blocks_.front());
+            full_blocks_.pop_front();
+            lock.unlock();
+
+            try {
+                writeData_(record_file_, block.data(), block.size());
+
+                // Caught up: make everything handed over so far (at least
+                // up to the last heartbeat) visible to readers
+                lock.lock();
+                const bool caught_up = full_blocks_.empty();
+                lock.unlock();
+                if(caught_up) {
+                    record_file_.flush();
+                }
+            }
+            catch(...) {
+                lock.lock();
+                writer_error_ = std::current_exception();
+                full_blocks_.clear();
+                block_cond_.notify_all();
+                break;
+            }
+
+            block.clear();
+            lock.lock();
+            free_blocks_.emplace_back(std::move(block));
+            block_cond_.notify_all();
+        }
+    }
 }//namespace sparta::pipeViewer
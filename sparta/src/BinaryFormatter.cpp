@@ -0,0 +1,274 @@
+// <BinaryFormatter.cpp> -*- C++ -*-
+
+
+/*!
+ * \file BinaryFormatter.cpp
+ * \brief Implementation of the asynchronous binary log formatter and renderer
+ */
+
+#include "sparta/log/BinaryFormatter.hpp"
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+#include "sparta/simulation/Clock.hpp"
+
+namespace sparta {
+    namespace log {
+
+BinaryFormatter::BinaryFormatter(std::ostream& stream, uint64_t ring_bytes) :
+    Formatter(stream),
+    ring_(ring_bytes)
+{
+    scratch_.insert(scratch_.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    put_(VERSION);
+    commit_();
+
+    writer_ = std::thread([this]() { writerLoop_(); });
+}
+
+BinaryFormatter::~BinaryFormatter()
+{
+    stop_.store(true, std::memory_order_release);
+    writer_.join();
+}
+
+void BinaryFormatter::write(const sparta::log::Message& msg)
+{
+    checkWriterError_();
+
+    const TreeNode& origin = msg.info.origin;
+    const TreeNode::node_uid_type uid = origin.getNodeUID();
+    if(known_nodes_.insert(uid).second){
+        put_(static_cast<uint8_t>(REC_LOCATION));
+        put_(uid);
+        putString_(origin.getLocation());
+    }
+
+    auto cat_itr = categories_.find(msg.info.category);
+    if(cat_itr == categories_.end()){
+        const uint32_t cat_id = categories_.size();
+        cat_itr = categories_.emplace(msg.info.category, cat_id).first;
+        put_(static_cast<uint8_t>(REC_CATEGORY));
+        put_(cat_id);
+        putString_(*msg.info.category);
+    }
+
+    const Clock* clk = origin.getClock();
+    put_(static_cast<uint8_t>(REC_MESSAGE));
+    put_(static_cast<uint64_t>(msg.info.sim_time));
+    put_(clk ? static_cast<uint64_t>(clk->currentCycle()) : NO_CYCLE);
+    put_(static_cast<double>(msg.info.wall_time));
+    put_(uid);
+    put_(cat_itr->second);
+    put_(static_cast<uint32_t>(msg.info.thread_id));
+    put_(static_cast<int64_t>(msg.info.seq_num));
+    putString_(msg.content);
+
+    commit_();
+}
+
+void BinaryFormatter::writeHeader(const SimulationInfo& sim_info)
+{
+    std::stringstream ss;
+    sim_info.write(ss, "#", "\n");
+    put_(static_cast<uint8_t>(REC_HEADER));
+    putString_(ss.str());
+    commit_();
+    flush();
+}
+
+void BinaryFormatter::flush()
+{
+    while(bytes_written_.load(std::memory_order_acquire) != bytes_committed_){
+        checkWriterError_();
+        std::this_thread::yield();
+    }
+}
+
+void BinaryFormatter::commit_()
+{
+    const char* data = scratch_.data();
+    uint64_t remaining = scratch_.size();
+    while(remaining != 0){
+        const uint64_t pushed = ring_.push(data, remaining);
+        if(pushed == 0){
+            // Ring is full. Wait for the writer thread to catch up
+            checkWriterError_();
+            std::this_thread::yield();
+            continue;
+        }
+        data += pushed;
+        remaining -= pushed;
+    }
+    bytes_committed_ += scratch_.size();
+    scratch_.clear();
+}
+
+void BinaryFormatter::checkWriterError_()
+{
+    if(SPARTA_EXPECT_FALSE(writer_failed_.load(std::memory_order_acquire))){
+        std::rethrow_exception(writer_error_);
+    }
+}
+
+void BinaryFormatter::writerLoop_()
+{
+    try{
+        while(true){
+            // Sample the stop flag before draining so that everything
+            // committed prior to the stop request is written
+            const bool stopping = stop_.load(std::memory_order_acquire);
+            const uint64_t drained = ring_.drainTo(stream_);
+            if(drained != 0){
+                stream_.flush();
+                bytes_written_.fetch_add(drained, std::memory_order_release);
+                continue;
+            }
+            if(stopping){
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }catch(...){
+        writer_error_ = std::current_exception();
+        writer_failed_.store(true, std::memory_order_release);
+    }
+}
+
+namespace {
+
+    template <typename T>
+    T readBinary(std::istream& in)
+    {
+        T val;
+        if(!in.read(reinterpret_cast<char*>(&val), sizeof(T))){
+            throw SpartaException("Binary log is truncated");
+        }
+        return val;
+    }
+
+    std::string readBinaryString(std::istream& in)
+    {
+        const uint32_t len = readBinary<uint32_t>(in);
+        std::string s(len, '\0');
+        if(len != 0 && !in.read(&s[0], len)){
+            throw SpartaException("Binary log is truncated");
+        }
+        return s;
+    }
+
+} // namespace
+
+uint64_t BinaryLogRenderer::render(std::istream& in, std::ostream& out, Format fmt)
+{
+    char magic[sizeof(BinaryFormatter::MAGIC)];
+    if(!in.read(magic, sizeof(magic)) ||
+       std::memcmp(magic, BinaryFormatter::MAGIC, sizeof(magic)) != 0){
+        throw SpartaException("Input is not a SPARTA binary log");
+    }
+    const uint32_t version = readBinary<uint32_t>(in);
+    if(version != BinaryFormatter::VERSION){
+        throw SpartaException("Unsupported binary log version ") << version
+            << ". Expected " << BinaryFormatter::VERSION;
+    }
+
+    std::unordered_map<TreeNode::node_uid_type, std::string> locations;
+    std::vector<std::string> categories;
+    uint64_t num_msgs = 0;
+
+    int rec;
+    while((rec = in.get()) != std::char_traits<char>::eof()){
+        switch(rec){
+        case BinaryFormatter::REC_HEADER:
+            out << readBinaryString(in);
+            break;
+        case BinaryFormatter::REC_LOCATION: {
+            const auto uid = readBinary<TreeNode::node_uid_type>(in);
+            locations[uid] = readBinaryString(in);
+            break;
+        }
+        case BinaryFormatter::REC_CATEGORY: {
+            const uint32_t cat_id = readBinary<uint32_t>(in);
+            if(cat_id != categories.size()){
+                throw SpartaException("Binary log category ") << cat_id << " is out of order";
+            }
+            categories.emplace_back(readBinaryString(in));
+            break;
+        }
+        case BinaryFormatter::REC_MESSAGE: {
+            const uint64_t sim_time = readBinary<uint64_t>(in);
+            const uint64_t cycle = readBinary<uint64_t>(in);
+            readBinary<double>(in);  // wall time
+            const auto uid = readBinary<TreeNode::node_uid_type>(in);
+            const uint32_t cat_id = readBinary<uint32_t>(in);
+            readBinary<uint32_t>(in); // thread id
+            readBinary<int64_t>(in);  // sequence number
+            const std::string content = readBinaryString(in);
+
+            auto loc_itr = locations.find(uid);
+            if(loc_itr == locations.end() || cat_id >= categories.size()){
+                throw SpartaException("Binary log message references an undefined origin or category");
+            }
+
+            writeMessage(out, fmt, sim_time, cycle, loc_itr->second, categories[cat_id], content);
+            ++num_msgs;
+            break;
+        }
+        default:
+            throw SpartaException("Unknown binary log record type ") << rec;
+        }
+    }
+
+    out.flush();
+    return num_msgs;
+}
+
+void BinaryLogRenderer::writeMessage(std::ostream& out, Format fmt,
+                                     uint64_t sim_time, uint64_t cycle,
+                                     const std::string& location,
+                                     const std::string& category,
+                                     const std::string& content)
+{
+    switch(fmt){
+    case Format::DEFAULT: {
+        std::ios::fmtflags f = out.flags();
+        const char fill = out.fill();
+        out << '{' << std::setfill('0') << std::dec
+            << std::setw(10) << std::right << sim_time << INFO_DELIMITER;
+        if(cycle != BinaryFormatter::NO_CYCLE){
+            out << std::setw(8) << std::right << cycle << INFO_DELIMITER;
+        }else{
+            out << "--------" << INFO_DELIMITER;
+        }
+        out << location << INFO_DELIMITER << category << "} "
+            << copyWithReplace(content, '\n', "") << '\n';
+        out.flags(f);
+        out.fill(fill);
+        break;
+    }
+    case Format::BASIC:
+        out << location << ": " << category << ": " << copyWithReplace(content, '\n', "") << '\n';
+        break;
+    case Format::RAW:
+        out << copyWithReplace(content, '\n', "") << '\n';
+        break;
+    }
+}
+
+BinaryLogRenderer::Format BinaryLogRenderer::parseFormat(const std::string& name)
+{
+    if(name == "default"){
+        return Format::DEFAULT;
+    }else if(name == "basic"){
+        return Format::BASIC;
+    }else if(name == "raw"){
+        return Format::RAW;
+    }
+    throw SpartaException("Unknown binary log render format \"") << name
+        << "\". Expected one of: default, basic, raw";
+}
+
+    } // namespace log
+} // namespace sparta
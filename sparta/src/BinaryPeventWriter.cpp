@@ -0,0 +1,360 @@
+// <BinaryPeventWriter.cpp> -*- C++ -*-
+
+
+/**
+ * \file BinaryPeventWriter.cpp
+ * \brief Implementation of binary pevent output and rendering
+ */
+
+#include "sparta/pevents/BinaryPeventWriter.hpp"
+
+#include <cstring>
+#include <sstream>
+
+#include "sparta/app/SimulationInfo.hpp"
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/log/BinaryFormatter.hpp"
+#include "sparta/simulation/Clock.hpp"
+#include "sparta/utils/SpartaException.hpp"
+
+namespace sparta{
+namespace pevents{
+
+std::map<std::string, std::unique_ptr<BinaryPeventWriter>> BinaryPeventWriter::writers_;
+
+BinaryPeventWriter* BinaryPeventWriter::getWriter(const std::string& filename)
+{
+    auto itr = writers_.find(filename);
+    if(itr == writers_.end()){
+        itr = writers_.emplace(filename, new BinaryPeventWriter(filename)).first;
+    }
+    return itr->second.get();
+}
+
+bool BinaryPeventWriter::isBinaryFile(const std::string& filename)
+{
+    static const std::string ext = ".bin";
+    return filename.size() > ext.size() &&
+        filename.compare(filename.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+void BinaryPeventWriter::flushAll()
+{
+    for(auto& w : writers_){
+        w.second->flush();
+    }
+}
+
+BinaryPeventWriter::BinaryPeventWriter(const std::string& filename) :
+    filename_(filename),
+    file_(filename, std::ios::out | std::ios::binary)
+{
+    if(!file_.good()){
+        throw SpartaException("Failed to open binary pevent file \"") << filename << "\"";
+    }
+    file_.exceptions(std::ostream::badbit | std::ostream::failbit);
+
+    buf_.reserve(FLUSH_THRESHOLD + 4096);
+    buf_.insert(buf_.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    put_(VERSION);
+
+    std::stringstream header;
+    SimulationInfo::getInstance().write(header, "#", "\n");
+    put_(static_cast<uint8_t>(REC_HEADER));
+    putString_(header.str());
+}
+
+BinaryPeventWriter::~BinaryPeventWriter()
+{
+    try{
+        flush();
+    }catch(...){
+        // Do not throw from destruction at exit
+    }
+}
+
+uint32_t BinaryPeventWriter::registerEventType(const TreeNode& origin,
+                                               const std::string& category,
+                                               const std::string& event_name,
+                                               const std::vector<std::string>& keys,
+                                               const PairFormatterVector& formats)
+{
+    sparta_assert(keys.size() == formats.size());
+    const uint32_t type_id = num_types_++;
+    put_(static_cast<uint8_t>(REC_SCHEMA));
+    put_(type_id);
+    putString_(origin.getLocation());
+    putString_(category);
+    putString_(event_name);
+    put_(static_cast<uint32_t>(keys.size()));
+    for(std::size_t i = 0; i < keys.size(); ++i){
+        putString_(keys[i]);
+        put_(static_cast<uint8_t>(formats[i]));
+    }
+    return type_id;
+}
+
+void BinaryPeventWriter::writeEvent(uint32_t type_id,
+                                    uint64_t tick,
+                                    uint64_t clock_cycle,
+                                    uint64_t pevent_cycle,
+                                    const PairCache& cache)
+{
+    const auto& strings = cache.getStringVector();
+    const auto& data = cache.getDataVector();
+
+    // Define any string values not seen before. These records must precede
+    // the event referencing them
+    inline_strings_.clear();
+    for(const auto& s : strings){
+        if(!s.empty() && strings_.size() < MAX_INTERNED_STRINGS && strings_.count(s) == 0){
+            const uint32_t id = strings_.size();
+            strings_.emplace(s, id);
+            put_(static_cast<uint8_t>(REC_STRING));
+            put_(id);
+            putString_(s);
+        }
+    }
+
+    put_(static_cast<uint8_t>(REC_EVENT));
+    put_(type_id);
+    put_(tick);
+    put_(clock_cycle);
+    put_(pevent_cycle);
+    for(std::size_t i = 0; i < strings.size(); ++i){
+        if(!strings[i].empty()){
+            auto itr = strings_.find(strings[i]);
+            if(SPARTA_EXPECT_TRUE(itr != strings_.end())){
+                put_(static_cast<uint8_t>(FIELD_STRING));
+                put_(static_cast<uint64_t>(itr->second));
+            }else{
+                put_(static_cast<uint8_t>(FIELD_INLINE_STRING));
+                put_(static_cast<uint64_t>(strings[i].size()));
+                inline_strings_.emplace_back(&strings[i]);
+            }
+        }else if(data[i].second){
+            put_(static_cast<uint8_t>(FIELD_NUMBER));
+            put_(data[i].first);
+        }else{
+            put_(static_cast<uint8_t>(FIELD_ABSENT));
+            put_(uint64_t(0));
+        }
+    }
+    for(const std::string* s : inline_strings_){
+        buf_.insert(buf_.end(), s->begin(), s->end());
+    }
+
+    if(buf_.size() >= FLUSH_THRESHOLD){
+        flush();
+    }
+}
+
+void BinaryPeventWriter::flush()
+{
+    if(!buf_.empty()){
+        file_.write(buf_.data(), buf_.size());
+        buf_.clear();
+    }
+    file_.flush();
+}
+
+bool BinaryPeventTap::addFile(const std::string& filename)
+{
+    BinaryPeventWriter* writer = BinaryPeventWriter::getWriter(filename);
+    for(const auto& w : writers_){
+        if(w.first == writer){
+            return false;
+        }
+    }
+    writers_.emplace_back(writer, UNREGISTERED);
+    return true;
+}
+
+void BinaryPeventTap::write(const TreeNode& origin,
+                            const std::string& category,
+                            const std::string& event_name,
+                            const PairCache& cache,
+                            uint64_t pevent_cycle)
+{
+    const Clock* clk = origin.getClock();
+    const uint64_t tick = clk ? clk->getScheduler()->getCurrentTick() : 0;
+    const uint64_t cycle = clk ? clk->currentCycle() : BinaryPeventWriter::NO_CYCLE;
+    for(auto& w : writers_){
+        if(SPARTA_EXPECT_FALSE(w.second == UNREGISTERED)){
+            // Keys are final once collection starts
+            w.second = w.first->registerEventType(origin, category, event_name,
+                                                  cache.getNameStrings(),
+                                                  cache.getFormatVector());
+        }
+        w.first->writeEvent(w.second, tick, cycle, pevent_cycle, cache);
+    }
+}
+
+namespace {
+
+    template <typename T>
+    T readBinary(std::istream& in)
+    {
+        T val;
+        if(!in.read(reinterpret_cast<char*>(&val), sizeof(T))){
+            throw SpartaException("Binary pevent file is truncated");
+        }
+        return val;
+    }
+
+    std::string readBinaryString(std::istream& in, uint64_t len)
+    {
+        std::string s(len, '\0');
+        if(len != 0 && !in.read(&s[0], len)){
+            throw SpartaException("Binary pevent file is truncated");
+        }
+        return s;
+    }
+
+    std::string readBinaryString(std::istream& in)
+    {
+        return readBinaryString(in, readBinary<uint32_t>(in));
+    }
+
+    struct Schema
+    {
+        std::string location;
+        std::string category;
+        std::string event_name;
+        std::vector<std::string> keys;
+        std::vector<PairFormatter> formats;
+    };
+
+} // namespace
+
+uint64_t BinaryPeventRenderer::render(std::istream& in, std::ostream& out)
+{
+    char magic[sizeof(BinaryPeventWriter::MAGIC)];
+    if(!in.read(magic, sizeof(magic)) ||
+       std::memcmp(magic, BinaryPeventWriter::MAGIC, sizeof(magic)) != 0){
+        throw SpartaException("Input is not a SPARTA binary pevent file");
+    }
+    const uint32_t version = readBinary<uint32_t>(in);
+    if(version != BinaryPeventWriter::VERSION){
+        throw SpartaException("Unsupported binary pevent version ") << version
+            << ". Expected " << BinaryPeventWriter::VERSION;
+    }
+
+    std::vector<Schema> schemas;
+    std::vector<std::string> strings;
+    std::vector<std::pair<uint8_t, uint64_t>> fields;
+    std::vector<std::string> inline_strings;
+    std::ostringstream content;
+    uint64_t num_events = 0;
+
+    int rec;
+    while((rec = in.get()) != std::char_traits<char>::eof()){
+        switch(rec){
+        case BinaryPeventWriter::REC_HEADER:
+            out << readBinaryString(in);
+            break;
+        case BinaryPeventWriter::REC_SCHEMA: {
+            const uint32_t type_id = readBinary<uint32_t>(in);
+            if(type_id != schemas.size()){
+                throw SpartaException("Binary pevent type ") << type_id << " is out of order";
+            }
+            Schema sch;
+            sch.location = readBinaryString(in);
+            sch.category = readBinaryString(in);
+            sch.event_name = readBinaryString(in);
+            const uint32_t num_keys = readBinary<uint32_t>(in);
+            for(uint32_t i = 0; i < num_keys; ++i){
+                sch.keys.emplace_back(readBinaryString(in));
+                sch.formats.emplace_back(static_cast<PairFormatter>(readBinary<uint8_t>(in)));
+            }
+            schemas.emplace_back(std::move(sch));
+            break;
+        }
+        case BinaryPeventWriter::REC_STRING: {
+            const uint32_t id = readBinary<uint32_t>(in);
+            if(id != strings.size()){
+                throw SpartaException("Binary pevent string ") << id << " is out of order";
+            }
+            strings.emplace_back(readBinaryString(in));
+            break;
+        }
+        case BinaryPeventWriter::REC_EVENT: {
+            const uint32_t type_id = readBinary<uint32_t>(in);
+            if(type_id >= schemas.size()){
+                throw SpartaException("Binary pevent references undefined type ") << type_id;
+            }
+            const Schema& sch = schemas[type_id];
+            const uint64_t tick = readBinary<uint64_t>(in);
+            const uint64_t cycle = readBinary<uint64_t>(in);
+            const uint64_t pevent_cycle = readBinary<uint64_t>(in);
+
+            fields.clear();
+            for(std::size_t i = 0; i < sch.keys.size(); ++i){
+                const uint8_t kind = readBinary<uint8_t>(in);
+                fields.emplace_back(kind, readBinary<uint64_t>(in));
+            }
+
+            // Inline string bytes follow the fixed-width slots
+            inline_strings.clear();
+            for(const auto& f : fields){
+                if(f.first == BinaryPeventWriter::FIELD_INLINE_STRING){
+                    inline_strings.emplace_back(readBinaryString(in, f.second));
+                }
+            }
+
+            // Same text as PeventCollector::generateCollectionString_
+            content.str("");
+            content << "ev=" << "\"" << sch.event_name << "\" ";
+            std::size_t next_inline = 0;
+            for(std::size_t i = 0; i < fields.size(); ++i){
+                const uint64_t val = fields[i].second;
+                switch(fields[i].first){
+                case BinaryPeventWriter::FIELD_ABSENT:
+                    break;
+                case BinaryPeventWriter::FIELD_NUMBER:
+                    content << sch.keys[i] << "=" << "\"";
+                    switch(sch.formats[i]){
+                    case PairFormatter::OCTAL:
+                        content << std::oct << val << std::dec;
+                        break;
+                    case PairFormatter::HEX:
+                        content << std::hex << val << std::dec;
+                        break;
+                    default:
+                        content << val;
+                        break;
+                    }
+                    content << "\" ";
+                    break;
+                case BinaryPeventWriter::FIELD_STRING:
+                    if(val >= strings.size()){
+                        throw SpartaException("Binary pevent references undefined string ") << val;
+                    }
+                    content << sch.keys[i] << "=" << "\"" << strings[val] << "\" ";
+                    break;
+                case BinaryPeventWriter::FIELD_INLINE_STRING:
+                    content << sch.keys[i] << "=" << "\"" << inline_strings[next_inline++] << "\" ";
+                    break;
+                default:
+                    throw SpartaException("Unknown binary pevent field kind ")
+                        << static_cast<uint32_t>(fields[i].first);
+                }
+            }
+            content << "cyc=" << pevent_cycle << ";";
+
+            log::BinaryLogRenderer::writeMessage(out, log::BinaryLogRenderer::Format::DEFAULT,
+                                                 tick, cycle, sch.location, sch.category, content.str());
+            ++num_events;
+            break;
+        }
+        default:
+            throw SpartaException("Unknown binary pevent record type ") << rec;
+        }
+    }
+
+    out.flush();
+    return num_events;
+}
+
+} // namespace pevents
+} // namespace sparta
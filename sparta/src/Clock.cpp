@@ -71,7 +71,7 @@ namespace sparta {
     {
         parent_ratio_ = utils::Rational<uint32_t>(p_rat, c_rat);
         root_ratio_   = parent_ratio_.inv();
-        period_       = 1;
+        setPeriod_(1);
         normalized_   = false;
     }
 }
@@ -21,6 +21,7 @@
 #include <boost/program_options/value_semantic.hpp>
 #include <boost/type_index/type_index_facade.hpp>
 #include <iostream>
+#include <iomanip>
 #include <algorithm>
 #include <chrono>
 #include <exception>
@@ -56,6 +57,8 @@
 #include "sparta/utils/TimeManager.hpp"
 #include "sparta/simulation/TreeNode.hpp"
 #include "sparta/app/AppTriggers.hpp"
+#include "sparta/app/ConfigImage.hpp"
+#include "sparta/app/SimulationInfo.hpp"
 #include "sparta/app/MetaTreeNode.hpp"
 #include "sparta/app/Simulation.hpp"
 #include "sparta/pipeViewer/InformationWriter.hpp"
@@ -253,6 +256,12 @@ CommandLineSimulator::CommandLineSimulator(const std::string& usage,
          "aways be appropriate because the simulation can be be ended abruptly with an "
          "instruction-count or cycle-count limit",
          "Enable post-run validation after run completes without exception") // Brief
+        ("finalize-threads",
+         named_value<uint32_t>("THREADS", &sim_config_.finalize_threads),
+         "Number of threads used to prepare resources while finalizing the device tree. "
+         "Parameters are validated and resources constructed one at a time in tree order, so the "
+         "resulting tree does not depend on this value. Default is 1",
+         "Threads used to prepare resources during tree finalization") // Brief
         ("disable-infinite-loop-protection",
          "Disable detection of infinite loops during simulation.") // Brief
         ("debug-dump",
@@ -481,6 +490,15 @@ CommandLineSimulator::CommandLineSimulator(const std::string& usage,
          "the simulation. The output will include parameter descriptions and extra whitespace for "
          "readability",
          "Write parameter configuration to file with long descriptions")
+        ("config-cache",
+         named_value<std::string>("DIR", &config_cache_dir_),
+         "Example: \"--config-cache /tmp/cfg_cache\"\n"
+         "Caches the parameter trees built from --arch, --config-file, --node-config-file, "
+         "--read-final-config and --parameter options in a binary image in DIR (created if "
+         "needed), named by a hash of these options and search directories. Later runs with the "
+         "same options load the image instead of parsing the YAML files again. An image is "
+         "rebuilt if any file it was built from (including included files) has changed",
+         "Cache parsed configuration files as binary images in DIR")
         ("enable-state-tracking",
          named_value<std::vector<std::string>>("FILENAME", 1, 1),
          "Specify a Text file to save State Residency Tracking Histograms. "
@@ -572,6 +590,14 @@ CommandLineSimulator::CommandLineSimulator(const std::string& usage,
          named_value<std::vector<std::vector<std::string>>>("[DEF_FILE]", 0, 1)->multitoken(),
          "Example: \"--log-memory-usage memory.yaml\"",
          "Capture memory usage statistics at periodic intervals throughout simulation")
+        ("startup-profile",
+         named_value<std::string>("FILENAME", &sim_config_.startup_profile_file),
+         "Example: \"--startup-profile startup.json\"\n"
+         "Records the wall time and heap growth of each device tree subtree while building, "
+         "configuring, finalizing and binding the tree and writes a report sorted by cost to "
+         "FILENAME once the tree is finalized. The report is JSON if FILENAME ends in '.json'. "
+         "Use '1' to print the report to stdout",
+         "Profile time and memory used by each subtree during simulator startup")
         ("retired-inst-counter-path",
          named_value<std::string>("FILENAME", &sim_config_.parsed_path_to_retired_inst_counter_),
          "From 'top.core*', what is the path to the counter specifying "
@@ -669,7 +695,8 @@ CommandLineSimulator::CommandLineSimulator(const std::string& usage,
          named_value<std::string>("OPTION", &auto_summary_)->default_value(auto_summary_),
          "Controls automatic summary at destruction. Valid values include 'off': Do not write "
          "summary, 'on' or 'normal': (default) Write summary after running, and 'verbose': Write "
-         "summary with detailed descriptions of each statistic",
+         "summary with detailed descriptions of each statistic and print the root clock cycles "
+         "elapsed after running",
          "Controls automatic summary at destruction. Valid values are {off,on,verbose}") // Brief"
         ;
 
@@ -1624,75 +1651,131 @@ bool CommandLineSimulator::parse(int argc,
         sim_config_.omitStatsWithValueZeroForReportFormat("json_reduced");
     }
 
-    // Get metadata architecture param from config files
-    bool config_metadata_arch_final = false;
-    for (const auto & cfg : config_pattern_names) {
-        const std::string & filename = std::get<1>(cfg);
-        const bool is_final = std::get<2>(cfg);
-        if(config_metadata_arch_final && !is_final) { continue; }
-        TreeNode dummy("dummy", "dummy");
-        sparta::ConfigParser::YAML param_file(filename, sim_config_.getConfigSearchPath());
-        param_file.allowMissingNodes(true);
-        constexpr bool VERBOSE = false;
-        param_file.consumeParameters(&dummy, VERBOSE);
-
-        const auto ptree = param_file.getParameterTree();
-        if(ptree.hasValue("meta.params.architecture")) {
-            const std::string& arch = ptree.get("meta.params.architecture").getValue();
-            if(arch != "NONE") {
-                const std::string & pattern = std::get<0>(cfg);
-                config_metadata_arch = std::make_pair(pattern, arch);
-            }
-            if(is_final) {
-                config_metadata_arch_final = true;
-            }
+    // With --config-cache, reuse the parameter trees built by an earlier run
+    // given the same options instead of parsing the arch and configuration
+    // files again. The image key covers every input other than file content
+    // (checked by the image itself), including parameters set so far
+    uint64_t config_image_key = 0;
+    std::string config_image_file;
+    bool config_image_loaded = false;
+    if(!config_cache_dir_.empty()) {
+        std::ostringstream inputs;
+        auto add_input = [&inputs](const std::string & str) {
+            inputs << str.size() << ':' << str << ';';
+        };
+        add_input(SimulationInfo::sparta_version);
+        add_input(arch_pattern_name.isValid() ? "1" : "0");
+        if(arch_pattern_name.isValid()) {
+            add_input(arch_pattern_name.getValue().first);
+            add_input(arch_pattern_name.getValue().second);
         }
-
+        add_input(sim_config_.getDefaults().arch_arg_default);
+        for (const auto & cfg : config_pattern_names) {
+            add_input(std::get<0>(cfg));
+            add_input(std::get<1>(cfg));
+            add_input(std::get<2>(cfg) ? "final" : "");
+        }
+        add_input("-p");
+        for (const auto & pvalue : individual_parameter_values) {
+            add_input(std::get<0>(pvalue));
+            add_input(std::get<1>(pvalue));
+            add_input(std::get<2>(pvalue) ? "optional" : "");
+        }
+        add_input("search");
+        for (const auto & dir : sim_config_.getArchSearchPath()) {
+            add_input(dir);
+        }
+        add_input("");
+        for (const auto & dir : sim_config_.getConfigSearchPath()) {
+            add_input(dir);
+        }
+        sim_config_.getArchUnboundParameterTree().recursePrint(inputs);
+        sim_config_.getUnboundParameterTree().recursePrint(inputs);
+
+        config_image_key = ConfigImage::hash(inputs.str());
+        std::stringstream key_str;
+        key_str << std::hex << std::setw(16) << std::setfill('0') << config_image_key;
+        config_image_file = (std::filesystem::path(config_cache_dir_) / (key_str.str() + ".cfgimg")).string();
+        config_image_loaded = sim_config_.loadConfigImage(config_image_file, config_image_key);
     }
 
-    // Check for valid arch config if required by defaults
-    //
-    // Priority:
-    // 1. --arch
-    // 2. --read-final-config
-    // 3. --config-file / --node-config-file
-    // 4. Default (if required)
-    if(arch_pattern_name.isValid()) {
-        sim_config_.processArch(arch_pattern_name.getValue().first, arch_pattern_name.getValue().second);
-    }
-    else if(config_metadata_arch.isValid()) {
-        sim_config_.processArch(config_metadata_arch.getValue().first, config_metadata_arch.getValue().second);
-    }
-    else {
-        if(!sim_config_.archFileProvided()) {
-            if(sim_config_.getDefaults().non_empty_arch_arg_required && sim_config_.getDefaults().arch_arg_default.empty()) {
-                throw SpartaException("This simulator requires an architecture be selected with --arch to proceed: ")
-                    << utils::ARCH_OPTIONS_RESOLUTION_RULES;
+    if(!config_image_loaded) {
+        // Get metadata architecture param from config files
+        bool config_metadata_arch_final = false;
+        for (const auto & cfg : config_pattern_names) {
+            const std::string & filename = std::get<1>(cfg);
+            const bool is_final = std::get<2>(cfg);
+            if(config_metadata_arch_final && !is_final) { continue; }
+            TreeNode dummy("dummy", "dummy");
+            sparta::ConfigParser::YAML param_file(filename, sim_config_.getConfigSearchPath());
+            param_file.allowMissingNodes(true);
+            constexpr bool VERBOSE = false;
+            param_file.consumeParameters(&dummy, VERBOSE);
+
+            const auto ptree = param_file.getParameterTree();
+            if(ptree.hasValue("meta.params.architecture")) {
+                const std::string& arch = ptree.get("meta.params.architecture").getValue();
+                if(arch != "NONE") {
+                    const std::string & pattern = std::get<0>(cfg);
+                    config_metadata_arch = std::make_pair(pattern, arch);
+                }
+                if(is_final) {
+                    config_metadata_arch_final = true;
+                }
             }
-            else if(!sim_config_.getDefaults().arch_arg_default.empty()) {
-                // Parse the default arch file provided since one was not
-                // provided on the command line
-                std::string pattern = ""; // Start from global node
-                sim_config_.processArch(pattern, sim_config_.getDefaults().arch_arg_default);
+
+        }
+
+        // Check for valid arch config if required by defaults
+        //
+        // Priority:
+        // 1. --arch
+        // 2. --read-final-config
+        // 3. --config-file / --node-config-file
+        // 4. Default (if required)
+        if(arch_pattern_name.isValid()) {
+            sim_config_.processArch(arch_pattern_name.getValue().first, arch_pattern_name.getValue().second);
+        }
+        else if(config_metadata_arch.isValid()) {
+            sim_config_.processArch(config_metadata_arch.getValue().first, config_metadata_arch.getValue().second);
+        }
+        else {
+            if(!sim_config_.archFileProvided()) {
+                if(sim_config_.getDefaults().non_empty_arch_arg_required && sim_config_.getDefaults().arch_arg_default.empty()) {
+                    throw SpartaException("This simulator requires an architecture be selected with --arch to proceed: ")
+                        << utils::ARCH_OPTIONS_RESOLUTION_RULES;
+                }
+                else if(!sim_config_.getDefaults().arch_arg_default.empty()) {
+                    // Parse the default arch file provided since one was not
+                    // provided on the command line
+                    std::string pattern = ""; // Start from global node
+                    sim_config_.processArch(pattern, sim_config_.getDefaults().arch_arg_default);
+                }
             }
         }
-    }
 
-    // Now that all --config-search-dir option(s) have been parsed, apply configurations
-    for (const auto & cfg : config_pattern_names) {
-        const std::string & pattern = std::get<0>(cfg);
-        const std::string & filename = std::get<1>(cfg);
-        const bool is_final = std::get<2>(cfg);
-        sim_config_.processConfigFile(pattern, filename, is_final);
-    }
+        // Now that all --config-search-dir option(s) have been parsed, apply configurations
+        for (const auto & cfg : config_pattern_names) {
+            const std::string & pattern = std::get<0>(cfg);
+            const std::string & filename = std::get<1>(cfg);
+            const bool is_final = std::get<2>(cfg);
+            sim_config_.processConfigFile(pattern, filename, is_final);
+        }
 
-    // **After** all arch/config/node-config yamls have been applied, consume
-    // any --parameter/-p values to the sim config
-    for (const auto & pvalue : individual_parameter_values) {
-        const std::string & pattern = std::get<0>(pvalue);
-        const std::string & value = std::get<1>(pvalue);
-        const bool is_optional = std::get<2>(pvalue);
-        sim_config_.processParameter(pattern, value, is_optional);
+        // **After** all arch/config/node-config yamls have been applied, consume
+        // any --parameter/-p values to the sim config
+        for (const auto & pvalue : individual_parameter_values) {
+            const std::string & pattern = std::get<0>(pvalue);
+            const std::string & value = std::get<1>(pvalue);
+            const bool is_optional = std::get<2>(pvalue);
+            sim_config_.processParameter(pattern, value, is_optional);
+        }
+
+        if(!config_cache_dir_.empty()) {
+            std::filesystem::create_directories(config_cache_dir_);
+            sim_config_.saveConfigImage(config_image_file, config_image_key);
+            std::cout << "  [out] Config image: \"" << config_image_file << "\"" << std::endl;
+        }
     }
 
     // Interpret debug-dump post-run value
@@ -0,0 +1,317 @@
+// <ConfigImage> -*- C++ -*-
+
+
+/*!
+ * \file ConfigImage.cpp
+ * \brief Implementation of ConfigImage
+ */
+
+#include "sparta/app/ConfigImage.hpp"
+
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "sparta/utils/SpartaAssert.hpp"
+#include "sparta/utils/SpartaException.hpp"
+
+namespace sparta {
+namespace app {
+
+namespace {
+
+    //! Identifies image files
+    constexpr char IMAGE_MAGIC[8] = {'S', 'P', 'C', 'F', 'G', 'I', 'M', 'G'};
+
+    //! Incremented whenever the layout of images changes
+    constexpr uint32_t IMAGE_FORMAT_VERSION = 1;
+
+    template <typename T>
+    void writeInt(std::string & buf, T val) {
+        buf.append(reinterpret_cast<const char*>(&val), sizeof(val));
+    }
+
+    void writeString(std::string & buf, const std::string & str) {
+        writeInt<uint32_t>(buf, static_cast<uint32_t>(str.size()));
+        buf.append(str);
+    }
+
+    //! Bounds-checked reader over the content of an image file
+    class Reader
+    {
+    public:
+        Reader(const std::string & buf, size_t begin, size_t end) :
+            buf_(buf), pos_(begin), end_(end)
+        { }
+
+        template <typename T>
+        bool readInt(T & val) {
+            if(end_ - pos_ < sizeof(val)){
+                return false;
+            }
+            std::memcpy(&val, buf_.data() + pos_, sizeof(val));
+            pos_ += sizeof(val);
+            return true;
+        }
+
+        bool readString(std::string & str) {
+            uint32_t size;
+            if(!readInt(size) || end_ - pos_ < size){
+                return false;
+            }
+            str.assign(buf_, pos_, size);
+            pos_ += size;
+            return true;
+        }
+
+        bool atEnd() const { return pos_ == end_; }
+
+    private:
+        const std::string & buf_;
+        size_t pos_;
+        const size_t end_;
+    };
+}
+
+uint64_t ConfigImage::hash(const std::string & data, uint64_t seed)
+{
+    uint64_t h = seed;
+    for(const char c : data){
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+bool ConfigImage::hashFile(const std::string & filename, uint64_t & hash)
+{
+    std::ifstream in(filename, std::ios::binary);
+    if(!in.is_open()){
+        return false;
+    }
+    const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if(in.bad()){
+        return false;
+    }
+    hash = ConfigImage::hash(content);
+    return true;
+}
+
+void ConfigImage::addDependency(const std::string & filename)
+{
+    for(const auto & dep : dependencies_){
+        if(dep.filename == filename){
+            return;
+        }
+    }
+    uint64_t content_hash;
+    if(!hashFile(filename, content_hash)){
+        throw SpartaException("Cannot read \"") << filename << "\" to add it to a configuration image";
+    }
+    dependencies_.push_back({filename, content_hash});
+}
+
+bool ConfigImage::isUpToDate() const
+{
+    for(const auto & dep : dependencies_){
+        uint64_t content_hash;
+        if(!hashFile(dep.filename, content_hash) || content_hash != dep.content_hash){
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string ConfigImage::getAttribute(const std::string & name) const
+{
+    auto itr = attributes_.find(name);
+    if(itr == attributes_.end()){
+        return "";
+    }
+    return itr->second;
+}
+
+void ConfigImage::flatten_(const ParameterTree::Node * node, uint32_t parent, FlatTree & flat)
+{
+    const uint32_t idx = static_cast<uint32_t>(flat.size());
+    flat.push_back({parent,
+                    node->getName(),
+                    node->hasValue() ? node->peekValue() : "",
+                    node->hasValue() ? node->getOrigin() : "",
+                    node->hasValue(),
+                    node->getRequiredCount()});
+    for(const ParameterTree::Node * child : node->getChildren()){
+        flatten_(child, idx, flat);
+    }
+}
+
+uint32_t ConfigImage::addTree(const ParameterTree & tree)
+{
+    trees_.emplace_back();
+    flatten_(tree.getRoot(), 0, trees_.back());
+    return static_cast<uint32_t>(trees_.size() - 1);
+}
+
+void ConfigImage::restoreTree(uint32_t idx, ParameterTree & tree) const
+{
+    sparta_assert(idx < trees_.size(), "No tree " << idx << " in configuration image");
+    const FlatTree & flat = trees_[idx];
+
+    tree.clear();
+    std::vector<ParameterTree::Node*> nodes;
+    nodes.reserve(flat.size());
+    nodes.push_back(tree.getRoot());
+
+    // Create every node before setting any value since nodes with values
+    // cannot be given children
+    for(size_t i = 1; i < flat.size(); ++i){
+        nodes.push_back(nodes[flat[i].parent]->addChild(flat[i].name, false));
+    }
+    for(size_t i = 0; i < flat.size(); ++i){
+        if(flat[i].has_value){
+            nodes[i]->setValue(flat[i].value, false, flat[i].origin);
+        }
+        for(uint32_t r = 0; r < flat[i].required; ++r){
+            nodes[i]->incRequired();
+        }
+    }
+}
+
+void ConfigImage::save(const std::string & filename) const
+{
+    std::string buf(IMAGE_MAGIC, sizeof(IMAGE_MAGIC));
+    writeInt<uint32_t>(buf, IMAGE_FORMAT_VERSION);
+    writeInt<uint64_t>(buf, key_);
+
+    writeInt<uint32_t>(buf, static_cast<uint32_t>(dependencies_.size()));
+    for(const auto & dep : dependencies_){
+        writeString(buf, dep.filename);
+        writeInt<uint64_t>(buf, dep.content_hash);
+    }
+
+    writeInt<uint32_t>(buf, static_cast<uint32_t>(attributes_.size()));
+    for(const auto & attr : attributes_){
+        writeString(buf, attr.first);
+        writeString(buf, attr.second);
+    }
+
+    writeInt<uint32_t>(buf, static_cast<uint32_t>(trees_.size()));
+    for(const FlatTree & flat : trees_){
+        writeInt<uint32_t>(buf, static_cast<uint32_t>(flat.size()));
+        for(const FlatNode & n : flat){
+            writeInt<uint32_t>(buf, n.parent);
+            writeString(buf, n.name);
+            writeString(buf, n.value);
+            writeString(buf, n.origin);
+            writeInt<uint8_t>(buf, n.has_value);
+            writeInt<uint32_t>(buf, n.required);
+        }
+    }
+
+    // Trailing checksum detects truncated or corrupted images
+    writeInt<uint64_t>(buf, hash(buf));
+
+    const std::string tmp_filename = filename + ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream out(tmp_filename, std::ios::binary | std::ios::trunc);
+        out.write(buf.data(), buf.size());
+        out.close();
+        if(!out){
+            std::remove(tmp_filename.c_str());
+            throw SpartaException("Failed to write configuration image \"") << tmp_filename << "\"";
+        }
+    }
+    if(std::rename(tmp_filename.c_str(), filename.c_str()) != 0){
+        std::remove(tmp_filename.c_str());
+        throw SpartaException("Failed to rename configuration image \"") << tmp_filename
+            << "\" to \"" << filename << "\"";
+    }
+}
+
+std::unique_ptr<ConfigImage> ConfigImage::load(const std::string & filename, uint64_t key)
+{
+    std::ifstream in(filename, std::ios::binary);
+    if(!in.is_open()){
+        return nullptr;
+    }
+    const std::string buf((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if(in.bad() || buf.size() < sizeof(IMAGE_MAGIC) + sizeof(uint64_t)){
+        return nullptr;
+    }
+
+    const size_t body_size = buf.size() - sizeof(uint64_t);
+    uint64_t checksum;
+    std::memcpy(&checksum, buf.data() + body_size, sizeof(checksum));
+    if(checksum != hash(buf.substr(0, body_size))
+       || buf.compare(0, sizeof(IMAGE_MAGIC), IMAGE_MAGIC, sizeof(IMAGE_MAGIC)) != 0){
+        return nullptr;
+    }
+
+    Reader rd(buf, sizeof(IMAGE_MAGIC), body_size);
+    uint32_t version;
+    uint64_t image_key;
+    if(!rd.readInt(version) || version != IMAGE_FORMAT_VERSION
+       || !rd.readInt(image_key) || image_key != key){
+        return nullptr;
+    }
+
+    std::unique_ptr<ConfigImage> image(new ConfigImage(key));
+
+    uint32_t num_deps;
+    if(!rd.readInt(num_deps)){
+        return nullptr;
+    }
+    for(uint32_t i = 0; i < num_deps; ++i){
+        Dependency dep;
+        if(!rd.readString(dep.filename) || !rd.readInt(dep.content_hash)){
+            return nullptr;
+        }
+        image->dependencies_.push_back(std::move(dep));
+    }
+
+    uint32_t num_attrs;
+    if(!rd.readInt(num_attrs)){
+        return nullptr;
+    }
+    for(uint32_t i = 0; i < num_attrs; ++i){
+        std::string name, value;
+        if(!rd.readString(name) || !rd.readString(value)){
+            return nullptr;
+        }
+        image->attributes_[name] = value;
+    }
+
+    uint32_t num_trees;
+    if(!rd.readInt(num_trees)){
+        return nullptr;
+    }
+    for(uint32_t t = 0; t < num_trees; ++t){
+        uint32_t num_nodes;
+        if(!rd.readInt(num_nodes) || num_nodes == 0){
+            return nullptr;
+        }
+        FlatTree flat;
+        for(uint32_t i = 0; i < num_nodes; ++i){
+            FlatNode n;
+            uint8_t has_value;
+            if(!rd.readInt(n.parent) || !rd.readString(n.name) || !rd.readString(n.value)
+               || !rd.readString(n.origin) || !rd.readInt(has_value) || !rd.readInt(n.required)
+               || (i > 0 && n.parent >= i)){
+                return nullptr;
+            }
+            n.has_value = (has_value != 0);
+            flat.push_back(std::move(n));
+        }
+        image->trees_.push_back(std::move(flat));
+    }
+
+    if(!rd.atEnd()){
+        return nullptr;
+    }
+    return image;
+}
+
+} // namespace app
+} // namespace sparta
@@ -607,6 +607,9 @@ namespace sparta
             TreeNode dummy("dummy", "dummy");
             NodeVector dummy_tree{&dummy};
             incl.consumeParameters(device_trees.size() > 0 ? device_trees : dummy_tree, verbose_); // Throws on error
+            included_files_.insert(included_files_.end(),
+                                   incl.getConsumedFiles().begin(),
+                                   incl.getConsumedFiles().end());
             if(ptn){ // Because ptree cannot handle parent references yet
                 ptn->appendTree(incl.getParameterTree().getRoot()); // Bring over tree
             }
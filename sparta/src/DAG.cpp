@@ -3,7 +3,12 @@
 
 #include "sparta/kernel/DAG.hpp"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "sparta/events/SchedulingPhases.hpp"
+#include "sparta/kernel/Scheduler.hpp"
 
 
 namespace sparta
@@ -168,14 +173,21 @@ namespace sparta
     void DAG::link(Vertex * source_vertex,
                    Vertex * dest_vertex, const std::string & reason)
     {
-        if(!source_vertex->isInDAG()){
-            alloc_vertices_.emplace_back(source_vertex);
-            source_vertex->setInDAG(true);
+        if(finalized_) {
+            sparta_assert(my_scheduler_->isRunning() == false,
+                          "Cannot add DAG link " << source_vertex->getLabel() << " -> "
+                          << dest_vertex->getLabel() << " while the Scheduler is running");
         }
 
-        if(!dest_vertex->isInDAG()){
-            alloc_vertices_.emplace_back(dest_vertex);
-            dest_vertex->setInDAG(true);
+        for(Vertex * v : {source_vertex, dest_vertex}) {
+            if(!v->isInDAG()){
+                alloc_vertices_.emplace_back(v);
+                v->setInDAG(true);
+                if(finalized_) {
+                    // Sort would have started it in the first group
+                    v->reset();
+                }
+            }
         }
 
         if(SPARTA_EXPECT_FALSE(debug_logger_)){
@@ -188,23 +200,95 @@ namespace sparta
         }
 
         if (source_vertex->link(e_factory_, dest_vertex, reason)) {
-            if (early_cycle_detect_ && detectCycle()) {
+            if (finalized_) {
+                updateGroupsAfterLink_(source_vertex, dest_vertex);
+            }
+            else if (early_cycle_detect_ && detectCycle()) {
                 throw CycleException(getCycles_());
             }
         }
     }
 
+    void DAG::updateGroupsAfterLink_(Vertex * source, Vertex * dest)
+    {
+        if (dest->getGroupID() > source->getGroupID()) {
+            return;
+        }
+
+        // Push dest after source, then walk forward raising every
+        // vertex that is no longer after its producer.  The rest of
+        // the DAG was already ordered, so the walk stops where the
+        // group IDs were already high enough.  Reaching source again
+        // means the new edge closed a cycle.
+        std::vector<std::pair<Vertex *, Vertex::PrecedenceGroup>> raised;
+        std::vector<Vertex *> to_visit;
+        raised.emplace_back(dest, dest->getGroupID());
+        dest->setGroupID(source->getGroupID() + 1);
+        to_visit.emplace_back(dest);
+
+        bool found_cycle = false;
+        while (!to_visit.empty() && !found_cycle)
+        {
+            Vertex * v = to_visit.back();
+            to_visit.pop_back();
+            const Vertex::PrecedenceGroup gid = v->getGroupID();
+            for (Vertex * w_out : v->edges())
+            {
+                if (w_out == source) {
+                    found_cycle = true;
+                    break;
+                }
+                if (w_out->getGroupID() <= gid) {
+                    raised.emplace_back(w_out, w_out->getGroupID());
+                    w_out->setGroupID(gid + 1);
+                    to_visit.emplace_back(w_out);
+                }
+            }
+        }
+
+        if (found_cycle) {
+            auto cycle = getCycles_();
+            for (auto ri = raised.rbegin(); ri != raised.rend(); ++ri) {
+                ri->first->setGroupID(ri->second);
+            }
+            source->unlink(e_factory_, dest);
+            throw CycleException(cycle);
+        }
+
+        uint32_t num_groups = num_groups_;
+        for (const auto & r : raised) {
+            num_groups = std::max(num_groups, r.first->getGroupID() + 1);
+        }
+        if (num_groups != num_groups_) {
+            num_groups_ = num_groups;
+            my_scheduler_->growDAGGroups_(num_groups_);
+        }
+
+        // Events scheduled before the link are still waiting in the
+        // old groups.  GOP associates follow their GOP.
+        for (const auto & r : raised) {
+            const Vertex * v = r.first;
+            if (v->getScheduleable() != nullptr) {
+                my_scheduler_->moveScheduledEvents_(v->getScheduleable(), r.second);
+            }
+            if (v->isGOP()) {
+                for (const Scheduleable * s : v->retransferGID()) {
+                    my_scheduler_->moveScheduledEvents_(s, r.second);
+                }
+            }
+        }
+    }
 
     bool DAG::sort()
     {
         uint32_t vcount = alloc_vertices_.size();
         num_groups_ = 1;
-        typename Vertex::VertexList   zlist;
 
-        if (detectCycle()) {
-            printCycles(std::cout);
-            //sparta_assert(false);
-        }
+        // Vertices with no remaining inbound edges, in the order they
+        // were found.  zlist_head is the next one to visit.
+        std::vector<Vertex *> zlist;
+        zlist.reserve(vcount);
+        size_t zlist_head = 0;
 
         // Initialize the queue of 0-vertices
         for (auto & vi : alloc_vertices_) {
@@ -223,20 +307,17 @@ namespace sparta
         // appends them to the zlist to keep this while loop going.
         // If list empties, but there are still vertexes not removed,
         // then we have a cycle
-        while (!zlist.empty())
+        while (zlist_head < zlist.size())
         {
-            Vertex *v = zlist.front();
+            Vertex *v = zlist[zlist_head++];
             sparta_assert(v != nullptr);
-            zlist.pop_front();
 
             sparta_assert(vcount > 0);
             --vcount;
 
-            // v->assignConsumerGroupIDs(zlist);
             uint32_t gid = v->getGroupID();
             for(auto &w_out : v->edges())
             {
-                // Vertex * outbound = ei.first;
                 // The outbound edge better have a count of edges by at
                 // LEAST one -- it has to include this link!
                 uint32_t w_out_inbound_edges = w_out->getNumInboundEdgesForSorting();
@@ -267,7 +348,11 @@ namespace sparta
         //How many groups are there after finalization.
         sparta_assert(num_groups_ > 0);
 
+        // Vertices never reaching zero inbound edges are on (or
+        // after) a cycle.  The sort finds this on its own, so the
+        // graph is only searched for the cycle when there is one.
         if (vcount != 0) {
+            printCycles(std::cout);
             throw CycleException(getCycles_());
         }
         return (vcount == 0);
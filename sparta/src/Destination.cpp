@@ -7,6 +7,7 @@
  */
 
 #include "sparta/log/Destination.hpp"
+#include "sparta/log/BinaryFormatter.hpp"
 
 #include <fstream>
 #include <iomanip>
@@ -34,6 +35,12 @@ const Formatter::Info FMTLIST[] = {
       "verbose formatter. Contains no message meta-data",
       [](std::ostream& s) -> sparta::log::Formatter* { return new sparta::log::RawFormatter(s); } },
 
+    /*! Compact binary records written by a background thread. Render with sparta_log_render */
+    { ".log.bin",
+      "binary formatter. Contains all message meta-data. Written asynchronously; "
+      "convert to text with sparta_log_render",
+      [](std::ostream& s) -> sparta::log::Formatter* { return new sparta::log::BinaryFormatter(s); } },
+
     /*! Writes all content to HTML table */
     /*{ ".log.html",  "html formatting. Contains all message data",
       [](std::ofstream& s) -> sparta::log::Formatter* { return new sparta::log::HTMLFormatter(s); } },*/
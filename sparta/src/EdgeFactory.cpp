@@ -22,6 +22,7 @@ void EdgeFactory::removeEdge(const sparta::Edge* edge) {
                            });
 
     if (ei != edges_.end()) {
+        edge_keys_.erase(edgeKey_(edge->getSource(), edge->getDest()));
         edges_.erase(ei);
     }
 }
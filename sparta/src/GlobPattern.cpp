@@ -0,0 +1,174 @@
+// <GlobPattern> -*- C++ -*-
+
+
+#include "sparta/utils/GlobPattern.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
+#include "sparta/simulation/TreeNode.hpp"
+
+namespace sparta
+{
+    namespace utils
+    {
+        namespace
+        {
+            /*!
+             * \brief Characters which are not wildcards but have a special
+             * meaning in the regex generated by
+             * TreeNode::createSearchRegexPattern. Patterns containing these
+             * are matched through std::regex to keep identical behavior
+             */
+            constexpr char REGEX_SPECIAL_CHARS[] = ".^$|{}\\";
+
+            /*!
+             * \brief Maximum number of cached patterns. The cache is cleared
+             * when full rather than tracking use
+             */
+            constexpr size_t MAX_CACHED_PATTERNS = 16384;
+
+            //! Wildcard text cannot include line terminators (like regex '.')
+            bool isLineTerminator(char c) {
+                return c == '\n' || c == '\r';
+            }
+        }
+
+        GlobPattern::GlobPattern(const std::string& pattern) :
+            pattern_(pattern)
+        {
+            if(pattern_.find_first_of(REGEX_SPECIAL_CHARS) != std::string::npos){
+                fallback_.reset(new std::regex(TreeNode::createSearchRegexPattern(pattern_)));
+                return;
+            }
+
+            for(const char c : pattern_){
+                TokenType type;
+                switch(c){
+                case '*':
+                    type = TokenType::ANY;
+                    break;
+                case '?':
+                    type = TokenType::ZERO_OR_ONE;
+                    break;
+                case '+':
+                    type = TokenType::ONE_OR_MORE;
+                    break;
+                default:
+                    if(tokens_.empty() || tokens_.back().type != TokenType::LITERAL){
+                        tokens_.push_back({TokenType::LITERAL, "", 0});
+                    }
+                    tokens_.back().literal += c;
+                    continue;
+                }
+                tokens_.push_back({type, "", num_wildcards_++});
+            }
+        }
+
+        std::shared_ptr<const GlobPattern> GlobPattern::get(const std::string& pattern)
+        {
+            static std::mutex cache_mutex;
+            static std::unordered_map<std::string, std::shared_ptr<const GlobPattern>> cache;
+
+            std::lock_guard<std::mutex> lock(cache_mutex);
+            auto itr = cache.find(pattern);
+            if(itr != cache.end()){
+                return itr->second;
+            }
+            if(cache.size() >= MAX_CACHED_PATTERNS){
+                cache.clear(); // Outstanding patterns stay alive through their shared_ptrs
+            }
+            auto compiled = std::make_shared<const GlobPattern>(pattern);
+            cache.emplace(pattern, compiled);
+            return compiled;
+        }
+
+        bool GlobPattern::match(const std::string& str) const
+        {
+            if(fallback_){
+                return std::regex_match(str, *fallback_);
+            }
+            if(num_wildcards_ == 0){
+                return str == pattern_;
+            }
+            return matchTokens_(0, str, nullptr);
+        }
+
+        bool GlobPattern::match(const std::string& str, std::vector<std::string>& captures) const
+        {
+            if(fallback_){
+                std::smatch what;
+                if(!std::regex_match(str, what, *fallback_)){
+                    return false;
+                }
+                // Skip 0 because it is the whole expression
+                for(size_t i = 1; i < what.size(); ++i){
+                    captures.push_back(what[i].str());
+                }
+                return true;
+            }
+            if(num_wildcards_ == 0){
+                return str == pattern_;
+            }
+
+            std::vector<std::string_view> matched(num_wildcards_);
+            if(!matchTokens_(0, str, &matched)){
+                return false;
+            }
+            for(const std::string_view& cap : matched){
+                captures.emplace_back(cap);
+            }
+            return true;
+        }
+
+        bool GlobPattern::matchTokens_(size_t tok, std::string_view rest,
+                                       std::vector<std::string_view>* captures) const
+        {
+            if(tok == tokens_.size()){
+                return rest.empty();
+            }
+
+            const Token& token = tokens_[tok];
+            if(token.type == TokenType::LITERAL){
+                if(rest.compare(0, token.literal.size(), token.literal) != 0){
+                    return false;
+                }
+                return matchTokens_(tok + 1, rest.substr(token.literal.size()), captures);
+            }
+
+            // Longest run of text this wildcard can consume
+            size_t max_len = 0;
+            while(max_len < rest.size() && !isLineTerminator(rest[max_len])){
+                ++max_len;
+            }
+            if(token.type == TokenType::ZERO_OR_ONE && max_len > 1){
+                max_len = 1;
+            }
+            const size_t min_len = (token.type == TokenType::ONE_OR_MORE) ? 1 : 0;
+
+            // A trailing wildcard must consume everything that remains
+            if(tok + 1 == tokens_.size()){
+                if(max_len != rest.size() || max_len < min_len){
+                    return false;
+                }
+                if(captures){
+                    (*captures)[token.capture] = rest;
+                }
+                return true;
+            }
+
+            // Greedy: try the longest text first, as std::regex would, so
+            // that captures are identical
+            for(size_t len = max_len + 1; len-- > min_len;){
+                if(matchTokens_(tok + 1, rest.substr(len), captures)){
+                    if(captures){
+                        (*captures)[token.capture] = rest.substr(0, len);
+                    }
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    } // namespace utils
+} // namespace sparta
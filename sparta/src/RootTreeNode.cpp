@@ -9,9 +9,13 @@
 #include "sparta/simulation/RootTreeNode.hpp"
 
 #include <algorithm>
+#include <atomic>
 #include <sstream>
+#include <system_error>
+#include <thread>
 
 #include "sparta/simulation/Resource.hpp"
+#include "sparta/simulation/ResourceTreeNode.hpp"
 #include "sparta/functional/ArchData.hpp"
 #ifdef SPARTA_PYTHON_SUPPORT
 #include "python/sparta_support/PythonInterpreter.hpp"
@@ -144,6 +148,54 @@ void RootTreeNode::dumpTypeMix(std::ostream& o) const {
     o << "UNIMPLEMENTED: " << __PRETTY_FUNCTION__ << std::endl;
 }
 
+void RootTreeNode::prepareResourcesConcurrently_() {
+    // Gather resource nodes in tree order from the main thread. Nodes which
+    // cannot create a resource are left for createResource_ to report
+    std::vector<ResourceTreeNode*> rtns;
+    std::vector<TreeNode*> to_visit = {this};
+    while(!to_visit.empty()){
+        TreeNode* n = to_visit.back();
+        to_visit.pop_back();
+
+        ResourceTreeNode* rtn = dynamic_cast<ResourceTreeNode*>(n);
+        if(rtn && rtn->getResourceNow() == nullptr && rtn->isAttached() && rtn->getClock() != nullptr){
+            rtns.push_back(rtn);
+        }
+
+        const TreeNode::ChildrenVector& children = TreeNodePrivateAttorney::getAllChildren(n);
+        to_visit.insert(to_visit.end(), children.rbegin(), children.rend());
+    }
+
+    // Parameter validation callbacks can read other nodes' parameters
+    // (which counts reads) and log, so they stay on this thread
+    for(ResourceTreeNode* rtn : rtns){
+        rtn->validateParameters();
+    }
+
+    // Nodes are handed out in tree order to whichever thread is free.
+    // prepareResource does not throw
+    std::atomic<size_t> next(0);
+    auto worker = [&rtns, &next]() {
+        for(size_t i = next++; i < rtns.size(); i = next++){
+            rtns[i]->prepareResource();
+        }
+    };
+
+    const size_t num_threads = std::min<size_t>(num_finalize_threads_, rtns.size());
+    std::vector<std::thread> threads;
+    for(size_t t = 1; t < num_threads; ++t){
+        try{
+            threads.emplace_back(worker);
+        }catch(std::system_error&){
+            break; // Continue with the threads already running
+        }
+    }
+    worker(); // This thread works too
+    for(std::thread& th : threads){
+        th.join();
+    }
+}
+
 void RootTreeNode::enterFinalized(sparta::python::PythonInterpreter* pyshell) {
     if(getPhase() != TREE_CONFIGURING){
         throw SpartaException("Device tree with root \"")
@@ -153,6 +205,10 @@ void RootTreeNode::enterFinalized(sparta::python::PythonInterpreter* pyshell) {
 
     enterFinalizing_(); // Enter the next phase (cannot throw)
 
+    if(num_finalize_threads_ > 1){
+        prepareResourcesConcurrently_(); // Errors are held until resources are created
+    }
+
     finalizeTree_(); // Do the finalization, which may throw
 
 #ifdef SPARTA_PYTHON_SUPPORT
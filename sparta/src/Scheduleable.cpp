@@ -56,8 +56,8 @@ namespace sparta
     void Scheduleable::precedes(Scheduleable & w, const std::string & label) {
         sparta_assert(scheduler_);
         DAG * dag = scheduler_->getDAG();
-        sparta_assert(dag->isFinalized() == false,
-                    "You cannot set precedence during a running simulation (i.e., the DAG is finalized)");
+        sparta_assert(dag->isFinalized() == false || scheduler_->isRunning() == false,
+                    "You cannot set precedence during a running simulation");
         try {
             dag->link(this->vertex_, w.vertex_, label);
         } catch(sparta::DAG::CycleException & e) {
@@ -78,8 +78,8 @@ namespace sparta
     void Scheduleable::precedes(Vertex & w, const std::string & label) const {
         sparta_assert(scheduler_);
         DAG * dag = scheduler_->getDAG();
-        sparta_assert(dag->isFinalized() == false,
-                    "You cannot set precedence during a running simulation (i.e., the DAG is finalized)");
+        sparta_assert(dag->isFinalized() == false || scheduler_->isRunning() == false,
+                    "You cannot set precedence during a running simulation");
         try {
             dag->link(this->vertex_, &w, label);
         } catch(sparta::DAG::CycleException & e) {
@@ -114,7 +114,9 @@ namespace sparta
     {
 
         sparta_assert(scheduler_);
-        if (scheduler_->isFinalized()) {
+        // Scheduleables created after finalization join the DAG
+        // incrementally, but not while events are firing
+        if (scheduler_->isRunning()) {
             return;
         }
 
@@ -257,6 +257,7 @@ void Scheduler::clearEvents()
             events.clear();
             last_event_idx = 0;
         }
+        std::fill(tq->occupied_groups.begin(), tq->occupied_groups.end(), 0);
 
         auto temp_tq = tq;
         tq = tq->next;
@@ -291,6 +292,70 @@ void Scheduler::restartAt(Tick t)
     }
 }
 
+Scheduler::TickQuantum* Scheduler::allocateTickQuantum_()
+{
+    TickQuantum * tq = tick_quantum_allocator_.create(firing_group_count_);
+
+    // A recycled quantum may predate growDAGGroups_
+    if(SPARTA_EXPECT_FALSE(tq->groups.size() != firing_group_count_)) {
+        tq->resizeGroups(firing_group_count_);
+    }
+    return tq;
+}
+
+void Scheduler::growDAGGroups_(uint32_t dag_group_count)
+{
+    sparta_assert(!running_, "Cannot add groups to the DAG while the Scheduler is running");
+
+    // finalize() reads the group count itself
+    if(!dag_finalized_ || (dag_group_count <= dag_group_count_)) {
+        return;
+    }
+    if(SPARTA_EXPECT_FALSE(debug_)) {
+        debug_ << "DAG grew from " << dag_group_count_ << " to " << dag_group_count << " groups";
+    }
+
+    // Same layout as finalize: DAG groups, pre/post-tick, then group zero
+    dag_group_count_    = dag_group_count;
+    firing_group_count_ = dag_group_count_ + 2;
+    group_zero_         = firing_group_count_++;
+
+    for(TickQuantum * tq = current_tick_quantum_; tq != nullptr; tq = tq->next) {
+        tq->resizeGroups(firing_group_count_);
+    }
+}
+
+void Scheduler::moveScheduledEvents_(const Scheduleable * scheduleable, uint32_t old_dag_group)
+{
+    sparta_assert(!running_, "Cannot move scheduled events while the Scheduler is running");
+
+    const uint32_t new_dag_group = scheduleable->getGroupID();
+    const uint32_t old_firing_group = (old_dag_group != 0) ? old_dag_group + 1 : group_zero_;
+    const uint32_t new_firing_group = (new_dag_group != 0) ? new_dag_group + 1 : group_zero_;
+    if(old_firing_group == new_firing_group) {
+        return;
+    }
+
+    for(TickQuantum * tq = current_tick_quantum_; tq != nullptr; tq = tq->next)
+    {
+        TickQuantum::ScheduleableGroup & scheduleables = tq->groups[old_firing_group];
+        for(uint32_t i = 0; i < scheduleables.size(); ++i)
+        {
+            if(scheduleables[i] == scheduleable) {
+                Scheduleable * sched = scheduleables[i];
+                scheduleables[i] = cancelled_event_.get();
+                tq->addEvent(new_firing_group, sched);
+                if(SPARTA_EXPECT_FALSE(debug_)) {
+                    debug_ << "moving: " << scheduleable->getLabel()
+                           << " at tick: " << tq->tick
+                           << " from group: " << old_firing_group
+                           << " to group: " << new_firing_group;
+                }
+            }
+        }
+    }
+}
+
 Scheduler::TickQuantum* Scheduler::determineTickQuantum_(Tick rel_time)
 {
     const Tick index_time = calcIndexTime(rel_time);
@@ -308,7 +373,7 @@ Scheduler::TickQuantum* Scheduler::determineTickQuantum_(Tick rel_time)
         }
         else if(rit->tick > index_time) {
             // We're past the tick quantum.  Insert before rit
-            rit = tick_quantum_allocator_.create(firing_group_count_);
+            rit = allocateTickQuantum_();
             rit->tick = index_time;
 
             // rit could have pointed to the
@@ -332,7 +397,7 @@ Scheduler::TickQuantum* Scheduler::determineTickQuantum_(Tick rel_time)
     //if(SPARTA_EXPECT_FALSE(rit == nullptr))
     if(rit == nullptr)
     {
-        rit = tick_quantum_allocator_.create(firing_group_count_);
+        rit = allocateTickQuantum_();
         rit->tick = index_time;
         if(SPARTA_EXPECT_TRUE(last_tq != nullptr)) {
             last_tq->next = rit;
@@ -543,7 +608,7 @@ void Scheduler::run(Tick num_ticks,
         elapsed_ticks_             += std::llabs(int64_t(current_tick_) - int64_t(elapsed_ticks_));
 
         // Optimization -- start at the first group with events
-        current_group_firing_       = quantum->first_group_idx;
+        current_group_firing_       = quantum->nextOccupiedGroup(0);
 
         for(auto clk : registered_clocks_) {
             clk->updateElapsedCycles(elapsed_ticks_);
@@ -599,21 +664,18 @@ void Scheduler::run(Tick num_ticks,
             {
                 const Scheduleable * sched = events[current_event_firing_];
                 current_scheduling_phase_ = sched->getSchedulingPhase();
-                if(SPARTA_EXPECT_FALSE(debug_)) {
-                    printNextCycleEventTree(debug_, current_group_firing_, current_event_firing_);
-                    debug_ << SPARTA_CURRENT_COLOR_BRIGHT_CYAN << "--> SCHEDULER: Firing " << sched->getLabel()
-                           << " at time: " << current_tick_
-                           << " group: " << current_group_firing_
-                           << SPARTA_CURRENT_COLOR_NORMAL;
-                }
-                if(SPARTA_EXPECT_FALSE(call_trace_logger_)) {
-                    call_trace_stream_ << sched->getLabel() << " ";
+                if(SPARTA_EXPECT_FALSE(debug_ || call_trace_logger_)) {
+                    logFiringEvent_(sched);
                 }
                 sched->getHandler()();
                 ++events_fired_;
             }
             events.clear();
-            ++current_group_firing_;
+            quantum->markEmpty(current_group_firing_);
+
+            // Jump to the next group with events, which includes any
+            // group scheduled into while this one was firing
+            current_group_firing_ = quantum->nextOccupiedGroup(current_group_firing_ + 1);
         }
 
         if(SPARTA_EXPECT_FALSE(call_trace_logger_)) {
@@ -689,7 +751,7 @@ bool Scheduler::isScheduled(const Scheduleable * scheduleable, Tick rel_time) co
         if(rit->tick == index_time)
         {
             // This is the time quantum requested
-            const auto events = rit->groups[dag_group];
+            const auto & events = rit->groups[dag_group];
             const auto grp_size = events.size();
             for(size_t idx = 0; idx < grp_size; ++idx)
             {
@@ -716,7 +778,7 @@ bool Scheduler::isScheduled(const Scheduleable * scheduleable) const
     const TickQuantum * rit = current_tick_quantum_;
     while(rit != nullptr)
     {
-        const auto events = rit->groups[dag_group];
+        const auto & events = rit->groups[dag_group];
         const auto grp_size = events.size();
         for(size_t idx = 0; idx < grp_size; ++idx)
         {
@@ -833,6 +895,20 @@ void Scheduler::throwPrecedenceIssue_(const Scheduleable * scheduleable, const u
     throw SpartaException(st.str());
 }
 
+void Scheduler::logFiringEvent_(const Scheduleable * sched)
+{
+    if(debug_) {
+        printNextCycleEventTree(debug_, current_group_firing_, current_event_firing_);
+        debug_ << SPARTA_CURRENT_COLOR_BRIGHT_CYAN << "--> SCHEDULER: Firing " << sched->getLabel()
+               << " at time: " << current_tick_
+               << " group: " << current_group_firing_
+               << SPARTA_CURRENT_COLOR_NORMAL;
+    }
+    if(call_trace_logger_) {
+        call_trace_stream_ << sched->getLabel() << " ";
+    }
+}
+
 const char * Scheduler::getScheduleableLabel_(const Scheduleable * sched) const
 {
     return sched->getLabel();
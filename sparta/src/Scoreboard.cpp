@@ -1,6 +1,8 @@
 
 #include "sparta/resources/Scoreboard.hpp"
 
+#include <algorithm>
+
 namespace sparta
 {
     const char Scoreboard::name[] = "Scoreboard";
@@ -230,6 +232,27 @@ namespace sparta
     // ScoreboardView implementation
     ////////////////////////////////////////////////////////////////////////////////
 
+    namespace
+    {
+        // Call func(reg) for each register set in bits, in increasing order
+        template<class FuncT>
+        void forEachRegister(const Scoreboard::RegisterBitMask & bits, FuncT && func)
+        {
+            if(bits.none()) {
+                return;
+            }
+            static const Scoreboard::RegisterBitMask word_mask(~0ull);
+            for(uint32_t base = 0; base < Scoreboard::MAX_REGISTERS; base += 64)
+            {
+                uint64_t word = ((bits >> base) & word_mask).to_ullong();
+                while(word != 0) {
+                    func(base + static_cast<uint32_t>(__builtin_ctzll(word)));
+                    word &= word - 1;
+                }
+            }
+        }
+    }
+
     ScoreboardView::ScoreboardView(const std::string & unit_name,
                                    const std::string & scoreboard_type,
                                    sparta::TreeNode * parent) :
@@ -256,49 +279,136 @@ namespace sparta
         sparta_assert(bits.any(),
                       "Update should only be generated for non-empty vector: " << unit_name_);
 
-        // Setting local ready bits
+        // Setting local ready bits.  Only the waiters of registers which
+        // just became ready are visited
+        const auto newly_ready = bits & ~local_ready_mask_;
         local_ready_mask_ |= bits;
-
-        auto cbit = ready_callbacks_.begin();
-        const auto eit = ready_callbacks_.end();
-        while(cbit != eit)
+        forEachRegister(newly_ready, [this](uint32_t reg) {
+            for(PoolIndex lidx = register_waiters_[reg]; lidx != INVALID_INDEX; lidx = links_[lidx].next) {
+                const PoolIndex widx = links_[lidx].waiter;
+                if(--waiters_[widx].num_not_ready == 0) {
+                    ready_waiters_.emplace_back(waiters_[widx].seq, widx);
+                }
+            }
+        });
+
+        // Call the ready waiters in registration order.  Callbacks can
+        // register waiters that are already ready; those are called by this
+        // update as well.  The scratch list is taken (not used in place) in
+        // case a callback causes a nested update of this view
+        ReadyWaiters calling;
+        calling.swap(calling_waiters_);
+        while(!ready_waiters_.empty())
         {
-            const auto & cb_data = *cbit;
-            if (cb_data.needed_bits == (local_ready_mask_ & cb_data.needed_bits))
+            calling.swap(ready_waiters_);
+            std::sort(calling.begin(), calling.end());
+            for(const auto & [seq, widx] : calling)
             {
-                cb_data.callback(bits);
-                cbit = ready_callbacks_.erase(cbit);
-                continue;
+                auto & waiter = waiters_[widx];
+                // Skip waiters called, cleared (the slot may have been
+                // reused) or made not ready by clearBits_ since they were
+                // queued
+                if(!waiter.active || waiter.seq != seq || waiter.num_not_ready != 0) {
+                    continue;
+                }
+                const ReadinessCallback callback = std::move(waiter.callback);
+                releaseWaiter_(widx);
+                callback(bits);
             }
-            ++cbit;
+            calling.clear();
         }
+        calling_waiters_.swap(calling);
     }
 
     void ScoreboardView::registerReadyCallback(const Scoreboard::RegisterBitMask & bits,
                                                const Scoreboard::InstID inst_id,
                                                const ReadinessCallback & callback)
     {
-        ready_callbacks_.emplace_back(bits, inst_id, callback, clock_->currentCycle());
+        PoolIndex widx;
+        if(free_waiters_.empty()) {
+            widx = static_cast<PoolIndex>(waiters_.size());
+            waiters_.emplace_back();
+        }
+        else {
+            widx = free_waiters_.back();
+            free_waiters_.pop_back();
+        }
+
+        auto & waiter = waiters_[widx];
+        waiter.needed_bits     = bits;
+        waiter.inst_id         = inst_id;
+        waiter.callback        = callback;
+        waiter.registered_time = clock_->currentCycle();
+        waiter.seq             = next_waiter_seq_++;
+        waiter.num_not_ready   = static_cast<uint32_t>((bits & ~local_ready_mask_).count());
+        waiter.first_link      = INVALID_INDEX;
+        waiter.active          = true;
+
+        // Wait on every needed register, including ready ones, since they
+        // can be cleared before the others become ready
+        forEachRegister(bits, [this, widx](uint32_t reg) {
+            PoolIndex lidx;
+            if(free_links_.empty()) {
+                lidx = static_cast<PoolIndex>(links_.size());
+                links_.emplace_back();
+            }
+            else {
+                lidx = free_links_.back();
+                free_links_.pop_back();
+            }
+            auto & link = links_[lidx];
+            link.waiter = widx;
+            link.reg    = reg;
+            link.prev   = INVALID_INDEX;
+            link.next   = register_waiters_[reg];
+            if(link.next != INVALID_INDEX) {
+                links_[link.next].prev = lidx;
+            }
+            register_waiters_[reg] = lidx;
+            link.next_of_waiter = waiters_[widx].first_link;
+            waiters_[widx].first_link = lidx;
+        });
+
+        // Like any waiter, one that is already ready is called on the next
+        // update
+        if(waiter.num_not_ready == 0) {
+            ready_waiters_.emplace_back(waiter.seq, widx);
+        }
+    }
+
+    void ScoreboardView::releaseWaiter_(PoolIndex widx)
+    {
+        auto & waiter = waiters_[widx];
+        PoolIndex lidx = waiter.first_link;
+        while(lidx != INVALID_INDEX)
+        {
+            const auto & link = links_[lidx];
+            if(link.prev != INVALID_INDEX) {
+                links_[link.prev].next = link.next;
+            }
+            else {
+                register_waiters_[link.reg] = link.next;
+            }
+            if(link.next != INVALID_INDEX) {
+                links_[link.next].prev = link.prev;
+            }
+            free_links_.emplace_back(lidx);
+            lidx = link.next_of_waiter;
+        }
+        waiter.first_link = INVALID_INDEX;
+        waiter.callback   = nullptr;
+        waiter.active     = false;
+        free_waiters_.emplace_back(widx);
     }
 
     void ScoreboardView::clearCallbacks(const Scoreboard::InstID inst_id)
     {
-        auto clear_fn = [inst_id] (auto & callbacks)
-                        {
-                            auto cbit = callbacks.begin();
-                            const auto eit = callbacks.end();
-                            while (cbit != eit)
-                            {
-                                const auto & cb_data = *cbit;
-                                if((cb_data.inst_id == inst_id))
-                                {
-                                    cbit = callbacks.erase(cbit);
-                                } else {
-                                    ++cbit;
-                                }
-                            }
-                        };
-        clear_fn(ready_callbacks_);
+        for(PoolIndex widx = 0; widx < waiters_.size(); ++widx)
+        {
+            if(waiters_[widx].active && (waiters_[widx].inst_id == inst_id)) {
+                releaseWaiter_(widx);
+            }
+        }
     }
 
 
@@ -361,7 +471,13 @@ namespace sparta
 
     void ScoreboardView::clearBits_(const Scoreboard::RegisterBitMask & bits)
     {
+        const auto newly_cleared = bits & local_ready_mask_;
         local_ready_mask_ &= ~bits;
+        forEachRegister(newly_cleared, [this](uint32_t reg) {
+            for(PoolIndex lidx = register_waiters_[reg]; lidx != INVALID_INDEX; lidx = links_[lidx].next) {
+                ++waiters_[links_[lidx].waiter].num_not_ready;
+            }
+        });
     }
 
     std::string printBitSet(const Scoreboard::RegisterBitMask & bits)
@@ -40,6 +40,7 @@
 #include "sparta/parsers/YAMLTreeEventHandler.hpp"
 #include "src/State.tpp"
 #include "sparta/kernel/MemoryProfiler.hpp"
+#include "sparta/kernel/StartupProfiler.hpp"
 #include "sparta/statistics/dispatch/streams/StatisticsStreams.hpp"
 #include "sparta/app/FeatureConfiguration.hpp"
 #include "sparta/kernel/PhasedObject.hpp"
@@ -638,6 +639,7 @@ void Simulation::buildTree()
     // Subclass callback
     {
         PHASE_PROFILER(memory_profiler_, MemoryProfiler::Phase::Build);
+        StartupProfiler::PhaseScope startup_phase(startup_profiler_.get(), StartupProfiler::Phase::Build);
         buildTree_();
     }
 
@@ -663,6 +665,8 @@ void Simulation::configureTree()
     }
 #endif
 
+    StartupProfiler::PhaseScope startup_phase(startup_profiler_.get(), StartupProfiler::Phase::Configure);
+
     root_.enterConfiguring(); // No more adding ResourceTreeNodes
 
     // Subclass callback
@@ -677,12 +681,19 @@ void Simulation::finalizeTree()
     std::cout << "Finalizing tree..." << std::endl;
     sparta_assert(root_clk_ != nullptr, "Root clock was not set up in this simulator");
 
+    if(sim_config_){
+        root_.setNumFinalizeThreads(sim_config_->finalize_threads);
+    }
+
     // No more ResourceTreeNodes can be created during this.
+    {
+        StartupProfiler::PhaseScope startup_phase(startup_profiler_.get(), StartupProfiler::Phase::Finalize);
 #ifdef SPARTA_PYTHON_SUPPORT
-    root_.enterFinalized(pyshell_.get());
+        root_.enterFinalized(pyshell_.get());
 #else
-    root_.enterFinalized();
+        root_.enterFinalized();
 #endif
+    }
 
     // No more TreeNodes added to tree from now on
 
@@ -701,17 +712,21 @@ void Simulation::finalizeTree()
         }
     }
 
-    // Bind nodes within resources
-    root_.bindTreeEarly();
-
-    // Subclass callback
     {
-        PHASE_PROFILER(memory_profiler_, MemoryProfiler::Phase::Bind);
-        bindTree_();
-    }
+        StartupProfiler::PhaseScope startup_phase(startup_profiler_.get(), StartupProfiler::Phase::Bind);
+
+        // Bind nodes within resources
+        root_.bindTreeEarly();
 
-    // Bind nodes within resources
-    root_.bindTreeLate();
+        // Subclass callback
+        {
+            PHASE_PROFILER(memory_profiler_, MemoryProfiler::Phase::Bind);
+            bindTree_();
+        }
+
+        // Bind nodes within resources
+        root_.bindTreeLate();
+    }
 
     if(sim_config_)
     {
@@ -727,6 +742,11 @@ void Simulation::finalizeTree()
 
     // Check ports and such
     root_.validatePreRun();
+
+    if (startup_profiler_) {
+        startup_profiler_->deactivate();
+        startup_profiler_->saveReport(sim_config_->startup_profile_file, &root_);
+    }
 }
 
 void Simulation::finalizeFramework()
@@ -909,6 +929,10 @@ void Simulation::run(uint64_t run_time)
             std::cout << "Running Complete\n";
             // Show simulator performance
             printSchedulerPerformanceInfo(std::cout, timer, scheduler_);
+            if(sim_config_ && (sim_config_->auto_summary_state ==
+                               SimulationConfiguration::AutoSummaryState::AUTO_SUMMARY_VERBOSE)) {
+                std::cout << "  Root Clock Cycles Elapsed: " << root_clk_->currentCycle() << std::endl;
+            }
         }else{
             std::cerr << SPARTA_CMDLINE_COLOR_ERROR "Exception while running" SPARTA_CMDLINE_COLOR_NORMAL
                       << std::endl;
@@ -1658,6 +1682,11 @@ void Simulation::setupProfilers_()
         return;
     }
 
+    if (!sim_config_->startup_profile_file.empty()) {
+        startup_profiler_.reset(new StartupProfiler);
+        startup_profiler_->activate();
+    }
+
     auto & def_file = sim_config_->getMemoryUsageDefFile();
     if (def_file.empty()) {
         return;
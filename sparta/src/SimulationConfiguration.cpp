@@ -11,6 +11,7 @@
 #include <cstddef>
 #include <iostream>
 
+#include "sparta/app/ConfigImage.hpp"
 #include "sparta/utils/File.hpp"
 #include "sparta/utils/SpartaException.hpp"
 
@@ -65,6 +66,60 @@ namespace app {
         std::cout << "  [in] Arch Config: " << arch_applicator_->stringize() << std::endl;
     }
 
+    //! Save the unbound arch and configuration trees to a ConfigImage
+    void SimulationConfiguration::saveConfigImage(const std::string & filename,
+                                                  uint64_t key) const
+    {
+        ConfigImage image(key);
+        if(arch_applicator_) {
+            for(const auto & file : arch_applicator_->getConsumedFiles()) {
+                image.addDependency(file);
+            }
+            image.setAttribute("arch_config", arch_applicator_->stringize());
+        }
+        for(const auto & cp : config_applicators_) {
+            for(const auto & file : cp->getConsumedFiles()) {
+                image.addDependency(file);
+            }
+        }
+        for(const auto & md : run_metadata_) {
+            if(md.first == "arch") {
+                image.setAttribute("arch", md.second);
+            }
+        }
+        image.setAttribute("final_config_file", final_config_file_);
+        image.addTree(arch_ptree_);
+        image.addTree(ptree_);
+        image.save(filename);
+    }
+
+    //! Load the unbound arch and configuration trees from a ConfigImage
+    bool SimulationConfiguration::loadConfigImage(const std::string & filename,
+                                                  uint64_t key)
+    {
+        sparta_assert(!is_consumed_, "You cannot load a config image after simulation has been populated");
+        sparta_assert(arch_applicator_ == nullptr, "Cannot load a config image after an arch file was processed");
+        std::unique_ptr<ConfigImage> image = ConfigImage::load(filename, key);
+        if(image == nullptr || image->getNumTrees() != 2 || !image->isUpToDate()) {
+            return false;
+        }
+
+        image->restoreTree(0, arch_ptree_);
+        image->restoreTree(1, ptree_);
+        const std::string arch = image->getAttribute("arch");
+        if(!arch.empty()) {
+            addRunMetadata("arch", arch);
+        }
+        final_config_file_ = image->getAttribute("final_config_file");
+        config_image_file_ = filename;
+        if(!image->getAttribute("arch_config").empty()) {
+            std::cout << "  [in] Arch Config: " << image->getAttribute("arch_config") << std::endl;
+        }
+        std::cout << "  [in] Config image: \"" << filename << "\" (" << image->getDependencies().size()
+                  << " files)" << std::endl;
+        return true;
+    }
+
     //! Enable logging on a specific node, for a specific category,
     //! and redirect output to the given destination
     void SimulationConfiguration::enableLogging(const std::string & pattern,
@@ -0,0 +1,363 @@
+// <StartupProfiler.cpp> -*- C++ -*-
+
+#include "sparta/kernel/StartupProfiler.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "sparta/simulation/TreeNode.hpp"
+#include "sparta/simulation/TreeNodePrivateAttorney.hpp"
+#include "sparta/utils/SpartaAssert.hpp"
+#include "sparta/utils/SpartaException.hpp"
+
+#if defined(SPARTA_TCMALLOC_SUPPORT)
+#include <gperftools/malloc_extension.h>
+#define SPARTA_STARTUP_PROFILER_ALLOCS 1
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define SPARTA_STARTUP_PROFILER_ALLOCS 1
+#else
+#define SPARTA_STARTUP_PROFILER_ALLOCS 0
+#endif
+
+namespace sparta {
+
+namespace {
+
+    //! Subtrees below this fraction of the total cost are left out of text reports
+    constexpr double REPORT_THRESHOLD = 0.001;
+
+    int64_t currentAllocatedBytes()
+    {
+#if defined(SPARTA_TCMALLOC_SUPPORT)
+        static const char CURRENT_ALLOC[] = "generic.current_allocated_bytes";
+        size_t allocated_bytes = 0;
+        MallocExtension::instance()->GetNumericProperty(CURRENT_ALLOC, &allocated_bytes);
+        return static_cast<int64_t>(allocated_bytes);
+#elif SPARTA_STARTUP_PROFILER_ALLOCS
+        // Small allocations plus those mmapped separately
+        const struct mallinfo2 info = mallinfo2();
+        return static_cast<int64_t>(info.uordblks + info.hblkhd);
+#else
+        return 0;
+#endif
+    }
+
+    double toSeconds(const std::chrono::nanoseconds & t) {
+        return std::chrono::duration<double>(t).count();
+    }
+
+    constexpr size_t NUM_PHASES = static_cast<size_t>(StartupProfiler::Phase::NUM_PHASES);
+
+    StartupProfiler::Cost sumPhases(const StartupProfiler::PhaseCosts & costs)
+    {
+        StartupProfiler::Cost total;
+        for (const auto & cost : costs) {
+            total += cost;
+        }
+        return total;
+    }
+
+    void writeJSONCost(std::ostream & os, const StartupProfiler::Cost & cost)
+    {
+        os << "{\"time_s\": " << toSeconds(cost.time)
+           << ", \"alloc_bytes\": " << cost.alloc_bytes << "}";
+    }
+
+    void writeJSONPhaseCosts(std::ostream & os, const StartupProfiler::PhaseCosts & costs)
+    {
+        os << "{";
+        for (size_t i = 0; i < NUM_PHASES; ++i) {
+            os << (i ? ", " : "") << "\""
+               << StartupProfiler::getPhaseName(static_cast<StartupProfiler::Phase>(i)) << "\": ";
+            writeJSONCost(os, costs[i]);
+        }
+        os << "}";
+    }
+}
+
+StartupProfiler * StartupProfiler::active_ = nullptr;
+
+struct StartupProfiler::SubtreeCosts
+{
+    const TreeNode * node = nullptr;
+    PhaseCosts self;
+    PhaseCosts total;
+    Cost total_all; //!< Sum of total over all phases. Used for sorting
+    std::vector<SubtreeCosts> children;
+};
+
+const char * StartupProfiler::getPhaseName(Phase phase)
+{
+    switch (phase) {
+        case Phase::Build:
+            return "build";
+        case Phase::Configure:
+            return "configure";
+        case Phase::Finalize:
+            return "finalize";
+        case Phase::Bind:
+            return "bind";
+        default:
+            sparta_assert(false, "Invalid StartupProfiler phase " << static_cast<int>(phase));
+    }
+    return "";
+}
+
+StartupProfiler::~StartupProfiler()
+{
+    deactivate();
+}
+
+void StartupProfiler::activate()
+{
+    if (active_ == this) {
+        return;
+    }
+    if (active_ != nullptr) {
+        throw SpartaException("Cannot activate a StartupProfiler while another one is active");
+    }
+    active_ = this;
+}
+
+void StartupProfiler::deactivate()
+{
+    if (active_ == this) {
+        active_ = nullptr;
+    }
+}
+
+bool StartupProfiler::measuresAllocations()
+{
+    return SPARTA_STARTUP_PROFILER_ALLOCS != 0;
+}
+
+void StartupProfiler::enteringPhase(Phase phase)
+{
+    sparta_assert(phase != Phase::NUM_PHASES);
+    if (current_phase_ != Phase::NUM_PHASES) {
+        throw SpartaException("Cannot enter startup phase '") << getPhaseName(phase)
+            << "' before exiting phase '" << getPhaseName(current_phase_) << "'";
+    }
+    current_phase_ = phase;
+    phase_start_bytes_ = currentAllocatedBytes();
+    phase_start_ = std::chrono::steady_clock::now();
+}
+
+void StartupProfiler::exitingPhase(Phase phase)
+{
+    if (current_phase_ != phase) {
+        return;
+    }
+    Cost & cost = phase_costs_[static_cast<size_t>(phase)];
+    cost.time += std::chrono::steady_clock::now() - phase_start_;
+    cost.alloc_bytes += currentAllocatedBytes() - phase_start_bytes_;
+    current_phase_ = Phase::NUM_PHASES;
+
+    // Scopes left open by an exception are discarded
+    open_scopes_.clear();
+}
+
+void StartupProfiler::openScope_(const TreeNode * node)
+{
+    if (current_phase_ == Phase::NUM_PHASES) {
+        return;
+    }
+    open_scopes_.push_back({node, {}, currentAllocatedBytes(), {}});
+    open_scopes_.back().start = std::chrono::steady_clock::now();
+}
+
+void StartupProfiler::closeScope_()
+{
+    if (open_scopes_.empty()) {
+        return; // Opened outside of a phase
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    const OpenScope & scope = open_scopes_.back();
+    Cost inclusive;
+    inclusive.time = end - scope.start;
+    inclusive.alloc_bytes = currentAllocatedBytes() - scope.start_bytes;
+
+    Cost & self = node_costs_[scope.node][static_cast<size_t>(current_phase_)];
+    self.time += inclusive.time - scope.nested.time;
+    self.alloc_bytes += inclusive.alloc_bytes - scope.nested.alloc_bytes;
+
+    open_scopes_.pop_back();
+    if (!open_scopes_.empty()) {
+        open_scopes_.back().nested += inclusive;
+    }
+}
+
+const StartupProfiler::PhaseCosts * StartupProfiler::getNodeCosts(const TreeNode * node) const
+{
+    auto itr = node_costs_.find(node);
+    if (itr == node_costs_.end()) {
+        return nullptr;
+    }
+    return &itr->second;
+}
+
+void StartupProfiler::computeSubtree_(const TreeNode * node, SubtreeCosts & costs) const
+{
+    costs.node = node;
+    if (const PhaseCosts * self = getNodeCosts(node)) {
+        costs.self = *self;
+    }
+    costs.total = costs.self;
+
+    for (const TreeNode * child : TreeNodePrivateAttorney::getAllChildren(node)) {
+        SubtreeCosts child_costs;
+        computeSubtree_(child, child_costs);
+        if (child_costs.total_all.time.count() == 0 && child_costs.total_all.alloc_bytes == 0) {
+            continue;
+        }
+        for (size_t i = 0; i < NUM_PHASES; ++i) {
+            costs.total[i] += child_costs.total[i];
+        }
+        costs.children.emplace_back(std::move(child_costs));
+    }
+    costs.total_all = sumPhases(costs.total);
+
+    // Most expensive first. Stable so that ties keep tree order
+    std::stable_sort(costs.children.begin(), costs.children.end(),
+                     [](const SubtreeCosts & a, const SubtreeCosts & b) {
+                         return a.total_all.time > b.total_all.time;
+                     });
+}
+
+void StartupProfiler::writeReport(std::ostream & os, const TreeNode * root) const
+{
+    SubtreeCosts root_costs;
+    computeSubtree_(root, root_costs);
+
+    /*
+     * Reports are formatted as follows (times in seconds, allocations are
+     * the net growth of heap bytes):
+     *
+     *   Phase            Time       Alloc   Unattr. time  Unattr. alloc
+     *   build        1.234567    12345678       0.012345           1234
+     *   ...
+     *
+     *   Subtree          Time       Alloc         build  ...  Node
+     *               1.234567    12345678      0.123456  ...  top
+     *               0.934567     9345678      0.093456  ...    cpu
+     */
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << std::fixed << std::setprecision(6);
+
+    os << "# Startup profile (time in seconds, alloc in net allocated bytes"
+       << (measuresAllocations() ? "" : ", not measured on this platform") << ")\n";
+    os << std::left << std::setw(12) << "# Phase" << std::right
+       << std::setw(14) << "Time" << std::setw(16) << "Alloc"
+       << std::setw(16) << "Unattr. time" << std::setw(16) << "Unattr. alloc" << "\n";
+    for (size_t i = 0; i < NUM_PHASES; ++i) {
+        const Cost & phase = phase_costs_[i];
+        const Cost & attributed = root_costs.total[i];
+        os << "  " << std::left << std::setw(10) << getPhaseName(static_cast<Phase>(i)) << std::right
+           << std::setw(14) << toSeconds(phase.time) << std::setw(16) << phase.alloc_bytes
+           << std::setw(16) << toSeconds(phase.time - attributed.time)
+           << std::setw(16) << (phase.alloc_bytes - attributed.alloc_bytes) << "\n";
+    }
+    const Cost total = sumPhases(phase_costs_);
+    os << "  " << std::left << std::setw(10) << "total" << std::right
+       << std::setw(14) << toSeconds(total.time) << std::setw(16) << total.alloc_bytes << "\n\n";
+
+    os << std::left << std::setw(12) << "# Subtree" << std::right
+       << std::setw(14) << "Time" << std::setw(16) << "Alloc";
+    for (size_t i = 0; i < NUM_PHASES; ++i) {
+        os << std::setw(14) << getPhaseName(static_cast<Phase>(i));
+    }
+    os << "  Node\n";
+
+    const double min_time = toSeconds(root_costs.total_all.time) * REPORT_THRESHOLD;
+    const double min_bytes = std::abs(root_costs.total_all.alloc_bytes) * REPORT_THRESHOLD;
+    auto write_subtree = [&](const SubtreeCosts & costs, uint32_t depth, auto & write_ref) -> void {
+        os << std::setw(26) << toSeconds(costs.total_all.time)
+           << std::setw(16) << costs.total_all.alloc_bytes;
+        for (size_t i = 0; i < NUM_PHASES; ++i) {
+            os << std::setw(14) << toSeconds(costs.total[i].time);
+        }
+        os << "  " << std::string(depth * 2, ' ')
+           << (depth == 0 ? costs.node->getLocation() : costs.node->getName()) << "\n";
+
+        uint32_t num_omitted = 0;
+        for (const SubtreeCosts & child : costs.children) {
+            if (toSeconds(child.total_all.time) < min_time
+                && std::abs(child.total_all.alloc_bytes) < min_bytes)
+            {
+                ++num_omitted;
+                continue;
+            }
+            write_ref(child, depth + 1, write_ref);
+        }
+        if (num_omitted > 0) {
+            os << std::setw(26 + 16 + 14 * NUM_PHASES) << "" << "  "
+               << std::string((depth + 1) * 2, ' ') << "(" << num_omitted << " smaller subtrees)\n";
+        }
+    };
+    write_subtree(root_costs, 0, write_subtree);
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void StartupProfiler::writeJSON(std::ostream & os, const TreeNode * root) const
+{
+    SubtreeCosts root_costs;
+    computeSubtree_(root, root_costs);
+
+    os << "{\n  \"allocs_measured\": " << (measuresAllocations() ? "true" : "false")
+       << ",\n  \"phases\": ";
+    writeJSONPhaseCosts(os, phase_costs_);
+    os << ",\n  \"tree\": ";
+
+    auto write_subtree = [&](const SubtreeCosts & costs, uint32_t depth, auto & write_ref) -> void {
+        const std::string indent((depth + 1) * 2, ' ');
+        os << "{\n" << indent << "  \"name\": \"" << costs.node->getName() << "\",\n"
+           << indent << "  \"location\": \"" << costs.node->getLocation() << "\",\n"
+           << indent << "  \"total\": ";
+        writeJSONCost(os, costs.total_all);
+        os << ",\n" << indent << "  \"subtree\": ";
+        writeJSONPhaseCosts(os, costs.total);
+        os << ",\n" << indent << "  \"self\": ";
+        writeJSONPhaseCosts(os, costs.self);
+        os << ",\n" << indent << "  \"children\": [";
+        for (size_t i = 0; i < costs.children.size(); ++i) {
+            os << (i ? ", " : "");
+            write_ref(costs.children[i], depth + 1, write_ref);
+        }
+        os << "]\n" << indent << "}";
+    };
+    write_subtree(root_costs, 0, write_subtree);
+    os << "\n}\n";
+}
+
+void StartupProfiler::saveReport(const std::string & filename, const TreeNode * root) const
+{
+    if (filename == "1") {
+        writeReport(std::cout, root);
+        return;
+    }
+
+    std::ofstream fout(filename);
+    if (!fout) {
+        throw SpartaException("Unable to open output file for writing: '") << filename << "'";
+    }
+
+    const std::string json_ext = ".json";
+    if (filename.size() >= json_ext.size()
+        && filename.compare(filename.size() - json_ext.size(), json_ext.size(), json_ext) == 0)
+    {
+        writeJSON(fout, root);
+    } else {
+        writeReport(fout, root);
+    }
+    std::cout << "  [profile] Wrote startup profile to \"" << filename << "\"" << std::endl;
+}
+
+}
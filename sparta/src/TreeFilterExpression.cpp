@@ -219,7 +219,6 @@ namespace filter {
             std::cout << "]";
         }
 
-        std::regex expr(tag_); // Create the expression regardles of comparison type
         std::smatch what;
 
         // Look at each tag
@@ -236,7 +235,7 @@ namespace filter {
                 }
                 break;
             case TAGCOMP_REM:
-                if(std::regex_match(*tag, what, expr)) { // , boost::match_extra)){
+                if(std::regex_match(*tag, what, *regex_)) { // , boost::match_extra)){
                     // Print out matches
                     // Skip 0 because it is the whole expression.  match_extra might cause this
                     // These replacements will probably be concatenated together.
@@ -273,7 +272,6 @@ namespace filter {
             std::cout << "name of " << n->getLocation() << " is \"" << n->getName() << "\"";
         }
 
-        std::regex expr(name_); // Create the expression regardles of comparison type
         std::smatch what;
 
         // Look at name
@@ -283,7 +281,7 @@ namespace filter {
         case NAMECOMP_NE:
             return n->getName() != name_;
         case NAMECOMP_REM:
-            if(std::regex_match(n->getName(), what, expr)) { // , boost::match_extra)){
+            if(std::regex_match(n->getName(), what, *regex_)) { // , boost::match_extra)){
                 // Print out matches
                 // Skip 0 because it is the whole expression.  match_extra might cause this
                 // These replacements will probably be concatenated together.
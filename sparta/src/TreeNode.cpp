@@ -28,6 +28,7 @@
 #include "sparta/simulation/Resource.hpp"
 #include "sparta/utils/Colors.hpp"
 #include "sparta/kernel/Scheduler.hpp"
+#include "sparta/kernel/StartupProfiler.hpp"
 #include "sparta/simulation/ParameterSet.hpp"
 #include "sparta/simulation/ParameterTree.hpp"
 #include "sparta/app/Simulation.hpp"
@@ -53,16 +54,19 @@ const std::map<const TreeNode*, TreeNode::WeakPtr>& TreeNode::getParentlessNodes
     return statics_->parentless_map_;
 }
 
-const std::map<const TreeNode*, TreeNode::WeakPtr>& TreeNode::getAllNodes()
+std::map<const TreeNode*, TreeNode::WeakPtr> TreeNode::getAllNodes()
 {
-    return statics_->node_map_;
+    // node_map_ is hashed for node construction and destruction. Callers
+    // see the nodes in pointer order
+    return std::map<const TreeNode*, WeakPtr>(statics_->node_map_.begin(), statics_->node_map_.end());
 }
 
 std::string TreeNode::formatAllNodes()
 {
+    const auto all_nodes = getAllNodes();
     std::stringstream ss;
-    ss << statics_->node_map_.size() << " TreeNodes known:" << std::endl;
-    for(auto& n : statics_->node_map_){
+    ss << all_nodes.size() << " TreeNodes known:" << std::endl;
+    for(auto& n : all_nodes){
         if(n.second.expired() == true){
             ss << "expired!" << std::endl;
         }else{
@@ -170,6 +174,7 @@ TreeNode::TreeNode(TreeNode&& rhp) :
     self_ptr_(this, [](TreeNode*){}), // no deleter
     children_(), // Do not inherit
     names_(), // Do not inherit
+    names_index_(), // Do not inherit
     obs_local_(), // Do not inherit
     is_expired_(false)
 {
@@ -899,21 +904,15 @@ uint32_t TreeNode::findChildren_(const std::string& pattern,
     }
     else
     {
-        // Using regex here to find children because full regex pattern
-        // should probably be supported eventually. Having some regex
-        // code here already should encourage that.
-
-        std::string patexp = createSearchRegexPattern(sub_pattern);
-
-        //std::cout << "Local search pattern is \"" << patexp << "\" from " << getLocation()
-        //          << " extracted from pattern \"" << pattern << "\"" << std::endl;
-        std::regex expr(patexp);
+        // Compiled patterns are cached, so searching many times with the
+        // same pattern (e.g. from configuration files) compiles it once
+        const std::shared_ptr<const utils::GlobPattern> expr = utils::GlobPattern::get(sub_pattern);
 
         // Get the immediate children of this node matching the first part of
         // the pattern
         std::vector<TreeNode*> immediate_children;
         std::vector<std::vector<std::string>> immediate_replacements;
-        findImmediateChildren_(expr, immediate_children, immediate_replacements,
+        findImmediateChildren_(*expr, immediate_children, immediate_replacements,
                                allow_private);
 
         // This is logic for tracking all wildcard replacements while
@@ -959,13 +958,20 @@ uint32_t TreeNode::findChildren_(const std::string& pattern,
     return findChildren_(pattern, results, replacements, allow_private);
 }
 
-uint32_t TreeNode::findImmediateChildren_(std::regex& expr,
+uint32_t TreeNode::findImmediateChildren_(const utils::GlobPattern& expr,
                                           std::vector<TreeNode*>& found,
                                           std::vector<std::vector<std::string>>& replacements,
                                           bool allow_private) {
     uint32_t num_found = 0;
-    for(ChildNameMapping::reference chp : names_)
+
+    // Without wildcards, only identifiers equal to the pattern can match
+    auto range = std::make_pair(names_.begin(), names_.end());
+    if(!expr.hasWildcards()){
+        range = names_.equal_range(expr.getPattern());
+    }
+    for(auto itr = range.first; itr != range.second; ++itr)
     {
+        ChildNameMapping::reference chp = *itr;
         std::vector<std::string> replaced; // Replacements per name
         if(identityMatchesPattern_(chp.first, expr, replaced)){
             TreeNode* child = chp.second;
@@ -988,7 +994,7 @@ uint32_t TreeNode::findImmediateChildren_(std::regex& expr,
     return num_found;
 }
 
-uint32_t TreeNode::findImmediateChildren_(std::regex& expr,
+uint32_t TreeNode::findImmediateChildren_(const utils::GlobPattern& expr,
                                           std::vector<TreeNode*>& found,
                                           bool allow_private) {
     std::vector<std::vector<std::string>> replacements;
@@ -996,12 +1002,19 @@ uint32_t TreeNode::findImmediateChildren_(std::regex& expr,
 }
 
 // Const variant of findImmediateChildren_
-uint32_t TreeNode::findImmediateChildren_(std::regex& expr,
+uint32_t TreeNode::findImmediateChildren_(const utils::GlobPattern& expr,
                                           std::vector<const TreeNode*>& found,
                                           std::vector<std::vector<std::string>>& replacements,
                                           bool allow_private) const {
     uint32_t num_found = 0;
-    for(ChildNameMapping::const_reference chp : names_){
+
+    // Without wildcards, only identifiers equal to the pattern can match
+    auto range = std::make_pair(names_.cbegin(), names_.cend());
+    if(!expr.hasWildcards()){
+        range = names_.equal_range(expr.getPattern());
+    }
+    for(auto itr = range.first; itr != range.second; ++itr){
+        ChildNameMapping::const_reference chp = *itr;
 
         std::vector<std::string> replaced; // Replacements per name
         if(identityMatchesPattern_(chp.first, expr, replaced)){
@@ -1021,7 +1034,7 @@ uint32_t TreeNode::findImmediateChildren_(std::regex& expr,
     return num_found;
 }
 
-uint32_t TreeNode::findImmediateChildren_(std::regex& expr,
+uint32_t TreeNode::findImmediateChildren_(const utils::GlobPattern& expr,
                                           std::vector<const TreeNode*>& found,
                                           bool allow_private) const {
     std::vector<std::vector<std::string>> replacements;
@@ -1064,15 +1077,13 @@ bool TreeNode::locationMatchesPattern(const std::string& pattern,
             // This is the reason why this function cannot be called
             // with any upwards traversal
         }
-        std::string pat_expr = createSearchRegexPattern(pat_tok);
-        std::regex expr(pat_expr);
+        const std::shared_ptr<const utils::GlobPattern> expr = utils::GlobPattern::get(pat_tok);
 
         auto idents = node->getIdentifiers();
         bool matched = false;
         for(const std::string* ident : idents){
-            std::cmatch what;
             // Test against this ident
-            if(std::regex_match(ident->c_str(), what, expr)){
+            if(expr->match(*ident)){
 
                 // If parent is null, check that it might be the start
                 // node because if the startnode is a GlobalTreeNode
@@ -1231,9 +1242,7 @@ std::pair<uint32_t, std::string> TreeNode::recursGetDeepestMatchingPath_(const s
         deepest += getParent()->recursGetDeepestMatchingPath_(path, out_path_pos).second;
     }else{
         std::vector<const TreeNode*> children;
-        std::string patexp = createSearchRegexPattern(immediate_child_name);
-        std::regex expr(patexp);
-        findImmediateChildren_(expr, children);
+        findImmediateChildren_(*utils::GlobPattern::get(immediate_child_name), children);
         uint32_t max_depth = 0;
         if(children.size() == 0){
             return {0, ""}; // No children found
@@ -1526,10 +1535,7 @@ std::string TreeNode::getNextName(const std::string& name, size_t& pos) {
 }
 
 bool TreeNode::matchesGlobLike(const std::string& pattern, const std::string& other) {
-    std::string patexpr = createSearchRegexPattern(pattern);
-    std::regex expr(patexpr);
-    std::smatch what;
-    return std::regex_match(other, what, expr); // , boost::match_extra);
+    return utils::GlobPattern::get(pattern)->match(other);
 }
 
 TreeNode::node_uid_type TreeNode::getNextNodeUID_() {
@@ -1741,20 +1747,30 @@ void TreeNode::addChild_(TreeNode* child, bool inherit_phase) {
         ++levels;
     }
 
-    // Check for repeat objects and duplicates within the group.
-    for(TreeNode* tn : children_){
-        // Ensure no duplicate node instances (name collisions should be caught before this)
-        if(tn == child){
+    // Group+index identifier of the child (if it has a group)
+    const std::string group_ident = child->getGroup().size() > 0
+        ? child->getGroup() + std::to_string(child->getGroupIdx())
+        : std::string();
+
+    // Ensure no duplicate node instances (name collisions should be caught
+    // before this). A child already present is mapped by its name, or by
+    // its group+index if anonymous
+    const auto present = names_index_.equal_range(child->getName().size() > 0 ? child->getName()
+                                                                                : group_ident);
+    for(auto itr = present.first; itr != present.second; ++itr){
+        if(itr->second == child){
             throw SpartaException("Child instance \"")
-                << tn->getName() << " @" << (void*)tn
+                << child->getName() << " @" << (void*)child
                 << " is already present under TreeNode \"" << getName() << "\"";
         }
+    }
 
-        // Ensure no group index collisions
-        if(tn->getGroup() == child->getGroup()){
-            if(tn->getGroupIdx() != GROUP_IDX_NONE \
-               && tn->getGroupIdx() == child->getGroupIdx() \
-               && child->isIndexableByGroup() \
+    // Ensure no group index collisions. Grouped children are mapped by
+    // group+index, so only those candidates need to be checked
+    if(child->getGroupIdx() != GROUP_IDX_NONE && child->isIndexableByGroup()){
+        auto check_group_collision = [&](const TreeNode* tn) {
+            if(tn->getGroup() == child->getGroup()
+               && tn->getGroupIdx() == child->getGroupIdx()
                && tn->isIndexableByGroup()){
                 throw SpartaException("Cannot add child named \"")
                     << child->getName() << "\" because a child named \""
@@ -1762,6 +1778,17 @@ void TreeNode::addChild_(TreeNode* child, bool inherit_phase) {
                     << tn->getGroup() << "\" and group index " << tn->getGroupIdx()
                     << " is already present under TreeNode \"" << *name_ << "\"";
             }
+        };
+        if(group_ident.size() > 0){
+            const auto candidates = names_index_.equal_range(group_ident);
+            for(auto itr = candidates.first; itr != candidates.second; ++itr){
+                check_group_collision(itr->second);
+            }
+        }else{
+            // Indexed children without a group have no group mapping
+            for(const TreeNode* tn : children_){
+                check_group_collision(tn);
+            }
         }
     }
 
@@ -1798,8 +1825,8 @@ void TreeNode::addChild_(TreeNode* child, bool inherit_phase) {
             addChildNameMapping_(*ident, child);
         }
 
-        if(child->getGroup().size() > 0){ // Group may be empty string
-            addChildNameMapping_(child->getGroup() + std::to_string(child->getGroupIdx()), child);
+        if(group_ident.size() > 0){ // Group may be empty string
+            addChildNameMapping_(group_ident, child);
         }
 
         // Connect child to parent.
@@ -1985,15 +2012,18 @@ TreeNode::getImmediateChildByIdentity_(const std::string& name,
     // What's in a name?  The name could be an alias or the actual
     // TreeNode.  Look for the actual TreeNode name first, then return
     // the next alias.
-    const auto it = names_.equal_range(name);
+    TreeNode* const child = findChildNameMapping_(name);
+    if(child != nullptr){
+        return child;
+    }
+
+    if(false == must_exist){
+        return nullptr;
+    }
 
     // No match
-    if(it.first == it.second)
+    if(names_.find(name) == names_.end())
     {
-        if(false == must_exist){
-            return nullptr;
-        }
-
         std::vector<std::string> idents;
         getChildrenIdentifiers(idents, false);
         std::stringstream ss;
@@ -2004,21 +2034,6 @@ TreeNode::getImmediateChildByIdentity_(const std::string& name,
             << name << "\" in node \"" << getLocation() << "\". Valid names are:\n"
             << ss.str();
     }
-    else
-    {
-        for(auto item = it.first; item != it.second; ++item)
-        {
-            if(item->first == name) {
-                if(nullptr != item->second) {
-                    return item->second;
-                }
-            }
-        }
-    }
-
-    if(false == must_exist){
-        return nullptr;
-    }
 
     throw SpartaException("name \"")
         << name << "\" resolved to a group (not a child) in node \""
@@ -2034,15 +2049,18 @@ TreeNode::getImmediateChildByIdentity_(const std::string& name,
     // What's in a name?  The name could be an alias or the actual
     // TreeNode.  Look for the actual TreeNode name first, then return
     // the next alias.
-    const auto it = names_.equal_range(name);
+    TreeNode* const child = findChildNameMapping_(name);
+    if(child != nullptr){
+        return child;
+    }
+
+    if(false == must_exist){
+        return nullptr;
+    }
 
     // No match
-    if(it.first == it.second)
+    if(names_.find(name) == names_.end())
     {
-        if(false == must_exist){
-            return nullptr;
-        }
-
         std::vector<std::string> idents;
         getChildrenIdentifiers(idents, false);
         std::stringstream ss;
@@ -2053,21 +2071,6 @@ TreeNode::getImmediateChildByIdentity_(const std::string& name,
             << name << "\" in node \"" << getLocation() << "\". Valid names are:\n"
             << ss.str();
     }
-    else
-    {
-        for(auto item = it.first; item != it.second; ++item)
-        {
-            if(item->first == name) {
-                if(nullptr != item->second) {
-                    return item->second;
-                }
-            }
-        }
-    }
-
-    if(false == must_exist){
-        return nullptr;
-    }
 
     throw SpartaException("name \"")
         << name << "\" resolved to a group (not a child) in node \""
@@ -2091,31 +2094,17 @@ void TreeNode::ensureNoParent_(const char* action) {
 // Miscellaneous
 
 bool TreeNode::identityMatchesPattern_(const std::string& ident,
-                                       std::regex& expr,
+                                       const utils::GlobPattern& expr,
                                        std::vector<std::string>& replacements) {
-    std::smatch what;
-    // Test against this name (could be alias, group, etc.)
-    if(std::regex_match(ident, what, expr)) { // , boost::match_extra)){
-        // Print out matches
-        //for(unsigned i = 0; i < what.size(); ++i){
-        //    std::cout << "      $" << i << " = \"" << what[i] << "\"\n";
-        //}
-
-        // Captures - Equivalent of perl regex $i.
-        // Skip 0 because it is the whole expression and these replacements will
-        // probably be concatenated together
-        for(unsigned i = 1; i < what.size(); ++i){
-            replacements.push_back(what[i].str());
-        }
-        return true;
-    }
-    return false;
+    // Test against this name (could be alias, group, etc.). Captures are the
+    // text matched by each wildcard (equivalent of perl regex $i) and will
+    // probably be concatenated together
+    return expr.match(ident, replacements);
 }
 
 bool TreeNode::identityMatchesPattern_(const std::string& ident,
-                                       std::regex& expr) {
-    std::vector<std::string> replacements;
-    return identityMatchesPattern_(ident, expr, replacements);
+                                       const utils::GlobPattern& expr) {
+    return expr.match(ident);
 }
 
 std::string TreeNode::getPreviousName_(const std::string& name,
@@ -2169,17 +2158,21 @@ void TreeNode::finalizeTree_() {
     // Cache working clock since no clocks can be added
     working_clock_ = getClock();
 
-    createResource_();
-
-    // Tree node extensions parameter validation should occur here.
-    // We do this here since parameter validation also occurs for
-    // resources in createResource_() above.
-    for (const auto& kvp : extensions_) {
-        if (const auto* params = kvp.second->getParameters()) {
-            std::string errs;
-            if (!params->validateDependencies(this, errs)) {
-                throw SpartaException("Parameter validation callbacks indicated invalid parameters: ")
-                    << errs;
+    {
+        StartupProfiler::NodeScope profile(this);
+
+        createResource_();
+
+        // Tree node extensions parameter validation should occur here.
+        // We do this here since parameter validation also occurs for
+        // resources in createResource_() above.
+        for (const auto& kvp : extensions_) {
+            if (const auto* params = kvp.second->getParameters()) {
+                std::string errs;
+                if (!params->validateDependencies(this, errs)) {
+                    throw SpartaException("Parameter validation callbacks indicated invalid parameters: ")
+                        << errs;
+                }
             }
         }
     }
@@ -2217,7 +2210,10 @@ void TreeNode::enterFinalized_() {
 void TreeNode::enterConfig_() noexcept {
     setPhase_(TREE_CONFIGURING);
 
-    onConfiguring_();
+    {
+        StartupProfiler::NodeScope profile(this);
+        onConfiguring_();
+    }
 
     for(TreeNode* child : children_){
         child->enterConfig_();
@@ -2227,11 +2223,15 @@ void TreeNode::enterConfig_() noexcept {
 void TreeNode::bindTreeEarly_() {
     sparta_assert(getPhase() == TREE_FINALIZED);
 
-    onBindTreeEarly_();
+    {
+        StartupProfiler::NodeScope profile(this);
 
-    Resource* const res = getResource_();
-    if(res){
-        res->onBindTreeEarly_();
+        onBindTreeEarly_();
+
+        Resource* const res = getResource_();
+        if(res){
+            res->onBindTreeEarly_();
+        }
     }
 
     for(TreeNode* child : children_){
@@ -2242,11 +2242,15 @@ void TreeNode::bindTreeEarly_() {
 void TreeNode::bindTreeLate_() {
     sparta_assert(getPhase() == TREE_FINALIZED);
 
-    onBindTreeLate_();
+    {
+        StartupProfiler::NodeScope profile(this);
 
-    Resource* const res = getResource_();
-    if(res){
-        res->onBindTreeLate_();
+        onBindTreeLate_();
+
+        Resource* const res = getResource_();
+        if(res){
+            res->onBindTreeLate_();
+        }
     }
 
     for(TreeNode* child : children_){
@@ -2368,8 +2372,8 @@ void TreeNode::enterTeardown_() noexcept {
 
 void TreeNode::verifyUniqueChildIdentifier_(const std::string& ident,
                                             bool is_group) {
-    ChildNameMapping::const_iterator it = names_.find(ident);
-    if(it != names_.end()){
+    ChildNameIndex::const_iterator it = names_index_.find(ident);
+    if(it != names_index_.end()){
         if(it->second != nullptr){ // Error if anything overwrites name or alias
             SpartaException ex("The ");
             if(is_group){
@@ -2394,16 +2398,18 @@ void TreeNode::removeChildForTeardown_(TreeNode* child) {
     onDestroyingChild_(this);
 
     auto erase_child = [this, child] (ChildrenVector& list, bool ignore_missing) {
-                           // Remove child from children_ list
-                           auto itr = std::find(list.begin(),
-                                                list.end(),
+                           // Remove child from children_ list. Search from
+                           // the back since children are usually destroyed
+                           // in reverse order of construction
+                           auto itr = std::find(list.rbegin(),
+                                                list.rend(),
                                                 child);
-                           if(itr == list.end() && !ignore_missing){
+                           if(itr == list.rend() && !ignore_missing){
                                throw SpartaException("Cannot removeChildForTeardown_ with child node ")
                                    << child->getLocation() << " because it is not a child of parent: " << getLocation()
                                    << " whose children include: " << list;
-                           }else if (itr != list.end()){
-                               list.erase(itr);
+                           }else if (itr != list.rend()){
+                               list.erase(std::next(itr).base());
                            }
                        };
 
@@ -2412,7 +2418,21 @@ void TreeNode::removeChildForTeardown_(TreeNode* child) {
     // Remove child from child identifier mapping
     for(const std::string* ident : child->getIdentifiers()){
         sparta_assert(ident != nullptr);
-        names_.erase(*ident); // Does not fail if key not found
+        removeChildNameMapping_(*ident); // Does not fail if key not found
+    }
+
+    // Remove the group+index mapping of this child (other children may
+    // share the identifier)
+    if(child->getGroup().size() > 0){
+        const std::string group_ident = child->getGroup() + std::to_string(child->getGroupIdx());
+        const auto indexed = names_index_.equal_range(group_ident);
+        for(auto itr = indexed.first; itr != indexed.second;){
+            itr = (itr->second == child) ? names_index_.erase(itr) : std::next(itr);
+        }
+        const auto mapped = names_.equal_range(group_ident);
+        for(auto itr = mapped.first; itr != mapped.second;){
+            itr = (itr->second == child) ? names_.erase(itr) : std::next(itr);
+        }
     }
 }
 
@@ -2980,7 +3000,39 @@ void TreeNode::addChildNameMapping_(const std::string& name,
                   "Name of child identifier cannot be empty string. Parent is "
                   << getLocation());
 
-    names_.emplace(name, child);
+    const auto itr = names_.emplace(name, child);
+    if(child != nullptr){
+        // View the key owned by names_ so the index holds no string copies
+        names_index_.emplace(std::string_view(itr->first), child);
+    }
+}
+
+void TreeNode::removeChildNameMapping_(const std::string& name) {
+    // Index entries view keys owned by names_, so drop them first
+    names_index_.erase(name);
+    names_.erase(name);
+}
+
+TreeNode* TreeNode::findChildNameMapping_(const std::string& name) const {
+    const auto range = names_index_.equal_range(name);
+    if(range.first == range.second){
+        return nullptr;
+    }
+    TreeNode* const found = range.first->second;
+    for(auto itr = std::next(range.first); itr != range.second; ++itr){
+        if(itr->second != found){
+            // Distinct children share this identifier (e.g. a child named
+            // like another child's group+index). Resolve deterministically
+            // using the ordered mapping, which keeps insertion order
+            const auto ordered = names_.equal_range(name);
+            for(auto ord = ordered.first; ord != ordered.second; ++ord){
+                if(ord->second != nullptr){
+                    return ord->second;
+                }
+            }
+        }
+    }
+    return found;
 }
 
 } // namespace sparta
@@ -1,8 +1,8 @@
 // <Vertex> -*- C++ -*-
 
 
+#include <algorithm>
 #include <cstdint>
-#include <map>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -25,15 +25,13 @@ namespace sparta
     {
         if(dest == this) return false;
 
-        if (outbound_edge_map_.find(dest) != outbound_edge_map_.end()) {
+        if (efact.hasEdge(this, dest)) {
             // Edge already present -- not necessary to add it again
             return false;
-        } else {
-            const Edge* new_edge = efact.newFactoryEdge(this, dest, label);
-            outbound_edge_map_[dest] = new_edge;
-            outbound_edge_list_.push_back(dest);
-            ++(dest->num_inbound_edges_);
         }
+        outbound_edges_.emplace_back(efact.newFactoryEdge(this, dest, label));
+        outbound_vertices_.emplace_back(dest);
+        ++(dest->num_inbound_edges_);
         return true;
     }
 
@@ -41,23 +39,17 @@ namespace sparta
     {
         if(w == this) return false;
 
-        auto ei = outbound_edge_map_.find(w);
-        if (ei == outbound_edge_map_.end()) {
+        auto vi = std::find(outbound_vertices_.begin(), outbound_vertices_.end(), w);
+        if (vi == outbound_vertices_.end()) {
             // Edge not present -- just ignore
             return false;
-        } else {
-            for (auto el = outbound_edge_list_.begin(); el != outbound_edge_list_.end(); ) {
-                if (*el == ei->first) {
-                    el = outbound_edge_list_.erase(el);
-                } else {
-                    ++el;
-                }
-            }
-            efact.removeEdge(ei->second);
-            outbound_edge_map_.erase(ei);
-            sparta_assert(w->num_inbound_edges_ > 0);
-            --(w->num_inbound_edges_);
         }
+        auto ei = outbound_edges_.begin() + (vi - outbound_vertices_.begin());
+        efact.removeEdge(*ei);
+        outbound_edges_.erase(ei);
+        outbound_vertices_.erase(vi);
+        sparta_assert(w->num_inbound_edges_ > 0);
+        --(w->num_inbound_edges_);
         return true;
     }
 
@@ -75,7 +67,7 @@ namespace sparta
         marker_ = CycleMarker::GRAY;
 
         // Loop through this vertex's outbound edges...
-        for (auto& w_out : outbound_edge_list_) {
+        for (auto& w_out : outbound_vertices_) {
             // Vertex *w = ei.first;
 
             switch (w_out->marker_) {
@@ -128,7 +120,7 @@ namespace sparta
         marker_ = CycleMarker::GRAY;
 
         // Loop through this vertex's outbound edges...
-        for (auto& w_out : outbound_edge_list_) {
+        for (auto& w_out : outbound_vertices_) {
             //Vertex *w = ei.first;
 
             switch (w_out->marker_) {
@@ -159,8 +151,8 @@ namespace sparta
     void Vertex::precedes(Scheduleable & s, const std::string & label) {
         sparta_assert(my_scheduler_);
         DAG * dag = my_scheduler_->getDAG();
-        sparta_assert(dag->isFinalized() == false,
-                    "You cannot set precedence during a running simulation (i.e., the DAG is finalized)");
+        sparta_assert(dag->isFinalized() == false || my_scheduler_->isRunning() == false,
+                    "You cannot set precedence during a running simulation");
         dag->link(this, s.getVertex(), label);
     }
 
@@ -187,7 +179,7 @@ namespace sparta
     {
         std::ios_base::fmtflags os_state(os.flags());
         os << std::string(*this) << std::endl;
-        for (const auto & w_out : outbound_edge_list_) {
+        for (const auto & w_out : outbound_vertices_) {
             os << "\t-> " << std::string(*(w_out)) << std::endl;
         }
         os << std::endl;
@@ -198,7 +190,7 @@ namespace sparta
     {
         std::ios_base::fmtflags os_state(os.flags());
         os << std::string(*this) << std::endl;
-        for (const auto & w_out : outbound_edge_list_) {
+        for (const auto & w_out : outbound_vertices_) {
             if (w_out->marker_ == matchingMarker) {
                 os << "\t-> " << std::string(*(w_out)) << std::endl;
             }
@@ -1,6 +1,9 @@
 
 #include <inttypes.h>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
 
 #include "sparta/sparta.hpp"
 #include "sparta/simulation/Clock.hpp"
@@ -104,12 +107,94 @@ static void test_frequency_clocks()
 
 }
 
+// Check the reciprocal tick->cycle conversion against plain division
+static void expect_conversions(const Clock & clk, const std::vector<Scheduler::Tick> & ticks)
+{
+    const Scheduler::Tick period = clk.getPeriod();
+    for (const Scheduler::Tick t : ticks) {
+        EXPECT_EQUAL(clk.getCycle(t), t / period);
+        const Clock::Cycle c = t / period;
+        EXPECT_EQUAL(clk.getTick(c), c * period);
+    }
+}
+
+static void test_randomized_conversions()
+{
+    std::mt19937_64 rng(0x5EED);
+    std::uniform_int_distribution<uint32_t> ratio_dist(1, 12);
+    std::uniform_int_distribution<Scheduler::Tick> tick_dist;
+
+    // Random ratio trees, including the cached current cycle
+    for (uint32_t trial = 0; trial < 50; ++trial) {
+        sparta::Scheduler sched;
+        sparta::ClockManager m(&sched);
+        Clock::Handle c_root = m.makeRoot();
+        std::vector<Clock::Handle> clks = {c_root};
+        for (uint32_t i = 0; i < 4; ++i) {
+            clks.emplace_back(m.makeClock("C" + std::to_string(i), clks[ratio_dist(rng) % clks.size()],
+                                          ratio_dist(rng), ratio_dist(rng)));
+        }
+        m.normalize();
+        sched.finalize();
+
+        std::vector<Scheduler::Tick> ticks;
+        for (uint32_t i = 0; i < 200; ++i) {
+            ticks.emplace_back(i);
+            ticks.emplace_back(tick_dist(rng) >> (i % 64));
+        }
+        for (const auto & clk : clks) {
+            expect_conversions(*clk, ticks);
+        }
+
+        // Move time forwards and backwards
+        for (uint32_t i = 0; i < 20; ++i) {
+            const Scheduler::Tick t = tick_dist(rng) >> 24;
+            sched.restartAt(t);
+            sched.run(ratio_dist(rng), true, false);
+            for (const auto & clk : clks) {
+                const Scheduler::Tick now = sched.getCurrentTick();
+                EXPECT_EQUAL(clk->currentCycle(), now / clk->getPeriod());
+                EXPECT_EQUAL(clk->currentCycle(), now / clk->getPeriod());
+                EXPECT_EQUAL(clk->isPosedge(), (now % clk->getPeriod()) == 0);
+            }
+        }
+    }
+
+    // Extreme periods and ticks
+    sparta::Scheduler sched;
+    const std::vector<Scheduler::Tick> edge_ticks = {
+        0, 1, 2, 3, 0xFFFFFFFFull, 0x100000000ull, 0x100000001ull,
+        std::numeric_limits<Scheduler::Tick>::max() - 1,
+        std::numeric_limits<Scheduler::Tick>::max()
+    };
+    std::vector<uint32_t> periods = {1, 2, 3, 7, 1000, 1024, 3000, 65535, 65536,
+                                     0x7FFFFFFF, 0x80000000, 0xFFFFFFFE, 0xFFFFFFFF};
+    for (uint32_t i = 0; i < 100; ++i) {
+        periods.emplace_back(static_cast<uint32_t>(tick_dist(rng) >> (32 + (i % 32))) | 1);
+    }
+    for (const uint32_t period : periods) {
+        Clock clk("edge_clk", &sched);
+        clk.setPeriod(period);
+        EXPECT_EQUAL(clk.getPeriod(), period);
+        std::vector<Scheduler::Tick> ticks = edge_ticks;
+        for (uint32_t i = 0; i < 100; ++i) {
+            const Scheduler::Tick t = tick_dist(rng);
+            ticks.emplace_back(t);
+            ticks.emplace_back((t / period) * period);
+            ticks.emplace_back((t / period) * period - 1);
+        }
+        expect_conversions(clk, ticks);
+    }
+}
+
 int main()
 {
     test_ratioed_clocks();
 
     test_frequency_clocks();
 
+    test_randomized_conversions();
+
     REPORT_ERROR;
 
     return ERROR_CODE;
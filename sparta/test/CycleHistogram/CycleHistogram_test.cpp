@@ -10,6 +10,9 @@
 
 #include <string>
 #include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
 
 #include "sparta/kernel/Scheduler.hpp"
 #include "sparta/sparta.hpp"
@@ -135,18 +138,18 @@ void binsOneThroughThree()
     EXPECT_EQUAL(cycle_histogram_tn.getNumBins(), 3);
     EXPECT_EQUAL(cycle_histogram_sa.getNumBins(), 4);
 
-    sparta::CycleCounter *tn_1  = nullptr, *tn_2  = nullptr, *tn_3  = nullptr;
-    sparta::CycleCounter *tn_uf = nullptr, *tn_of = nullptr, *tn_tt = nullptr;
-    sparta::CycleCounter *sa_6  = nullptr, *sa_7  = nullptr;
-    sparta::Counter      *tn_mx = nullptr;
-
-    EXPECT_NOTHROW(tn_uf = rtn.getChildAs<sparta::CycleCounter>("cycle_histogram_tn.stats.UF"));
-    EXPECT_NOTHROW(tn_1  = rtn.getChildAs<sparta::CycleCounter>("cycle_histogram_tn.stats.cycle_count1"));
-    EXPECT_NOTHROW(tn_2  = rtn.getChildAs<sparta::CycleCounter>("cycle_histogram_tn.stats.cycle_count2"));
-    EXPECT_NOTHROW(tn_3  = rtn.getChildAs<sparta::CycleCounter>("cycle_histogram_tn.stats.cycle_count3"));
-    EXPECT_NOTHROW(tn_of = rtn.getChildAs<sparta::CycleCounter>("cycle_histogram_tn.stats.OF"));
-    EXPECT_NOTHROW(tn_tt = rtn.getChildAs<sparta::CycleCounter>("cycle_histogram_tn.stats.total"));
-    EXPECT_NOTHROW(tn_mx = rtn.getChildAs<sparta::Counter>("cycle_histogram_tn.stats.max_value"));
+    sparta::CounterBase *tn_1  = nullptr, *tn_2  = nullptr, *tn_3  = nullptr;
+    sparta::CounterBase *tn_uf = nullptr, *tn_of = nullptr, *tn_tt = nullptr;
+    sparta::CounterBase *sa_6  = nullptr, *sa_7  = nullptr;
+    sparta::CounterBase *tn_mx = nullptr;
+
+    EXPECT_NOTHROW(tn_uf = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.UF"));
+    EXPECT_NOTHROW(tn_1  = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.cycle_count1"));
+    EXPECT_NOTHROW(tn_2  = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.cycle_count2"));
+    EXPECT_NOTHROW(tn_3  = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.cycle_count3"));
+    EXPECT_NOTHROW(tn_of = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.OF"));
+    EXPECT_NOTHROW(tn_tt = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.total"));
+    EXPECT_NOTHROW(tn_mx = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.max_value"));
     EXPECT_TRUE(tn_uf);
     EXPECT_TRUE(tn_1);
     EXPECT_TRUE(tn_2);
@@ -155,8 +158,8 @@ void binsOneThroughThree()
     EXPECT_TRUE(tn_tt);
     EXPECT_TRUE(tn_mx);
 
-    EXPECT_NOTHROW(sa_6  = sset.getCounterAs<sparta::CycleCounter>("cycle_histogram_sa_bin_5_6"));
-    EXPECT_NOTHROW(sa_7  = sset.getCounterAs<sparta::CycleCounter>("cycle_histogram_sa_count7"));
+    EXPECT_NOTHROW(sa_6  = sset.getCounterAs<sparta::CounterBase>("cycle_histogram_sa_bin_5_6"));
+    EXPECT_NOTHROW(sa_7  = sset.getCounterAs<sparta::CounterBase>("cycle_histogram_sa_count7"));
     EXPECT_NOTEQUAL(sa_6,  nullptr);
     EXPECT_NOTEQUAL(sa_7,  nullptr);
 
@@ -236,7 +239,7 @@ void binsOneThroughThree()
     EXPECT_EQUAL(getMeanBinCount(histogram_vector), cycle_histogram_tn.getMeanBinCount());
     const auto& bin_vector = cycle_histogram_tn.getRegularBin();
     std::for_each(bin_vector.begin(), bin_vector.end(),
-        [&histogram_vector](const sparta::CycleCounter& c){
+        [&histogram_vector](const uint64_t c){
         static std::size_t i {0};
         EXPECT_EQUAL(static_cast<double>(c), histogram_vector[i++]);
     });
@@ -247,7 +250,7 @@ void binsOneThroughThree()
     EXPECT_EQUAL(cycle_histogram_tn.getOverflowProbability(), static_cast<double>(2)/total_vals);
     const auto& bin_prob_vector = cycle_histogram_tn.recomputeRegularBinProbabilities();
     std::for_each(bin_vector.begin(), bin_vector.end(),
-        [&bin_prob_vector, &total_vals](const sparta::CycleCounter& c){
+        [&bin_prob_vector, &total_vals](const uint64_t c){
         static std::size_t i {0};
         EXPECT_EQUAL(bin_prob_vector[i++], static_cast<double>(c)/total_vals);
     });
@@ -308,20 +311,20 @@ void binsZeroThroughThree()
     EXPECT_EQUAL(cycle_histogram_tn.getNumBins(), 4);
     EXPECT_EQUAL(cycle_histogram_sa.getNumBins(), 4);
 
-    sparta::CycleCounter *tn_0  = nullptr;
-    sparta::CycleCounter *tn_1  = nullptr, *tn_2  = nullptr, *tn_3  = nullptr;
-    sparta::CycleCounter *tn_uf = nullptr, *tn_of = nullptr, *tn_tt = nullptr;
-    sparta::CycleCounter *sa_6  = nullptr, *sa_7  = nullptr;
-    sparta::Counter      *tn_mx = nullptr;
-
-    EXPECT_NOTHROW(tn_uf = rtn.getChildAs<sparta::CycleCounter>("cycle_histogram_tn.stats.UF"));
-    EXPECT_NOTHROW(tn_0  = rtn.getChildAs<sparta::CycleCounter>("cycle_histogram_tn.stats.cycle_count0"));
-    EXPECT_NOTHROW(tn_1  = rtn.getChildAs<sparta::CycleCounter>("cycle_histogram_tn.stats.cycle_count1"));
-    EXPECT_NOTHROW(tn_2  = rtn.getChildAs<sparta::CycleCounter>("cycle_histogram_tn.stats.cycle_count2"));
-    EXPECT_NOTHROW(tn_3  = rtn.getChildAs<sparta::CycleCounter>("cycle_histogram_tn.stats.cycle_count3"));
-    EXPECT_NOTHROW(tn_of = rtn.getChildAs<sparta::CycleCounter>("cycle_histogram_tn.stats.OF"));
-    EXPECT_NOTHROW(tn_tt = rtn.getChildAs<sparta::CycleCounter>("cycle_histogram_tn.stats.total"));
-    EXPECT_NOTHROW(tn_mx = rtn.getChildAs<sparta::Counter>("cycle_histogram_tn.stats.max_value"));
+    sparta::CounterBase *tn_0  = nullptr;
+    sparta::CounterBase *tn_1  = nullptr, *tn_2  = nullptr, *tn_3  = nullptr;
+    sparta::CounterBase *tn_uf = nullptr, *tn_of = nullptr, *tn_tt = nullptr;
+    sparta::CounterBase *sa_6  = nullptr, *sa_7  = nullptr;
+    sparta::CounterBase *tn_mx = nullptr;
+
+    EXPECT_NOTHROW(tn_uf = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.UF"));
+    EXPECT_NOTHROW(tn_0  = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.cycle_count0"));
+    EXPECT_NOTHROW(tn_1  = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.cycle_count1"));
+    EXPECT_NOTHROW(tn_2  = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.cycle_count2"));
+    EXPECT_NOTHROW(tn_3  = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.cycle_count3"));
+    EXPECT_NOTHROW(tn_of = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.OF"));
+    EXPECT_NOTHROW(tn_tt = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.total"));
+    EXPECT_NOTHROW(tn_mx = rtn.getChildAs<sparta::CounterBase>("cycle_histogram_tn.stats.max_value"));
     EXPECT_TRUE(tn_uf);
     EXPECT_TRUE(tn_0);
     EXPECT_TRUE(tn_1);
@@ -331,8 +334,8 @@ void binsZeroThroughThree()
     EXPECT_TRUE(tn_tt);
     EXPECT_TRUE(tn_mx);
 
-    EXPECT_NOTHROW(sa_6  = sset.getCounterAs<sparta::CycleCounter>("cycle_histogram_sa_bin_5_6"));
-    EXPECT_NOTHROW(sa_7  = sset.getCounterAs<sparta::CycleCounter>("cycle_histogram_sa_count7"));
+    EXPECT_NOTHROW(sa_6  = sset.getCounterAs<sparta::CounterBase>("cycle_histogram_sa_bin_5_6"));
+    EXPECT_NOTHROW(sa_7  = sset.getCounterAs<sparta::CounterBase>("cycle_histogram_sa_count7"));
     EXPECT_NOTEQUAL(sa_6,  nullptr);
     EXPECT_NOTEQUAL(sa_7,  nullptr);
 
@@ -420,7 +423,7 @@ void binsZeroThroughThree()
     EXPECT_EQUAL(getMeanBinCount(histogram_vector), cycle_histogram_tn.getMeanBinCount());
     const auto& bin_vector = cycle_histogram_tn.getRegularBin();
     std::for_each(bin_vector.begin(), bin_vector.end(),
-        [&histogram_vector](const sparta::CycleCounter& c){
+        [&histogram_vector](const uint64_t c){
         static std::size_t i {0};
         EXPECT_EQUAL(static_cast<double>(c), histogram_vector[i++]);
     });
@@ -431,7 +434,7 @@ void binsZeroThroughThree()
     EXPECT_EQUAL(cycle_histogram_tn.getOverflowProbability(), static_cast<double>(2)/total_vals);
     const auto& bin_prob_vector = cycle_histogram_tn.recomputeRegularBinProbabilities();
     std::for_each(bin_vector.begin(), bin_vector.end(),
-        [&bin_prob_vector, &total_vals](const sparta::CycleCounter& c){
+        [&bin_prob_vector, &total_vals](const uint64_t c){
         static std::size_t i {0};
         EXPECT_EQUAL(bin_prob_vector[i++], static_cast<double>(c)/total_vals);
     });
@@ -440,10 +443,214 @@ void binsZeroThroughThree()
     rtn.enterTeardown();
 }
 
+// CycleCounter, with the current cycle passed in
+struct ReferenceCycleCounter
+{
+    uint64_t count = 0;
+    uint64_t start = 0;
+    bool counting = false;
+
+    uint64_t get(uint64_t now) const {
+        return (counting && (now > start)) ? count + (now - start) : count;
+    }
+};
+
+// CycleHistogram as it was with one CycleCounter per bin.  addValue and
+// setValue return false where a CycleCounter would have asserted, and
+// leave the bins as they were.
+class ReferenceCycleHistogram
+{
+public:
+    ReferenceCycleHistogram(uint64_t lower_val, uint64_t upper_val,
+                            uint64_t num_vals_per_bin, uint64_t idle_value) :
+        lower_val_(lower_val),
+        upper_val_(upper_val),
+        idx_shift_amount_(sparta::utils::floor_log2(num_vals_per_bin)),
+        idle_value_(idle_value),
+        bins_((upper_val - lower_val) / num_vals_per_bin + 3)
+    {
+        startCounting_(idle_value_, 0);
+    }
+
+    bool addValue(uint64_t val, uint64_t now)
+    {
+        if (!canStopCounting_(last_value_, now)) {
+            return false;
+        }
+        stopCounting_(last_value_, now);
+        startCounting_(val, now);
+        stopCounting_(val, now + 1);
+        startCounting_(idle_value_, now + 1);
+        return true;
+    }
+
+    bool setValue(uint64_t val, uint64_t now)
+    {
+        if (last_value_ != val) {
+            if (!canStopCounting_(last_value_, now)) {
+                return false;
+            }
+            stopCounting_(last_value_, now);
+            startCounting_(val, now);
+        }
+        return true;
+    }
+
+    //! Underflow bin, regular bins and overflow bin at cycle now
+    std::vector<uint64_t> getBins(uint64_t now) const
+    {
+        std::vector<uint64_t> counts;
+        for (const auto & bin : bins_) {
+            counts.push_back(bin.get(now));
+        }
+        return counts;
+    }
+
+private:
+    ReferenceCycleCounter & bin_(uint64_t val)
+    {
+        if (val < lower_val_) {
+            return bins_.front();
+        }
+        if (val > upper_val_) {
+            return bins_.back();
+        }
+        return bins_.at(((val - lower_val_) >> idx_shift_amount_) + 1);
+    }
+
+    bool canStopCounting_(uint64_t val, uint64_t stop)
+    {
+        const ReferenceCycleCounter & bin = bin_(val);
+        return bin.counting && (stop >= bin.start);
+    }
+
+    void startCounting_(uint64_t val, uint64_t start)
+    {
+        ReferenceCycleCounter & bin = bin_(val);
+        sparta_assert(bin.counting == false);
+        bin.start = start;
+        bin.counting = true;
+        last_value_ = val;
+    }
+
+    void stopCounting_(uint64_t val, uint64_t stop)
+    {
+        ReferenceCycleCounter & bin = bin_(val);
+        bin.count += stop - bin.start;
+        bin.counting = false;
+    }
+
+    const uint64_t lower_val_;
+    const uint64_t upper_val_;
+    const uint64_t idx_shift_amount_;
+    const uint64_t idle_value_;
+    uint64_t last_value_ = 0;
+    std::vector<ReferenceCycleCounter> bins_;
+};
+
+// Drive histograms with random mixes of addValue and setValue, sometimes
+// several in the same cycle, and check every bin against one CycleCounter
+// per bin, both before and after each update (while a bin is open)
+void randomAgainstCycleCounters()
+{
+    PRINT_ENTER_TEST
+
+    sparta::Scheduler scheduler("test");
+    sparta::Clock clk("clock", &scheduler);
+    sparta::RootTreeNode rtn("root");
+    rtn.setClock(&clk);
+
+    sparta::ResourceFactory<DummyDevice, DummyDevice::ParameterSet> rfact;
+    sparta::ResourceTreeNode dummy(&rtn, "dummy", "dummy node", &rfact);
+    sparta::StatisticSet sset(&dummy);
+
+    constexpr uint32_t NUM_HISTOGRAMS = 16;
+    constexpr uint32_t NUM_STEPS = 500;
+    std::mt19937_64 rng(0x5eed);
+
+    std::vector<std::unique_ptr<sparta::CycleHistogramStandalone>> histograms;
+    std::vector<std::unique_ptr<ReferenceCycleHistogram>> references;
+    std::vector<uint64_t> value_limits;
+    for (uint32_t i = 0; i < NUM_HISTOGRAMS; ++i) {
+        const uint64_t num_vals_per_bin = uint64_t(1) << (rng() % 3);
+        const uint64_t lower_val = rng() % 5;
+        const uint64_t upper_val = lower_val + 1 + rng() % 12;
+        const uint64_t idle_value = rng() % (upper_val + 3);
+        histograms.emplace_back(new sparta::CycleHistogramStandalone(
+            &sset, &clk, "random_" + std::to_string(i) + "_hist", "Randomly driven histogram",
+            lower_val, upper_val, num_vals_per_bin, idle_value));
+        references.emplace_back(new ReferenceCycleHistogram(
+            lower_val, upper_val, num_vals_per_bin, idle_value));
+        // Reach the underflow and overflow bins
+        value_limits.push_back(upper_val + 4);
+    }
+
+    rtn.enterConfiguring();
+    rtn.enterFinalized();
+    scheduler.finalize();
+
+    auto check_bins = [&](uint32_t i) {
+        std::vector<uint64_t> bins = histograms[i]->getRegularBin();
+        bins.insert(bins.begin(), histograms[i]->getUnderflowBin());
+        bins.push_back(histograms[i]->getOverflowBin());
+        EXPECT_TRUE(bins == references[i]->getBins(clk.elapsedCycles()));
+    };
+
+    for (uint32_t step = 0; step < NUM_STEPS; ++step) {
+        // 0 keeps the next updates in the same cycle as the last ones
+        const uint64_t advance = rng() % 3;
+        if (advance > 0) {
+            scheduler.run(advance, true, false);
+        }
+
+        for (uint32_t i = 0; i < NUM_HISTOGRAMS; ++i) {
+            check_bins(i);
+
+            const uint64_t val = rng() % value_limits[i];
+            const uint64_t now = clk.elapsedCycles();
+            switch (rng() % 3) {
+            case 0:
+                if (references[i]->addValue(val, now)) {
+                    EXPECT_NOTHROW(histograms[i]->addValue(val));
+                }
+                else {
+                    EXPECT_THROW(histograms[i]->addValue(val));
+                }
+                break;
+            case 1:
+                if (references[i]->setValue(val, now)) {
+                    EXPECT_NOTHROW(histograms[i]->setValue(val));
+                }
+                else {
+                    EXPECT_THROW(histograms[i]->setValue(val));
+                }
+                break;
+            default:
+                break;
+            }
+
+            check_bins(i);
+        }
+    }
+
+    // A second addValue in the same cycle is rejected by both
+    scheduler.run(1, true, false);
+    EXPECT_TRUE(references[0]->addValue(0, clk.elapsedCycles()));
+    EXPECT_NOTHROW(histograms[0]->addValue(0));
+    EXPECT_FALSE(references[0]->addValue(0, clk.elapsedCycles()));
+    EXPECT_THROW(histograms[0]->addValue(0));
+    check_bins(0);
+    scheduler.run(1, true, false);
+    check_bins(0);
+
+    rtn.enterTeardown();
+}
+
 int main()
 {
     binsOneThroughThree();
     binsZeroThroughThree();
+    randomAgainstCycleCounters();
 
     ENSURE_ALL_REACHED(0);
     REPORT_ERROR;
@@ -2,6 +2,8 @@
 #include <inttypes.h>
 #include <iostream>
 #include <fstream>
+#include <string>
+#include <vector>
 
 #include "sparta/sparta.hpp"
 #include "sparta/kernel/DAG.hpp"
@@ -371,6 +373,81 @@ int main()
         delete chain_outp[p];
     }
 
+    // Links made after finalization update the group IDs in place
+    {
+        sparta::Scheduler inc_sched;
+        sparta::RootTreeNode inc_rtn;
+        sparta::Clock inc_clk("inc_clock", &inc_sched);
+        inc_rtn.setClock(&inc_clk);
+        sparta::EventSet inc_es(&inc_rtn);
+        Observer inc_obs("IncrementalListener");
+
+        Event<> ev_early(&inc_es, "ev_early", CREATE_SPARTA_HANDLER_WITH_OBJ(Observer, &inc_obs, activate));
+        inc_sched.finalize();
+        DAG * inc_dag = inc_sched.getDAG();
+        EXPECT_TRUE(inc_dag->isFinalized());
+
+        // Events created after the DAG is finalized are placed in
+        // their phase like those created before it
+        Event<> ev_a(&inc_es, "ev_a", CREATE_SPARTA_HANDLER_WITH_OBJ(Observer, &inc_obs, activate));
+        Event<> ev_b(&inc_es, "ev_b", CREATE_SPARTA_HANDLER_WITH_OBJ(Observer, &inc_obs, activate));
+        EXPECT_EQUAL(ev_a.getGroupID(), ev_early.getGroupID());
+        EXPECT_EQUAL(ev_b.getGroupID(), ev_early.getGroupID());
+
+        inc_rtn.enterConfiguring();
+        inc_rtn.enterFinalized();
+
+        // Scheduled before the DAG grows; must still fire afterwards
+        ev_early.schedule(5);
+
+        // A chain longer than the DAG grows the group count
+        const uint32_t groups_before = inc_dag->numGroups();
+        const uint32_t chain_len = groups_before + 4;
+        std::vector<Vertex *> chain;
+        for (uint32_t i = 0; i < chain_len; ++i) {
+            chain.emplace_back(inc_dag->newFactoryVertex("inc_chain_" + std::to_string(i), &inc_sched));
+        }
+        ev_b.precedes(*chain[0]);
+        for (uint32_t i = 1; i < chain_len; ++i) {
+            inc_dag->link(chain[i - 1], chain[i]);
+        }
+        for (uint32_t i = 0; i < chain_len; ++i) {
+            EXPECT_EQUAL(chain[i]->getGroupID(), ev_b.getGroupID() + i + 1);
+        }
+        EXPECT_EQUAL(inc_dag->numGroups(), chain[chain_len - 1]->getGroupID() + 1);
+        EXPECT_TRUE(inc_dag->numGroups() > groups_before);
+
+        // Putting ev_a before ev_b only moves ev_b and what follows it
+        ev_a >> ev_b;
+        EXPECT_EQUAL(ev_b.getGroupID(), ev_a.getGroupID() + 1);
+        EXPECT_EQUAL(chain[0]->getGroupID(), ev_b.getGroupID() + 1);
+        EXPECT_EQUAL(chain[chain_len - 1]->getGroupID(), ev_b.getGroupID() + chain_len);
+        EXPECT_EQUAL(ev_early.getGroupID(), ev_a.getGroupID());
+
+        // A link closing a cycle is rejected and leaves the DAG as it was
+        const uint32_t last_gid   = chain[chain_len - 1]->getGroupID();
+        const uint32_t num_groups = inc_dag->numGroups();
+        bool inc_did_throw = false;
+        try {
+            inc_dag->link(chain[chain_len - 1], chain[0]);
+        } catch (DAG::CycleException &) {
+            inc_did_throw = true;
+        }
+        EXPECT_TRUE(inc_did_throw);
+        EXPECT_EQUAL(chain[chain_len - 1]->getGroupID(), last_gid);
+        EXPECT_EQUAL(chain[0]->getGroupID(), ev_b.getGroupID() + 1);
+        EXPECT_EQUAL(inc_dag->numGroups(), num_groups);
+        EXPECT_TRUE(chain[chain_len - 1]->getEdgeTo(chain[0]) == nullptr);
+
+        // Events in the grown groups fire alongside the earlier one
+        ev_b.schedule(5);
+        ev_a.schedule(5);
+        inc_sched.run(10, true, false);
+        EXPECT_EQUAL(inc_obs.getActivations(), 3);
+
+        inc_rtn.enterTeardown();
+    }
+
     REPORT_ERROR;
 
     return ERROR_CODE;
@@ -181,20 +181,20 @@ void testOpStateHistogram(){
     EXPECT_EQUAL(op_state_histogram_tn.getNumBins(), 4);
     EXPECT_EQUAL(op_state_histogram_tn.getNumValuesPerBin(), 1);
 
-    sparta::CycleCounter *tn_0  = nullptr, *tn_1  = nullptr, *tn_2  = nullptr, *tn_3 = nullptr;
-    sparta::CycleCounter *tn_uf = nullptr, *tn_of = nullptr, *tn_tt = nullptr;
-    sparta::Counter      *tn_mx = nullptr;
+    sparta::CounterBase *tn_0  = nullptr, *tn_1  = nullptr, *tn_2  = nullptr, *tn_3 = nullptr;
+    sparta::CounterBase *tn_uf = nullptr, *tn_of = nullptr, *tn_tt = nullptr;
+    sparta::CounterBase *tn_mx = nullptr;
 
     // This enum class has no overloaded << operator for name decoration.
     // Hence, statistic definition names will be generated using the default behaviour.
-    EXPECT_NOTHROW(tn_uf = rtn.getChildAs<sparta::CycleCounter>("op_state_histogram_tn.stats.UF"));
-    EXPECT_NOTHROW(tn_0  = rtn.getChildAs<sparta::CycleCounter>("op_state_histogram_tn.stats.cycle_count0"));
-    EXPECT_NOTHROW(tn_1  = rtn.getChildAs<sparta::CycleCounter>("op_state_histogram_tn.stats.cycle_count1"));
-    EXPECT_NOTHROW(tn_2  = rtn.getChildAs<sparta::CycleCounter>("op_state_histogram_tn.stats.cycle_count2"));
-    EXPECT_NOTHROW(tn_3  = rtn.getChildAs<sparta::CycleCounter>("op_state_histogram_tn.stats.cycle_count3"));
-    EXPECT_NOTHROW(tn_of = rtn.getChildAs<sparta::CycleCounter>("op_state_histogram_tn.stats.OF"));
-    EXPECT_NOTHROW(tn_tt = rtn.getChildAs<sparta::CycleCounter>("op_state_histogram_tn.stats.total"));
-    EXPECT_NOTHROW(tn_mx = rtn.getChildAs<sparta::Counter>("op_state_histogram_tn.stats.max_value"));
+    EXPECT_NOTHROW(tn_uf = rtn.getChildAs<sparta::CounterBase>("op_state_histogram_tn.stats.UF"));
+    EXPECT_NOTHROW(tn_0  = rtn.getChildAs<sparta::CounterBase>("op_state_histogram_tn.stats.cycle_count0"));
+    EXPECT_NOTHROW(tn_1  = rtn.getChildAs<sparta::CounterBase>("op_state_histogram_tn.stats.cycle_count1"));
+    EXPECT_NOTHROW(tn_2  = rtn.getChildAs<sparta::CounterBase>("op_state_histogram_tn.stats.cycle_count2"));
+    EXPECT_NOTHROW(tn_3  = rtn.getChildAs<sparta::CounterBase>("op_state_histogram_tn.stats.cycle_count3"));
+    EXPECT_NOTHROW(tn_of = rtn.getChildAs<sparta::CounterBase>("op_state_histogram_tn.stats.OF"));
+    EXPECT_NOTHROW(tn_tt = rtn.getChildAs<sparta::CounterBase>("op_state_histogram_tn.stats.total"));
+    EXPECT_NOTHROW(tn_mx = rtn.getChildAs<sparta::CounterBase>("op_state_histogram_tn.stats.max_value"));
     EXPECT_TRUE(tn_uf);
     EXPECT_TRUE(tn_0);
     EXPECT_TRUE(tn_1);
@@ -372,27 +372,27 @@ void testUopStateHistogram(){
     EXPECT_EQUAL(uop_state_histogram_tn.getNumBins(), 5);
     EXPECT_EQUAL(uop_state_histogram_tn.getNumValuesPerBin(), 1);
 
-    sparta::CycleCounter *tn_0  = nullptr, *tn_1  = nullptr, *tn_2  = nullptr, *tn_3 = nullptr, *tn_4 = nullptr;
-    sparta::CycleCounter *tn_uf = nullptr, *tn_of = nullptr, *tn_tt = nullptr;
-    sparta::Counter      *tn_mx = nullptr;
+    sparta::CounterBase *tn_0  = nullptr, *tn_1  = nullptr, *tn_2  = nullptr, *tn_3 = nullptr, *tn_4 = nullptr;
+    sparta::CounterBase *tn_uf = nullptr, *tn_of = nullptr, *tn_tt = nullptr;
+    sparta::CounterBase *tn_mx = nullptr;
 
     // This enum class has user-defined overloaded << operator for name decoration.
     // Hence, statistic definition names will be generated using the overloaded << oeprator generated names.
     EXPECT_NOTHROW(tn_uf =
-        rtn.getChildAs<sparta::CycleCounter>("uop_state_histogram_tn.stats.UF"));
+        rtn.getChildAs<sparta::CounterBase>("uop_state_histogram_tn.stats.UF"));
     EXPECT_NOTHROW(tn_0 =
-        rtn.getChildAs<sparta::CycleCounter>("uop_state_histogram_tn.stats.cycle_countUOP_INIT"));
+        rtn.getChildAs<sparta::CounterBase>("uop_state_histogram_tn.stats.cycle_countUOP_INIT"));
     EXPECT_NOTHROW(tn_1 =
-        rtn.getChildAs<sparta::CycleCounter>("uop_state_histogram_tn.stats.cycle_countUOP_READY"));
+        rtn.getChildAs<sparta::CounterBase>("uop_state_histogram_tn.stats.cycle_countUOP_READY"));
     EXPECT_NOTHROW(tn_2 =
-        rtn.getChildAs<sparta::CycleCounter>("uop_state_histogram_tn.stats.cycle_countUOP_WAIT"));
+        rtn.getChildAs<sparta::CounterBase>("uop_state_histogram_tn.stats.cycle_countUOP_WAIT"));
     EXPECT_NOTHROW(tn_3 =
-        rtn.getChildAs<sparta::CycleCounter>("uop_state_histogram_tn.stats.cycle_countUOP_RETIRE"));
+        rtn.getChildAs<sparta::CounterBase>("uop_state_histogram_tn.stats.cycle_countUOP_RETIRE"));
     EXPECT_NOTHROW(tn_4 =
-        rtn.getChildAs<sparta::CycleCounter>("uop_state_histogram_tn.stats.cycle_countUOP_RESET"));
-    EXPECT_NOTHROW(tn_of = rtn.getChildAs<sparta::CycleCounter>("uop_state_histogram_tn.stats.OF"));
-    EXPECT_NOTHROW(tn_tt = rtn.getChildAs<sparta::CycleCounter>("uop_state_histogram_tn.stats.total"));
-    EXPECT_NOTHROW(tn_mx = rtn.getChildAs<sparta::Counter>("uop_state_histogram_tn.stats.max_value"));
+        rtn.getChildAs<sparta::CounterBase>("uop_state_histogram_tn.stats.cycle_countUOP_RESET"));
+    EXPECT_NOTHROW(tn_of = rtn.getChildAs<sparta::CounterBase>("uop_state_histogram_tn.stats.OF"));
+    EXPECT_NOTHROW(tn_tt = rtn.getChildAs<sparta::CounterBase>("uop_state_histogram_tn.stats.total"));
+    EXPECT_NOTHROW(tn_mx = rtn.getChildAs<sparta::CounterBase>("uop_state_histogram_tn.stats.max_value"));
     EXPECT_TRUE(tn_uf);
     EXPECT_TRUE(tn_0);
     EXPECT_TRUE(tn_1);
@@ -605,26 +605,26 @@ void testMMUStateHistogram(){
     EXPECT_EQUAL(mmu_state_histogram_tn.getNumBins(), 4);
     EXPECT_EQUAL(mmu_state_histogram_tn.getNumValuesPerBin(), 1);
 
-    sparta::CycleCounter *tn_0  = nullptr, *tn_1  = nullptr, *tn_2  = nullptr, *tn_3 = nullptr;
-    sparta::CycleCounter *tn_uf = nullptr, *tn_of = nullptr, *tn_tt = nullptr;
-    sparta::Counter      *tn_mx = nullptr;
+    sparta::CounterBase *tn_0  = nullptr, *tn_1  = nullptr, *tn_2  = nullptr, *tn_3 = nullptr;
+    sparta::CounterBase *tn_uf = nullptr, *tn_of = nullptr, *tn_tt = nullptr;
+    sparta::CounterBase *tn_mx = nullptr;
 
     // This histogram is templated on sparta::utils::Enum<EnumT>.
     // Hence, the user does not need to define an overloaded << operator for generating names.
     // Hence, statistic definition names will be generated using the names that were mapped
     // to enum constants by user.
-    EXPECT_NOTHROW(tn_uf = rtn.getChildAs<sparta::CycleCounter>("mmu_state_histogram_tn.stats.UF"));
+    EXPECT_NOTHROW(tn_uf = rtn.getChildAs<sparta::CounterBase>("mmu_state_histogram_tn.stats.UF"));
     EXPECT_NOTHROW(tn_0  =
-        rtn.getChildAs<sparta::CycleCounter>("mmu_state_histogram_tn.stats.cycle_countMMUSTATE_NO_ACCESS"));
+        rtn.getChildAs<sparta::CounterBase>("mmu_state_histogram_tn.stats.cycle_countMMUSTATE_NO_ACCESS"));
     EXPECT_NOTHROW(tn_1  =
-        rtn.getChildAs<sparta::CycleCounter>("mmu_state_histogram_tn.stats.cycle_countMMUSTATE_MISS"));
+        rtn.getChildAs<sparta::CounterBase>("mmu_state_histogram_tn.stats.cycle_countMMUSTATE_MISS"));
     EXPECT_NOTHROW(tn_2  =
-        rtn.getChildAs<sparta::CycleCounter>("mmu_state_histogram_tn.stats.cycle_countMMUSTATE_HIT"));
+        rtn.getChildAs<sparta::CounterBase>("mmu_state_histogram_tn.stats.cycle_countMMUSTATE_HIT"));
     EXPECT_NOTHROW(tn_3  =
-        rtn.getChildAs<sparta::CycleCounter>("mmu_state_histogram_tn.stats.cycle_countMMUSTATE_RETIRE"));
-    EXPECT_NOTHROW(tn_of = rtn.getChildAs<sparta::CycleCounter>("mmu_state_histogram_tn.stats.OF"));
-    EXPECT_NOTHROW(tn_tt = rtn.getChildAs<sparta::CycleCounter>("mmu_state_histogram_tn.stats.total"));
-    EXPECT_NOTHROW(tn_mx = rtn.getChildAs<sparta::Counter>("mmu_state_histogram_tn.stats.max_value"));
+        rtn.getChildAs<sparta::CounterBase>("mmu_state_histogram_tn.stats.cycle_countMMUSTATE_RETIRE"));
+    EXPECT_NOTHROW(tn_of = rtn.getChildAs<sparta::CounterBase>("mmu_state_histogram_tn.stats.OF"));
+    EXPECT_NOTHROW(tn_tt = rtn.getChildAs<sparta::CounterBase>("mmu_state_histogram_tn.stats.total"));
+    EXPECT_NOTHROW(tn_mx = rtn.getChildAs<sparta::CounterBase>("mmu_state_histogram_tn.stats.max_value"));
     EXPECT_TRUE(tn_uf);
     EXPECT_TRUE(tn_0);
     EXPECT_TRUE(tn_1);
@@ -62,7 +62,7 @@ int main() {
     EXPECT_EQUAL(getMeanBinCount(histogram_vector), histogram_tn.getMeanBinCount());
     const auto& bin_vector = histogram_tn.getRegularBin();
     std::for_each(bin_vector.begin(), bin_vector.end(),
-        [&histogram_vector](const sparta::Counter& c){
+        [&histogram_vector](const uint64_t c){
         static std::size_t i {0};
         EXPECT_EQUAL(static_cast<double>(c), histogram_vector[i++]);
     });
@@ -73,7 +73,7 @@ int main() {
     EXPECT_EQUAL(histogram_tn.getOverflowProbability(), static_cast<double>(1)/total_vals);
     const auto& bin_prob_vector = histogram_tn.recomputeRegularBinProbabilities();
     std::for_each(bin_vector.begin(), bin_vector.end(),
-        [&bin_prob_vector, &total_vals](const sparta::Counter& c){
+        [&bin_prob_vector, &total_vals](const uint64_t c){
         static std::size_t i {0};
         EXPECT_EQUAL(bin_prob_vector[i++], static_cast<double>(c)/total_vals);
     });
@@ -95,7 +95,7 @@ int main() {
     EXPECT_EQUAL(getMeanBinCount(histogram_vector_2), histogram_tn_2.getMeanBinCount());
     const auto& bin_vector_2 = histogram_tn_2.getRegularBin();
     std::for_each(bin_vector_2.begin(), bin_vector_2.end(),
-        [&histogram_vector_2](const sparta::Counter& c){
+        [&histogram_vector_2](const uint64_t c){
         static std::size_t i {0};
         EXPECT_EQUAL(static_cast<double>(c), histogram_vector_2[i++]);
     });
@@ -106,7 +106,7 @@ int main() {
     EXPECT_EQUAL(histogram_tn_2.getOverflowProbability(), static_cast<double>(1)/total_vals_2);
     const auto& bin_prob_vector_2 = histogram_tn_2.recomputeRegularBinProbabilities();
     std::for_each(bin_vector_2.begin(), bin_vector_2.end(),
-        [&bin_prob_vector_2, total_vals_2](const sparta::Counter& c){
+        [&bin_prob_vector_2, total_vals_2](const uint64_t c){
         static std::size_t i {0};
         EXPECT_EQUAL(bin_prob_vector_2[i++], static_cast<double>(c)/total_vals_2);
     });
@@ -0,0 +1,238 @@
+
+
+#include <iostream>
+#include <vector>
+
+#include "sparta/sparta.hpp"
+#include "sparta/events/EventSet.hpp"
+#include "sparta/events/IdleSleeper.hpp"
+#include "sparta/events/UniqueEvent.hpp"
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/ports/DataPort.hpp"
+#include "sparta/ports/PortSet.hpp"
+#include "sparta/resources/Buffer.hpp"
+#include "sparta/simulation/ClockManager.hpp"
+#include "sparta/statistics/StatisticSet.hpp"
+#include "sparta/utils/SpartaTester.hpp"
+
+TEST_INIT
+
+/*
+ * This test puts a consumer's per-cycle event to sleep and checks
+ * that port arrivals, Buffer appends, and direct wakes bring it back
+ * on the cycle a polling consumer would have seen the work.
+ */
+
+// A consumer that drains a Buffer one entry per cycle and sleeps
+// when it is empty
+class Consumer
+{
+public:
+    Consumer(sparta::TreeNode * node, const sparta::Clock * clk) :
+        ps_(node),
+        es_(node),
+        stats_(node),
+        in(&ps_, "in_data", 1),
+        buf("consumer_buf", 8, clk, &stats_),
+        ev_tick(&es_, "ev_tick", CREATE_SPARTA_HANDLER(Consumer, tick_)),
+        sleeper(&stats_, "tick", ev_tick),
+        clk_(clk)
+    {
+        in.registerConsumerHandler(CREATE_SPARTA_HANDLER_WITH_DATA(Consumer, receive_, uint32_t));
+        sleeper.addWakeSource(in);
+        sleeper.addWakeSource(buf);
+    }
+
+    uint64_t getCounter(const std::string & name) const {
+        return stats_.getCounter(name)->get();
+    }
+
+private:
+    sparta::PortSet ps_;
+    sparta::EventSet es_;
+    sparta::StatisticSet stats_;
+
+public:
+    sparta::DataInPort<uint32_t> in;
+    sparta::Buffer<uint32_t> buf;
+    sparta::UniqueEvent<> ev_tick;
+    sparta::IdleSleeper sleeper;
+
+    std::vector<uint64_t> tick_cycles;
+    std::vector<uint32_t> consumed;
+
+private:
+    void receive_(const uint32_t & dat) {
+        buf.push_back(dat);
+    }
+
+    void tick_() {
+        tick_cycles.push_back(clk_->currentCycle());
+        if(!buf.empty()) {
+            consumed.push_back(buf.read(0));
+            buf.erase(0);
+        }
+        if(buf.empty()) {
+            sleeper.sleep();
+        }
+        else {
+            ev_tick.schedule(1);
+        }
+    }
+
+    const sparta::Clock * clk_;
+};
+
+// A consumer whose event is in the Update phase, before ports deliver
+// their data in PortUpdate
+class UpdateConsumer
+{
+public:
+    UpdateConsumer(sparta::TreeNode * node, const sparta::Clock * clk) :
+        ps_(node),
+        es_(node),
+        stats_(node),
+        in(&ps_, "in_data", 1),
+        ev_update(&es_, "ev_update", CREATE_SPARTA_HANDLER(UpdateConsumer, update_)),
+        sleeper(&stats_, "update", ev_update),
+        clk_(clk)
+    {
+        in.registerConsumerHandler(CREATE_SPARTA_HANDLER_WITH_DATA(UpdateConsumer, receive_, uint32_t));
+        sleeper.addWakeSource(in);
+    }
+
+    uint64_t getCounter(const std::string & name) const {
+        return stats_.getCounter(name)->get();
+    }
+
+private:
+    sparta::PortSet ps_;
+    sparta::EventSet es_;
+    sparta::StatisticSet stats_;
+
+public:
+    sparta::DataInPort<uint32_t> in;
+    sparta::UniqueEvent<sparta::SchedulingPhase::Update> ev_update;
+    sparta::IdleSleeper sleeper;
+
+    std::vector<uint64_t> update_cycles;
+
+private:
+    void receive_(const uint32_t &) {}
+
+    void update_() {
+        update_cycles.push_back(clk_->currentCycle());
+        sleeper.sleep();
+    }
+
+    const sparta::Clock * clk_;
+};
+
+// Wakes the consumer from the Tick phase, which can only take effect
+// on the next cycle
+class Poker
+{
+public:
+    Poker(sparta::TreeNode * node, sparta::IdleSleeper & sleeper) :
+        es_(node),
+        ev_poke(&es_, "ev_poke", CREATE_SPARTA_HANDLER(Poker, poke_)),
+        sleeper_(sleeper)
+    {}
+
+private:
+    sparta::EventSet es_;
+
+public:
+    sparta::UniqueEvent<> ev_poke;
+
+private:
+    void poke_() {
+        sleeper_.wake();
+    }
+
+    sparta::IdleSleeper & sleeper_;
+};
+
+int main()
+{
+    sparta::Scheduler sched;
+    sparta::ClockManager cm(&sched);
+    sparta::RootTreeNode rtn;
+    sparta::Clock::Handle root_clk = cm.makeRoot(&rtn, "root_clk");
+    cm.normalize();
+    rtn.setClock(root_clk.get());
+
+    sparta::TreeNode consumer_node(&rtn, "consumer", "Sleeping consumer");
+    sparta::TreeNode poker_node(&rtn, "poker", "Wakes the consumer");
+    Consumer consumer(&consumer_node, root_clk.get());
+    Poker poker(&poker_node, consumer.sleeper);
+    sparta::TreeNode update_node(&rtn, "update_consumer", "Sleeping Update-phase consumer");
+    UpdateConsumer update_consumer(&update_node, root_clk.get());
+
+    sparta::PortSet ps(&rtn, "producer_ports");
+    sparta::DataOutPort<uint32_t> out(&ps, "out");
+    out.bind(consumer.in);
+    sparta::DataOutPort<uint32_t> update_out(&ps, "update_out");
+    update_out.bind(update_consumer.in);
+
+    sched.finalize();
+    rtn.enterConfiguring();
+    rtn.enterFinalized();
+
+    sched.run(1, true, false);
+    EXPECT_EQUAL(root_clk->currentCycle(), 1);
+    consumer.sleeper.sleep();
+    EXPECT_TRUE(consumer.sleeper.isAsleep());
+
+    // Data arriving on the port (PortUpdate) wakes the consumer in the
+    // same cycle.  Nothing fires in between.
+    out.send(5, 9);
+    sched.run(20, true, false);
+    EXPECT_TRUE(consumer.tick_cycles == std::vector<uint64_t>({11}));
+    EXPECT_TRUE(consumer.consumed == std::vector<uint32_t>({5}));
+    EXPECT_TRUE(consumer.sleeper.isAsleep());
+    EXPECT_EQUAL(consumer.getCounter("tick_idle_cycles_skipped"), 9);
+    EXPECT_EQUAL(consumer.getCounter("tick_wakeups"), 1);
+
+    // Buffer appends between runs wake it on the current cycle, and it
+    // stays awake until the Buffer drains
+    EXPECT_EQUAL(root_clk->currentCycle(), 21);
+    consumer.buf.push_back(1);
+    consumer.buf.push_back(2);
+    sched.run(10, true, false);
+    EXPECT_TRUE(consumer.tick_cycles == std::vector<uint64_t>({11, 21, 22}));
+    EXPECT_TRUE(consumer.consumed == std::vector<uint32_t>({5, 1, 2}));
+    EXPECT_EQUAL(consumer.getCounter("tick_idle_cycles_skipped"), 18);
+    EXPECT_EQUAL(consumer.getCounter("tick_wakeups"), 2);
+
+    // A wake from the consumer's own phase fires it next cycle
+    poker.ev_poke.schedule(5);
+    sched.run(10, true, false);
+    EXPECT_TRUE(consumer.tick_cycles == std::vector<uint64_t>({11, 21, 22, 37}));
+    EXPECT_EQUAL(consumer.getCounter("tick_idle_cycles_skipped"), 32);
+    EXPECT_EQUAL(consumer.getCounter("tick_wakeups"), 3);
+    EXPECT_TRUE(consumer.sleeper.isAsleep());
+
+    // Waking an awake event does nothing
+    consumer.sleeper.wake();
+    consumer.sleeper.wake();
+    sched.run(5, true, false);
+    EXPECT_EQUAL(consumer.getCounter("tick_wakeups"), 4);
+    EXPECT_EQUAL(consumer.tick_cycles.size(), 5);
+
+    // Data arriving on a port (PortUpdate) after the Update phase
+    // wakes an Update event on the next cycle
+    update_consumer.sleeper.sleep();
+    const uint64_t sleep_cycle = root_clk->currentCycle();
+    update_out.send(7, 3);
+    sched.run(10, true, false);
+    EXPECT_TRUE(update_consumer.update_cycles == std::vector<uint64_t>({sleep_cycle + 5}));
+    EXPECT_TRUE(update_consumer.sleeper.isAsleep());
+    EXPECT_EQUAL(update_consumer.getCounter("update_idle_cycles_skipped"), 4);
+    EXPECT_EQUAL(update_consumer.getCounter("update_wakeups"), 1);
+
+    rtn.enterTeardown();
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
@@ -13,6 +13,7 @@
 #include "sparta/utils/LogUtils.hpp"
 #include "sparta/log/Tap.hpp"
 #include "sparta/log/MessageSource.hpp"
+#include "sparta/log/BinaryFormatter.hpp"
 
 /*!
  * \file main.cpp
@@ -98,6 +99,10 @@ int main()
     // Tap which outlives the tree to capture destructors
     sparta::log::Tap* a_tap_all = nullptr;
 
+    // Stream destination for the format buffer reuse checks. Destinations live
+    // until exit, so this must outlive the test body
+    static std::stringstream reuse_ss;
+
     // Scope all of the tests
     {
         // Build Tree
@@ -271,6 +276,7 @@ int main()
 
         // Tap using category lists
         sparta::log::Tap a_tap_allcats(&a, "*", "a_allcats.log"); // Write everything
+        sparta::log::Tap a_tap_allcats_bin(&a, "*", "a_allcats.log.bin"); // Write everything asynchronously in binary
         sparta::log::Tap a_tap_warnmycat(&a, "warning,mycategory", "a_warnmycat.log"); // Write warning and mycategory
         sparta::log::Tap a_tap_noduplicate(&a, "*,warning, warning ", "a_nodups.log"); // Write everything. Prove no duplicates and parsing functionality
         sparta::log::Tap a_tap_wildparse(&a, " +category ", "a_cats_wildcard.log"); // Wild-card based parsing
@@ -365,8 +371,8 @@ int main()
         // warn.log, cerr, a_out.log, b_out.log, c_out.log, e_out.log,
         // a_removed.log, top_tap_warn.log, all.log.basic, empty.log
         // a_allcats.log, a_warnmycat.log global_warn.log.basic, a_nodups.log,
-        // a_cats_wildcard.log, hex_output.basic
-        EXPECT_EQUAL(sparta::log::DestinationManager::getNumDestinations(), 16);
+        // a_cats_wildcard.log, hex_output.basic, a_allcats.log.bin
+        EXPECT_EQUAL(sparta::log::DestinationManager::getNumDestinations(), 17);
 
         top.enterTeardown();
 
@@ -376,6 +382,50 @@ int main()
     // tree
     delete a_tap_all;
 
+    // LogObjects format into a buffer reused by each thread. Make sure
+    // formatting state does not leak between messages, that messages longer
+    // than the initial buffer are intact, and that overlapping LogObjects on
+    // the same or different sources (which cannot share the buffer) still
+    // work.
+    {
+        sparta::RootTreeNode top("top");
+        sparta::TreeNode h("h", "H node");
+        top.addChild(h);
+        sparta::log::MessageSource h_src(&h, "reuse", "Messages exercising the reusable format buffer");
+        sparta::log::MessageSource h_other_src(&h, "reuse_other", "Second source sharing the format buffer");
+        sparta::log::Tap h_tap(&h, "reuse", static_cast<std::ostream&>(reuse_ss));
+        sparta::log::Tap h_other_tap(&h, "reuse_other", static_cast<std::ostream&>(reuse_ss));
+
+        h_src << "hex " << std::hex << 255;
+        h_src << "dec " << 255 << " " << 1.5;
+        h_src << std::string(1000, 'x') << "|end";
+        {
+            auto outer = h_src.emit("outer");
+            h_src << "inner";
+            outer << " done";
+        }
+        {
+            auto first = h_src.emit("first");
+            h_other_src << "other";
+            first << " source";
+        }
+        auto moved_from = h_src << "moved";
+        sparta::log::MessageSource::LogObject moved(std::move(moved_from));
+        top.enterTeardown();
+    }
+
+    const std::string reuse_log = reuse_ss.str();
+    EXPECT_NOTEQUAL(reuse_log.find("} hex ff\n"), std::string::npos);
+    EXPECT_NOTEQUAL(reuse_log.find("} dec 255 1.5\n"), std::string::npos);
+    EXPECT_NOTEQUAL(reuse_log.find("} " + std::string(1000, 'x') + "|end\n"), std::string::npos);
+    EXPECT_NOTEQUAL(reuse_log.find("} inner\n"), std::string::npos);
+    EXPECT_NOTEQUAL(reuse_log.find("} outer done\n"), std::string::npos);
+    EXPECT_TRUE(reuse_log.find("} inner\n") < reuse_log.find("} outer done\n"));
+    EXPECT_NOTEQUAL(reuse_log.find("} other\n"), std::string::npos);
+    EXPECT_NOTEQUAL(reuse_log.find("} first source\n"), std::string::npos);
+    EXPECT_EQUAL(reuse_log.find("} moved\n"), reuse_log.rfind("} moved\n")); // Emitted only once
+    EXPECT_NOTEQUAL(reuse_log.find("} moved\n"), std::string::npos);
+
 
     // Look at output files (note that the last messages arrive during tree
     // destruction)
@@ -395,6 +445,21 @@ int main()
     EXPECT_FILES_EQUAL("a_nodups.log.EXPECTED",         "a_nodups.log");
     EXPECT_FILES_EQUAL("a_cats_wildcard.log.EXPECTED",  "a_cats_wildcard.log");
 
+    // The binary destination must render to exactly what the text destination
+    // with the same taps wrote
+    sparta::log::DestinationManager::flushDestinations();
+    {
+        std::ifstream bin_in("a_allcats.log.bin", std::ios::binary);
+        std::ofstream rendered("a_allcats.log.bin.rendered");
+        EXPECT_EQUAL(sparta::log::BinaryLogRenderer::render(bin_in, rendered), 11);
+    }
+    EXPECT_FILES_EQUAL("a_allcats.log", "a_allcats.log.bin.rendered");
+
+    std::stringstream not_binary("{0000000000 -------- top.a mycategory} text");
+    std::stringstream discard;
+    EXPECT_THROW(sparta::log::BinaryLogRenderer::render(not_binary, discard));
+    EXPECT_THROW(sparta::log::BinaryLogRenderer::parseFormat("verbose"));
+
     // Done
 
     REPORT_ERROR;
@@ -10,6 +10,9 @@
 #include "sparta/pevents/PeventTrigger.hpp"
 #include "sparta/pevents/PeventCollector.hpp"
 #include "sparta/pevents/PeventController.hpp"
+#include "sparta/pevents/BinaryPeventWriter.hpp"
+
+#include <fstream>
 
 using namespace sparta;
 
@@ -92,6 +95,10 @@ int main() {
     pevents::PeventCollectorController controller;
     controller.cacheTap("pair.log", "RETIRE", verbose_tap);
     controller.cacheTap("all.log", "ALL", !verbose_tap);
+    // Binary taps, rendered and checked against the text taps below
+    controller.cacheTap("pair.bin", "RETIRE", verbose_tap);
+    controller.cacheTap("all.bin", "ALL", !verbose_tap);
+    controller.cacheTap("all_nonverbose.bin", "ALL", verbose_tap);
     controller.finalize(&root);
     trigger::PeventTrigger trigger(&root);
     trigger.go();
@@ -100,6 +107,8 @@ int main() {
     pair_verbose_pevent.collect(a);
     decode_pevent.collect(a);
     my_pevent.collect(a, 32);
+    a.setX("test1");
+    pair_pevent.collect(a);
     pair_pevent.isCollecting();
     log::MessageSource logger_pevent_(&root, "regress", "LSU PEvents");
     log::Tap tap(TreeNode::getVirtualGlobalNode(), "regress", "log.log");
@@ -122,6 +131,33 @@ int main() {
 
     root.enterTeardown();
 
+    // Binary pevents render into the same text as the text taps
+    log::DestinationManager::flushDestinations();
+    pevents::BinaryPeventWriter::flushAll();
+    const std::vector<std::pair<std::string, std::string>> bin_files = {
+        {"pair.bin", "pair.log"}, {"all.bin", "all.log"}};
+    for(const auto& f : bin_files) {
+        std::ifstream in(f.first, std::ios::binary);
+        std::ofstream out(f.first + ".rendered");
+        EXPECT_NOTHROW(pevents::BinaryPeventRenderer::render(in, out));
+        out.close();
+        EXPECT_FILES_EQUAL(f.second, f.first + ".rendered");
+    }
+    {
+        std::ifstream in("all_nonverbose.bin", std::ios::binary);
+        std::ostringstream out;
+        EXPECT_EQUAL(pevents::BinaryPeventRenderer::render(in, out), 4u);
+        EXPECT_TRUE(out.str().find("ev=\"DECODE\"") != std::string::npos);
+        EXPECT_TRUE(out.str().find("ev=\"MY_EVENT\"") != std::string::npos);
+        EXPECT_TRUE(out.str().find("extra_arg=\"32\"") != std::string::npos);
+        EXPECT_TRUE(out.str().find("x_val=\"test1\"") != std::string::npos);
+    }
+    {
+        std::istringstream in("not a pevent file");
+        std::ostringstream out;
+        EXPECT_THROW(pevents::BinaryPeventRenderer::render(in, out));
+    }
+
     REPORT_ERROR;
     return ERROR_CODE;
 }
@@ -0,0 +1,127 @@
+#include <iostream>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "sparta/resources/Pipeline.hpp"
+#include "sparta/events/EventSet.hpp"
+#include "sparta/events/UniqueEvent.hpp"
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/simulation/Clock.hpp"
+#include "sparta/simulation/RootTreeNode.hpp"
+#include "sparta/utils/SpartaTester.hpp"
+
+TEST_INIT
+
+/*
+ * Deep pipelines with stalls: one item is appended every cycle, and a
+ * stage is stalled periodically.  The number of times each stage
+ * handler is called must match the original sparta::Pipeline exactly.
+ * bench/ResourceBench.cpp times the same pipelines.
+ */
+
+class StallingPipeline
+{
+public:
+    StallingPipeline(sparta::EventSet * es, const uint32_t num_stages, const uint32_t handler_stride) :
+        pipeline_(es, "stall_pipeline", num_stages, es->getClock()),
+        ev_append_(es, "ev_append", CREATE_SPARTA_HANDLER(StallingPipeline, appendItem_))
+    {
+        for (uint32_t stage = 0; stage < num_stages; stage += handler_stride) {
+            handlers_.emplace_back(new StageHandler{0});
+            pipeline_.registerHandlerAtStage(stage, CREATE_SPARTA_HANDLER_WITH_OBJ(StageHandler,
+                                                                                  handlers_.back().get(),
+                                                                                  handle));
+        }
+        pipeline_.setDefaultStagePrecedence(sparta::Pipeline<uint64_t>::Precedence::BACKWARD);
+        pipeline_.performOwnUpdates();
+        ev_append_.setContinuing(true);
+    }
+
+    void start() { ev_append_.schedule(); }
+
+    //! Calls of each registered stage handler, in stage order
+    std::vector<uint64_t> stageCalls() const {
+        std::vector<uint64_t> calls;
+        for (const auto & handler : handlers_) {
+            calls.emplace_back(handler->calls);
+        }
+        return calls;
+    }
+
+    uint64_t numStalls() const { return num_stalls_; }
+
+private:
+    struct StageHandler
+    {
+        uint64_t calls;
+        void handle() { ++calls; }
+    };
+
+    void appendItem_()
+    {
+        // The front of the pipeline holds still while stalled
+        if (!pipeline_.isAppended()) {
+            pipeline_.append(next_item_);
+        }
+        ++next_item_;
+
+        // Stall the middle of the pipeline for a few cycles every so often
+        const uint32_t stall_stage = pipeline_.capacity() / 2;
+        if (((next_item_ % 97) == 0) && !pipeline_.isStalledOrStalling() && pipeline_.isValid(stall_stage)) {
+            pipeline_.stall(stall_stage, 3);
+            ++num_stalls_;
+        }
+        ev_append_.schedule(1);
+    }
+
+    sparta::Pipeline<uint64_t> pipeline_;
+    std::vector<std::unique_ptr<StageHandler>> handlers_;
+    sparta::UniqueEvent<> ev_append_;
+    uint64_t next_item_ = 0;
+    uint64_t num_stalls_ = 0;
+};
+
+void testStalls(const uint32_t num_stages, const uint32_t handler_stride,
+                const std::vector<uint64_t> & expected_calls, const uint64_t expected_stalls)
+{
+    sparta::Scheduler    sched;
+    sparta::Clock        clk("clk", &sched);
+    sparta::RootTreeNode rtn;
+    rtn.setClock(&clk);
+    sparta::EventSet     es(&rtn);
+
+    StallingPipeline pipe(&es, num_stages, handler_stride);
+    sched.finalize();
+    rtn.enterConfiguring();
+    rtn.enterFinalized();
+
+    pipe.start();
+    sched.run(2000, true, false);
+
+    std::cout << num_stages << " stages, handler every " << handler_stride << " stage(s):";
+    for (const uint64_t calls : pipe.stageCalls()) {
+        std::cout << " " << calls;
+    }
+    std::cout << ", " << pipe.numStalls() << " stalls" << std::endl;
+
+    EXPECT_TRUE(pipe.stageCalls() == expected_calls);
+    EXPECT_EQUAL(pipe.numStalls(), expected_stalls);
+
+    rtn.enterTeardown();
+}
+
+int main()
+{
+    // Every stage holds an item once the pipeline fills
+    testStalls(24, 1, {1939, 1938, 1937, 1936, 1935, 1934, 1933, 1932,
+                       1931, 1930, 1929, 1928, 1927, 1926, 1925, 1924,
+                       1923, 1922, 1921, 1920, 1919, 1918, 1917, 1916}, 20);
+
+    // Sparse handlers on deeper pipelines
+    testStalls(64, 8, {1939, 1931, 1923, 1915, 1907, 1899, 1891, 1883}, 20);
+    testStalls(128, 32, {1939, 1907, 1875, 1843}, 20);
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
@@ -0,0 +1,185 @@
+
+#include <iostream>
+#include <cstdint>
+#include <vector>
+
+#include "sparta/simulation/Clock.hpp"
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/utils/SpartaTester.hpp"
+#include "sparta/ports/PortSet.hpp"
+#include "sparta/ports/BatchedDataPort.hpp"
+
+TEST_INIT
+
+/*
+ * Tests BatchedDataOutPort/BatchedDataInPort: items sent on the same
+ * cycle with the same delay arrive in one handler call, in send order.
+ */
+
+class BatchReceiver
+{
+public:
+    BatchReceiver(sparta::PortSet * ps, const std::string & name, sparta::Clock::Cycle delay) :
+        receiver_pt(ps, name, delay)
+    {
+        receiver_pt.registerConsumerHandler(CREATE_SPARTA_HANDLER_WITH_DATA(BatchReceiver, receive,
+                                                                            sparta::PortBatch<uint32_t>));
+    }
+
+    void receive(const sparta::PortBatch<uint32_t> & batch) {
+        batches.emplace_back(batch.begin(), batch.end());
+        delivery_ticks.emplace_back(receiver_pt.getClock()->getScheduler()->getCurrentTick());
+    }
+
+    void clear() {
+        batches.clear();
+        delivery_ticks.clear();
+    }
+
+    sparta::BatchedDataInPort<uint32_t> receiver_pt;
+    std::vector<std::vector<uint32_t>> batches;
+    std::vector<sparta::Scheduler::Tick> delivery_ticks;
+};
+
+/*
+ * Sends more items to its own port from inside the handler, which
+ * allocates new batches while the delivered one is still being read
+ */
+class LoopbackReceiver
+{
+public:
+    LoopbackReceiver(sparta::PortSet * ps) :
+        loop_out(ps, "loop_out"),
+        loop_in(ps, "loop_in", 1)
+    {
+        loop_in.registerConsumerHandler(CREATE_SPARTA_HANDLER_WITH_DATA(LoopbackReceiver, receive,
+                                                                        sparta::PortBatch<uint32_t>));
+        sparta::bind(loop_out, loop_in);
+    }
+
+    void receive(const sparta::PortBatch<uint32_t> & batch) {
+        std::vector<uint32_t> items;
+        for(const uint32_t & item : batch) {
+            // Each delay is a new batch
+            if(item < 100) {
+                for(uint32_t delay = 0; delay < 8; ++delay) {
+                    loop_out.send(item * 100 + delay, delay);
+                }
+            }
+            items.emplace_back(item);
+        }
+        batches.emplace_back(std::move(items));
+    }
+
+    sparta::BatchedDataOutPort<uint32_t> loop_out;
+    sparta::BatchedDataInPort<uint32_t> loop_in;
+    std::vector<std::vector<uint32_t>> batches;
+};
+
+int main()
+{
+    sparta::Scheduler sched;
+    sparta::Clock     clk("clk", &sched);
+    sparta::PortSet   ps(nullptr);
+    ps.setClock(&clk);
+
+    sparta::BatchedDataOutPort<uint32_t> out(&ps, "batch_out");
+    BatchReceiver rcv(&ps, "batch_in", 1);
+    sparta::bind(out, rcv.receiver_pt);
+
+    sparta::BatchedDataOutPort<uint32_t> fanout_out(&ps, "fanout_out");
+    BatchReceiver fanout_rcv0(&ps, "fanout_in0", 1);
+    BatchReceiver fanout_rcv1(&ps, "fanout_in1", 2);
+    sparta::bind(fanout_out, fanout_rcv0.receiver_pt);
+    sparta::bind(fanout_out, fanout_rcv1.receiver_pt);
+
+    sparta::BatchedDataOutPort<uint32_t> unbound_out(&ps, "unbound_out");
+
+    LoopbackReceiver loop(&ps);
+
+    sched.finalize();
+    sched.run(1, true, false);
+
+    EXPECT_THROW(unbound_out.send(1));
+
+    // Events fired delivering a single item
+    out.send(100);
+    uint64_t fired_before = sched.getNumFired();
+    sched.run(2, true, false);
+    const uint64_t single_fired = sched.getNumFired() - fired_before;
+    EXPECT_EQUAL(rcv.batches.size(), 1);
+    rcv.clear();
+
+    // Four sends in one cycle: one batch, in order, next cycle
+    const sparta::Scheduler::Tick start = sched.getCurrentTick();
+    for(uint32_t i = 0; i < 4; ++i) {
+        out.send(i);
+    }
+    EXPECT_TRUE(out.isDriven());
+    EXPECT_TRUE(out.isDriven(1));
+    EXPECT_FALSE(out.isDriven(2));
+    fired_before = sched.getNumFired();
+    sched.run(2, true, false);
+    EXPECT_EQUAL(sched.getNumFired() - fired_before, single_fired); // One delivery event for four items
+    EXPECT_EQUAL(rcv.batches.size(), 1);
+    EXPECT_TRUE(rcv.batches[0] == std::vector<uint32_t>({0, 1, 2, 3}));
+    EXPECT_EQUAL(rcv.delivery_ticks[0], start + 1);
+    EXPECT_FALSE(out.isDriven());
+    rcv.clear();
+
+    // Different delays make different batches; later cycles too
+    out.send(10);
+    out.send(20, 1);
+    out.send(11);
+    out.send(21, 1);
+    sched.run(1, true, false);
+    out.send(30);       // Same delivery tick as 20/21, but a different send cycle
+    sched.run(3, true, false);
+    EXPECT_EQUAL(rcv.batches.size(), 3);
+    EXPECT_TRUE(rcv.batches[0] == std::vector<uint32_t>({10, 11}));
+    EXPECT_TRUE(rcv.batches[1] == std::vector<uint32_t>({20, 21}));
+    EXPECT_TRUE(rcv.batches[2] == std::vector<uint32_t>({30}));
+    EXPECT_EQUAL(rcv.delivery_ticks[1], rcv.delivery_ticks[2]);
+    rcv.clear();
+
+    // Fanout: each bound port batches independently with its own delay
+    fanout_out.send(1);
+    fanout_out.send(2);
+    sched.run(3, true, false);
+    EXPECT_EQUAL(fanout_rcv0.batches.size(), 1);
+    EXPECT_EQUAL(fanout_rcv1.batches.size(), 1);
+    EXPECT_TRUE(fanout_rcv0.batches[0] == std::vector<uint32_t>({1, 2}));
+    EXPECT_TRUE(fanout_rcv1.batches[0] == std::vector<uint32_t>({1, 2}));
+    EXPECT_EQUAL(fanout_rcv1.delivery_ticks[0], fanout_rcv0.delivery_ticks[0] + 1);
+
+    // Cancel everything in flight
+    out.send(40);
+    out.send(41);
+    out.send(50, 3);
+    EXPECT_EQUAL(out.cancel(), 3);
+    EXPECT_FALSE(out.isDriven());
+    sched.run(5, true, false);
+    EXPECT_EQUAL(rcv.batches.size(), 0);
+
+    // Batch storage is reused after a cancel
+    out.send(60);
+    out.send(61);
+    sched.run(2, true, false);
+    EXPECT_EQUAL(rcv.batches.size(), 1);
+    EXPECT_TRUE(rcv.batches[0] == std::vector<uint32_t>({60, 61}));
+
+    // Resending from the handler does not disturb the batch being delivered
+    loop.loop_out.send(1);
+    loop.loop_out.send(2);
+    loop.loop_out.send(3);
+    sched.run(12, true, false);
+    EXPECT_EQUAL(loop.batches.size(), 9);
+    EXPECT_TRUE(loop.batches[0] == std::vector<uint32_t>({1, 2, 3}));
+    for(uint32_t delay = 0; delay < 8; ++delay) {
+        EXPECT_TRUE(loop.batches[delay + 1] ==
+                    std::vector<uint32_t>({100 + delay, 200 + delay, 300 + delay}));
+    }
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
@@ -0,0 +1,209 @@
+
+#include <iostream>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <boost/timer/timer.hpp>
+
+#include "sparta/simulation/Clock.hpp"
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/utils/SpartaTester.hpp"
+#include "sparta/ports/PortSet.hpp"
+#include "sparta/ports/DataPort.hpp"
+#include "sparta/events/EventSet.hpp"
+#include "sparta/events/PayloadEvent.hpp"
+
+TEST_INIT
+
+/*
+ * Tests the rvalue DataOutPort::send and PayloadEvent::preparePayload
+ * paths: the payload must be moved (not copied) into the last bound
+ * DataInPort, and heavy payloads should be cheaper to send.
+ */
+
+//! Payload counting the copies made of it
+struct CountedPayload
+{
+    static uint32_t copies;
+    static uint32_t moves;
+
+    CountedPayload() = default;
+    explicit CountedPayload(uint32_t n) : data(n) {
+        std::iota(data.begin(), data.end(), 0);
+    }
+    CountedPayload(const CountedPayload & o) : data(o.data) { ++copies; }
+    CountedPayload(CountedPayload && o) : data(std::move(o.data)) { ++moves; }
+    CountedPayload & operator=(const CountedPayload & o) { data = o.data; ++copies; return *this; }
+    CountedPayload & operator=(CountedPayload && o) { data = std::move(o.data); ++moves; return *this; }
+    bool operator==(const CountedPayload & o) const { return data == o.data; }
+
+    static void reset() { copies = 0; moves = 0; }
+
+    std::vector<uint64_t> data;
+};
+
+uint32_t CountedPayload::copies = 0;
+uint32_t CountedPayload::moves = 0;
+
+std::ostream & operator<<(std::ostream & os, const CountedPayload & pl) {
+    return os << "CountedPayload[" << pl.data.size() << "]";
+}
+
+class PayloadReceiver
+{
+public:
+    PayloadReceiver(sparta::PortSet * ps, const std::string & name, sparta::Clock::Cycle delay) :
+        receiver_pt(ps, name, delay)
+    {
+        receiver_pt.registerConsumerHandler(CREATE_SPARTA_HANDLER_WITH_DATA(PayloadReceiver, receive, CountedPayload));
+    }
+
+    void receive(const CountedPayload & dat) {
+        ++num_received;
+        last_size = dat.data.size();
+    }
+
+    sparta::DataInPort<CountedPayload> receiver_pt;
+    uint32_t num_received = 0;
+    uint64_t last_size = 0;
+};
+
+// Copies made by a send to N bound ports.  DataInPort keeps a copy
+// of the last data it delivered (DataContainer), so each receiver
+// costs one copy on delivery regardless of how the data was sent.
+void testMoveSemantics()
+{
+    sparta::Scheduler sched;
+    sparta::Clock     clk("clk", &sched);
+    sparta::PortSet   ps(nullptr);
+    ps.setClock(&clk);
+
+    sparta::DataOutPort<CountedPayload> single_out(&ps, "single_out");
+    PayloadReceiver single_in(&ps, "single_in", 1);
+    sparta::bind(single_out, single_in.receiver_pt);
+
+    sparta::DataOutPort<CountedPayload> fanout_out(&ps, "fanout_out");
+    PayloadReceiver fanout_in0(&ps, "fanout_in0", 1);
+    PayloadReceiver fanout_in1(&ps, "fanout_in1", 1);
+    sparta::bind(fanout_out, fanout_in0.receiver_pt);
+    sparta::bind(fanout_out, fanout_in1.receiver_pt);
+
+    sparta::EventSet es(nullptr);
+    es.setClock(&clk);
+    PayloadReceiver * pe_receiver = &single_in;
+    sparta::PayloadEvent<CountedPayload> pe(&es, "move_pe",
+                                            CREATE_SPARTA_HANDLER_WITH_DATA_WITH_OBJ(PayloadReceiver, pe_receiver,
+                                                                                    receive, CountedPayload), 1);
+
+    sched.finalize();
+    sched.run(1, true, false);
+
+    // Copy send into a single port: one copy into the delivery event
+    CountedPayload pl(16);
+    CountedPayload::reset();
+    single_out.send(pl);
+    EXPECT_EQUAL(CountedPayload::copies, 1);
+    EXPECT_EQUAL(pl.data.size(), 16);
+
+    // Move send into a single port: no copies
+    CountedPayload::reset();
+    single_out.send(std::move(pl), 1);
+    EXPECT_EQUAL(CountedPayload::copies, 0);
+    EXPECT_EQUAL(CountedPayload::moves, 1);
+
+    // Temporaries take the move path
+    CountedPayload::reset();
+    single_out.send(CountedPayload(16), 2);
+    EXPECT_EQUAL(CountedPayload::copies, 0);
+
+    // Fanout: every port but the last gets a copy
+    CountedPayload fan_pl(16);
+    CountedPayload::reset();
+    fanout_out.send(std::move(fan_pl));
+    EXPECT_EQUAL(CountedPayload::copies, 1);
+    EXPECT_EQUAL(CountedPayload::moves, 1);
+
+    // PayloadEvent
+    CountedPayload ev_pl(16);
+    CountedPayload::reset();
+    pe.preparePayload(std::move(ev_pl))->schedule();
+    EXPECT_EQUAL(CountedPayload::copies, 0);
+    EXPECT_EQUAL(CountedPayload::moves, 1);
+    EXPECT_TRUE(pe.confirmIf(CountedPayload(16)));
+
+    CountedPayload::reset();
+    sched.run(4, true, false);
+
+    // Four deliveries to single_in (three sends + the PayloadEvent)
+    // and one to each fanout port.  Each port delivery copies into
+    // the DataInPort's DataContainer; the PayloadEvent does not
+    EXPECT_EQUAL(single_in.num_received, 4);
+    EXPECT_EQUAL(single_in.last_size, 16);
+    EXPECT_EQUAL(fanout_in0.num_received, 1);
+    EXPECT_EQUAL(fanout_in1.num_received, 1);
+    EXPECT_EQUAL(fanout_in0.last_size, 16);
+    EXPECT_EQUAL(fanout_in1.last_size, 16);
+    EXPECT_EQUAL(CountedPayload::copies, 5);
+    EXPECT_TRUE(single_in.receiver_pt.dataReceived());
+    EXPECT_EQUAL(single_in.receiver_pt.pullData().data.size(), 16);
+    EXPECT_EQUAL(pe.getNumOutstandingEvents(), 0);
+}
+
+// Microbenchmark: send a heavy payload through a DataOutPort -> DataInPort
+// hop by copy and by move
+void benchmarkSend()
+{
+    sparta::Scheduler sched;
+    sparta::Clock     clk("clk", &sched);
+    sparta::PortSet   ps(nullptr);
+    ps.setClock(&clk);
+
+    sparta::DataOutPort<CountedPayload> out(&ps, "bench_out");
+    PayloadReceiver in(&ps, "bench_in", 1);
+    sparta::bind(out, in.receiver_pt);
+
+    sched.finalize();
+    sched.run(1, true, false);
+
+    const uint32_t num_sends = 50000;
+    const uint32_t payload_size = 4096;
+
+    boost::timer::cpu_timer copy_timer;
+    for(uint32_t i = 0; i < num_sends; ++i) {
+        CountedPayload pl(payload_size);
+        out.send(pl);
+        sched.run(1, true, false);
+    }
+    copy_timer.stop();
+
+    boost::timer::cpu_timer move_timer;
+    for(uint32_t i = 0; i < num_sends; ++i) {
+        CountedPayload pl(payload_size);
+        out.send(std::move(pl));
+        sched.run(1, true, false);
+    }
+    move_timer.stop();
+
+    // Deliver the last send
+    sched.run(1, true, false);
+
+    EXPECT_EQUAL(in.num_received, 2 * num_sends);
+    EXPECT_EQUAL(in.last_size, payload_size);
+
+    const double copy_sec = copy_timer.elapsed().user / 1000000000.0;
+    const double move_sec = move_timer.elapsed().user / 1000000000.0;
+    std::cout << "DataOutPort::send of " << num_sends << " x vector<uint64_t>(" << payload_size << "):\n"
+              << "  copy: " << copy_sec << " sec\n"
+              << "  move: " << move_sec << " sec" << std::endl;
+}
+
+int main()
+{
+    testMoveSemantics();
+    benchmarkSend();
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
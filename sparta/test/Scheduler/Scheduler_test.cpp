@@ -11,6 +11,7 @@
 // - Start/stop behavior
 // - Clearing of events during run
 // - restart behavior
+// - Skipping of empty firing groups
 //
 
 #include "sparta/sparta.hpp"
@@ -23,6 +24,8 @@
 #include "sparta/utils/SpartaTester.hpp"
 #include <boost/timer/timer.hpp>
 #include "sparta/kernel/SleeperThread.hpp"
+#include "sparta/events/Event.hpp"
+#include "sparta/events/EventSet.hpp"
 
 TEST_INIT
 
@@ -108,8 +111,149 @@ static_assert(sparta::NUM_SCHEDULING_PHASES == 7,
               "\n\nIf you got this compile-time assert, then you need to update this test 'cause you added more phases to SchedulingPhase. \n"
               "Specifically, you need to add more TestEvent's below\n\n");
 
+// An event in a long precedence chain (one firing group per link)
+// that records when it fires and schedules other links
+class ChainLink
+{
+public:
+    ChainLink(sparta::EventSet * es, uint32_t idx, std::vector<uint32_t> & order) :
+        ev(es, "link" + std::to_string(idx), CREATE_SPARTA_HANDLER(ChainLink, fire)),
+        idx_(idx),
+        order_(order)
+    {}
+
+    void fire()
+    {
+        order_.push_back(idx_);
+        for(auto & link_delay : to_schedule) {
+            link_delay.first->ev.schedule(link_delay.second);
+        }
+        if(too_early != nullptr) {
+            // Earlier group in the same tick -- a precedence issue
+            EXPECT_THROW(too_early->ev.schedule());
+        }
+    }
+
+    sparta::Event<sparta::SchedulingPhase::Tick> ev;
+    std::vector<std::pair<ChainLink *, sparta::Clock::Cycle>> to_schedule;
+    ChainLink * too_early = nullptr;
+
+private:
+    const uint32_t idx_;
+    std::vector<uint32_t> & order_;
+};
+
+// Fire events in a sparse set of firing groups spread over several
+// words of the group occupancy bitmap, adding events to earlier and
+// later groups while firing
+void testSparseGroupFiring()
+{
+    constexpr uint32_t NUM_LINKS = 150;
+
+    sparta::Scheduler sched;
+    sparta::Clock clk("clock", &sched);
+    sparta::RootTreeNode rtn;
+    rtn.setClock(&clk);
+    sparta::EventSet es(&rtn);
+
+    std::vector<uint32_t> order;
+    std::vector<std::unique_ptr<ChainLink>> links;
+    for(uint32_t i = 0; i < NUM_LINKS; ++i) {
+        links.emplace_back(new ChainLink(&es, i, order));
+        if(i > 0) {
+            links[i - 1]->ev >> links[i]->ev;
+        }
+    }
+
+    sched.finalize();
+    rtn.enterConfiguring();
+    rtn.enterFinalized();
+
+    // Link 3 adds later groups (in another bitmap word) in this tick,
+    // link 140 adds the adjacent group, and link 100 adds earlier
+    // groups in the next tick
+    links[3]->to_schedule   = {{links[140].get(), 0}, {links[70].get(), 0}};
+    links[140]->to_schedule = {{links[141].get(), 0}};
+    links[100]->to_schedule = {{links[1].get(), 1}, {links[64].get(), 1}};
+    links[100]->too_early   = links[2].get();
+
+    sched.run(1, true, false);
+    links[100]->ev.schedule();
+    links[3]->ev.schedule();
+    sched.run(1, true, false);
+    EXPECT_TRUE(order == std::vector<uint32_t>({3, 70, 100, 140, 141}));
+
+    order.clear();
+    sched.run(1, true, false);
+    EXPECT_TRUE(order == std::vector<uint32_t>({1, 64}));
+
+    // Nothing left behind in any group
+    order.clear();
+    sched.run(2, true, false);
+    EXPECT_TRUE(order.empty());
+    EXPECT_TRUE(sched.isFinished());
+
+    // A cleared quantum does not leave stale groups behind
+    links[120]->ev.schedule(1);
+    sched.clearEvents();
+    links[5]->ev.schedule(1);
+    sched.run(3, true, false);
+    EXPECT_TRUE(order == std::vector<uint32_t>({5}));
+
+    rtn.enterTeardown();
+}
+
+// Link events after a run while some are still scheduled: the pending
+// events follow their raised groups, so they fire in the new order and
+// can still be found and cancelled
+void testLinkAfterRun()
+{
+    sparta::Scheduler sched;
+    sparta::Clock clk("clock", &sched);
+    sparta::RootTreeNode rtn;
+    rtn.setClock(&clk);
+    sparta::EventSet es(&rtn);
+
+    std::vector<uint32_t> order;
+    std::vector<std::unique_ptr<ChainLink>> links;
+    for(uint32_t i = 0; i < 4; ++i) {
+        links.emplace_back(new ChainLink(&es, i, order));
+    }
+    links[0]->ev >> links[1]->ev;
+    links[2]->ev >> links[3]->ev;
+
+    sched.finalize();
+    rtn.enterConfiguring();
+    rtn.enterFinalized();
+
+    sched.run(1, true, false);
+    links[1]->ev.schedule(1);
+    links[2]->ev.schedule(1);
+    links[3]->ev.schedule(1);
+
+    // Raises links 2 and 3 past link 1
+    EXPECT_TRUE(links[2]->ev.getGroupID() <= links[1]->ev.getGroupID());
+    links[1]->ev >> links[2]->ev;
+    EXPECT_TRUE(links[2]->ev.getGroupID() > links[1]->ev.getGroupID());
+    EXPECT_TRUE(links[3]->ev.getGroupID() > links[2]->ev.getGroupID());
+
+    EXPECT_TRUE(links[2]->ev.isScheduled());
+    EXPECT_TRUE(links[3]->ev.isScheduled());
+    links[3]->ev.cancel();
+    EXPECT_FALSE(links[3]->ev.isScheduled());
+
+    sched.run(2, true, false);
+    EXPECT_TRUE(order == std::vector<uint32_t>({1, 2}));
+    EXPECT_TRUE(sched.isFinished());
+
+    rtn.enterTeardown();
+}
+
 int main()
 {
+    testSparseGroupFiring();
+    testLinkAfterRun();
+
     sparta::Scheduler lsched;
     sparta::Clock clk("clock", &lsched);
     sparta::RootTreeNode rtn("dummyrtn");
@@ -562,6 +562,87 @@ void testScoreboardClearing()
     rtn.enterTeardown();
 }
 
+void testScoreboardWakeup()
+{
+    sparta::RootTreeNode rtn;
+    sparta::Scheduler    sched;
+    sparta::ClockManager cm(&sched);
+    sparta::Clock::Handle root_clk;
+    root_clk = cm.makeRoot(&rtn, "root_clk");
+    cm.normalize();
+    rtn.setClock(root_clk.get());
+
+    sparta::TreeNode cpu(&rtn, "core", "Dummy CPU");
+
+    sparta::ResourceFactory<sparta::Scoreboard,
+                            sparta::Scoreboard::ScoreboardParameters> fact;
+
+    sparta::ResourceTreeNode sbtn(&cpu,
+                                  SB_NAMES[0],
+                                  sparta::TreeNode::GROUP_NAME_NONE,
+                                  sparta::TreeNode::GROUP_IDX_NONE,
+                                  "Test scoreboard",
+                                  &fact);
+
+    sparta::Scoreboard::ScoreboardParameters * params =
+        dynamic_cast<sparta::Scoreboard::ScoreboardParameters *>(sbtn.getParameterSet());
+    params->latency_matrix = GPR_FORWARDING_MATRIX;
+
+    rtn.enterConfiguring();
+    rtn.enterFinalized();
+    sparta::Scoreboard * master_sb = sbtn.getResourceAs<sparta::Scoreboard>();
+    sparta::ScoreboardView view(UNIT_NAMES[0], SB_NAMES[0], &cpu);
+
+    master_sb->clearBits(sparta::Scoreboard::RegisterBitMask().set());
+
+    auto make_bits = [](std::initializer_list<uint32_t> regs) {
+        sparta::Scoreboard::RegisterBitMask bits;
+        for(auto reg : regs) { bits.set(reg); }
+        return bits;
+    };
+
+    std::vector<uint32_t> woken;
+    auto wake = [&woken](uint32_t inst) {
+        return [&woken, inst](const sparta::Scoreboard::RegisterBitMask &) { woken.emplace_back(inst); };
+    };
+
+    view.registerReadyCallback(make_bits({1, 2}),   1, wake(1));
+    view.registerReadyCallback(make_bits({3}),      2, wake(2));
+    view.registerReadyCallback(make_bits({1, 300}), 3, wake(3));
+    view.registerReadyCallback(make_bits({2}),      4, wake(4));
+    view.registerReadyCallback(make_bits({3, 4}),   5, wake(5));
+
+    // Only the waiters whose last operand becomes ready are called
+    master_sb->set(make_bits({1}));
+    EXPECT_TRUE(woken.empty());
+
+    // Called in registration order
+    master_sb->set(make_bits({2, 300}));
+    EXPECT_EQUAL(woken, std::vector<uint32_t>({1, 3, 4}));
+    woken.clear();
+
+    // Clearing a ready operand makes its waiters wait for it again
+    master_sb->set(make_bits({4}));
+    master_sb->clearBits(make_bits({4}));
+    master_sb->set(make_bits({3}));
+    EXPECT_EQUAL(woken, std::vector<uint32_t>({2}));
+    woken.clear();
+
+    // Flushed waiters are never called; their slots are reused
+    view.clearCallbacks(5);
+    view.registerReadyCallback(make_bits({4, 5}), 6, wake(6));
+    master_sb->set(make_bits({4}));
+    EXPECT_TRUE(woken.empty());
+
+    // A waiter that is already ready is called on the next update
+    view.registerReadyCallback(make_bits({1}), 7, wake(7));
+    EXPECT_TRUE(woken.empty());
+    master_sb->set(make_bits({5}));
+    EXPECT_EQUAL(woken, std::vector<uint32_t>({6, 7}));
+
+    rtn.enterTeardown();
+}
+
 void testScoreboardNonCore()
 {
     // testing scoreboard view is able to find scoreboards when there is a non core.*
@@ -615,6 +696,8 @@ int main ()
 
     testScoreboardClearing();
 
+    testScoreboardWakeup();
+
     testScoreboardNonCore();
 
     testPrintBits();
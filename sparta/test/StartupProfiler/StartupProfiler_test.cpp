@@ -0,0 +1,169 @@
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "sparta/kernel/StartupProfiler.hpp"
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/simulation/Clock.hpp"
+#include "sparta/simulation/Resource.hpp"
+#include "sparta/simulation/ResourceFactory.hpp"
+#include "sparta/simulation/ResourceTreeNode.hpp"
+#include "sparta/simulation/RootTreeNode.hpp"
+#include "sparta/simulation/ParameterSet.hpp"
+#include "sparta/utils/SpartaTester.hpp"
+
+TEST_INIT
+
+/*
+ * Tests sparta::StartupProfiler: per-node attribution of startup time
+ * and heap growth in each phase, and its reports.
+ */
+
+namespace
+{
+    void spin(std::chrono::milliseconds duration) {
+        const auto start = std::chrono::steady_clock::now();
+        while (std::chrono::steady_clock::now() - start < duration) {
+        }
+    }
+}
+
+class Unit : public sparta::Resource
+{
+public:
+    static constexpr const char* name = "unit";
+
+    class ParameterSet : public sparta::ParameterSet
+    {
+    public:
+        ParameterSet(sparta::TreeNode* n) :
+            sparta::ParameterSet(n)
+        { }
+
+        PARAMETER(uint32_t, spin_ms, 0, "Time spent constructing the resource")
+        PARAMETER(uint32_t, alloc_bytes, 0, "Bytes allocated by the resource")
+    };
+
+    Unit(sparta::TreeNode* node, const ParameterSet* params) :
+        sparta::Resource(node),
+        data_(params->alloc_bytes, 1)
+    {
+        spin(std::chrono::milliseconds(params->spin_ms));
+    }
+
+private:
+    std::vector<char> data_;
+};
+
+int main()
+{
+    sparta::Scheduler sched;
+    sparta::Clock clk("clock", &sched);
+    sparta::RootTreeNode rtn;
+    rtn.setClock(&clk);
+    sparta::ResourceFactory<Unit, Unit::ParameterSet> fact;
+
+    sparta::StartupProfiler profiler;
+    profiler.activate();
+    EXPECT_EQUAL(sparta::StartupProfiler::getActive(), &profiler);
+    sparta::StartupProfiler other;
+    EXPECT_THROW(other.activate());
+
+    std::vector<std::unique_ptr<sparta::TreeNode>> nodes;
+    sparta::ResourceTreeNode * big = nullptr;
+    sparta::ResourceTreeNode * small = nullptr;
+    sparta::ResourceTreeNode * leaf = nullptr;
+    {
+        sparta::StartupProfiler::PhaseScope phase(&profiler, sparta::StartupProfiler::Phase::Build);
+        EXPECT_THROW(profiler.enteringPhase(sparta::StartupProfiler::Phase::Configure));
+
+        small = new sparta::ResourceTreeNode(&rtn, "small", "Cheap unit", &fact);
+        nodes.emplace_back(small);
+        auto cluster = new sparta::TreeNode(&rtn, "cluster", "Cluster");
+        nodes.emplace_back(cluster);
+        big = new sparta::ResourceTreeNode(cluster, "big", "Expensive unit", &fact);
+        nodes.emplace_back(big);
+        leaf = new sparta::ResourceTreeNode(big, "leaf", "Leaf unit", &fact);
+        nodes.emplace_back(leaf);
+
+        small->getParameterSet()->getParameter("spin_ms")->setValueFromString("2");
+        big->getParameterSet()->getParameter("spin_ms")->setValueFromString("30");
+        big->getParameterSet()->getParameter("alloc_bytes")->setValueFromString(std::to_string(16 << 20));
+        leaf->getParameterSet()->getParameter("spin_ms")->setValueFromString("10");
+    }
+    {
+        sparta::StartupProfiler::PhaseScope phase(&profiler, sparta::StartupProfiler::Phase::Configure);
+        rtn.enterConfiguring();
+    }
+    {
+        sparta::StartupProfiler::PhaseScope phase(&profiler, sparta::StartupProfiler::Phase::Finalize);
+        rtn.enterFinalized();
+    }
+    {
+        sparta::StartupProfiler::PhaseScope phase(&profiler, sparta::StartupProfiler::Phase::Bind);
+        rtn.bindTreeEarly();
+        spin(std::chrono::milliseconds(5)); // Not attributed to any node
+        rtn.bindTreeLate();
+    }
+
+    // Outside of any phase: not charged
+    const sparta::TreeNode outside("outside", "Node profiled outside of a phase");
+    {
+        sparta::StartupProfiler::NodeScope scope(&outside);
+        spin(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQUAL(profiler.getNodeCosts(&outside), nullptr);
+
+    profiler.deactivate();
+    EXPECT_EQUAL(sparta::StartupProfiler::getActive(), nullptr);
+
+    const size_t FINALIZE = static_cast<size_t>(sparta::StartupProfiler::Phase::Finalize);
+    const size_t BIND = static_cast<size_t>(sparta::StartupProfiler::Phase::Bind);
+    const auto & phases = profiler.getPhaseCosts();
+    EXPECT_TRUE(phases[FINALIZE].time >= std::chrono::milliseconds(42));
+    EXPECT_TRUE(phases[BIND].time >= std::chrono::milliseconds(5));
+
+    // Costs are exclusive of nested nodes
+    EXPECT_NOTEQUAL(profiler.getNodeCosts(big), nullptr);
+    EXPECT_NOTEQUAL(profiler.getNodeCosts(leaf), nullptr);
+    EXPECT_NOTEQUAL(profiler.getNodeCosts(small), nullptr);
+    const auto & big_costs = (*profiler.getNodeCosts(big))[FINALIZE];
+    const auto & leaf_costs = (*profiler.getNodeCosts(leaf))[FINALIZE];
+    const auto & small_costs = (*profiler.getNodeCosts(small))[FINALIZE];
+    EXPECT_TRUE(big_costs.time >= std::chrono::milliseconds(30));
+    EXPECT_TRUE(big_costs.time + leaf_costs.time + small_costs.time <= phases[FINALIZE].time);
+    EXPECT_TRUE(leaf_costs.time >= std::chrono::milliseconds(10));
+    EXPECT_TRUE(small_costs.time < leaf_costs.time);
+    if (sparta::StartupProfiler::measuresAllocations()) {
+        EXPECT_TRUE(big_costs.alloc_bytes >= (16 << 20));
+        EXPECT_TRUE(phases[FINALIZE].alloc_bytes >= (16 << 20));
+        EXPECT_TRUE(small_costs.alloc_bytes < (1 << 20));
+    }
+
+    // Most expensive subtrees first
+    std::stringstream report;
+    profiler.writeReport(report, &rtn);
+    std::cout << report.str() << std::endl;
+    const std::string report_str = report.str();
+    EXPECT_NOTEQUAL(report_str.find("finalize"), std::string::npos);
+    EXPECT_NOTEQUAL(report_str.find(" top\n"), std::string::npos);
+    EXPECT_TRUE(report_str.find("cluster") < report_str.find("small"));
+    EXPECT_TRUE(report_str.find("big") < report_str.find("leaf"));
+
+    std::stringstream json;
+    profiler.writeJSON(json, &rtn);
+    const std::string json_str = json.str();
+    EXPECT_NOTEQUAL(json_str.find("\"location\": \"top.cluster.big.leaf\""), std::string::npos);
+    EXPECT_NOTEQUAL(json_str.find("\"phases\": {\"build\": {\"time_s\": "), std::string::npos);
+    EXPECT_TRUE(json_str.find("top.cluster") < json_str.find("top.small"));
+
+    rtn.enterTeardown();
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
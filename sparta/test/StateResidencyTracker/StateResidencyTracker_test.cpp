@@ -1,6 +1,8 @@
 #include <iostream>
+#include <fstream>
 #include <inttypes.h>
 #include <memory>
+#include <sstream>
 #include "sparta/sparta.hpp"
 #include "sparta/kernel/Scheduler.hpp"
 #include "sparta/events/Event.hpp"
@@ -100,6 +102,57 @@ public:
     }
 };
 
+// Recycling and teardown of a StatePool, used directly so that its
+// tracking file can be checked
+void testStatePool(sparta::Scheduler & sched)
+{
+    const std::string filename = "state_pool_test.txt";
+    std::ofstream(filename, std::ios::trunc).close();
+
+    sparta::tracker::state_tracker_ptr<OperandState> orphan;
+    {
+        sparta::tracker::StatePool<OperandState> pool(filename);
+        auto a = pool.getNewStateTrackerUnit(&sched);
+        auto b = pool.getNewStateTrackerUnit(&sched);
+        auto c = pool.getNewStateTrackerUnit(&sched);
+        a->startState(OperandState::OPER_READY);
+        b->startState(OperandState::OPER_WAIT);
+        c->startState(OperandState::OPER_RETIRE);
+        sched.run(3, true, false);
+
+        // A released unit is dispatched again, keeping its totals
+        const auto * b_unit = b.get();
+        b.reset();
+        auto d = pool.getNewStateTrackerUnit(&sched);
+        EXPECT_TRUE(d.get() == b_unit);
+        EXPECT_EQUAL(d->getStateSet().state_delta_set[static_cast<uint32_t>(OperandState::OPER_WAIT)], 3);
+        d->startState(OperandState::OPER_INIT);
+
+        // None available, so this is a new unit. It is held past the pool
+        orphan = pool.getNewStateTrackerUnit(&sched);
+        orphan->startState(OperandState::OPER_INIT);
+        sched.run(2, true, false);
+
+        // Released out of dispatch order: the last dispatched unit is
+        // moved into each released unit's place
+        c.reset();
+        a.reset();
+        d.reset();
+    }
+
+    // Units still held are orphaned and freed when released
+    EXPECT_NOTHROW(orphan->startState(OperandState::OPER_WAIT));
+    EXPECT_NOTHROW(orphan.reset());
+
+    // Only the units returned to the pool are aggregated
+    std::ifstream data_file(filename);
+    std::stringstream contents;
+    contents << data_file.rdbuf();
+    EXPECT_NOTEQUAL(contents.str().find("Total State Tracker Units used : 5\n"), std::string::npos);
+    EXPECT_NOTEQUAL(contents.str().find("Aggregate Residency Stats: \n : 2\n : 5\n : 3\n : 5\n"),
+                    std::string::npos);
+}
+
 int main()
 {
     sparta::Scheduler sched;
@@ -403,6 +456,8 @@ int main()
         EXPECT_EQUAL(observer_2.getState().getRawAccumulatedTime(), agg_vec);
     }
 
+    testStatePool(sched);
+
     REPORT_ERROR
     return ERROR_CODE;
 }
@@ -3,16 +3,18 @@
 
 #include "Dummy_device.hpp"
 #include <iostream>
+#include <algorithm>
 #include <cstring>
 #include "sparta/simulation/Clock.hpp"
 #include "sparta/simulation/ClockManager.hpp"
 #include "sparta/utils/SpartaTester.hpp"
 
 template<class EnumClassT>
-std::string generateHistogramString(EnumClassT state_enum, std::vector<uint32_t> & values)
+std::string generateHistogramString(EnumClassT state_enum, std::vector<uint32_t> & values,
+                                    const std::string & unit_name = "state_timer_unit_1")
 {
     std::stringstream histo_string;
-    std::string name = std::string("state_timer_unit_1_histogram_set_") + typeid(state_enum).name() + "_state_" + std::to_string(static_cast<uint32_t>(state_enum));
+    std::string name = unit_name + "_histogram_set_" + typeid(state_enum).name() + "_state_" + std::to_string(static_cast<uint32_t>(state_enum));
     histo_string << "\t" <<  name << "[ UF ] = " << std::to_string(values[0]) << std::endl;
     for (uint32_t i=0; i<=5; ++i) {
         histo_string << "\t" << name
@@ -53,6 +55,10 @@ int main()
     EXPECT_THROW(sparta::StateTimerUnit state_timer_unit_1(&rtn, "state_timer_unit_1", "state_timer_unit_1",
                 2, 0, 5, 1, DummyState1::__LAST,DummyState1::__LAST));  // Should not add same state set more than once
 
+    // Destroyed while one of its timers is still held (section 4)
+    std::unique_ptr<sparta::StateTimerUnit> state_timer_unit_2(new sparta::StateTimerUnit(&rtn, "state_timer_unit_2",
+                "state_timer_unit_2", 2, 0, 5, 1, DummyState1::__LAST));
+
     rtn.enterConfiguring();
     rtn.enterFinalized();
     clk.getScheduler()->finalize();
@@ -68,7 +74,7 @@ int main()
         std::shared_ptr<sparta::StateTimerUnit::StateTimer> state_timer_1;
         std::shared_ptr<sparta::StateTimerUnit::StateTimer> state_timer_2;
         // cycle 1
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
         std::cout << std::endl << "Cycle: " << clk.currentCycle()<< "--------------------------------------------------" << std::endl;
 
         // allocate timers
@@ -107,29 +113,29 @@ int main()
         EXPECT_THROW(*state_timer_1 = DummyState1::DS1_1);   // State already started.
 
         // cycle 2
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
         std::cout << std::endl << "Cycle: " << clk.currentCycle()<< "--------------------------------------------------" << std::endl;
 
         // cycle 3
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
         std::cout << std::endl << "Cycle: " << clk.currentCycle()<< "--------------------------------------------------" << std::endl;
 
         *state_timer_1 = DummyState1::DS1_2;
         std::cout << "state_timer_1 State: DummyState1::DS1_2 ("<< static_cast<uint32_t>(DummyState1::DS1_2) <<"), start" << std::endl;
 
         // cycle 4
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
         std::cout << std::endl << "Cycle: " << clk.currentCycle()<< "--------------------------------------------------" << std::endl;
 
         state_timer_2->endState(DummyState1::DS1_1);
         std::cout << "state_timer_2 State: DummyState1::DS1_1 ("<< static_cast<uint32_t>(DummyState1::DS1_1) <<"), end" << std::endl;
 
         // cycle 5
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
         std::cout << std::endl << "Cycle: " << clk.currentCycle()<< "--------------------------------------------------" << std::endl;
 
         // cycle 6
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
         std::cout << std::endl << "Cycle: " << clk.currentCycle()<< "--------------------------------------------------" << std::endl;
 
         std::cout << "dynamicQuery()" << std::endl;
@@ -160,7 +166,7 @@ int main()
         std::shared_ptr<sparta::StateTimerUnit::StateTimer> state_timer_1;
         std::shared_ptr<sparta::StateTimerUnit::StateTimer> state_timer_2;
         // cycle 7
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
 
         // allocate timer for dummy_op_1 at cycle 7, and send it to dummy_device1
         DummyOpPtr dummy_op_1 = DummyOpPtr(new DummyOp(1));
@@ -189,7 +195,7 @@ int main()
 
 
         // cycle 8
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
 
         // allocate timer for dummy_op_2 at cycle 8, and send it to dummy_device1
         DummyOpPtr dummy_op_2 = DummyOpPtr(new DummyOp(2));
@@ -200,22 +206,22 @@ int main()
         std::cout << "dummy_op_2 sent to dummy_device1" << " at Cycle: "<< clk.currentCycle() << std::endl;
 
         //cycle 9
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
 
         //cycle 10
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
 
         //cycle 11
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
 
         // cycle 12
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
 
         // cycle 13
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
 
         // cycle 14
-        clk.getScheduler()->run(1);
+        clk.getScheduler()->run(1, true, false);
 
         // dynamic query
         std::cout << "dynamicQuery()" << " at Cycle: "<< clk.currentCycle() << std::endl;
@@ -238,5 +244,53 @@ int main()
         // teardown will automatically release inflight StateTimers
         rtn.enterTeardown();
     }
-    return 0;
+
+    //////////////////////////////////////////////////////
+    // 4.Test timer recycling and destroying the unit first
+    //////////////////////////////////////////////////////
+
+    std::cout << std::endl << "Start Timer Recycling Test-------------------------------------------------" << std::endl;
+    {
+        // Grows the pool from 2 to 4 timers
+        std::vector<sparta::StateTimerUnit::StateTimer::Handle> timers;
+        for (uint32_t i = 0; i < 4; ++i) {
+            timers.emplace_back(state_timer_unit_2->allocateStateTimer());
+            *timers.back() = DummyState1::DS1_1;
+        }
+        clk.getScheduler()->run(2, true, false);
+
+        // Released out of allocation order, so the last active timer is
+        // moved into each released timer's place
+        std::vector<sparta::StateTimerUnit::StateTimer *> released = {timers[1].get(), timers[0].get()};
+        timers[1].reset();
+        timers[0].reset();
+
+        // Released timers are reused before the pool grows
+        std::vector<sparta::StateTimerUnit::StateTimer::Handle> recycled;
+        for (uint32_t i = 0; i < 2; ++i) {
+            recycled.emplace_back(state_timer_unit_2->allocateStateTimer());
+            EXPECT_TRUE(std::find(released.begin(), released.end(), recycled.back().get()) != released.end());
+            *recycled.back() = DummyState1::DS1_2;
+        }
+        clk.getScheduler()->run(1, true, false);
+
+        // Released: 2, 2.  Still active: 3, 3 (moved timers) and 0, 0 (recycled)
+        histo_val = {0,2,2,4,6,6,6,6};
+        EXPECT_EQUAL(state_timer_unit_2->dynamicQuery(DummyState1::DS1_1),
+                     generateHistogramString(DummyState1::DS1_1, histo_val, "state_timer_unit_2"));
+        histo_val = {0,4,6,6,6,6,6,6};
+        EXPECT_EQUAL(state_timer_unit_2->dynamicQuery(DummyState1::DS1_2),
+                     generateHistogramString(DummyState1::DS1_2, histo_val, "state_timer_unit_2"));
+
+        // The unit releases the timer still held, and the Handle no
+        // longer refers to the pool once it is gone
+        sparta::StateTimerUnit::StateTimer::Handle survivor = timers[2];
+        timers.clear();
+        recycled.clear();
+        state_timer_unit_2.reset();
+        EXPECT_NOTHROW(survivor.reset());
+    }
+
+    REPORT_ERROR;
+    return ERROR_CODE;
 }
@@ -0,0 +1,179 @@
+
+#include <iostream>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sparta/simulation/Clock.hpp"
+#include "sparta/simulation/Resource.hpp"
+#include "sparta/simulation/ResourceFactory.hpp"
+#include "sparta/simulation/ResourceTreeNode.hpp"
+#include "sparta/simulation/RootTreeNode.hpp"
+#include "sparta/simulation/ParameterSet.hpp"
+#include "sparta/kernel/Scheduler.hpp"
+#include "sparta/utils/SpartaTester.hpp"
+
+TEST_INIT
+
+/*
+ * Tests ResourceFactoryBase::prepareResource and finalizing a tree with
+ * multiple threads: the finalized tree and the errors reported must not
+ * depend on the number of threads.
+ */
+
+namespace
+{
+    constexpr uint32_t NUM_UNITS = 64;
+
+    std::mutex order_mutex;
+    std::vector<std::string> construction_order;
+
+    //! Threads which ran parameter validation callbacks
+    std::vector<std::thread::id> validation_threads;
+}
+
+class TableUnit : public sparta::Resource
+{
+public:
+    static constexpr const char* name = "table_unit";
+
+    class ParameterSet : public sparta::ParameterSet
+    {
+    public:
+        ParameterSet(sparta::TreeNode* n) :
+            sparta::ParameterSet(n)
+        {
+            auto non_zero = [](uint32_t & val, const sparta::TreeNode*) -> bool {
+                std::lock_guard<std::mutex> lock(order_mutex);
+                validation_threads.push_back(std::this_thread::get_id());
+                return val != 0;
+            };
+            num_entries.addDependentValidationCallback(non_zero, "num_entries must be non-zero");
+        }
+
+        PARAMETER(uint32_t, num_entries, 16, "Number of table entries")
+        PARAMETER(uint32_t, seed, 1, "Table seed. 0 fails to prepare")
+
+        //! Built by prepareResource
+        std::vector<uint64_t> table;
+        uint32_t num_prepares = 0;
+    };
+
+    static void prepareResource(const sparta::TreeNode* node, ParameterSet* params) {
+        if(params->seed == 0){
+            throw sparta::SpartaException("Cannot build table for ") << node->getLocation();
+        }
+        params->table.clear();
+        uint64_t val = params->seed;
+        for(uint32_t i = 0; i < params->num_entries; ++i){
+            val = val * 6364136223846793005ull + 1442695040888963407ull;
+            params->table.push_back(val);
+        }
+        ++params->num_prepares;
+    }
+
+    TableUnit(sparta::TreeNode* node, const ParameterSet* params) :
+        sparta::Resource(node),
+        table(params->table),
+        num_prepares(params->num_prepares)
+    {
+        std::lock_guard<std::mutex> lock(order_mutex);
+        construction_order.push_back(node->getLocation());
+    }
+
+    const std::vector<uint64_t> table;
+    const uint32_t num_prepares;
+};
+
+struct TestTree
+{
+    explicit TestTree(uint32_t num_threads) :
+        clk("clock", &sched)
+    {
+        rtn.setClock(&clk);
+        rtn.setNumFinalizeThreads(num_threads);
+        for(uint32_t i = 0; i < NUM_UNITS; ++i){
+            auto * cluster = nodes.emplace_back(new sparta::ResourceTreeNode(&rtn, "unit" + std::to_string(i),
+                                                                              "unit", i, "A unit", &fact)).get();
+            cluster->getParameterSet()->getParameter("seed")->setValueFromString(std::to_string(i + 1));
+            cluster->getParameterSet()->getParameter("num_entries")->setValueFromString(std::to_string(8 + i));
+            nodes.emplace_back(new sparta::ResourceTreeNode(cluster, "sub", "A sub-unit", &fact));
+        }
+        rtn.enterConfiguring();
+    }
+
+    ~TestTree() {
+        rtn.enterTeardown();
+    }
+
+    sparta::Scheduler sched;
+    sparta::Clock clk;
+    sparta::RootTreeNode rtn;
+    sparta::ResourceFactory<TableUnit, TableUnit::ParameterSet> fact;
+    std::vector<std::unique_ptr<sparta::ResourceTreeNode>> nodes;
+};
+
+int main()
+{
+    std::vector<std::string> serial_order;
+    std::vector<std::vector<uint64_t>> serial_tables;
+    {
+        TestTree tree(1);
+        EXPECT_EQUAL(tree.rtn.getNumFinalizeThreads(), 1);
+        construction_order.clear();
+        EXPECT_NOTHROW(tree.rtn.enterFinalized());
+        serial_order = construction_order;
+        for(auto & n : tree.nodes){
+            serial_tables.push_back(n->getResourceAs<TableUnit*>()->table);
+            EXPECT_EQUAL(n->getResourceAs<TableUnit*>()->num_prepares, 1);
+        }
+    }
+    EXPECT_EQUAL(serial_order.size(), NUM_UNITS * 2);
+    EXPECT_EQUAL(serial_order.front(), "top.unit0");
+    EXPECT_EQUAL(serial_order.at(1), "top.unit0.sub");
+    EXPECT_EQUAL(serial_tables.front().size(), 8);
+
+    // Same resources, constructed in the same order, with any thread count.
+    // Parameters are always validated on the finalizing thread
+    for(const uint32_t num_threads : {2u, 4u, 16u}){
+        TestTree tree(num_threads);
+        construction_order.clear();
+        validation_threads.clear();
+        EXPECT_NOTHROW(tree.rtn.enterFinalized());
+        EXPECT_TRUE(construction_order == serial_order);
+        EXPECT_EQUAL(validation_threads.size(), NUM_UNITS * 2);
+        for(const std::thread::id & id : validation_threads){
+            EXPECT_TRUE(id == std::this_thread::get_id());
+        }
+        for(uint32_t i = 0; i < tree.nodes.size(); ++i){
+            EXPECT_TRUE(tree.nodes[i]->getResourceAs<TableUnit*>()->table == serial_tables[i]);
+            EXPECT_EQUAL(tree.nodes[i]->getResourceAs<TableUnit*>()->num_prepares, 1);
+        }
+    }
+
+    // Errors from prepareResource and parameter validation are reported for
+    // the first failing node in tree order
+    for(const uint32_t num_threads : {1u, 4u}){
+        TestTree tree(num_threads);
+        tree.rtn.getChildAs<sparta::ResourceTreeNode>("unit40")->getParameterSet()->
+            getParameter("seed")->setValueFromString("0");
+        tree.rtn.getChildAs<sparta::ResourceTreeNode>("unit9.sub")->getParameterSet()->
+            getParameter("num_entries")->setValueFromString("0");
+        tree.rtn.getChildAs<sparta::ResourceTreeNode>("unit7")->getParameterSet()->
+            getParameter("seed")->setValueFromString("0");
+        try{
+            tree.rtn.enterFinalized();
+            EXPECT_TRUE(false); // Should have thrown
+        }catch(sparta::SpartaException & ex){
+            EXPECT_NOTEQUAL(std::string(ex.what()).find("Cannot build table for top.unit7"), std::string::npos);
+        }
+        EXPECT_THROW(tree.rtn.getChildAs<sparta::ResourceTreeNode>("unit7")->finalize()); // Prepared again on retry
+        EXPECT_THROW(tree.rtn.getChildAs<sparta::ResourceTreeNode>("unit9.sub")->finalize());
+    }
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
@@ -0,0 +1,115 @@
+
+#include <iostream>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/timer/timer.hpp>
+
+#include "sparta/simulation/TreeNode.hpp"
+#include "sparta/simulation/RootTreeNode.hpp"
+#include "sparta/utils/SpartaTester.hpp"
+
+TEST_INIT
+
+/*
+ * Startup benchmark: build a synthetic wide and deep tree (like a
+ * many-core SoC), look nodes up by path and by group, then tear the
+ * tree down.
+ */
+
+namespace
+{
+    constexpr uint32_t NUM_CORES   = 16;
+    constexpr uint32_t NUM_UNITS   = 50;  // Per core
+    constexpr uint32_t NUM_ENTRIES = 240; // Per unit, all in one group
+    constexpr uint32_t NUM_LOOKUPS = 200000;
+    constexpr uint32_t NUM_PATTERN_SEARCHES = 200;
+
+    double seconds(const boost::timer::cpu_timer & t) {
+        return t.elapsed().user / 1000000000.0;
+    }
+}
+
+int main()
+{
+    std::vector<std::unique_ptr<sparta::TreeNode>> nodes;
+    nodes.reserve(NUM_CORES * NUM_UNITS * (NUM_ENTRIES + 1) + NUM_CORES);
+
+    sparta::RootTreeNode rtn;
+
+    boost::timer::cpu_timer build_timer;
+    for (uint32_t c = 0; c < NUM_CORES; ++c) {
+        sparta::TreeNode * core = new sparta::TreeNode(&rtn, "core" + std::to_string(c), "core", c, "A core");
+        nodes.emplace_back(core);
+        for (uint32_t u = 0; u < NUM_UNITS; ++u) {
+            sparta::TreeNode * unit = new sparta::TreeNode(core, "unit" + std::to_string(u), "A unit");
+            nodes.emplace_back(unit);
+            for (uint32_t e = 0; e < NUM_ENTRIES; ++e) {
+                nodes.emplace_back(new sparta::TreeNode(unit, "entry" + std::to_string(e), "entry", e, "An entry"));
+            }
+        }
+    }
+    build_timer.stop();
+
+    const uint64_t num_nodes = nodes.size();
+    std::vector<sparta::TreeNode*> cores;
+    EXPECT_EQUAL(rtn.getGroup("core", cores), NUM_CORES);
+    EXPECT_TRUE(sparta::TreeNode::isNodeConstructed(nodes.back().get()));
+
+    // Lookups through each level of the tree
+    boost::timer::cpu_timer lookup_timer;
+    uint64_t found = 0;
+    for (uint32_t i = 0; i < NUM_LOOKUPS; ++i) {
+        const uint32_t c = i % NUM_CORES;
+        const uint32_t u = (i / NUM_CORES) % NUM_UNITS;
+        const uint32_t e = (i * 7) % NUM_ENTRIES;
+        const std::string path = "core" + std::to_string(c) + ".unit" + std::to_string(u) + ".entry" + std::to_string(e);
+        found += (rtn.getChild(path, false) != nullptr);
+    }
+    lookup_timer.stop();
+    EXPECT_EQUAL(found, NUM_LOOKUPS);
+
+    // Children iterate in construction order and groups in index order
+    sparta::TreeNode * unit = rtn.getChild("core3.unit7");
+    EXPECT_EQUAL(unit->getChildren().front()->getName(), "entry0");
+    EXPECT_EQUAL(unit->getChildren().back()->getName(), "entry" + std::to_string(NUM_ENTRIES - 1));
+    std::vector<sparta::TreeNode*> group;
+    EXPECT_EQUAL(unit->getGroup("entry", group), NUM_ENTRIES);
+    EXPECT_EQUAL(group.at(5)->getGroupIdx(), 5);
+
+    std::vector<sparta::TreeNode*> matches;
+    EXPECT_EQUAL(rtn.findChildren("core*.unit1.entry12", matches), NUM_CORES);
+
+    // Wildcard searches, as done when applying configuration files and
+    // report definitions
+    boost::timer::cpu_timer pattern_timer;
+    uint64_t num_matched = 0;
+    for (uint32_t i = 0; i < NUM_PATTERN_SEARCHES; ++i) {
+        const std::string pattern = "core*.unit" + std::to_string(i % NUM_UNITS) + ".entry1?";
+        matches.clear();
+        num_matched += rtn.findChildren(pattern, matches);
+    }
+    pattern_timer.stop();
+    EXPECT_EQUAL(num_matched, NUM_PATTERN_SEARCHES * NUM_CORES * 11);
+
+    rtn.enterTeardown();
+
+    boost::timer::cpu_timer teardown_timer;
+    sparta::TreeNode * last = nodes.back().get();
+    while (!nodes.empty()) {
+        nodes.pop_back(); // Children before parents
+    }
+    teardown_timer.stop();
+    EXPECT_FALSE(sparta::TreeNode::isNodeConstructed(last));
+
+    std::cout << "Tree of " << num_nodes << " nodes:" << std::endl
+              << "  build:    " << seconds(build_timer) << " sec" << std::endl
+              << "  " << NUM_LOOKUPS << " lookups: " << seconds(lookup_timer) << " sec" << std::endl
+              << "  " << NUM_PATTERN_SEARCHES << " pattern searches: " << seconds(pattern_timer) << " sec" << std::endl
+              << "  teardown: " << seconds(teardown_timer) << " sec" << std::endl;
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
@@ -1,6 +1,8 @@
 #include <memory>
 #include <unordered_map>
 #include <map>
+#include <random>
+#include <regex>
 #include "sparta/utils/Utils.hpp"
 #include "sparta/utils/MathUtils.hpp"
 #include "sparta/utils/Bits.hpp"
@@ -9,6 +11,8 @@
 #include "sparta/utils/StringUtils.hpp"
 #include "sparta/utils/LifeTracker.hpp"
 #include "sparta/utils/SpartaAssert.hpp"
+#include "sparta/utils/GlobPattern.hpp"
+#include "sparta/simulation/TreeNode.hpp"
 
 TEST_INIT
 
@@ -72,6 +76,73 @@ void testLifeTracker()
     }
 }
 
+// GlobPattern must agree with the regex generated by
+// TreeNode::createSearchRegexPattern, including wildcard captures
+bool globMatchesRegex(const std::string & pattern, const std::string & str)
+{
+    const std::regex expr(sparta::TreeNode::createSearchRegexPattern(pattern));
+    std::smatch what;
+    const bool regex_matched = std::regex_match(str, what, expr);
+    std::vector<std::string> regex_captures;
+    for (uint32_t i = 1; regex_matched && i < what.size(); ++i) {
+        regex_captures.push_back(what[i].str());
+    }
+
+    const sparta::utils::GlobPattern glob(pattern);
+    std::vector<std::string> glob_captures;
+    const bool glob_matched = glob.match(str, glob_captures);
+    if (glob_matched != regex_matched || glob_captures != regex_captures) {
+        std::cerr << "GlobPattern \"" << pattern << "\" disagrees with regex on \"" << str << "\"" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void testGlobPattern()
+{
+    using sparta::utils::GlobPattern;
+
+    EXPECT_TRUE(GlobPattern("core*").match("core0"));
+    EXPECT_TRUE(GlobPattern("core*").match("core"));
+    EXPECT_FALSE(GlobPattern("core+").match("core"));
+    EXPECT_TRUE(GlobPattern("core?").match("core1"));
+    EXPECT_FALSE(GlobPattern("core?").match("core12"));
+    EXPECT_TRUE(GlobPattern("core0").match("core0"));
+    EXPECT_FALSE(GlobPattern("core0").match("core01"));
+    EXPECT_FALSE(GlobPattern("core0").hasWildcards());
+    EXPECT_TRUE(GlobPattern("a(b)[c]").match("a(b)[c]"));
+
+    std::vector<std::string> captures;
+    EXPECT_TRUE(GlobPattern("c*e+_*").match("core_x_y", captures));
+    EXPECT_TRUE(captures == std::vector<std::string>({"or", "_x", "y"}));
+
+    // Cached compilation returns the same pattern object
+    EXPECT_EQUAL(GlobPattern::get("unit*").get(), GlobPattern::get("unit*").get());
+
+    // Characters that are special in the generated regex fall back to it
+    EXPECT_TRUE(GlobPattern::get("a|b")->match("b"));
+    EXPECT_TRUE(GlobPattern::get("a.c")->match("abc"));
+
+    // Randomized agreement with the regex implementation
+    std::mt19937 gen(7);
+    const std::string pat_chars = "ab_*?+()";
+    const std::string str_chars = "ab_()";
+    auto random_string = [&gen](const std::string & chars, uint32_t max_len) {
+        std::string s(std::uniform_int_distribution<uint32_t>(0, max_len)(gen), ' ');
+        for (auto & c : s) {
+            c = chars[std::uniform_int_distribution<size_t>(0, chars.size() - 1)(gen)];
+        }
+        return s;
+    };
+    uint32_t disagreements = 0;
+    for (uint32_t i = 0; i < 20000; ++i) {
+        const std::string pattern = random_string(pat_chars, 6);
+        const std::string str = random_string(str_chars, 8);
+        disagreements += !globMatchesRegex(pattern, str);
+    }
+    EXPECT_EQUAL(disagreements, 0);
+}
+
 int main()
 {
     auto u_map = std::unordered_map<std::string, int>{{"Key1", 1}, {"Key2", 2}, {"Key3", 3}};
@@ -87,6 +158,7 @@ int main()
     EXPECT_TRUE(flipper_map2["Key12"] == 12);
     
     testLifeTracker();
+    testGlobPattern();
 
     // testing checked casting of pointers and shared pointers
     auto b = std::make_shared<B>();
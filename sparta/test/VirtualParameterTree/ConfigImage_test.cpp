@@ -0,0 +1,99 @@
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "sparta/app/ConfigImage.hpp"
+#include "sparta/app/SimulationConfiguration.hpp"
+#include "sparta/simulation/ParameterTree.hpp"
+#include "sparta/utils/SpartaTester.hpp"
+
+TEST_INIT
+
+/*
+ * Tests saving the unbound parameter trees of a SimulationConfiguration to a
+ * ConfigImage and loading them back without parsing configuration files.
+ */
+
+namespace
+{
+    void writeFile(const std::string & filename, const std::string & content) {
+        std::ofstream out(filename);
+        out << content;
+    }
+
+    std::string printTree(const sparta::ParameterTree & ptree) {
+        std::stringstream ss;
+        ptree.recursePrint(ss);
+        return ss.str();
+    }
+
+    const std::string IMAGE = "config_image_test.cfgimg";
+    constexpr uint64_t KEY = 0x1234;
+}
+
+int main()
+{
+    writeFile("config_image_inc.yaml", "top.core0.params.depth: 8\n");
+    writeFile("config_image_arch.yaml",
+              "top:\n"
+              "  core*.params.width: 4\n"
+              "  core1.params.width: 2\n");
+    writeFile("config_image.yaml",
+              "include: config_image_inc.yaml\n"
+              "top.core*.params.mode: fast\n");
+
+    sparta::app::SimulationConfiguration cfg;
+    cfg.addArchSearchPath("./");
+    cfg.processArch("", "config_image_arch.yaml");
+    cfg.processConfigFile("", "config_image.yaml");
+    cfg.processParameter("top.core1.params.mode", "slow");
+    cfg.processParameter("top.core*.params.depth", "16");
+    cfg.saveConfigImage(IMAGE, KEY);
+
+    // Same trees, in the same order, without parsing
+    sparta::app::SimulationConfiguration loaded;
+    EXPECT_FALSE(loaded.loadConfigImage(IMAGE, KEY + 1));
+    EXPECT_FALSE(loaded.loadConfigImage("no_such_image.cfgimg", KEY));
+    EXPECT_TRUE(loaded.loadConfigImage(IMAGE, KEY));
+    EXPECT_EQUAL(printTree(loaded.getArchUnboundParameterTree()), printTree(cfg.getArchUnboundParameterTree()));
+    EXPECT_EQUAL(printTree(loaded.getUnboundParameterTree()), printTree(cfg.getUnboundParameterTree()));
+    EXPECT_EQUAL(loaded.stringizeRunMetadata(), "arch=config_image_arch.yaml");
+
+    const auto & arch = loaded.getArchUnboundParameterTree();
+    EXPECT_EQUAL(arch.get("top.core1.params.width").getValue(), "2");
+    EXPECT_EQUAL(arch.get("top.core3.params.width").getValue(), "4");
+    const auto & ptree = loaded.getUnboundParameterTree();
+    EXPECT_EQUAL(ptree.get("top.core0.params.depth").getValue(), "16");
+    EXPECT_EQUAL(ptree.get("top.core1.params.mode").getValue(), "slow");
+    EXPECT_EQUAL(ptree.get("top.core2.params.mode").getValue(), "fast");
+    EXPECT_EQUAL(ptree.get("top.core2.params.mode").getOrigin(), cfg.getUnboundParameterTree().get("top.core2.params.mode").getOrigin());
+    EXPECT_TRUE(ptree.isRequired("top.core2.params.mode"));
+
+    // Included files are dependencies of the image
+    auto image = sparta::app::ConfigImage::load(IMAGE, KEY);
+    EXPECT_NOTEQUAL(image.get(), nullptr);
+    EXPECT_EQUAL(image->getDependencies().size(), 3);
+    EXPECT_TRUE(image->isUpToDate());
+
+    writeFile("config_image_inc.yaml", "top.core0.params.depth: 9\n");
+    EXPECT_FALSE(image->isUpToDate());
+    sparta::app::SimulationConfiguration stale;
+    EXPECT_FALSE(stale.loadConfigImage(IMAGE, KEY));
+    EXPECT_EQUAL(stale.getUnboundParameterTree().getRoot()->getChildren().size(), 0);
+
+    // Truncated images are rejected
+    writeFile("config_image_inc.yaml", "top.core0.params.depth: 8\n");
+    EXPECT_NOTEQUAL(sparta::app::ConfigImage::load(IMAGE, KEY).get(), nullptr);
+    std::string content;
+    {
+        std::ifstream in(IMAGE, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    writeFile(IMAGE, content.substr(0, content.size() - 3));
+    EXPECT_EQUAL(sparta::app::ConfigImage::load(IMAGE, KEY).get(), nullptr);
+
+    REPORT_ERROR;
+    return ERROR_CODE;
+}
@@ -0,0 +1,76 @@
+// <sparta_log_render> -*- C++ -*-
+
+
+/*!
+ * \file sparta_log_render.cpp
+ * \brief Renders a binary (".log.bin") SPARTA log into text
+ *
+ * Usage: sparta_log_render <in.log.bin> [out.log] [--format default|basic|raw]
+ *
+ * Without an output file the text is written to stdout.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "sparta/log/BinaryFormatter.hpp"
+
+namespace
+{
+    int usage(const char* exe)
+    {
+        std::cerr << "Usage: " << exe << " <in.log.bin> [out.log] [--format default|basic|raw]\n"
+                  << "Renders a binary SPARTA log into the text format written by the\n"
+                  << "equivalent text destination (default: \"default\")" << std::endl;
+        return 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string in_file;
+    std::string out_file;
+    std::string format = "default";
+
+    for(int i = 1; i < argc; ++i){
+        if(std::strcmp(argv[i], "--format") == 0 && i + 1 < argc){
+            format = argv[++i];
+        }else if(std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0){
+            return usage(argv[0]);
+        }else if(in_file.empty()){
+            in_file = argv[i];
+        }else if(out_file.empty()){
+            out_file = argv[i];
+        }else{
+            return usage(argv[0]);
+        }
+    }
+    if(in_file.empty()){
+        return usage(argv[0]);
+    }
+
+    try{
+        const auto fmt = sparta::log::BinaryLogRenderer::parseFormat(format);
+
+        std::ifstream in(in_file, std::ios::binary);
+        if(!in){
+            throw sparta::SpartaException("Could not open \"") << in_file << "\"";
+        }
+
+        if(out_file.empty()){
+            sparta::log::BinaryLogRenderer::render(in, std::cout, fmt);
+        }else{
+            std::ofstream out(out_file);
+            if(!out){
+                throw sparta::SpartaException("Could not open \"") << out_file << "\" for write";
+            }
+            sparta::log::BinaryLogRenderer::render(in, out, fmt);
+        }
+    }catch(std::exception& ex){
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
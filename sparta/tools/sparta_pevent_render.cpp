@@ -0,0 +1,73 @@
+// <sparta_pevent_render> -*- C++ -*-
+
+
+/*!
+ * \file sparta_pevent_render.cpp
+ * \brief Renders a binary (".bin") pevent file into the text written by a
+ * text pevent tap
+ *
+ * Usage: sparta_pevent_render <in.bin> [out.log]
+ *
+ * Without an output file the text is written to stdout.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "sparta/pevents/BinaryPeventWriter.hpp"
+#include "sparta/utils/SpartaException.hpp"
+
+namespace
+{
+    int usage(const char* exe)
+    {
+        std::cerr << "Usage: " << exe << " <in.bin> [out.log]\n"
+                  << "Renders a binary SPARTA pevent file into the text format written\n"
+                  << "by a text pevent tap" << std::endl;
+        return 1;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string in_file;
+    std::string out_file;
+
+    for(int i = 1; i < argc; ++i){
+        if(std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0){
+            return usage(argv[0]);
+        }else if(in_file.empty()){
+            in_file = argv[i];
+        }else if(out_file.empty()){
+            out_file = argv[i];
+        }else{
+            return usage(argv[0]);
+        }
+    }
+    if(in_file.empty()){
+        return usage(argv[0]);
+    }
+
+    try{
+        std::ifstream in(in_file, std::ios::binary);
+        if(!in){
+            throw sparta::SpartaException("Could not open \"") << in_file << "\"";
+        }
+
+        if(out_file.empty()){
+            sparta::pevents::BinaryPeventRenderer::render(in, std::cout);
+        }else{
+            std::ofstream out(out_file);
+            if(!out){
+                throw sparta::SpartaException("Could not open \"") << out_file << "\" for write";
+            }
+            sparta::pevents::BinaryPeventRenderer::render(in, out);
+        }
+    }catch(std::exception& ex){
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}